@@ -55,6 +55,14 @@ typedef struct {
   uint32_t firstGlyphIndex;   ///< First glyph index in the global glyph array
 } EpdFontGroup;
 
+/// Supplies the stored bytes of font groups that are not in memory (SD-card fonts). The returned pointer stays valid
+/// until the next fetchGroup() on the same source. A group whose compressedSize equals its uncompressedSize is stored
+/// without DEFLATE.
+typedef struct {
+  const uint8_t* (*fetchGroup)(void* context, uint16_t groupIndex);  ///< nullptr if the group could not be read
+  void* context;
+} EpdGroupSource;
+
 /// Glyph interval structure
 typedef struct {
   uint32_t first;   ///< The first unicode code point of the interval
@@ -98,4 +106,5 @@ typedef struct {
   uint8_t kernRightClassCount;           ///< Number of distinct right classes (matrix cols)
   const EpdLigaturePair* ligaturePairs;  ///< Sorted ligature pair table (nullptr if none)
   uint32_t ligaturePairCount;            ///< Number of entries in ligaturePairs
+  const EpdGroupSource* groupSource = nullptr;  ///< Fetches groups instead of reading bitmap (nullptr for built-in fonts)
 } EpdFontData;
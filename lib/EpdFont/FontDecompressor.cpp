@@ -4,9 +4,16 @@
 #include <Logging.h>
 #include <Utf8.h>
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 
+namespace {
+// Pinned groups never take more than this, nor more than half of the free heap above PIN_HEAP_RESERVE.
+constexpr uint32_t MAX_PINNED_BYTES = 48 * 1024;
+constexpr uint32_t PIN_HEAP_RESERVE = 64 * 1024;
+}  // namespace
+
 FontDecompressor::~FontDecompressor() { deinit(); }
 
 bool FontDecompressor::init() {
@@ -17,6 +24,8 @@ bool FontDecompressor::init() {
 void FontDecompressor::deinit() {
   freePageBuffer();
   freeHotGroup();
+  releasePinnedGroups();
+  pinCandidateCount = 0;
 }
 
 void FontDecompressor::clearCache() {
@@ -42,17 +51,102 @@ void FontDecompressor::freeHotGroup() {
   hotGlyphBuf.shrink_to_fit();
 }
 
+// --- Pinned groups ---
+
+void FontDecompressor::setPinCandidates(const PinCandidate* candidates, uint8_t count) {
+  if (count > MAX_PIN_CANDIDATES) count = MAX_PIN_CANDIDATES;
+  pinCandidateCount = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    if (candidates[i].fontData && candidates[i].groupIndex < candidates[i].fontData->groupCount) {
+      pinCandidates[pinCandidateCount++] = candidates[i];
+    }
+  }
+
+  // Drop pinned groups the new section doesn't rank; iterate backwards since unpinAt() moves the last entry down
+  for (int i = pinnedCount - 1; i >= 0; i--) {
+    if (!isPinCandidate(pinned[i].fontData, pinned[i].groupIndex)) unpinAt(static_cast<uint8_t>(i));
+  }
+  LOG_DBG("FDC", "Pin candidates: %u, %u groups still pinned (%lu bytes)", pinCandidateCount, pinnedCount,
+          stats.pinnedBytes);
+}
+
+void FontDecompressor::releasePinnedGroups() {
+  while (pinnedCount > 0) unpinAt(pinnedCount - 1);
+}
+
+void FontDecompressor::unpinAt(const uint8_t i) {
+  free(pinned[i].data);
+  stats.pinnedBytes -= pinned[i].size;
+  pinned[i] = pinned[--pinnedCount];
+  pinned[pinnedCount] = {};
+  stats.pinnedGroups = pinnedCount;
+}
+
+bool FontDecompressor::isPinCandidate(const EpdFontData* fontData, const uint16_t groupIndex) const {
+  for (uint8_t i = 0; i < pinCandidateCount; i++) {
+    if (pinCandidates[i].fontData == fontData && pinCandidates[i].groupIndex == groupIndex) return true;
+  }
+  return false;
+}
+
+const uint8_t* FontDecompressor::findPinned(const EpdFontData* fontData, const uint16_t groupIndex) {
+  for (uint8_t i = 0; i < pinnedCount; i++) {
+    if (pinned[i].fontData == fontData && pinned[i].groupIndex == groupIndex) {
+      pinned[i].lastUse = ++pinClock;
+      return pinned[i].data;
+    }
+  }
+  return nullptr;
+}
+
+uint32_t FontDecompressor::pinnedBudget() const {
+  const uint32_t freeHeap = ESP.getFreeHeap();
+  if (freeHeap <= PIN_HEAP_RESERVE) return 0;
+  return std::min<uint32_t>(MAX_PINNED_BYTES, stats.pinnedBytes + (freeHeap - PIN_HEAP_RESERVE) / 2);
+}
+
+bool FontDecompressor::pinGroup(const EpdFontData* fontData, const uint16_t groupIndex, uint8_t* data,
+                                const uint32_t size) {
+  if (!isPinCandidate(fontData, groupIndex)) return false;
+
+  const uint32_t budget = pinnedBudget();
+  if (size > budget) {
+    // Heap is tight: give back what is pinned rather than keep competing with page buffers
+    if (budget < stats.pinnedBytes) releasePinnedGroups();
+    return false;
+  }
+  while (pinnedCount > 0 && (pinnedCount >= MAX_PINNED_GROUPS || stats.pinnedBytes + size > budget)) {
+    uint8_t lru = 0;
+    for (uint8_t i = 1; i < pinnedCount; i++) {
+      if (pinned[i].lastUse < pinned[lru].lastUse) lru = i;
+    }
+    unpinAt(lru);
+  }
+
+  pinned[pinnedCount++] = {fontData, groupIndex, data, size, ++pinClock};
+  stats.pinnedBytes += size;
+  stats.pinnedGroups = pinnedCount;
+  return true;
+}
+
 uint16_t FontDecompressor::getGroupIndex(const EpdFontData* fontData, uint32_t glyphIndex) {
   // O(1) path for frequency-grouped fonts with glyphToGroup mapping
   if (fontData->glyphToGroup != nullptr) {
     return fontData->glyphToGroup[glyphIndex];
   }
 
-  // Contiguous-group fonts: linear scan
-  for (uint16_t i = 0; i < fontData->groupCount; i++) {
-    uint32_t first = fontData->groups[i].firstGlyphIndex;
-    if (glyphIndex >= first && glyphIndex < first + fontData->groups[i].glyphCount) {
-      return i;
+  // Contiguous-group fonts: groups are in glyph order, so binary search (SD fonts can have hundreds of groups)
+  int left = 0;
+  int right = fontData->groupCount - 1;
+  while (left <= right) {
+    const int mid = left + (right - left) / 2;
+    const EpdFontGroup& group = fontData->groups[mid];
+    if (glyphIndex < group.firstGlyphIndex) {
+      right = mid - 1;
+    } else if (glyphIndex >= group.firstGlyphIndex + group.glyphCount) {
+      left = mid + 1;
+    } else {
+      return mid;
     }
   }
   return fontData->groupCount;  // sentinel = not found
@@ -63,8 +157,27 @@ bool FontDecompressor::decompressGroup(const EpdFontData* fontData, uint16_t gro
   const EpdFontGroup& group = fontData->groups[groupIndex];
 
   const uint32_t tDecomp = millis();
+  const uint8_t* source = nullptr;
+  if (!fontData->groupSource) {
+    source = &fontData->bitmap[group.compressedOffset];
+  } else {
+    source = fontData->groupSource->fetchGroup(fontData->groupSource->context, groupIndex);
+    if (!source) {
+      stats.decompressTimeMs += millis() - tDecomp;
+      LOG_ERR("FDC", "Failed to fetch group %u", groupIndex);
+      return false;
+    }
+    // SD fonts keep groups that DEFLATE could not shrink as they are
+    if (group.compressedSize == group.uncompressedSize) {
+      memcpy(outBuf, source, std::min(outSize, group.uncompressedSize));
+      stats.decompressTimeMs += millis() - tDecomp;
+      return true;
+    }
+  }
+
+  stats.groupInflates++;
   inflateReader.init(false);
-  inflateReader.setSource(&fontData->bitmap[group.compressedOffset], group.compressedSize);
+  inflateReader.setSource(source, group.compressedSize);
   if (!inflateReader.read(outBuf, outSize)) {
     stats.decompressTimeMs += millis() - tDecomp;
     LOG_ERR("FDC", "Decompression failed for group %u", groupIndex);
@@ -170,6 +283,23 @@ const uint8_t* FontDecompressor::getBitmap(const EpdFontData* fontData, const Ep
     return nullptr;
   }
 
+  // Glyphs missing from the page buffer (cap reached, prewarm skipped) can still come from a pinned group
+  if (const uint8_t* pinnedGroup = findPinned(fontData, groupIndex)) {
+    stats.cacheHits++;
+    stats.pinnedHits++;
+    if (glyph->dataLength > hotGlyphBuf.size()) {
+      hotGlyphBuf.resize(glyph->dataLength);
+    }
+    if (hotGlyphBuf.empty()) {
+      stats.getBitmapTimeUs += micros() - tStart;
+      return nullptr;
+    }
+    compactSingleGlyph(&pinnedGroup[getAlignedOffset(fontData, groupIndex, glyphIndex)], hotGlyphBuf.data(),
+                       glyph->width, glyph->height);
+    stats.getBitmapTimeUs += micros() - tStart;
+    return hotGlyphBuf.data();
+  }
+
   // Check if hot group already has this group decompressed — if not, decompress it
   if (!(!hotGroup.empty() && hotGroupFont == fontData && hotGroupIndex == groupIndex)) {
     stats.cacheMisses++;
@@ -246,13 +376,6 @@ int32_t FontDecompressor::findGlyphIndex(const EpdFontData* fontData, uint32_t c
 int FontDecompressor::prewarmCache(const EpdFontData* fontData, const char* utf8Text) {
   if (!fontData || !fontData->groups || !utf8Text) return 0;
 
-  // Allocate the next available slot (caller must call freePageBuffer/clearCache to reset)
-  if (pageSlotCount >= MAX_PAGE_SLOTS) {
-    LOG_ERR("FDC", "All %u page buffer slots full, cannot prewarm fontData=%p", MAX_PAGE_SLOTS, (void*)fontData);
-    return -1;
-  }
-  PageSlot& slot = pageSlots[pageSlotCount];
-
   // Step 1: Collect unique glyph indices needed for this page
   uint32_t neededGlyphs[MAX_PAGE_GLYPHS];
   uint16_t glyphCount = 0;
@@ -285,7 +408,19 @@ int FontDecompressor::prewarmCache(const EpdFontData* fontData, const char* utf8
     }
   }
 
-  if (glyphCount == 0) return 0;
+  return prewarmGlyphs(fontData, neededGlyphs, glyphCount);
+}
+
+int FontDecompressor::prewarmGlyphs(const EpdFontData* fontData, const uint32_t* neededGlyphs, uint16_t glyphCount) {
+  if (!fontData || !fontData->groups || glyphCount == 0) return 0;
+  if (glyphCount > MAX_PAGE_GLYPHS) glyphCount = MAX_PAGE_GLYPHS;
+
+  // Allocate the next available slot (caller must call freePageBuffer/clearCache to reset)
+  if (pageSlotCount >= MAX_PAGE_SLOTS) {
+    LOG_ERR("FDC", "All %u page buffer slots full, cannot prewarm fontData=%p", MAX_PAGE_SLOTS, (void*)fontData);
+    return -1;
+  }
+  PageSlot& slot = pageSlots[pageSlotCount];
 
   // Step 2: Compute total buffer size and collect unique groups
   uint32_t totalBytes = 0;
@@ -418,28 +553,37 @@ int FontDecompressor::prewarmCache(const EpdFontData* fontData, const char* utf8
     }
   }
 
-  // Step 4: For each unique group, decompress to temp buffer and extract needed glyphs
+  // Step 4: For each unique group, decompress to temp buffer (or use the pinned copy) and extract needed glyphs
   uint32_t writeOffset = 0;
   int missed = 0;
+  uint8_t pinnedUsed = 0;
 
   for (uint8_t g = 0; g < groupCount; g++) {
     uint16_t groupIdx = neededGroups[g];
     const EpdFontGroup& group = fontData->groups[groupIdx];
 
-    auto* tempBuf = static_cast<uint8_t*>(malloc(group.uncompressedSize));
-    if (!tempBuf) {
-      LOG_ERR("FDC", "Failed to allocate temp buffer (%u bytes) for group %u", group.uncompressedSize, groupIdx);
-      missed++;
-      continue;
-    }
-    if (group.uncompressedSize > stats.peakTempBytes) {
-      stats.peakTempBytes = group.uncompressedSize;
-    }
+    uint8_t* tempBuf = nullptr;
+    const uint8_t* groupData = findPinned(fontData, groupIdx);
+    if (groupData) {
+      stats.pinnedHits++;
+      pinnedUsed++;
+    } else {
+      tempBuf = static_cast<uint8_t*>(malloc(group.uncompressedSize));
+      if (!tempBuf) {
+        LOG_ERR("FDC", "Failed to allocate temp buffer (%u bytes) for group %u", group.uncompressedSize, groupIdx);
+        missed++;
+        continue;
+      }
+      if (group.uncompressedSize > stats.peakTempBytes) {
+        stats.peakTempBytes = group.uncompressedSize;
+      }
 
-    if (!decompressGroup(fontData, groupIdx, tempBuf, group.uncompressedSize)) {
-      free(tempBuf);
-      missed++;
-      continue;
+      if (!decompressGroup(fontData, groupIdx, tempBuf, group.uncompressedSize)) {
+        free(tempBuf);
+        missed++;
+        continue;
+      }
+      groupData = tempBuf;
     }
 
     // Extract needed glyphs directly from the byte-aligned temp buffer, compacting on the fly.
@@ -449,29 +593,41 @@ int FontDecompressor::prewarmCache(const EpdFontData* fontData, const char* utf8
       if (getGroupIndex(fontData, slot.glyphs[i].glyphIndex) != groupIdx) continue;
 
       const EpdGlyph& glyph = fontData->glyph[slot.glyphs[i].glyphIndex];
-      compactSingleGlyph(&tempBuf[slot.glyphs[i].alignedOffset], &slot.buffer[writeOffset], glyph.width, glyph.height);
+      compactSingleGlyph(&groupData[slot.glyphs[i].alignedOffset], &slot.buffer[writeOffset], glyph.width,
+                         glyph.height);
       slot.glyphs[i].bufferOffset = writeOffset;
       writeOffset += glyph.dataLength;
     }
 
-    free(tempBuf);
+    // A freshly inflated candidate is kept for the next pages instead of being thrown away
+    if (tempBuf && !pinGroup(fontData, groupIdx, tempBuf, group.uncompressedSize)) {
+      free(tempBuf);
+    }
   }
 
-  LOG_DBG("FDC", "Prewarm: %u glyphs in %u bytes from %u groups (%d missed)", glyphCount, writeOffset, groupCount,
-          missed);
+  LOG_DBG("FDC", "Prewarm: %u glyphs in %u bytes from %u groups (%u pinned, %d missed)", glyphCount, writeOffset,
+          groupCount, pinnedUsed, missed);
 
   return missed;
 }
 
 // --- Stats ---
 
-void FontDecompressor::resetStats() { stats = Stats{}; }
+void FontDecompressor::resetStats() {
+  const uint8_t pinnedGroups = stats.pinnedGroups;
+  const uint32_t pinnedBytes = stats.pinnedBytes;
+  stats = Stats{};
+  stats.pinnedGroups = pinnedGroups;
+  stats.pinnedBytes = pinnedBytes;
+}
 
 void FontDecompressor::logStats(const char* label) {
   const uint32_t total = stats.cacheHits + stats.cacheMisses;
   LOG_DBG("FDC", "[%s] hits=%lu misses=%lu (%.1f%% hit rate)", label, stats.cacheHits, stats.cacheMisses,
           total > 0 ? 100.0f * stats.cacheHits / total : 0.0f);
   LOG_DBG("FDC", "[%s] decompress=%lums groups_accessed=%u", label, stats.decompressTimeMs, stats.uniqueGroupsAccessed);
+  LOG_DBG("FDC", "[%s] inflates=%lu avoided_by_pins=%lu pinned=%u groups/%lu bytes", label, stats.groupInflates,
+          stats.pinnedHits, stats.pinnedGroups, stats.pinnedBytes);
   LOG_DBG("FDC", "[%s] mem: pageBuf=%lu pageGlyphs=%lu hotGroup=%lu peakTemp=%lu", label, stats.pageBufferBytes,
           stats.pageGlyphsBytes, stats.hotGroupBytes, stats.peakTempBytes);
   if (stats.getBitmapCalls > 0) {
@@ -10,6 +10,8 @@ class FontDecompressor {
  public:
   static constexpr uint16_t MAX_PAGE_GLYPHS = 512;
   static constexpr uint8_t MAX_PAGE_SLOTS = 4;  // One per font style (R/B/I/BI)
+  static constexpr uint8_t MAX_PINNED_GROUPS = 8;
+  static constexpr uint8_t MAX_PIN_CANDIDATES = 16;
 
   FontDecompressor() = default;
   ~FontDecompressor();
@@ -21,14 +23,29 @@ class FontDecompressor {
   // Checks the page buffer (from prewarm) first, then falls back to the hot group slot.
   const uint8_t* getBitmap(const EpdFontData* fontData, const EpdGlyph* glyph, uint32_t glyphIndex);
 
-  // Free all cached data (page buffer + hot group).
+  // Free all cached data (page buffer + hot group). Pinned groups survive.
   void clearCache();
 
+  // Groups worth keeping decompressed across pages, most used first (from the section's glyph histogram).
+  // A candidate is pinned the first time it has to be inflated anyway, into a small LRU bounded by
+  // MAX_PINNED_GROUPS and by free heap; later pages extract its glyphs without inflating it again.
+  // Replacing the candidates releases every pinned group that is no longer one.
+  struct PinCandidate {
+    const EpdFontData* fontData;
+    uint16_t groupIndex;
+  };
+  void setPinCandidates(const PinCandidate* candidates, uint8_t count);
+  void releasePinnedGroups();
+
   // Pre-scan UTF-8 text and extract needed glyph bitmaps into a flat page buffer.
   // Each group is decompressed once into a temp buffer; only needed glyphs are kept.
   // Returns the number of glyphs that couldn't be loaded (0 on full success).
   int prewarmCache(const EpdFontData* fontData, const char* utf8Text);
 
+  // Same as prewarmCache() but for an already-resolved list of unique glyph indices (e.g. from a display list).
+  // At most MAX_PAGE_GLYPHS entries are used.
+  int prewarmGlyphs(const EpdFontData* fontData, const uint32_t* glyphIndices, uint16_t glyphCount);
+
   struct Stats {
     uint32_t cacheHits = 0;
     uint32_t cacheMisses = 0;
@@ -40,11 +57,20 @@ class FontDecompressor {
     uint32_t peakTempBytes = 0;    // largest temp buffer in prewarm
     uint32_t getBitmapTimeUs = 0;  // cumulative getBitmap time (micros)
     uint32_t getBitmapCalls = 0;   // number of getBitmap calls
+    uint32_t groupInflates = 0;    // groups actually decompressed
+    uint32_t pinnedHits = 0;       // group decompressions avoided thanks to a pinned group
+    uint8_t pinnedGroups = 0;      // currently pinned (kept across resetStats)
+    uint32_t pinnedBytes = 0;      // currently pinned (kept across resetStats)
   };
   void logStats(const char* label = "FDC");
   void resetStats();
   const Stats& getStats() const { return stats; }
 
+  // Lookup helpers, also used to build glyph group histograms during layout.
+  static int32_t findGlyphIndex(const EpdFontData* fontData, uint32_t codepoint);
+  // Returns fontData->groupCount if the glyph is in no group.
+  static uint16_t getGroupIndex(const EpdFontData* fontData, uint32_t glyphIndex);
+
  private:
   Stats stats;
   InflateReader inflateReader;
@@ -71,15 +97,33 @@ class FontDecompressor {
   uint16_t hotGroupIndex = UINT16_MAX;
   std::vector<uint8_t> hotGroup;
 
+  // Pinned groups: byte-aligned like the hot group, evicted least recently used first.
+  struct PinnedGroup {
+    const EpdFontData* fontData = nullptr;
+    uint16_t groupIndex = UINT16_MAX;
+    uint8_t* data = nullptr;
+    uint32_t size = 0;
+    uint32_t lastUse = 0;
+  };
+  PinnedGroup pinned[MAX_PINNED_GROUPS] = {};
+  uint8_t pinnedCount = 0;
+  uint32_t pinClock = 0;
+  PinCandidate pinCandidates[MAX_PIN_CANDIDATES] = {};
+  uint8_t pinCandidateCount = 0;
+
   // Scratch buffer for compacting a single glyph from the hot group.
   // Valid until the next getBitmap() call.
   std::vector<uint8_t> hotGlyphBuf;
 
   void freePageBuffer();
   void freeHotGroup();
-  uint16_t getGroupIndex(const EpdFontData* fontData, uint32_t glyphIndex);
+  const uint8_t* findPinned(const EpdFontData* fontData, uint16_t groupIndex);
+  bool isPinCandidate(const EpdFontData* fontData, uint16_t groupIndex) const;
+  // Takes ownership of a malloc'd decompressed group. Returns false (buffer untouched) if it can't be pinned.
+  bool pinGroup(const EpdFontData* fontData, uint16_t groupIndex, uint8_t* data, uint32_t size);
+  void unpinAt(uint8_t i);
+  uint32_t pinnedBudget() const;
   uint32_t getAlignedOffset(const EpdFontData* fontData, uint16_t groupIndex, uint32_t glyphIndex);
   bool decompressGroup(const EpdFontData* fontData, uint16_t groupIndex, uint8_t* outBuf, uint32_t outSize);
   static void compactSingleGlyph(const uint8_t* alignedSrc, uint8_t* packedDst, uint8_t width, uint8_t height);
-  static int32_t findGlyphIndex(const EpdFontData* fontData, uint32_t codepoint);
 };
@@ -0,0 +1,67 @@
+#include "GlyphGroupHistogram.h"
+
+#include <Utf8.h>
+
+#include <algorithm>
+
+#include "FontDecompressor.h"
+
+void GlyphGroupHistogram::reset(const EpdFontFamily* fontFamily) {
+  family = fontFamily;
+  for (auto& font : fonts) font = FontCounts{};
+  fontCount = 0;
+  pages = 0;
+}
+
+GlyphGroupHistogram::FontCounts* GlyphGroupHistogram::countsFor(const EpdFontFamily::Style style) {
+  const EpdFontData* data = family->getData(style);
+  if (!data || !data->groups || data->groupCount == 0) return nullptr;
+
+  for (uint8_t i = 0; i < fontCount; i++) {
+    if (fonts[i].data == data) return &fonts[i];
+  }
+  if (fontCount >= MAX_FONTS) return nullptr;
+
+  FontCounts& font = fonts[fontCount++];
+  font.data = data;
+  font.style = style;
+  font.pageCounts.assign(data->groupCount, 0);
+  font.lastPage.assign(data->groupCount, 0);
+  return &font;
+}
+
+void GlyphGroupHistogram::addText(const char* utf8Text, const EpdFontFamily::Style style) {
+  if (!family || !utf8Text) return;
+  FontCounts* font = countsFor(static_cast<EpdFontFamily::Style>(style & EpdFontFamily::BOLD_ITALIC));
+  if (!font) return;
+
+  const uint16_t stamp = pages + 1;
+  const auto* p = reinterpret_cast<const unsigned char*>(utf8Text);
+  while (*p) {
+    const uint32_t cp = utf8NextCodepoint(&p);
+    if (cp == 0) break;
+    const int32_t glyph = FontDecompressor::findGlyphIndex(font->data, cp);
+    if (glyph < 0) continue;
+    const uint16_t group = FontDecompressor::getGroupIndex(font->data, static_cast<uint32_t>(glyph));
+    if (group >= font->data->groupCount || font->lastPage[group] == stamp) continue;
+    font->lastPage[group] = stamp;
+    font->pageCounts[group]++;
+  }
+}
+
+void GlyphGroupHistogram::endPage() {
+  if (pages < UINT16_MAX - 1) pages++;
+}
+
+std::vector<GlyphGroupHistogram::Entry> GlyphGroupHistogram::top(const uint8_t maxEntries) const {
+  std::vector<Entry> entries;
+  for (uint8_t i = 0; i < fontCount; i++) {
+    const FontCounts& font = fonts[i];
+    for (uint16_t g = 0; g < font.pageCounts.size(); g++) {
+      if (font.pageCounts[g] > 0) entries.push_back({font.style, g, font.pageCounts[g]});
+    }
+  }
+  std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.pages > b.pages; });
+  if (entries.size() > maxEntries) entries.resize(maxEntries);
+  return entries;
+}
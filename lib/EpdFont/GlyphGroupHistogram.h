@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "EpdFontFamily.h"
+
+// Counts, for each compressed glyph group of a font family, how many pages use at least one glyph from it.
+//
+// Filled while a section is laid out; the groups at the top of the list (Latin lowercase, punctuation, digits) are
+// the ones worth keeping decompressed across page turns (see FontCacheManager::setPinnedGroups, which hands them to
+// FontDecompressor::setPinCandidates).
+class GlyphGroupHistogram {
+ public:
+  struct Entry {
+    uint8_t style;   // first EpdFontFamily::Style that resolved to this group's font
+    uint16_t group;  // index into EpdFontData::groups
+    uint16_t pages;  // pages using the group
+  };
+  static constexpr uint8_t MAX_ENTRIES = 16;
+
+  // Starts counting for family. Fonts without compressed groups are ignored.
+  void reset(const EpdFontFamily* family);
+  void addText(const char* utf8Text, EpdFontFamily::Style style);
+  // Closes the current page: every group seen since the last call counts once.
+  void endPage();
+  // Most used groups first, at most maxEntries.
+  std::vector<Entry> top(uint8_t maxEntries = MAX_ENTRIES) const;
+  uint16_t pageCount() const { return pages; }
+
+ private:
+  static constexpr uint8_t MAX_FONTS = 4;  // one per style; styles missing from the family share a font
+
+  struct FontCounts {
+    const EpdFontData* data = nullptr;
+    uint8_t style = 0;
+    std::vector<uint16_t> pageCounts;  // per group
+    std::vector<uint16_t> lastPage;    // per group: 1 + index of the last page that counted it, 0 for never
+  };
+
+  const EpdFontFamily* family = nullptr;
+  FontCounts fonts[MAX_FONTS];
+  uint8_t fontCount = 0;
+  uint16_t pages = 0;
+
+  FontCounts* countsFor(EpdFontFamily::Style style);
+};
@@ -9,17 +9,25 @@
 #include <Utf8.h>
 
 #include <algorithm>
-
-SdFont::SdFont() {
-  fontData.bitmap = nullptr;
-  fontData.glyph = nullptr;
-  fontData.intervals = nullptr;
-  fontData.intervalCount = 0;
-  fontData.advanceY = 0;
-  fontData.ascender = 0;
-  fontData.descender = 0;
-  fontData.is2Bit = false;
-}
+#include <cstring>
+
+namespace {
+constexpr uint32_t MAX_INTERVAL_COUNT = 4096;
+constexpr uint32_t MAX_GLYPH_COUNT = 65535;
+constexpr uint32_t MAX_BITMAP_SIZE = 8 * 1024 * 1024;
+// Version 2: a group is inflated whole into the decompressor's heap, so keep both sides of it small
+constexpr uint32_t MAX_GROUP_COUNT = 4096;
+constexpr uint32_t MAX_STORED_GROUP_SIZE = 32 * 1024;
+constexpr uint32_t MAX_GROUP_SIZE = 64 * 1024;
+
+constexpr size_t V1_HEADER_SIZE = 26;
+constexpr size_t V2_HEADER_SIZE = 34;
+// The tables are read straight into these structs
+static_assert(sizeof(EpdGlyph) == 16, "EpdGlyph layout changed, update the CPF format");
+static_assert(sizeof(EpdFontGroup) == 20, "EpdFontGroup layout changed, update the CPF format");
+}  // namespace
+
+SdFont::SdFont() = default;
 
 SdFont::~SdFont() { unload(); }
 
@@ -27,15 +35,31 @@ void SdFont::unload() {
   if (ownedBitmap) free(ownedBitmap);
   if (ownedGlyphs) free(ownedGlyphs);
   if (ownedIntervals) free(ownedIntervals);
+  if (ownedGroups) free(ownedGroups);
+  if (groupCache) free(groupCache);
+  if (file) file.close();
 
   ownedBitmap = nullptr;
   ownedGlyphs = nullptr;
   ownedIntervals = nullptr;
+  ownedGroups = nullptr;
+  groupCache = nullptr;
 
   fontData.bitmap = nullptr;
   fontData.glyph = nullptr;
   fontData.intervals = nullptr;
   fontData.intervalCount = 0;
+  fontData.groups = nullptr;
+  fontData.groupCount = 0;
+  fontData.groupSource = nullptr;
+
+  for (auto& slot : groupCacheSlots) {
+    slot = {};
+  }
+  groupCacheSlotCount = 0;
+  groupCacheClock = 0;
+  groupDataOffset = 0;
+  maxStoredGroupSize = 0;
 
   loaded = false;
 }
@@ -43,12 +67,37 @@ void SdFont::unload() {
 bool SdFont::load(const std::string& path) {
   unload();
 
-  FsFile file = Storage.open(path.c_str(), O_RDONLY);
+  file = Storage.open(path.c_str(), O_RDONLY);
   if (!file) {
     LOG_ERR("SDFONT", "Failed to open font file: %s", path.c_str());
     return false;
   }
 
+  char magic[4];
+  if (file.read(magic, sizeof(magic)) != sizeof(magic) || memcmp(magic, "CPF", 3) != 0) {
+    LOG_ERR("SDFONT", "Invalid font magic in %s", path.c_str());
+    file.close();
+    return false;
+  }
+
+  bool ok = false;
+  if (magic[3] == '\x01') {
+    ok = loadV1(path);
+    // Everything is in memory now
+    if (file) file.close();
+  } else if (magic[3] == '\x02') {
+    ok = loadV2(path);
+  } else {
+    LOG_ERR("SDFONT", "Unsupported font version %u in %s", static_cast<unsigned>(magic[3]), path.c_str());
+  }
+
+  if (!ok) {
+    unload();
+  }
+  return ok;
+}
+
+bool SdFont::loadV1(const std::string& path) {
   // Header format:
   // 4 bytes: Magic "CPF\x01"
   // 1 byte: advanceY
@@ -59,13 +108,7 @@ bool SdFont::load(const std::string& path) {
   // 4 bytes (uint32): totalGlyphs
   // 4 bytes (uint32): bitmapSize
 
-  auto readExact = [&file](void* dst, const size_t len) -> bool { return file.read(dst, len) == len; };
-
-  char magic[4];
-  if (!readExact(magic, sizeof(magic)) || memcmp(magic, "CPF\x01", 4) != 0) {
-    LOG_ERR("SDFONT", "Invalid font magic in %s", path.c_str());
-    return false;
-  }
+  auto readExact = [this](void* dst, const size_t len) -> bool { return file.read(dst, len) == len; };
 
   uint8_t advanceY;
   int32_t ascender, descender;
@@ -80,9 +123,6 @@ bool SdFont::load(const std::string& path) {
     return false;
   }
 
-  constexpr uint32_t MAX_INTERVAL_COUNT = 4096;
-  constexpr uint32_t MAX_GLYPH_COUNT = 65535;
-  constexpr uint32_t MAX_BITMAP_SIZE = 8 * 1024 * 1024;
   if (intervalCount > MAX_INTERVAL_COUNT || totalGlyphs > MAX_GLYPH_COUNT || bitmapSize > MAX_BITMAP_SIZE) {
     LOG_ERR("SDFONT", "CPF header out of bounds in %s (intervals=%u glyphs=%u bitmap=%u)", path.c_str(), intervalCount,
             totalGlyphs, bitmapSize);
@@ -91,7 +131,7 @@ bool SdFont::load(const std::string& path) {
 
   const uint64_t expectedPayloadSize = static_cast<uint64_t>(intervalCount) * sizeof(EpdUnicodeInterval) +
                                        static_cast<uint64_t>(totalGlyphs) * sizeof(EpdGlyph) + bitmapSize;
-  const uint64_t expectedFileSize = 22ULL + expectedPayloadSize;
+  const uint64_t expectedFileSize = V1_HEADER_SIZE + expectedPayloadSize;
   if (expectedFileSize != file.size()) {
     LOG_ERR("SDFONT", "Invalid CPF layout in %s (expected %llu bytes, got %u)", path.c_str(),
             static_cast<unsigned long long>(expectedFileSize), static_cast<unsigned>(file.size()));
@@ -109,8 +149,6 @@ bool SdFont::load(const std::string& path) {
   if (!ownedIntervals) goto oom;
   if (!readExact(ownedIntervals, intervalCount * sizeof(EpdUnicodeInterval))) {
     LOG_ERR("SDFONT", "Failed to read intervals in %s", path.c_str());
-    unload();
-    file.close();
     return false;
   }
   fontData.intervals = ownedIntervals;
@@ -120,8 +158,6 @@ bool SdFont::load(const std::string& path) {
   if (!ownedGlyphs) goto oom;
   if (!readExact(ownedGlyphs, totalGlyphs * sizeof(EpdGlyph))) {
     LOG_ERR("SDFONT", "Failed to read glyph data in %s", path.c_str());
-    unload();
-    file.close();
     return false;
   }
   fontData.glyph = ownedGlyphs;
@@ -131,24 +167,182 @@ bool SdFont::load(const std::string& path) {
   if (!ownedBitmap) goto oom;
   if (!readExact(ownedBitmap, bitmapSize)) {
     LOG_ERR("SDFONT", "Failed to read bitmap data in %s", path.c_str());
-    unload();
-    file.close();
     return false;
   }
   fontData.bitmap = ownedBitmap;
 
-  file.close();
   loaded = true;
   LOG_INF("SDFONT", "Loaded font %s (%u bytes bitmap, %u glyphs)", path.c_str(), bitmapSize, totalGlyphs);
   return true;
 
 oom:
   LOG_ERR("SDFONT", "Out of memory loading font %s", path.c_str());
-  unload();
-  file.close();
   return false;
 }
 
+bool SdFont::loadV2(const std::string& path) {
+  // Header format:
+  // 4 bytes: Magic "CPF\x02"
+  // 1 byte: advanceY
+  // 4 bytes (int32): ascender
+  // 4 bytes (int32): descender
+  // 1 byte: is2Bit (bool, always 1: groups hold byte-aligned 2-bit rows)
+  // 4 bytes (uint32): intervalCount
+  // 4 bytes (uint32): glyphCount
+  // 4 bytes (uint32): groupCount
+  // 4 bytes (uint32): maxStoredGroupSize
+  // 4 bytes (uint32): groupDataSize
+  // followed by the intervals, glyphs, group table and group data (see docs/file-formats.md)
+
+  auto readExact = [this](void* dst, const size_t len) -> bool { return file.read(dst, len) == len; };
+
+  uint8_t advanceY;
+  int32_t ascender, descender;
+  uint8_t is2Bit;
+  uint32_t intervalCount, glyphCount, groupCount, maxStored, groupDataSize;
+
+  if (!readExact(&advanceY, sizeof(advanceY)) || !readExact(&ascender, sizeof(ascender)) ||
+      !readExact(&descender, sizeof(descender)) || !readExact(&is2Bit, sizeof(is2Bit)) ||
+      !readExact(&intervalCount, sizeof(intervalCount)) || !readExact(&glyphCount, sizeof(glyphCount)) ||
+      !readExact(&groupCount, sizeof(groupCount)) || !readExact(&maxStored, sizeof(maxStored)) ||
+      !readExact(&groupDataSize, sizeof(groupDataSize))) {
+    LOG_ERR("SDFONT", "Truncated header in %s", path.c_str());
+    return false;
+  }
+
+  if (is2Bit != 1 || intervalCount > MAX_INTERVAL_COUNT || glyphCount > MAX_GLYPH_COUNT || groupCount == 0 ||
+      groupCount > MAX_GROUP_COUNT || maxStored > MAX_STORED_GROUP_SIZE) {
+    LOG_ERR("SDFONT", "CPF header out of bounds in %s (intervals=%u glyphs=%u groups=%u maxGroup=%u)", path.c_str(),
+            intervalCount, glyphCount, groupCount, maxStored);
+    return false;
+  }
+
+  const uint64_t tablesSize = static_cast<uint64_t>(intervalCount) * sizeof(EpdUnicodeInterval) +
+                              static_cast<uint64_t>(glyphCount) * sizeof(EpdGlyph) +
+                              static_cast<uint64_t>(groupCount) * sizeof(EpdFontGroup);
+  const uint64_t expectedFileSize = V2_HEADER_SIZE + tablesSize + groupDataSize;
+  if (expectedFileSize != file.size()) {
+    LOG_ERR("SDFONT", "Invalid CPF layout in %s (expected %llu bytes, got %u)", path.c_str(),
+            static_cast<unsigned long long>(expectedFileSize), static_cast<unsigned>(file.size()));
+    return false;
+  }
+
+  ownedIntervals = static_cast<EpdUnicodeInterval*>(malloc(intervalCount * sizeof(EpdUnicodeInterval)));
+  ownedGlyphs = static_cast<EpdGlyph*>(malloc(glyphCount * sizeof(EpdGlyph)));
+  ownedGroups = static_cast<EpdFontGroup*>(malloc(groupCount * sizeof(EpdFontGroup)));
+  if ((intervalCount > 0 && !ownedIntervals) || (glyphCount > 0 && !ownedGlyphs) || !ownedGroups) {
+    LOG_ERR("SDFONT", "Out of memory loading font index %s", path.c_str());
+    return false;
+  }
+  if (!readExact(ownedIntervals, intervalCount * sizeof(EpdUnicodeInterval)) ||
+      !readExact(ownedGlyphs, glyphCount * sizeof(EpdGlyph)) ||
+      !readExact(ownedGroups, groupCount * sizeof(EpdFontGroup))) {
+    LOG_ERR("SDFONT", "Failed to read font index in %s", path.c_str());
+    return false;
+  }
+
+  // The decompressor trusts these tables, so check everything it indexes with
+  for (uint32_t i = 0; i < intervalCount; i++) {
+    const EpdUnicodeInterval& interval = ownedIntervals[i];
+    const uint64_t lastGlyph = static_cast<uint64_t>(interval.offset) + interval.last - interval.first;
+    if (interval.first > interval.last || lastGlyph >= glyphCount) {
+      LOG_ERR("SDFONT", "Invalid interval %u in %s", i, path.c_str());
+      return false;
+    }
+  }
+  uint32_t nextGlyph = 0;
+  for (uint32_t g = 0; g < groupCount; g++) {
+    const EpdFontGroup& group = ownedGroups[g];
+    if (group.firstGlyphIndex != nextGlyph || group.glyphCount == 0 ||
+        static_cast<uint64_t>(group.firstGlyphIndex) + group.glyphCount > glyphCount ||
+        static_cast<uint64_t>(group.compressedOffset) + group.compressedSize > groupDataSize ||
+        group.compressedSize > maxStored || group.uncompressedSize > MAX_GROUP_SIZE) {
+      LOG_ERR("SDFONT", "Invalid group %u in %s", g, path.c_str());
+      return false;
+    }
+    uint32_t alignedSize = 0;
+    for (uint32_t i = group.firstGlyphIndex; i < group.firstGlyphIndex + group.glyphCount; i++) {
+      const EpdGlyph& glyph = ownedGlyphs[i];
+      if (glyph.dataLength != (glyph.width * glyph.height + 3) / 4) {
+        LOG_ERR("SDFONT", "Invalid glyph %u in %s", i, path.c_str());
+        return false;
+      }
+      alignedSize += ((glyph.width + 3) / 4) * glyph.height;
+    }
+    if (alignedSize != group.uncompressedSize) {
+      LOG_ERR("SDFONT", "Group %u size mismatch in %s", g, path.c_str());
+      return false;
+    }
+    nextGlyph += group.glyphCount;
+  }
+  if (nextGlyph != glyphCount) {
+    LOG_ERR("SDFONT", "Groups do not cover every glyph in %s", path.c_str());
+    return false;
+  }
+
+  fontData.advanceY = advanceY;
+  fontData.ascender = ascender;
+  fontData.descender = descender;
+  fontData.is2Bit = true;
+  fontData.intervals = ownedIntervals;
+  fontData.intervalCount = intervalCount;
+  fontData.glyph = ownedGlyphs;
+  fontData.groups = ownedGroups;
+  fontData.groupCount = groupCount;
+  groupSource.fetchGroup = &SdFont::fetchGroup;
+  groupSource.context = this;
+  fontData.groupSource = &groupSource;
+
+  groupDataOffset = V2_HEADER_SIZE + tablesSize;
+  maxStoredGroupSize = maxStored;
+  groupCacheSlotCount = maxStored == 0 ? 1 : std::clamp<uint32_t>(GROUP_CACHE_BYTES / maxStored, 1, GROUP_CACHE_SLOTS);
+
+  loaded = true;
+  LOG_INF("SDFONT", "Loaded paged font %s (%u glyphs, %u groups, %u bytes on card)", path.c_str(), glyphCount,
+          groupCount, groupDataSize);
+  return true;
+}
+
+const uint8_t* SdFont::fetchGroup(void* context, const uint16_t groupIndex) {
+  auto* font = static_cast<SdFont*>(context);
+  if (!font->loaded || groupIndex >= font->fontData.groupCount) {
+    return nullptr;
+  }
+
+  if (!font->groupCache) {
+    // At least one byte so a font made only of empty glyphs still gets a valid pointer
+    font->groupCache =
+        static_cast<uint8_t*>(malloc(std::max<uint32_t>(1, font->groupCacheSlotCount * font->maxStoredGroupSize)));
+    if (!font->groupCache) {
+      LOG_ERR("SDFONT", "Out of memory for %u group cache slots", font->groupCacheSlotCount);
+      return nullptr;
+    }
+  }
+
+  uint8_t victim = 0;
+  for (uint8_t s = 0; s < font->groupCacheSlotCount; s++) {
+    GroupCacheSlot& slot = font->groupCacheSlots[s];
+    if (slot.groupIndex == groupIndex) {
+      slot.lastUsed = ++font->groupCacheClock;
+      return &font->groupCache[s * font->maxStoredGroupSize];
+    }
+    if (slot.lastUsed < font->groupCacheSlots[victim].lastUsed) {
+      victim = s;
+    }
+  }
+
+  const EpdFontGroup& group = font->ownedGroups[groupIndex];
+  uint8_t* block = &font->groupCache[victim * font->maxStoredGroupSize];
+  if (!font->file.seek(font->groupDataOffset + group.compressedOffset) ||
+      font->file.read(block, group.compressedSize) != static_cast<int>(group.compressedSize)) {
+    font->groupCacheSlots[victim] = {};
+    LOG_ERR("SDFONT", "Failed to read group %u", groupIndex);
+    return nullptr;
+  }
+  font->groupCacheSlots[victim] = {groupIndex, ++font->groupCacheClock};
+  return block;
+}
+
 void SdFont::getTextBounds(const char* string, const int startX, const int startY, int* minX, int* minY, int* maxX,
                            int* maxY) const {
   *minX = startX;
@@ -3,14 +3,24 @@
 #include <FeatureFlags.h>
 #if ENABLE_USER_FONTS
 
+#include <HalStorage.h>
+
 #include <string>
 
 #include "IEpdFont.h"
 
+// A .cpf font on the SD card.
+//
+// Version 1 files are read into memory whole. Version 2 files keep only the intervals, glyph metrics and group table
+// in memory; the glyph bitmaps stay on the card in DEFLATE groups like the built-in compressed fonts, and the
+// FontDecompressor fetches a group through fontData.groupSource when a page needs it. Stored groups pass through a
+// small LRU of GROUP_CACHE_SLOTS blocks, so a large CJK font costs its index plus a few groups of RAM.
 class SdFont : public IEpdFont {
  public:
   SdFont();
   virtual ~SdFont();
+  SdFont(const SdFont&) = delete;
+  SdFont& operator=(const SdFont&) = delete;
 
   bool load(const std::string& path);
   void unload();
@@ -23,12 +33,36 @@ class SdFont : public IEpdFont {
   bool isLoaded() const { return loaded; }
 
  private:
-  EpdFontData fontData;
+  static constexpr uint8_t GROUP_CACHE_SLOTS = 4;
+  // Fewer slots are used when the largest stored group would take the cache over this
+  static constexpr uint32_t GROUP_CACHE_BYTES = 16 * 1024;
+
+  struct GroupCacheSlot {
+    uint16_t groupIndex = UINT16_MAX;
+    uint32_t lastUsed = 0;
+  };
+
+  EpdFontData fontData = {};
   uint8_t* ownedBitmap = nullptr;
   EpdGlyph* ownedGlyphs = nullptr;
   EpdUnicodeInterval* ownedIntervals = nullptr;
   bool loaded = false;
 
+  // Version 2 only
+  EpdFontGroup* ownedGroups = nullptr;
+  EpdGroupSource groupSource = {};
+  FsFile file;                   // Open while the font is loaded
+  uint32_t groupDataOffset = 0;  // File offset of the first group
+  uint32_t maxStoredGroupSize = 0;
+  uint8_t* groupCache = nullptr;  // groupCacheSlotCount blocks of maxStoredGroupSize, allocated on first fetch
+  GroupCacheSlot groupCacheSlots[GROUP_CACHE_SLOTS];
+  uint8_t groupCacheSlotCount = 0;
+  uint32_t groupCacheClock = 0;
+
+  bool loadV1(const std::string& path);
+  bool loadV2(const std::string& path);
+  static const uint8_t* fetchGroup(void* context, uint16_t groupIndex);
+
   void getTextBounds(const char* string, int startX, int startY, int* minX, int* minY, int* maxX, int* maxY) const;
 };
 
@@ -4,9 +4,14 @@ import sys
 import math
 import argparse
 import struct
+import zlib
 from collections import namedtuple
 
 # Based on fontconvert.py, but outputs binary CPF format for CrossPoint Reader.
+#
+# Format 2 (default) keeps the bitmaps on the SD card: glyphs are split into groups like the built-in compressed
+# fonts, each group is stored as raw DEFLATE of byte-aligned 2-bit rows, and the device only reads the groups a page
+# needs. Format 1 stores one flat bitmap that the device loads into memory whole. See docs/file-formats.md.
 
 parser = argparse.ArgumentParser(description="Generate a binary .cpf font file from a TTF/OTF font.")
 parser.add_argument("size", type=int, help="font size to use.")
@@ -14,13 +19,24 @@ parser.add_argument("fontstack", action="store", nargs='+', help="list of font f
 parser.add_argument("--output", dest="output", action="store", required=True, help="output .cpf file path.")
 parser.add_argument("--2bit", dest="is2Bit", action="store_true", help="generate 2-bit greyscale bitmap instead of 1-bit black and white.")
 parser.add_argument("--additional-intervals", dest="additional_intervals", action="append", help="Additional code point intervals to export as min,max. This argument can be repeated.")
+parser.add_argument("--format", dest="format", type=int, choices=[1, 2], default=2, help="CPF version: 2 (paged from SD, needs --2bit) or 1 (loaded whole, for older firmware).")
+parser.add_argument("--max-group-bytes", dest="max_group_bytes", type=int, default=8192, help="format 2: largest uncompressed group; smaller groups read less from SD per glyph.")
+parser.add_argument("--no-compress", dest="compress", action="store_false", help="format 2: store groups without DEFLATE.")
 args = parser.parse_args()
 
+if args.format == 2 and not args.is2Bit:
+    print("Error: format 2 requires --2bit (groups hold byte-aligned 2-bit rows); use --format 1 for 1-bit fonts", file=sys.stderr)
+    sys.exit(1)
+
 GlyphProps = namedtuple("GlyphProps", ["width", "height", "advance_x", "left", "top", "data_length", "data_offset", "code_point"])
 # Matches C++ EpdGlyph layout (16 bytes, little-endian):
-# B=width, B=height, B=advanceX, x=pad, h=left, h=top, H=dataLength, xx=pad, I=dataOffset
-GLYPH_STRUCT = "<BBBxhhHxxI"
+# B=width, B=height, H=advanceX (12.4 fixed-point), h=left, h=top, H=dataLength, xx=pad, I=dataOffset
+GLYPH_STRUCT = "<BBHhhHxxI"
 assert struct.calcsize(GLYPH_STRUCT) == 16
+# Matches C++ EpdFontGroup layout (20 bytes, little-endian):
+# I=compressedOffset, I=compressedSize, I=uncompressedSize, H=glyphCount, xx=pad, I=firstGlyphIndex
+GROUP_STRUCT = "<IIIHxxI"
+assert struct.calcsize(GROUP_STRUCT) == 20
 
 font_stack = [freetype.Face(f) for f in args.fontstack]
 is2Bit = args.is2Bit
@@ -53,6 +69,10 @@ def norm_floor(val):
 def norm_ceil(val):
     return int(math.ceil(val / (1 << 6)))
 
+def fp4_from_ft16_16(val):
+    # 16.16 linear advance to 12.4 fixed-point, rounded
+    return (val + (1 << 11)) >> 12
+
 def load_glyph(code_point):
     for face in font_stack:
         glyph_index = face.get_char_index(code_point)
@@ -147,7 +167,7 @@ for i_start, i_end in intervals:
         glyph = GlyphProps(
             width = bitmap.width,
             height = bitmap.rows,
-            advance_x = norm_floor(face.glyph.advance.x),
+            advance_x = fp4_from_ft16_16(face.glyph.linearHoriAdvance),
             left = face.glyph.bitmap_left,
             top = face.glyph.bitmap_top,
             data_length = len(packed),
@@ -163,27 +183,123 @@ advance_y = norm_ceil(face.size.height)
 ascender = norm_ceil(face.size.ascender)
 descender = norm_floor(face.size.descender)
 
-with open(args.output, "wb") as f:
+def to_byte_aligned(packed, width, height):
+    """Re-packs a 2-bit glyph from a continuous bit stream into rows starting on a byte boundary."""
+    if width == 0 or height == 0:
+        return b''
+    row_stride = (width + 3) // 4
+    aligned = bytearray(row_stride * height)
+    for y in range(height):
+        for x in range(width):
+            packed_pos = y * width + x
+            pixel = (packed[packed_pos // 4] >> ((3 - packed_pos % 4) * 2)) & 0x3
+            aligned[y * row_stride + x // 4] |= pixel << ((3 - x % 4) * 2)
+    return bytes(aligned)
+
+# Same script ranges as fontconvert.py; glyphs that are read together share a group
+SCRIPT_GROUP_RANGES = [
+    (0x0000, 0x007F),   # ASCII
+    (0x0080, 0x00FF),   # Latin-1 Supplement
+    (0x0100, 0x017F),   # Latin Extended-A
+    (0x0180, 0x024F),   # Latin Extended-B
+    (0x0300, 0x036F),   # Combining Diacritical Marks
+    (0x0400, 0x04FF),   # Cyrillic
+    (0x1EA0, 0x1EF9),   # Vietnamese Extended
+    (0x2000, 0x206F),   # General Punctuation
+    (0x2070, 0x209F),   # Superscripts & Subscripts
+    (0x20A0, 0x20CF),   # Currency Symbols
+    (0x2190, 0x21FF),   # Arrows
+    (0x2200, 0x22FF),   # Math Operators
+    (0xFB00, 0xFB06),   # Alphabetic Presentation Forms (ligatures)
+    (0xFFFD, 0xFFFD),   # Replacement Character
+]
+
+def group_key(code_point):
+    for i, (start, end) in enumerate(SCRIPT_GROUP_RANGES):
+        if start <= code_point <= end:
+            return i
+    # Anything else (CJK, other scripts) is grouped by 256-code-point page
+    return len(SCRIPT_GROUP_RANGES) + (code_point >> 8)
+
+def build_groups():
+    """Returns [(first_glyph_index, glyph_count, aligned_bytes)] with glyphs in array order."""
+    groups = []
+    current_key = None
+    for i, props in enumerate(all_glyphs_props):
+        aligned = to_byte_aligned(all_glyphs_data[i], props.width, props.height)
+        key = group_key(props.code_point)
+        if groups and key == current_key and len(groups[-1][2]) + len(aligned) <= args.max_group_bytes:
+            first, count, data = groups[-1]
+            groups[-1] = (first, count + 1, data + aligned)
+        else:
+            groups.append((i, 1, aligned))
+            current_key = key
+    return groups
+
+def write_v1(f):
     # 4 bytes: Magic "CPF\x01"
     f.write(b"CPF\x01")
     # 1 byte: advanceY, 4 bytes (int32): ascender, 4 bytes (int32): descender, 1 byte: is2Bit
     f.write(struct.pack("<Biib", advance_y, ascender, descender, 1 if is2Bit else 0))
     # 4 bytes (uint32): intervalCount, 4 bytes (uint32): totalGlyphs, 4 bytes (uint32): bitmapSize
     f.write(struct.pack("<III", len(intervals), len(all_glyphs_props), total_bitmap_size))
-    
-    # Intervals: uint32 first, uint32 last, uint32 offset
-    offset = 0
-    for i_start, i_end in intervals:
-        f.write(struct.pack("<III", i_start, i_end, offset))
-        offset += i_end - i_start + 1
-        
-    # Glyphs: uint8 width, uint8 height, uint8 advanceX, 1-byte padding,
-    # int16 left, int16 top, uint16 dataLength, 2-byte padding, uint32 dataOffset
+    write_intervals(f)
     for g in all_glyphs_props:
         f.write(struct.pack(GLYPH_STRUCT, g.width, g.height, g.advance_x, g.left, g.top, g.data_length, g.data_offset))
-        
     # Bitmap data
     for data in all_glyphs_data:
         f.write(data)
+    print(f"Generated {args.output}: {len(all_glyphs_props)} glyphs, {total_bitmap_size} bytes bitmap data.")
+
+def write_v2(f):
+    groups = build_groups()
+    stored_groups = []
+    glyph_offsets = [0] * len(all_glyphs_props)
+    for first, count, aligned in groups:
+        # dataOffset becomes the packed offset within the group, as in fontconvert.py --compress
+        packed_offset = 0
+        for gi in range(first, first + count):
+            glyph_offsets[gi] = packed_offset
+            packed_offset += all_glyphs_props[gi].data_length
+        stored = aligned
+        if args.compress:
+            compressor = zlib.compressobj(level=9, wbits=-15)
+            deflated = compressor.compress(aligned) + compressor.flush()
+            # The device takes a group whose stored size equals its size as uncompressed
+            if len(deflated) < len(aligned):
+                stored = deflated
+        stored_groups.append(stored)
+
+    group_data_size = sum(len(stored) for stored in stored_groups)
+    max_stored = max((len(stored) for stored in stored_groups), default=0)
+
+    # 4 bytes: Magic "CPF\x02"
+    f.write(b"CPF\x02")
+    # 1 byte: advanceY, 4 bytes (int32): ascender, 4 bytes (int32): descender, 1 byte: is2Bit
+    f.write(struct.pack("<Biib", advance_y, ascender, descender, 1))
+    # 4 bytes (uint32) each: intervalCount, glyphCount, groupCount, maxStoredGroupSize, groupDataSize
+    f.write(struct.pack("<IIIII", len(intervals), len(all_glyphs_props), len(groups), max_stored, group_data_size))
+    write_intervals(f)
+    for g, offset in zip(all_glyphs_props, glyph_offsets):
+        f.write(struct.pack(GLYPH_STRUCT, g.width, g.height, g.advance_x, g.left, g.top, g.data_length, offset))
+    stored_offset = 0
+    for (first, count, aligned), stored in zip(groups, stored_groups):
+        f.write(struct.pack(GROUP_STRUCT, stored_offset, len(stored), len(aligned), count, first))
+        stored_offset += len(stored)
+    for stored in stored_groups:
+        f.write(stored)
+    print(f"Generated {args.output}: {len(all_glyphs_props)} glyphs in {len(groups)} groups, "
+          f"{total_bitmap_size} -> {group_data_size} bytes bitmap data, largest group {max_stored} bytes.")
+
+def write_intervals(f):
+    # Intervals: uint32 first, uint32 last, uint32 offset
+    offset = 0
+    for i_start, i_end in intervals:
+        f.write(struct.pack("<III", i_start, i_end, offset))
+        offset += i_end - i_start + 1
 
-print(f"Generated {args.output}: {len(all_glyphs_props)} glyphs, {total_bitmap_size} bytes bitmap data.")
+with open(args.output, "wb") as f:
+    if args.format == 2:
+        write_v2(f)
+    else:
+        write_v1(f)
@@ -309,6 +309,22 @@ bool Epub::parseTocNavFile() const {
 
 std::string Epub::getCssRulesCache() const { return cachePath + "/css_rules.cache"; }
 
+std::string Epub::getZipIndexPath() const { return cachePath + "/zipindex.bin"; }
+
+void Epub::ensureZipIndex() const {
+  const std::string indexPath = getZipIndexPath();
+  ZipFile zip(filepath);
+  if (zip.hasValidIndex(indexPath)) {
+    return;
+  }
+  const uint32_t start = millis();
+  if (!zip.writeIndex(indexPath)) {
+    LOG_ERR("EBP", "Could not build zip index, item lookups will scan the central directory");
+    return;
+  }
+  LOG_DBG("EBP", "Zip index built in %lu ms", millis() - start);
+}
+
 bool Epub::loadCssRulesFromCache() const {
   FsFile cssCacheFile;
   if (Storage.openFileForRead("EBP", getCssRulesCache(), cssCacheFile)) {
@@ -397,6 +413,8 @@ bool Epub::load(const bool buildIfMissing, const bool skipLoadingCss) {
 
   // Try to load existing cache first
   if (bookMetadataCache->load()) {
+    // Caches written before the zip index existed don't have one yet
+    ensureZipIndex();
     if (!skipLoadingCss && !loadCssRulesFromCache()) {
       LOG_DBG("EBP", "Warning: CSS rules cache not found, attempting to parse CSS files");
       // to get CSS file list
@@ -420,6 +438,8 @@ bool Epub::load(const bool buildIfMissing, const bool skipLoadingCss) {
   setupCacheDir();
 
   const uint32_t indexingStart = millis();
+  // Index the zip first so every item read below (OPF, TOC, CSS, sizes) is a binary search
+  ensureZipIndex();
 
   // Begin building cache - stream entries to disk immediately
   if (!bookMetadataCache->beginWrite()) {
@@ -484,7 +504,7 @@ bool Epub::load(const bool buildIfMissing, const bool skipLoadingCss) {
 
   // Build final book.bin
   const uint32_t buildStart = millis();
-  if (!bookMetadataCache->buildBookBin(filepath, bookMetadata)) {
+  if (!bookMetadataCache->buildBookBin(filepath, getZipIndexPath(), bookMetadata)) {
     LOG_ERR("EBP", "Could not update mappings and sizes");
     return false;
   }
@@ -807,7 +827,7 @@ uint8_t* Epub::readItemContentsToBytes(const std::string& itemHref, size_t* size
 
   const std::string path = FsHelpers::normalisePath(itemHref);
 
-  const auto content = ZipFile(filepath).readFileToMemory(path.c_str(), size, trailingNullByte);
+  const auto content = ZipFile(filepath, getZipIndexPath()).readFileToMemory(path.c_str(), size, trailingNullByte);
   if (!content) {
     LOG_DBG("EBP", "Failed to read item %s", path.c_str());
     return nullptr;
@@ -824,12 +844,12 @@ bool Epub::readItemContentsToStream(const std::string& itemHref, Print& out, con
   }
 
   const std::string path = FsHelpers::normalisePath(itemHref);
-  return ZipFile(filepath).readFileToStream(path.c_str(), out, chunkSize);
+  return ZipFile(filepath, getZipIndexPath()).readFileToStream(path.c_str(), out, chunkSize);
 }
 
 bool Epub::getItemSize(const std::string& itemHref, size_t* size) const {
   const std::string path = FsHelpers::normalisePath(itemHref);
-  return ZipFile(filepath).getInflatedFileSize(path.c_str(), size);
+  return ZipFile(filepath, getZipIndexPath()).getInflatedFileSize(path.c_str(), size);
 }
 
 int Epub::getSpineItemsCount() const {
@@ -839,7 +859,16 @@ int Epub::getSpineItemsCount() const {
   return bookMetadataCache->getSpineCount();
 }
 
-size_t Epub::getCumulativeSpineItemSize(const int spineIndex) const { return getSpineItem(spineIndex).cumulativeSize; }
+size_t Epub::getCumulativeSpineItemSize(const int spineIndex) const {
+  if (!bookMetadataCache || !bookMetadataCache->isLoaded() || bookMetadataCache->getSpineCount() == 0) {
+    return 0;
+  }
+  if (spineIndex < 0 || spineIndex >= bookMetadataCache->getSpineCount()) {
+    LOG_ERR("EBP", "getCumulativeSpineItemSize index:%d is out of range", spineIndex);
+    return bookMetadataCache->getCumulativeSize(0);
+  }
+  return bookMetadataCache->getCumulativeSize(spineIndex);
+}
 
 BookMetadataCache::SpineEntry Epub::getSpineItem(const int spineIndex) const {
   if (!bookMetadataCache || !bookMetadataCache->isLoaded()) {
@@ -889,7 +918,7 @@ int Epub::getSpineIndexForTocIndex(const int tocIndex) const {
     return 0;
   }
 
-  const int spineIndex = bookMetadataCache->getTocEntry(tocIndex).spineIndex;
+  const int spineIndex = bookMetadataCache->getSpineIndexForToc(tocIndex);
   if (spineIndex < 0) {
     LOG_DBG("EBP", "Section not found for TOC index %d", tocIndex);
     return 0;
@@ -898,7 +927,16 @@ int Epub::getSpineIndexForTocIndex(const int tocIndex) const {
   return spineIndex;
 }
 
-int Epub::getTocIndexForSpineIndex(const int spineIndex) const { return getSpineItem(spineIndex).tocIndex; }
+int Epub::getTocIndexForSpineIndex(const int spineIndex) const {
+  if (!bookMetadataCache || !bookMetadataCache->isLoaded() || bookMetadataCache->getSpineCount() == 0) {
+    return -1;
+  }
+  if (spineIndex < 0 || spineIndex >= bookMetadataCache->getSpineCount()) {
+    LOG_ERR("EBP", "getTocIndexForSpineIndex index:%d is out of range", spineIndex);
+    return bookMetadataCache->getTocIndexForSpine(0);
+  }
+  return bookMetadataCache->getTocIndexForSpine(spineIndex);
+}
 
 size_t Epub::getBookSize() const {
   if (!bookMetadataCache || !bookMetadataCache->isLoaded() || bookMetadataCache->getSpineCount() == 0) {
@@ -922,6 +960,14 @@ int Epub::getSpineIndexForTextReference() const {
     return 0;
   }
 
+  // The file name index usually lands on it directly; fall back to a scan when another item shares the file name
+  const std::string& textReferenceHref = bookMetadataCache->coreMetadata.textReferenceHref;
+  const int candidate = bookMetadataCache->findSpineIndexByFileName(BookMetadataCache::fileNameOf(textReferenceHref));
+  if (candidate >= 0 && getSpineItem(candidate).href == textReferenceHref) {
+    LOG_DBG("EBP", "Text reference %s found at index %d", textReferenceHref.c_str(), candidate);
+    return candidate;
+  }
+
   // loop through spine items to get the correct index matching the text href
   for (size_t i = 0; i < getSpineItemsCount(); i++) {
     if (getSpineItem(i).href == bookMetadataCache->coreMetadata.textReferenceHref) {
@@ -952,25 +998,14 @@ int Epub::resolveHrefToSpineIndex(const std::string& href) const {
   if (!bookMetadataCache || !bookMetadataCache->isLoaded()) return -1;
 
   // Extract filename (remove #anchor)
-  std::string target = href;
-  size_t hashPos = target.find('#');
-  if (hashPos != std::string::npos) target = target.substr(0, hashPos);
+  std::string_view target = href;
+  const size_t hashPos = target.find('#');
+  if (hashPos != std::string_view::npos) target = target.substr(0, hashPos);
 
   // Same-file reference (anchor-only)
   if (target.empty()) return -1;
 
-  // Extract just the filename for comparison
-  size_t targetSlash = target.find_last_of('/');
-  std::string targetFilename = (targetSlash != std::string::npos) ? target.substr(targetSlash + 1) : target;
-
-  for (int i = 0; i < getSpineItemsCount(); i++) {
-    const auto& spineHref = getSpineItem(i).href;
-    // Try exact match first
-    if (spineHref == target) return i;
-    // Then filename-only match
-    size_t spineSlash = spineHref.find_last_of('/');
-    std::string spineFilename = (spineSlash != std::string::npos) ? spineHref.substr(spineSlash + 1) : spineHref;
-    if (spineFilename == targetFilename) return i;
-  }
-  return -1;
+  // An exact href match always has the same file name, so the first spine item with the target's file name is the
+  // one a scan for "exact or file name match" would stop at
+  return bookMetadataCache->findSpineIndexByFileName(BookMetadataCache::fileNameOf(target));
 }
@@ -37,6 +37,7 @@ class Epub {
   void parseCssFiles() const;
   std::string getCssRulesCache() const;
   bool loadCssRulesFromCache() const;
+  void ensureZipIndex() const;
 
  public:
   explicit Epub(std::string filepath, const std::string& cacheDir) : filepath(std::move(filepath)) {
@@ -49,6 +50,8 @@ class Epub {
   bool clearCache() const;
   void setupCacheDir() const;
   const std::string& getCachePath() const;
+  // Sorted entry index of the EPUB zip, built on load. Pass to ZipFile so item lookups skip the central directory walk.
+  std::string getZipIndexPath() const;
   const std::string& getPath() const;
   const std::string& getTitle() const;
   const std::string& getAuthor() const;
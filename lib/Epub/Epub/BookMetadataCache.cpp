@@ -7,12 +7,15 @@
 #include <vector>
 
 #include "FsHelpers.h"
+#include "SpiBusMutex.h"
 
 namespace {
-constexpr uint8_t BOOK_CACHE_VERSION = 6;
+constexpr uint8_t BOOK_CACHE_VERSION = 7;
 constexpr char bookBinFile[] = "/book.bin";
 constexpr char tmpSpineBinFile[] = "/spine.bin.tmp";
 constexpr char tmpTocBinFile[] = "/toc.bin.tmp";
+// Spines this long get their sizes from one pass over the ZIP central directory instead of a lookup per item
+constexpr uint16_t LARGE_SPINE_THRESHOLD = 400;
 }  // namespace
 
 /* ============= WRITING / BUILDING FUNCTIONS ================ */
@@ -48,28 +51,24 @@ bool BookMetadataCache::beginTocPass() {
     return false;
   }
 
-  if (spineCount >= LARGE_SPINE_THRESHOLD) {
-    spineHrefIndex.clear();
-    spineHrefIndex.reserve(spineCount);
-    spineFile.seek(0);
-    for (int i = 0; i < spineCount; i++) {
-      auto entry = readSpineEntry(spineFile);
-      SpineHrefIndexEntry idx;
-      idx.hrefHash = fnvHash64(entry.href);
-      idx.hrefLen = static_cast<uint16_t>(entry.href.size());
-      idx.spineIndex = static_cast<int16_t>(i);
-      spineHrefIndex.push_back(idx);
-    }
-    std::sort(spineHrefIndex.begin(), spineHrefIndex.end(),
-              [](const SpineHrefIndexEntry& a, const SpineHrefIndexEntry& b) {
-                return a.hrefHash < b.hrefHash || (a.hrefHash == b.hrefHash && a.hrefLen < b.hrefLen);
-              });
-    spineFile.seek(0);
-    useSpineHrefIndex = true;
-    LOG_DBG("BMC", "Using fast index for %d spine items", spineCount);
-  } else {
-    useSpineHrefIndex = false;
+  // One pass over the spine so each TOC entry resolves its href with a binary search instead of a rescan
+  spineHrefIndex.clear();
+  spineHrefIndex.reserve(spineCount);
+  spineFile.seek(0);
+  for (int i = 0; i < spineCount; i++) {
+    auto entry = readSpineEntry(spineFile);
+    SpineHrefIndexEntry idx;
+    idx.hrefHash = fnvHash64(entry.href);
+    idx.hrefLen = static_cast<uint16_t>(entry.href.size());
+    idx.spineIndex = static_cast<int16_t>(i);
+    spineHrefIndex.push_back(idx);
   }
+  // Stable, so the first spine item wins when an href is listed twice
+  std::stable_sort(spineHrefIndex.begin(), spineHrefIndex.end(),
+                   [](const SpineHrefIndexEntry& a, const SpineHrefIndexEntry& b) {
+                     return a.hrefHash < b.hrefHash || (a.hrefHash == b.hrefHash && a.hrefLen < b.hrefLen);
+                   });
+  spineFile.seek(0);
 
   return true;
 }
@@ -80,7 +79,6 @@ bool BookMetadataCache::endTocPass() {
 
   spineHrefIndex.clear();
   spineHrefIndex.shrink_to_fit();
-  useSpineHrefIndex = false;
 
   return true;
 }
@@ -96,7 +94,8 @@ bool BookMetadataCache::endWrite() {
   return true;
 }
 
-bool BookMetadataCache::buildBookBin(const std::string& epubPath, const BookMetadata& metadata) {
+bool BookMetadataCache::buildBookBin(const std::string& epubPath, const std::string& zipIndexPath,
+                                     const BookMetadata& metadata) {
   // Open all three files, writing to meta, reading from spine and toc
   if (!Storage.openFileForWrite("BMC", cachePath + bookBinFile, bookFile)) {
     return false;
@@ -113,19 +112,22 @@ bool BookMetadataCache::buildBookBin(const std::string& epubPath, const BookMeta
     return false;
   }
 
-  constexpr uint32_t headerASize =
-      sizeof(BOOK_CACHE_VERSION) + /* LUT Offset */ sizeof(uint32_t) + sizeof(spineCount) + sizeof(tocCount);
+  constexpr uint32_t headerASize = sizeof(BOOK_CACHE_VERSION) + /* LUT Offset */ sizeof(uint32_t) + sizeof(spineCount) +
+                                   sizeof(tocCount) + /* Resident tables offset */ sizeof(uint32_t);
   const uint32_t metadataSize = metadata.title.size() + metadata.author.size() + metadata.language.size() +
                                 metadata.coverItemHref.size() + metadata.textReferenceHref.size() +
                                 sizeof(uint32_t) * 5;
   const uint32_t lutSize = sizeof(uint32_t) * spineCount + sizeof(uint32_t) * tocCount;
   const uint32_t lutOffset = headerASize + metadataSize;
+  // Spine and TOC entries are rewritten with the same sizes they have in the temp files
+  const uint32_t tablesOffset = lutOffset + lutSize + spineFile.size() + tocFile.size();
 
   // Header A
   serialization::writePod(bookFile, BOOK_CACHE_VERSION);
   serialization::writePod(bookFile, lutOffset);
   serialization::writePod(bookFile, spineCount);
   serialization::writePod(bookFile, tocCount);
+  serialization::writePod(bookFile, tablesOffset);
   // Metadata
   serialization::writeString(bookFile, metadata.title);
   serialization::writeString(bookFile, metadata.author);
@@ -154,9 +156,11 @@ bool BookMetadataCache::buildBookBin(const std::string& epubPath, const BookMeta
 
   // Build spineIndex->tocIndex mapping in one pass (O(n) instead of O(n*m))
   std::vector<int16_t> spineToTocIndex(spineCount, -1);
+  std::vector<int16_t> tocToSpineIndex(tocCount, -1);
   tocFile.seek(0);
   for (int j = 0; j < tocCount; j++) {
     auto tocEntry = readTocEntry(tocFile);
+    tocToSpineIndex[j] = tocEntry.spineIndex;
     if (tocEntry.spineIndex >= 0 && tocEntry.spineIndex < spineCount) {
       if (spineToTocIndex[tocEntry.spineIndex] == -1) {
         spineToTocIndex[tocEntry.spineIndex] = static_cast<int16_t>(j);
@@ -164,7 +168,7 @@ bool BookMetadataCache::buildBookBin(const std::string& epubPath, const BookMeta
     }
   }
 
-  ZipFile zip(epubPath);
+  ZipFile zip(epubPath, zipIndexPath);
   // Pre-open zip file to speed up size calculations
   if (!zip.open()) {
     LOG_ERR("BMC", "Could not open EPUB zip for size calculations");
@@ -216,6 +220,13 @@ bool BookMetadataCache::buildBookBin(const std::string& epubPath, const BookMeta
     useBatchSizes = true;
   }
 
+  std::vector<uint32_t> cumulativeSizes(spineCount, 0);
+  struct FileNameEntry {
+    uint64_t hash;
+    int16_t spineIndex;
+  };
+  std::vector<FileNameEntry> fileNames(spineCount);
+
   uint32_t cumSize = 0;
   spineFile.seek(0);
   int lastSpineTocIndex = -1;
@@ -232,6 +243,8 @@ bool BookMetadataCache::buildBookBin(const std::string& epubPath, const BookMeta
       spineEntry.tocIndex = lastSpineTocIndex;
     }
     lastSpineTocIndex = spineEntry.tocIndex;
+    spineToTocIndex[i] = spineEntry.tocIndex;
+    fileNames[i] = {fnvHash64(fileNameOf(spineEntry.href)), static_cast<int16_t>(i)};
 
     size_t itemSize = 0;
     if (useBatchSizes) {
@@ -251,6 +264,7 @@ bool BookMetadataCache::buildBookBin(const std::string& epubPath, const BookMeta
 
     cumSize += itemSize;
     spineEntry.cumulativeSize = cumSize;
+    cumulativeSizes[i] = cumSize;
 
     // Write out spine data to book.bin
     writeSpineEntry(bookFile, spineEntry);
@@ -265,6 +279,34 @@ bool BookMetadataCache::buildBookBin(const std::string& epubPath, const BookMeta
     writeTocEntry(bookFile, tocEntry);
   }
 
+  if (bookFile.position() != tablesOffset) {
+    LOG_ERR("BMC", "Resident tables offset mismatch: expected %u, at %u", tablesOffset,
+            static_cast<uint32_t>(bookFile.position()));
+    bookFile.close();
+    spineFile.close();
+    tocFile.close();
+    return false;
+  }
+
+  // Resident tables: plain arrays so load() reads each one in a single call
+  std::sort(fileNames.begin(), fileNames.end(), [](const FileNameEntry& a, const FileNameEntry& b) {
+    return a.hash < b.hash || (a.hash == b.hash && a.spineIndex < b.spineIndex);
+  });
+  std::vector<uint64_t> fileNameHashList(spineCount);
+  std::vector<int16_t> fileNameSpineList(spineCount);
+  for (int i = 0; i < spineCount; i++) {
+    fileNameHashList[i] = fileNames[i].hash;
+    fileNameSpineList[i] = fileNames[i].spineIndex;
+  }
+  auto writeArray = [this](const auto& values) {
+    bookFile.write(reinterpret_cast<const uint8_t*>(values.data()), values.size() * sizeof(values[0]));
+  };
+  writeArray(cumulativeSizes);
+  writeArray(spineToTocIndex);
+  writeArray(tocToSpineIndex);
+  writeArray(fileNameHashList);
+  writeArray(fileNameSpineList);
+
   bookFile.close();
   spineFile.close();
   tocFile.close();
@@ -325,36 +367,17 @@ void BookMetadataCache::createTocEntry(const std::string& title, const std::stri
 
   int16_t spineIndex = -1;
 
-  if (useSpineHrefIndex) {
-    uint64_t targetHash = fnvHash64(href);
-    uint16_t targetLen = static_cast<uint16_t>(href.size());
-
-    auto it =
-        std::lower_bound(spineHrefIndex.begin(), spineHrefIndex.end(), SpineHrefIndexEntry{targetHash, targetLen, 0},
-                         [](const SpineHrefIndexEntry& a, const SpineHrefIndexEntry& b) {
-                           return a.hrefHash < b.hrefHash || (a.hrefHash == b.hrefHash && a.hrefLen < b.hrefLen);
-                         });
-
-    while (it != spineHrefIndex.end() && it->hrefHash == targetHash && it->hrefLen == targetLen) {
-      spineIndex = it->spineIndex;
-      break;
-    }
-
-    if (spineIndex == -1) {
-      LOG_DBG("BMC", "createTocEntry: Could not find spine item for TOC href %s", href.c_str());
-    }
+  const uint64_t targetHash = fnvHash64(href);
+  const auto targetLen = static_cast<uint16_t>(href.size());
+  const auto it =
+      std::lower_bound(spineHrefIndex.begin(), spineHrefIndex.end(), SpineHrefIndexEntry{targetHash, targetLen, 0},
+                       [](const SpineHrefIndexEntry& a, const SpineHrefIndexEntry& b) {
+                         return a.hrefHash < b.hrefHash || (a.hrefHash == b.hrefHash && a.hrefLen < b.hrefLen);
+                       });
+  if (it != spineHrefIndex.end() && it->hrefHash == targetHash && it->hrefLen == targetLen) {
+    spineIndex = it->spineIndex;
   } else {
-    spineFile.seek(0);
-    for (int i = 0; i < spineCount; i++) {
-      auto spineEntry = readSpineEntry(spineFile);
-      if (spineEntry.href == href) {
-        spineIndex = static_cast<int16_t>(i);
-        break;
-      }
-    }
-    if (spineIndex == -1) {
-      LOG_DBG("BMC", "createTocEntry: Could not find spine item for TOC href %s", href.c_str());
-    }
+    LOG_DBG("BMC", "createTocEntry: Could not find spine item for TOC href %s", href.c_str());
   }
 
   const TocEntry entry(title, href, anchor, level, spineIndex);
@@ -377,9 +400,11 @@ bool BookMetadataCache::load() {
     return false;
   }
 
+  uint32_t tablesOffset = 0;
   serialization::readPod(bookFile, lutOffset);
   serialization::readPod(bookFile, spineCount);
   serialization::readPod(bookFile, tocCount);
+  serialization::readPod(bookFile, tablesOffset);
 
   serialization::readString(bookFile, coreMetadata.title);
   serialization::readString(bookFile, coreMetadata.author);
@@ -387,11 +412,55 @@ bool BookMetadataCache::load() {
   serialization::readString(bookFile, coreMetadata.coverItemHref);
   serialization::readString(bookFile, coreMetadata.textReferenceHref);
 
+  if (!readResidentTables(tablesOffset)) {
+    LOG_ERR("BMC", "Could not read spine/TOC tables");
+    bookFile.close();
+    return false;
+  }
+
   loaded = true;
   LOG_DBG("BMC", "Loaded cache data: %d spine, %d TOC entries", spineCount, tocCount);
   return true;
 }
 
+bool BookMetadataCache::readResidentTables(const uint32_t offset) {
+  const size_t spineBytes = static_cast<size_t>(spineCount) *
+                            (sizeof(uint32_t) + sizeof(int16_t) + sizeof(uint64_t) + sizeof(int16_t));
+  const size_t tocBytes = static_cast<size_t>(tocCount) * sizeof(int16_t);
+  if (offset < lutOffset || offset + spineBytes + tocBytes > bookFile.size() || !bookFile.seek(offset)) {
+    return false;
+  }
+
+  spineCumulativeSizes.resize(spineCount);
+  spineTocIndices.resize(spineCount);
+  tocSpineIndices.resize(tocCount);
+  fileNameHashes.resize(spineCount);
+  fileNameSpineIndices.resize(spineCount);
+  auto readArray = [this](auto& values) {
+    const size_t bytes = values.size() * sizeof(values[0]);
+    return bookFile.read(values.data(), bytes) == static_cast<int>(bytes);
+  };
+  if (!readArray(spineCumulativeSizes) || !readArray(spineTocIndices) || !readArray(tocSpineIndices) ||
+      !readArray(fileNameHashes) || !readArray(fileNameSpineIndices)) {
+    return false;
+  }
+
+  for (int i = 0; i < spineCount; i++) {
+    if (fileNameSpineIndices[i] < 0 || fileNameSpineIndices[i] >= spineCount) return false;
+  }
+  return true;
+}
+
+int BookMetadataCache::findSpineIndexByFileName(const std::string_view fileName) const {
+  const uint64_t hash = fnvHash64(fileName);
+  // Entries with equal hashes are ordered by spine index, so the first one is the earliest spine item
+  const auto it = std::lower_bound(fileNameHashes.begin(), fileNameHashes.end(), hash);
+  if (it == fileNameHashes.end() || *it != hash) {
+    return -1;
+  }
+  return fileNameSpineIndices[it - fileNameHashes.begin()];
+}
+
 BookMetadataCache::SpineEntry BookMetadataCache::getSpineEntry(const int index) {
   if (!loaded) {
     LOG_ERR("BMC", "getSpineEntry called but cache not loaded");
@@ -403,6 +472,9 @@ BookMetadataCache::SpineEntry BookMetadataCache::getSpineEntry(const int index)
     return {};
   }
 
+  // The layout task and the reader both look entries up; each seek/read pair must not interleave with another
+  SpiBusMutex::Guard guard;
+  std::lock_guard<std::mutex> lock(readMutex);
   // Seek to spine LUT item, read from LUT and get out data
   bookFile.seek(lutOffset + sizeof(uint32_t) * index);
   uint32_t spineEntryPos;
@@ -422,6 +494,8 @@ BookMetadataCache::TocEntry BookMetadataCache::getTocEntry(const int index) {
     return {};
   }
 
+  SpiBusMutex::Guard guard;
+  std::lock_guard<std::mutex> lock(readMutex);
   // Seek to TOC LUT item, read from LUT and get out data
   bookFile.seek(lutOffset + sizeof(uint32_t) * spineCount + sizeof(uint32_t) * index);
   uint32_t tocEntryPos;
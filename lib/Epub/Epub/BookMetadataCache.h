@@ -3,7 +3,9 @@
 #include <HalStorage.h>
 
 #include <algorithm>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <vector>
 
 class BookMetadataCache {
@@ -44,30 +46,37 @@ class BookMetadataCache {
 
  private:
   std::string cachePath;
-  size_t lutOffset;
+  uint32_t lutOffset;
   uint16_t spineCount;
   uint16_t tocCount;
   bool loaded;
   bool buildMode;
 
   FsFile bookFile;
+  std::mutex readMutex;  // serializes getSpineEntry/getTocEntry on bookFile
   // Temp file handles during build
   FsFile spineFile;
   FsFile tocFile;
 
-  // Index for fast href→spineIndex lookup (used only for large EPUBs)
+  // Resident tables, read from the end of book.bin by load() so progress math and link resolution never seek.
+  // Cumulative size and TOC index per spine item, spine index per TOC entry.
+  std::vector<uint32_t> spineCumulativeSizes;
+  std::vector<int16_t> spineTocIndices;
+  std::vector<int16_t> tocSpineIndices;
+  // Spine items by FNV-1a hash of their file name (href after the last '/'), sorted by (hash, spine index)
+  std::vector<uint64_t> fileNameHashes;
+  std::vector<int16_t> fileNameSpineIndices;
+
+  // Index for fast href→spineIndex lookup while the TOC pass runs
   struct SpineHrefIndexEntry {
     uint64_t hrefHash;  // FNV-1a 64-bit hash
     uint16_t hrefLen;   // length for collision reduction
     int16_t spineIndex;
   };
   std::vector<SpineHrefIndexEntry> spineHrefIndex;
-  bool useSpineHrefIndex = false;
-
-  static constexpr uint16_t LARGE_SPINE_THRESHOLD = 400;
 
   // FNV-1a 64-bit hash function
-  static uint64_t fnvHash64(const std::string& s) {
+  static uint64_t fnvHash64(const std::string_view s) {
     uint64_t hash = 14695981039346656037ull;
     for (char c : s) {
       hash ^= static_cast<uint8_t>(c);
@@ -80,6 +89,7 @@ class BookMetadataCache {
   uint32_t writeTocEntry(FsFile& file, const TocEntry& entry) const;
   SpineEntry readSpineEntry(FsFile& file) const;
   TocEntry readTocEntry(FsFile& file) const;
+  bool readResidentTables(uint32_t offset);
 
  public:
   BookMetadata coreMetadata;
@@ -100,7 +110,7 @@ class BookMetadataCache {
   bool cleanupTmpFiles() const;
 
   // Post-processing to update mappings and sizes
-  bool buildBookBin(const std::string& epubPath, const BookMetadata& metadata);
+  bool buildBookBin(const std::string& epubPath, const std::string& zipIndexPath, const BookMetadata& metadata);
 
   // Reading phase (read mode)
   bool load();
@@ -109,4 +119,16 @@ class BookMetadataCache {
   int getSpineCount() const { return spineCount; }
   int getTocCount() const { return tocCount; }
   bool isLoaded() const { return loaded; }
+
+  // Served from the resident tables, index must be in range
+  uint32_t getCumulativeSize(const int spineIndex) const { return spineCumulativeSizes[spineIndex]; }
+  int16_t getTocIndexForSpine(const int spineIndex) const { return spineTocIndices[spineIndex]; }
+  int16_t getSpineIndexForToc(const int tocIndex) const { return tocSpineIndices[tocIndex]; }
+  // First spine item whose href ends in fileName (the part after the last '/'), or -1
+  int findSpineIndexByFileName(std::string_view fileName) const;
+
+  static std::string_view fileNameOf(const std::string_view href) {
+    const size_t slash = href.find_last_of('/');
+    return slash == std::string_view::npos ? href : href.substr(slash + 1);
+  }
 };
@@ -8,6 +8,11 @@ void PageLine::render(GfxRenderer& renderer, const int fontId, const int xOffset
   block->render(renderer, fontId, xPos + xOffset, yPos + yOffset);
 }
 
+void PageLine::appendToDisplayList(const GfxRenderer& renderer, GlyphDisplayList& list, const int fontId,
+                                   const int xOffset, const int yOffset) const {
+  block->appendToDisplayList(renderer, list, fontId, xPos + xOffset, yPos + yOffset);
+}
+
 bool PageLine::serialize(FsFile& file) {
   serialization::writePod(file, xPos);
   serialization::writePod(file, yPos);
@@ -63,6 +68,29 @@ void Page::render(GfxRenderer& renderer, const int fontId, const int xOffset, co
   }
 }
 
+void Page::buildDisplayList(const GfxRenderer& renderer, const int fontId, const int xOffset, const int yOffset,
+                            GlyphDisplayList& out) const {
+  // UTF-8 byte count is an upper bound on the glyph count; reserve once to avoid regrowth on the heap
+  size_t textBytes = 0;
+  for (const auto& element : elements) {
+    if (element->getTag() != TAG_PageLine) continue;
+    textBytes += static_cast<const PageLine&>(*element).getBlock()->textBytes();
+  }
+  out.reserve(textBytes);
+
+  for (const auto& element : elements) {
+    element->appendToDisplayList(renderer, out, fontId, xOffset, yOffset);
+  }
+}
+
+void Page::renderImages(GfxRenderer& renderer, const int fontId, const int xOffset, const int yOffset) const {
+  for (const auto& element : elements) {
+    if (element->getTag() == TAG_PageImage) {
+      element->render(renderer, fontId, xOffset, yOffset);
+    }
+  }
+}
+
 bool Page::serialize(FsFile& file) const {
   const uint16_t count = elements.size();
   serialization::writePod(file, count);
@@ -10,6 +10,8 @@
 #include "blocks/ImageBlock.h"
 #include "blocks/TextBlock.h"
 
+class GlyphDisplayList;
+
 enum PageElementTag : uint8_t {
   TAG_PageLine = 1,
   TAG_PageImage = 2,  // New tag
@@ -23,6 +25,9 @@ class PageElement {
   explicit PageElement(const int16_t xPos, const int16_t yPos) : xPos(xPos), yPos(yPos) {}
   virtual ~PageElement() = default;
   virtual void render(GfxRenderer& renderer, int fontId, int xOffset, int yOffset) = 0;
+  // Records text output into a display list. Elements without text (images) record nothing.
+  virtual void appendToDisplayList(const GfxRenderer& renderer, GlyphDisplayList& list, int fontId, int xOffset,
+                                   int yOffset) const {}
   virtual bool serialize(FsFile& file) = 0;
   virtual PageElementTag getTag() const = 0;  // Add type identification
 };
@@ -36,6 +41,8 @@ class PageLine final : public PageElement {
       : PageElement(xPos, yPos), block(std::move(block)) {}
   const std::shared_ptr<TextBlock>& getBlock() const { return block; }
   void render(GfxRenderer& renderer, int fontId, int xOffset, int yOffset) override;
+  void appendToDisplayList(const GfxRenderer& renderer, GlyphDisplayList& list, int fontId, int xOffset,
+                           int yOffset) const override;
   bool serialize(FsFile& file) override;
   PageElementTag getTag() const override { return TAG_PageLine; }
   static std::unique_ptr<PageLine> deserialize(FsFile& file);
@@ -75,6 +82,11 @@ class Page {
   }
 
   void render(GfxRenderer& renderer, int fontId, int xOffset, int yOffset) const;
+  // Split rendering for multi-pass readers: lay out all text once into a display list (replayed with
+  // GfxRenderer::drawDisplayList), and draw the non-text elements separately in each pass.
+  void buildDisplayList(const GfxRenderer& renderer, int fontId, int xOffset, int yOffset,
+                        GlyphDisplayList& out) const;
+  void renderImages(GfxRenderer& renderer, int fontId, int xOffset, int yOffset) const;
   bool serialize(FsFile& file) const;
   static std::unique_ptr<Page> deserialize(FsFile& file);
 
@@ -0,0 +1,210 @@
+#include "PageMap.h"
+
+#include <HalStorage.h>
+#include <Logging.h>
+#include <Serialization.h>
+
+#include "Page.h"
+#include "Section.h"
+#include "SpiBusMutex.h"
+
+namespace {
+constexpr uint8_t PAGE_MAP_VERSION = 1;
+}  // namespace
+
+bool PageMap::Layout::operator==(const Layout& other) const {
+  return fontId == other.fontId && lineCompression == other.lineCompression &&
+         extraParagraphSpacing == other.extraParagraphSpacing && paragraphAlignment == other.paragraphAlignment &&
+         viewportWidth == other.viewportWidth && viewportHeight == other.viewportHeight &&
+         hyphenationEnabled == other.hyphenationEnabled && embeddedStyle == other.embeddedStyle &&
+         imageRendering == other.imageRendering;
+}
+
+std::string PageMap::Layout::profileDir(const std::string& bookCachePath) const {
+  return Section::profileDir(bookCachePath, fontId, lineCompression, extraParagraphSpacing, paragraphAlignment,
+                             viewportWidth, viewportHeight, hyphenationEnabled, embeddedStyle, imageRendering);
+}
+
+void PageMap::open(const Layout& newLayout, const int spineCount) {
+  if (opened && layout == newLayout && pageCounts.size() == static_cast<size_t>(spineCount)) {
+    return;
+  }
+
+  layout = newLayout;
+  filePath = layout.profileDir(bookCachePath) + "/pagemap.bin";
+  opened = true;
+  dirty = false;
+  pageCounts.assign(spineCount > 0 ? spineCount : 0, UNKNOWN);
+  firstPages.clear();
+  knownCount = 0;
+  totalPages = 0;
+
+  if (load()) {
+    LOG_DBG("PMP", "Loaded page map: %u/%u spine items known", static_cast<unsigned>(knownCount),
+            static_cast<unsigned>(pageCounts.size()));
+    return;
+  }
+  pageCounts.assign(pageCounts.size(), UNKNOWN);
+  knownCount = 0;
+}
+
+bool PageMap::load() {
+  SpiBusMutex::Guard guard;
+  FsFile file;
+  if (!Storage.openFileForRead("PMP", filePath, file)) {
+    return false;
+  }
+
+  uint8_t version = 0;
+  uint8_t sectionVersion = 0;
+  Layout fileLayout;
+  uint16_t fileSpineCount = 0;
+  bool ok = serialization::readPod(file, version) && version == PAGE_MAP_VERSION &&
+            serialization::readPod(file, sectionVersion) && sectionVersion == Section::fileVersion() &&
+            serialization::readPod(file, fileLayout.fontId) &&
+            serialization::readPod(file, fileLayout.lineCompression) &&
+            serialization::readPod(file, fileLayout.extraParagraphSpacing) &&
+            serialization::readPod(file, fileLayout.paragraphAlignment) &&
+            serialization::readPod(file, fileLayout.viewportWidth) &&
+            serialization::readPod(file, fileLayout.viewportHeight) &&
+            serialization::readPod(file, fileLayout.hyphenationEnabled) &&
+            serialization::readPod(file, fileLayout.embeddedStyle) &&
+            serialization::readPod(file, fileLayout.imageRendering) && serialization::readPod(file, fileSpineCount);
+  if (!ok || fileLayout != layout || fileSpineCount != pageCounts.size()) {
+    file.close();
+    LOG_DBG("PMP", "Page map is stale or for other layout settings, starting over");
+    return false;
+  }
+
+  const size_t bytes = pageCounts.size() * sizeof(uint16_t);
+  ok = bytes == 0 || file.read(pageCounts.data(), bytes) == static_cast<int>(bytes);
+  file.close();
+  if (!ok) {
+    LOG_ERR("PMP", "Page map is truncated");
+    return false;
+  }
+
+  for (const uint16_t count : pageCounts) {
+    if (count != UNKNOWN) knownCount++;
+  }
+  if (isComplete()) {
+    rebuildFirstPages();
+  }
+  return true;
+}
+
+bool PageMap::save() {
+  if (!opened) {
+    return false;
+  }
+
+  SpiBusMutex::Guard guard;
+  const std::string dir = layout.profileDir(bookCachePath);
+  Storage.mkdir(dir.c_str());
+  FsFile file;
+  if (!Storage.openFileForWrite("PMP", filePath, file)) {
+    return false;
+  }
+  serialization::writePod(file, PAGE_MAP_VERSION);
+  serialization::writePod(file, Section::fileVersion());
+  serialization::writePod(file, layout.fontId);
+  serialization::writePod(file, layout.lineCompression);
+  serialization::writePod(file, layout.extraParagraphSpacing);
+  serialization::writePod(file, layout.paragraphAlignment);
+  serialization::writePod(file, layout.viewportWidth);
+  serialization::writePod(file, layout.viewportHeight);
+  serialization::writePod(file, layout.hyphenationEnabled);
+  serialization::writePod(file, layout.embeddedStyle);
+  serialization::writePod(file, layout.imageRendering);
+  serialization::writePod(file, static_cast<uint16_t>(pageCounts.size()));
+  const size_t bytes = pageCounts.size() * sizeof(uint16_t);
+  const bool ok = file.write(reinterpret_cast<const uint8_t*>(pageCounts.data()), bytes) == bytes;
+  file.close();
+  if (!ok) {
+    LOG_ERR("PMP", "Failed to write page map");
+    return false;
+  }
+  dirty = false;
+  return true;
+}
+
+bool PageMap::setPageCount(const int spineIndex, const uint16_t pages) {
+  if (!opened || spineIndex < 0 || spineIndex >= static_cast<int>(pageCounts.size()) || pages == UNKNOWN) {
+    return false;
+  }
+  uint16_t& count = pageCounts[spineIndex];
+  if (count == pages) {
+    return false;
+  }
+  if (count == UNKNOWN) {
+    knownCount++;
+  }
+  count = pages;
+  dirty = true;
+  if (isComplete()) {
+    rebuildFirstPages();
+  }
+  return true;
+}
+
+uint16_t PageMap::getPageCount(const int spineIndex) const {
+  if (spineIndex < 0 || spineIndex >= static_cast<int>(pageCounts.size())) {
+    return UNKNOWN;
+  }
+  return pageCounts[spineIndex];
+}
+
+int PageMap::nextUnknown(const int from) const {
+  const int count = static_cast<int>(pageCounts.size());
+  if (isComplete() || count == 0) {
+    return -1;
+  }
+  const int start = (from >= 0 && from < count) ? from : 0;
+  for (int i = 0; i < count; i++) {
+    const int index = (start + i) % count;
+    if (pageCounts[index] == UNKNOWN) {
+      return index;
+    }
+  }
+  return -1;
+}
+
+void PageMap::rebuildFirstPages() {
+  firstPages.resize(pageCounts.size());
+  uint32_t total = 0;
+  for (size_t i = 0; i < pageCounts.size(); i++) {
+    firstPages[i] = total;
+    total += pageCounts[i];
+  }
+  totalPages = total;
+}
+
+uint32_t PageMap::getBookPage(const int spineIndex, const int page) const {
+  if (!isComplete() || spineIndex < 0 || spineIndex >= static_cast<int>(firstPages.size())) {
+    return 0;
+  }
+  return firstPages[spineIndex] + (page > 0 ? static_cast<uint32_t>(page) : 0);
+}
+
+void PageMap::locate(const uint32_t bookPage, int& spineIndex, int& page) const {
+  spineIndex = 0;
+  page = 0;
+  if (!isComplete() || totalPages == 0) {
+    return;
+  }
+
+  const uint32_t target = bookPage < totalPages ? bookPage : totalPages - 1;
+  // Last spine item starting at or before target; empty items share their start with the next one and are skipped
+  size_t lo = 0;
+  size_t hi = firstPages.size();
+  while (hi - lo > 1) {
+    const size_t mid = (lo + hi) / 2;
+    if (firstPages[mid] <= target) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+  spineIndex = static_cast<int>(lo);
+  page = static_cast<int>(target - firstPages[lo]);
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Page count of every spine item for one set of layout parameters, persisted as pagemap.bin next to the section
+// files of that layout profile (see Section::profileDir).
+//
+// Counts are filled in as sections are laid out (by the reader or by a background pass over the whole book). Once
+// every spine item is known the map gives book-wide page numbers: progress, percent jumps and pages left stop being
+// proportional to chapter byte sizes.
+class PageMap {
+ public:
+  // The parameters a section file is validated against (see Section::loadSectionFile)
+  struct Layout {
+    int fontId = 0;
+    float lineCompression = 1.0f;
+    bool extraParagraphSpacing = false;
+    uint8_t paragraphAlignment = 0;
+    uint16_t viewportWidth = 0;
+    uint16_t viewportHeight = 0;
+    bool hyphenationEnabled = false;
+    bool embeddedStyle = false;
+    uint8_t imageRendering = 0;
+
+    bool operator==(const Layout& other) const;
+    bool operator!=(const Layout& other) const { return !(*this == other); }
+    // Section::profileDir for these parameters
+    std::string profileDir(const std::string& bookCachePath) const;
+  };
+
+  static constexpr uint16_t UNKNOWN = 0xFFFF;
+
+  explicit PageMap(std::string bookCachePath) : bookCachePath(std::move(bookCachePath)) {}
+
+  // Switches the map to `layout`: loads pagemap.bin if it was written for the same layout and spine count, otherwise
+  // starts with every count unknown. Does nothing if the map already holds `layout`.
+  void open(const Layout& layout, int spineCount);
+  bool isOpen() const { return opened; }
+  const Layout& getLayout() const { return layout; }
+
+  // Returns false if the count was already known and unchanged
+  bool setPageCount(int spineIndex, uint16_t pages);
+  uint16_t getPageCount(int spineIndex) const;
+  // First spine index at or after `from` (wrapping around) without a known count, -1 if the map is complete
+  int nextUnknown(int from) const;
+  bool isComplete() const { return opened && knownCount == pageCounts.size(); }
+
+  // Book-wide numbering, only valid once isComplete()
+  uint32_t getTotalPages() const { return totalPages; }
+  uint32_t getBookPage(int spineIndex, int page) const;
+  // Spine item and page within it for a book-wide page index; clamps to the last page
+  void locate(uint32_t bookPage, int& spineIndex, int& page) const;
+
+  bool isDirty() const { return dirty; }
+  bool save();
+
+ private:
+  std::string bookCachePath;
+  std::string filePath;
+  Layout layout;
+  bool opened = false;
+  bool dirty = false;
+  std::vector<uint16_t> pageCounts;
+  // First book-wide page of each spine item, filled when the last count becomes known
+  std::vector<uint32_t> firstPages;
+  size_t knownCount = 0;
+  uint32_t totalPages = 0;
+
+  bool load();
+  void rebuildFirstPages();
+};
@@ -2,20 +2,20 @@
 
 #include <FeatureFlags.h>
 #include <GfxRenderer.h>
+#include <Logging.h>
 #include <Utf8.h>
 
 #include <algorithm>
 #include <cmath>
 #include <functional>
 #include <limits>
+#include <string_view>
 #include <vector>
 
 #if ENABLE_HYPHENATION
 #include "hyphenation/Hyphenator.h"
 #endif
 
-constexpr int MAX_COST = std::numeric_limits<int>::max();
-
 namespace {
 
 // Soft hyphen byte pattern used throughout EPUBs (UTF-8 for U+00AD).
@@ -23,28 +23,30 @@ constexpr char SOFT_HYPHEN_UTF8[] = "\xC2\xAD";
 constexpr size_t SOFT_HYPHEN_BYTES = 2;
 
 // Returns the first rendered codepoint of a word (skipping leading soft hyphens).
-uint32_t firstCodepoint(const std::string& word) {
-  const auto* ptr = reinterpret_cast<const unsigned char*>(word.c_str());
-  while (true) {
+uint32_t firstCodepoint(const std::string_view word) {
+  const auto* ptr = reinterpret_cast<const unsigned char*>(word.data());
+  const auto* end = ptr + word.size();
+  while (ptr < end) {
     const uint32_t cp = utf8NextCodepoint(&ptr);
     if (cp == 0) return 0;
     if (cp != 0x00AD) return cp;  // skip soft hyphens
   }
+  return 0;
 }
 
 // Returns the last codepoint of a word by scanning backward for the start of the last UTF-8 sequence.
-uint32_t lastCodepoint(const std::string& word) {
+uint32_t lastCodepoint(const std::string_view word) {
   if (word.empty()) return 0;
   // UTF-8 continuation bytes start with 10xxxxxx; scan backward to find the leading byte.
   size_t i = word.size() - 1;
   while (i > 0 && (static_cast<uint8_t>(word[i]) & 0xC0) == 0x80) {
     --i;
   }
-  const auto* ptr = reinterpret_cast<const unsigned char*>(word.c_str() + i);
+  const auto* ptr = reinterpret_cast<const unsigned char*>(word.data() + i);
   return utf8NextCodepoint(&ptr);
 }
 
-bool containsSoftHyphen(const std::string& word) { return word.find(SOFT_HYPHEN_UTF8) != std::string::npos; }
+bool containsSoftHyphen(const std::string_view word) { return word.find(SOFT_HYPHEN_UTF8) != std::string_view::npos; }
 
 // Removes every soft hyphen in-place so rendered glyphs match measured widths.
 void stripSoftHyphensInPlace(std::string& word) {
@@ -56,18 +58,18 @@ void stripSoftHyphensInPlace(std::string& word) {
 
 // Returns the advance width for a word while ignoring soft hyphen glyphs and optionally appending a visible hyphen.
 // Uses advance width (sum of glyph advances + kerning) rather than bounding box width so that italic glyph overhangs
-// don't inflate inter-word spacing.
-uint16_t measureWordWidth(const GfxRenderer& renderer, const int fontId, const std::string& word,
+// don't inflate inter-word spacing. The word must be NUL-terminated right after its last byte (pool words are).
+uint16_t measureWordWidth(const GfxRenderer& renderer, const int fontId, const std::string_view word,
                           const EpdFontFamily::Style style, const bool appendHyphen = false) {
   if (word.size() == 1 && word[0] == ' ' && !appendHyphen) {
     return renderer.getSpaceWidth(fontId, style);
   }
   const bool hasSoftHyphen = containsSoftHyphen(word);
   if (!hasSoftHyphen && !appendHyphen) {
-    return renderer.getTextAdvanceX(fontId, word.c_str(), style);
+    return renderer.getTextAdvanceX(fontId, word.data(), style);
   }
 
-  std::string sanitized = word;
+  std::string sanitized(word);
   if (hasSoftHyphen) {
     stripSoftHyphensInPlace(sanitized);
   }
@@ -79,17 +81,32 @@ uint16_t measureWordWidth(const GfxRenderer& renderer, const int fontId, const s
 
 }  // namespace
 
-void ParsedText::addWord(std::string word, const EpdFontFamily::Style fontStyle, const bool underline,
+void ParsedText::addWord(const std::string_view word, const EpdFontFamily::Style fontStyle, const bool underline,
                          const bool attachToPrevious) {
   if (word.empty()) return;
 
-  words.push_back(std::move(word));
   EpdFontFamily::Style combinedStyle = fontStyle;
   if (underline) {
     combinedStyle = static_cast<EpdFontFamily::Style>(combinedStyle | EpdFontFamily::UNDERLINE);
   }
-  wordStyles.push_back(combinedStyle);
-  wordContinues.push_back(attachToPrevious);
+  pushWord(word, combinedStyle, attachToPrevious);
+}
+
+void ParsedText::pushWord(std::string_view word, const EpdFontFamily::Style style, const bool continues) {
+  if (word.size() > std::numeric_limits<uint16_t>::max()) {
+    LOG_WRN("PTX", "Truncating %u-byte word", static_cast<uint32_t>(word.size()));
+    word = word.substr(0, utf8SafeTruncateBuffer(word.data(), std::numeric_limits<uint16_t>::max()));
+  }
+  words.push_back({static_cast<uint32_t>(text.size()), static_cast<uint16_t>(word.size()), style, continues});
+  text.append(word);
+  text.push_back('\0');
+}
+
+void ParsedText::setWordText(const size_t i, const std::string& word) {
+  words[i].offset = static_cast<uint32_t>(text.size());
+  words[i].length = static_cast<uint16_t>(std::min<size_t>(word.size(), std::numeric_limits<uint16_t>::max()));
+  text.append(word, 0, words[i].length);
+  text.push_back('\0');
 }
 
 // Consumes data to minimize memory usage
@@ -105,30 +122,27 @@ void ParsedText::layoutAndExtractLines(const GfxRenderer& renderer, const int fo
 
   const int pageWidth = viewportWidth;
   auto wordWidths = calculateWordWidths(renderer, fontId);
+  std::vector<int16_t> wordGaps;
 
-  std::vector<size_t> lineBreakIndices;
-#if ENABLE_HYPHENATION
-  if (hyphenationEnabled) {
-    // Use greedy layout that can split words mid-loop when a hyphenated prefix fits.
-    lineBreakIndices = computeHyphenatedLineBreaks(renderer, fontId, pageWidth, wordWidths, wordContinues);
-  } else {
-    lineBreakIndices = computeLineBreaks(renderer, fontId, pageWidth, wordWidths, wordContinues);
-  }
-#else
-  lineBreakIndices = computeLineBreaks(renderer, fontId, pageWidth, wordWidths, wordContinues);
-#endif
+  const std::vector<size_t> lineBreakIndices = computeLineBreaks(renderer, fontId, pageWidth, wordWidths, wordGaps);
   const size_t lineCount = includeLastLine ? lineBreakIndices.size() : lineBreakIndices.size() - 1;
 
   for (size_t i = 0; i < lineCount; ++i) {
-    extractLine(i, pageWidth, wordWidths, wordContinues, lineBreakIndices, processLine, renderer, fontId);
+    extractLine(i, pageWidth, wordWidths, wordGaps, lineBreakIndices, processLine);
   }
 
-  // Remove consumed words so size() reflects only remaining words
+  // Remove consumed words so size() reflects only remaining words, and drop the pool bytes only they used
   if (lineCount > 0) {
     const size_t consumed = lineBreakIndices[lineCount - 1];
     words.erase(words.begin(), words.begin() + consumed);
-    wordStyles.erase(wordStyles.begin(), wordStyles.begin() + consumed);
-    wordContinues.erase(wordContinues.begin(), wordContinues.begin() + consumed);
+    if (words.empty()) {
+      text.clear();
+    } else {
+      uint32_t firstLive = words.front().offset;
+      for (const auto& word : words) firstLive = std::min(firstLive, word.offset);
+      text.erase(0, firstLive);
+      for (auto& word : words) word.offset -= firstLive;
+    }
   }
 }
 
@@ -137,127 +151,313 @@ std::vector<uint16_t> ParsedText::calculateWordWidths(const GfxRenderer& rendere
   wordWidths.reserve(words.size());
 
   for (size_t i = 0; i < words.size(); ++i) {
-    wordWidths.push_back(measureWordWidth(renderer, fontId, words[i], wordStyles[i]));
+    wordWidths.push_back(measureWordWidth(renderer, fontId, wordText(i), words[i].style));
   }
 
   return wordWidths;
 }
 
-std::vector<size_t> ParsedText::computeLineBreaks(const GfxRenderer& renderer, const int fontId, const int pageWidth,
-                                                  std::vector<uint16_t>& wordWidths, std::vector<bool>& continuesVec) {
-  if (words.empty()) {
-    return {};
+// Advance between word i-1 and word i when both sit on the same line: the space advance (with the kerning of the
+// flanking glyphs against the space), or plain cross-boundary kerning for continuation words (e.g. nonbreaking
+// spaces, attached punctuation). Each word's edge codepoints are decoded once here instead of per candidate line.
+std::vector<int16_t> ParsedText::calculateWordGaps(const GfxRenderer& renderer, const int fontId) const {
+  std::vector<int16_t> wordGaps(words.size(), 0);
+  uint32_t prevLast = words.empty() ? 0 : lastCodepoint(wordText(0));
+  for (size_t i = 1; i < words.size(); ++i) {
+    const uint32_t first = firstCodepoint(wordText(i));
+    if (words[i].continues) {
+      wordGaps[i] = static_cast<int16_t>(renderer.getKerning(fontId, prevLast, first, words[i - 1].style));
+    } else {
+      wordGaps[i] = static_cast<int16_t>(renderer.getSpaceAdvance(fontId, prevLast, first, words[i - 1].style));
+    }
+    prevLast = lastCodepoint(wordText(i));
   }
+  return wordGaps;
+}
 
-  // Calculate first line indent (only for left/justified text).
+int ParsedText::firstLineIndent() const {
+  // Only for left/justified text.
   // Positive text-indent (paragraph indent) is suppressed when extraParagraphSpacing is on.
   // Negative text-indent (hanging indent, e.g. margin-left:3em; text-indent:-1em) always applies —
   // it is structural (positions the bullet/marker), not decorative.
-  const int firstLineIndent =
-      blockStyle.textIndentDefined && (blockStyle.textIndent < 0 || !extraParagraphSpacing) &&
-              (blockStyle.alignment == CssTextAlign::Justify || blockStyle.alignment == CssTextAlign::Left)
-          ? blockStyle.textIndent
-          : 0;
+  return blockStyle.textIndentDefined && (blockStyle.textIndent < 0 || !extraParagraphSpacing) &&
+                 (blockStyle.alignment == CssTextAlign::Justify || blockStyle.alignment == CssTextAlign::Left)
+             ? blockStyle.textIndent
+             : 0;
+}
 
-  // Ensure any word that would overflow even as the first entry on a line is split using fallback hyphenation.
-  for (size_t i = 0; i < wordWidths.size(); ++i) {
-    // First word needs to fit in reduced width if there's an indent
-    const int effectiveWidth = i == 0 ? pageWidth - firstLineIndent : pageWidth;
-    while (wordWidths[i] > effectiveWidth) {
-      if (!hyphenateWordAtIndex(i, effectiveWidth, renderer, fontId, wordWidths, /*allowFallbackBreaks=*/true)) {
-        break;
+namespace {
+
+// A legal break inside a word (from Hyphenator::breakOffsets), measured once up front.
+struct HyphenPoint {
+  uint32_t word;
+  uint16_t byteOffset;
+  uint16_t prefixWidth;  // word up to the break, including the inserted hyphen if any
+  uint16_t suffixWidth;  // rest of the word, which starts the next line
+  bool insertsHyphen;
+};
+
+// A feasible break. The line after it starts at (nextWord, nextPoint): nextPoint < 0 means at the start of nextWord,
+// otherwise right after hyphenation point nextPoint inside nextWord.
+struct BreakNode {
+  long long demerits;  // total over every line from the paragraph start up to this break
+  int32_t prev;        // previous break on the best path, -1 for the paragraph start
+  uint32_t nextWord;
+  int32_t nextPoint;
+  int32_t point;  // hyphenation point this break is at, -1 after a whole word
+  int16_t slack;  // unused width of the line ending here
+  uint16_t gapCount;
+};
+
+constexpr long long FORCED_BREAK_DEMERITS = 1LL << 40;
+
+// Knuth-Plass total-fit line breaking over words and optional hyphenation points.
+//
+// Breaks are tried left to right against the list of active breaks (those that can still start a line reaching the
+// current position). An active break is retired for good once a whole-word line from it overflows, so the inner loop
+// only ever sees the few breaks within one line width: cost is linear in the word count in practice. Every line's
+// demerits depend only on its own slack and whether it ends in a hyphen, so the best path to each break is final once
+// found and the chosen breaks minimise the sum over the whole paragraph.
+class TotalFitBreaker {
+ public:
+  TotalFitBreaker(const std::vector<uint16_t>& widths, const std::vector<int16_t>& gaps,
+                  const std::vector<ParsedText::Word>& words, const std::vector<HyphenPoint>& points,
+                  const int pageWidth, const int firstLineIndent, const bool justify, const long long hyphenPenalty)
+      : widths(widths),
+        gaps(gaps),
+        words(words),
+        points(points),
+        pageWidth(pageWidth),
+        firstLineIndent(firstLineIndent),
+        justify(justify),
+        hyphenPenalty(hyphenPenalty) {
+    const size_t n = widths.size();
+    prefix.resize(n + 1);
+    gapCounts.resize(n + 1);
+    prefix[0] = 0;
+    gapCounts[0] = 0;
+    for (size_t i = 0; i < n; i++) {
+      prefix[i + 1] = prefix[i] + widths[i] + (i > 0 ? gaps[i] : 0);
+      gapCounts[i + 1] = gapCounts[i] + (i > 0 && !words[i].continues ? 1 : 0);
+    }
+  }
+
+  // measureInside(word, fromOffset, toOffset, insertsHyphen) measures a line that starts and ends inside one word.
+  template <typename MeasureInside>
+  void run(const MeasureInside& measureInside) {
+    nodes.clear();
+    active.clear();
+    nodes.push_back({0, -1, 0, -1, -1, 0, 0});
+    active.push_back(0);
+
+    const uint32_t n = static_cast<uint32_t>(widths.size());
+    size_t p = 0;
+    for (uint32_t w = 0; w < n; w++) {
+      for (; p < points.size() && points[p].word == w; p++) {
+        tryBreak(w, static_cast<int32_t>(p), measureInside);
+      }
+      // No break between a word and a continuation attached to it
+      if (w + 1 == n || !words[w + 1].continues) {
+        tryBreak(w, -1, measureInside);
       }
     }
   }
 
-  const size_t totalWordCount = words.size();
+  const std::vector<BreakNode>& result() const { return nodes; }
+
+ private:
+  const std::vector<uint16_t>& widths;
+  const std::vector<int16_t>& gaps;
+  const std::vector<ParsedText::Word>& words;
+  const std::vector<HyphenPoint>& points;
+  const int pageWidth;
+  const int firstLineIndent;
+  const bool justify;
+  const long long hyphenPenalty;
+
+  std::vector<int32_t> prefix;      // prefix[i] = widths and gaps of words [0, i)
+  std::vector<uint16_t> gapCounts;  // gapCounts[i] = stretchable gaps before word i
+  std::vector<BreakNode> nodes;
+  std::vector<int32_t> active;
+
+  template <typename MeasureInside>
+  int lineWidth(const BreakNode& from, const uint32_t endWord, const int32_t endPoint,
+                const MeasureInside& measureInside) const {
+    const uint32_t startWord = from.nextWord;
+    const int32_t startPoint = from.nextPoint;
+    const int startPart = startPoint >= 0 ? points[startPoint].suffixWidth : widths[startWord];
+    if (startWord == endWord) {
+      if (endPoint < 0) return startPart;
+      if (startPoint < 0) return points[endPoint].prefixWidth;
+      return measureInside(endWord, points[startPoint].byteOffset, points[endPoint].byteOffset,
+                           points[endPoint].insertsHyphen);
+    }
+    const int endPart = endPoint >= 0 ? points[endPoint].prefixWidth : widths[endWord];
+    return startPart + (prefix[endWord] - prefix[startWord + 1]) + gaps[endWord] + endPart;
+  }
 
-  // DP table to store the minimum badness (cost) of lines starting at index i
-  std::vector<int> dp(totalWordCount);
-  // 'ans[i]' stores the index 'j' of the *last word* in the optimal line starting at 'i'
-  std::vector<size_t> ans(totalWordCount);
+  template <typename MeasureInside>
+  void tryBreak(const uint32_t word, const int32_t point, const MeasureInside& measureInside) {
+    const bool wordEnd = point < 0;
+    const bool paragraphEnd = wordEnd && word + 1 == widths.size();
+
+    BreakNode best = {std::numeric_limits<long long>::max(), -1, 0, 0, point, 0, 0};
+    int32_t lastRetired = -1;
+    size_t keep = 0;
+    for (size_t i = 0; i < active.size(); i++) {
+      const int32_t a = active[i];
+      const BreakNode& from = nodes[a];
+      const int width = lineWidth(from, word, point, measureInside);
+      const int available = a == 0 ? pageWidth - firstLineIndent : pageWidth;
+      if (width > available) {
+        // A whole-word line from here overflows, and every later break would too
+        if (wordEnd) {
+          lastRetired = a;
+          continue;
+        }
+        active[keep++] = a;
+        continue;
+      }
+      active[keep++] = a;
+
+      const int slack = available - width;
+      const uint16_t lineGaps = gapCounts[word + 1] - gapCounts[from.nextWord + 1];
+      long long demerits = 0;
+      if (!paragraphEnd) {
+        const long long slackSq = static_cast<long long>(slack) * slack;
+        // Justified lines spread the slack over their gaps, so the same slack looks looser with fewer gaps
+        demerits = justify ? slackSq / std::max<int>(1, lineGaps) : slackSq;
+      }
+      if (!wordEnd) {
+        demerits += hyphenPenalty;
+        if (from.point >= 0) demerits += hyphenPenalty;  // discourage hyphens on consecutive lines
+      }
+      if (from.demerits + demerits < best.demerits) {
+        best.demerits = from.demerits + demerits;
+        best.prev = a;
+        best.slack = static_cast<int16_t>(slack);
+        best.gapCount = lineGaps;
+      }
+    }
+    active.resize(keep);
 
-  // Base Case
-  dp[totalWordCount - 1] = 0;
-  ans[totalWordCount - 1] = totalWordCount - 1;
+    if (best.prev < 0) {
+      if (!wordEnd || !active.empty() || lastRetired < 0) {
+        return;
+      }
+      // Nothing fits (a word or continuation group wider than the line): overflow from the nearest break rather than
+      // dropping the rest of the paragraph
+      best.demerits = nodes[lastRetired].demerits + FORCED_BREAK_DEMERITS;
+      best.prev = lastRetired;
+    }
+
+    best.nextWord = wordEnd ? word + 1 : word;
+    best.nextPoint = wordEnd ? -1 : point;
+    nodes.push_back(best);
+    active.push_back(static_cast<int32_t>(nodes.size() - 1));
+  }
+};
 
-  for (int i = totalWordCount - 2; i >= 0; --i) {
-    int currlen = 0;
-    dp[i] = MAX_COST;
+}  // namespace
 
-    // First line has reduced width due to text-indent
-    const int effectivePageWidth = i == 0 ? pageWidth - firstLineIndent : pageWidth;
+// Computes line breaks with TotalFitBreaker. Hyphenation follows TeX's two-pass scheme: the paragraph is first set
+// without hyphenation, and only if some line comes out looser than one extra space per gap is it set again with every
+// hyphenation point as a penalised break. Fills wordGaps for extractLine(); both vectors reflect any split words.
+std::vector<size_t> ParsedText::computeLineBreaks(const GfxRenderer& renderer, const int fontId, const int pageWidth,
+                                                  std::vector<uint16_t>& wordWidths, std::vector<int16_t>& wordGaps) {
+  if (words.empty()) {
+    return {};
+  }
 
-    for (size_t j = i; j < totalWordCount; ++j) {
-      // Add space before word j, unless it's the first word on the line or a continuation
-      int gap = 0;
-      if (j > static_cast<size_t>(i) && !continuesVec[j]) {
-        gap =
-            renderer.getSpaceAdvance(fontId, lastCodepoint(words[j - 1]), firstCodepoint(words[j]), wordStyles[j - 1]);
-      } else if (j > static_cast<size_t>(i) && continuesVec[j]) {
-        // Cross-boundary kerning for continuation words (e.g. nonbreaking spaces, attached punctuation)
-        gap = renderer.getKerning(fontId, lastCodepoint(words[j - 1]), firstCodepoint(words[j]), wordStyles[j - 1]);
-      }
-      currlen += wordWidths[j] + gap;
+  const int indent = firstLineIndent();
 
-      if (currlen > effectivePageWidth) {
+  // Ensure any word that would overflow even as the first entry on a line is split using fallback hyphenation.
+  for (size_t i = 0; i < wordWidths.size(); ++i) {
+    // First word needs to fit in reduced width if there's an indent
+    const int effectiveWidth = i == 0 ? pageWidth - indent : pageWidth;
+    while (wordWidths[i] > effectiveWidth) {
+      if (!hyphenateWordAtIndex(i, effectiveWidth, renderer, fontId, wordWidths, /*allowFallbackBreaks=*/true)) {
         break;
       }
+    }
+  }
 
-      // Cannot break after word j if the next word attaches to it (continuation group)
-      if (j + 1 < totalWordCount && continuesVec[j + 1]) {
-        continue;
-      }
+  wordGaps = calculateWordGaps(renderer, fontId);
 
-      int cost;
-      if (j == totalWordCount - 1) {
-        cost = 0;  // Last line
-      } else {
-        const int remainingSpace = effectivePageWidth - currlen;
-        // Use long long for the square to prevent overflow
-        const long long cost_ll = static_cast<long long>(remainingSpace) * remainingSpace + dp[j + 1];
-
-        if (cost_ll > MAX_COST) {
-          cost = MAX_COST;
-        } else {
-          cost = static_cast<int>(cost_ll);
+  const int spaceWidth = std::max(1, renderer.getSpaceWidth(fontId, EpdFontFamily::REGULAR));
+  const bool justify = blockStyle.alignment == CssTextAlign::Justify;
+  // A hyphen costs about as much as three spaces of slack on a ragged line
+  const long long hyphenPenalty = 9LL * spaceWidth * spaceWidth;
+
+  std::vector<HyphenPoint> points;
+  const auto measureInside = [&](const uint32_t word, const uint16_t from, const uint16_t to, const bool hyphen) {
+    const std::string part(wordText(word).substr(from, to - from));
+    return static_cast<int>(measureWordWidth(renderer, fontId, part, words[word].style, hyphen));
+  };
+
+  TotalFitBreaker breaker(wordWidths, wordGaps, words, points, pageWidth, indent, justify, hyphenPenalty);
+  breaker.run(measureInside);
+
+#if ENABLE_HYPHENATION
+  if (hyphenationEnabled) {
+    bool loose = false;
+    const auto& nodes = breaker.result();
+    for (int32_t n = nodes.back().prev; n > 0 && !loose; n = nodes[n].prev) {
+      loose = nodes[n].slack > std::max<int>(1, nodes[n].gapCount) * spaceWidth;
+    }
+    if (loose) {
+      std::vector<Hyphenator::BreakInfo> breakInfos;
+      for (size_t w = 0; w < words.size(); w++) {
+        const std::string word(wordText(w));
+        Hyphenator::breakOffsets(word, false, breakInfos);
+        for (const auto& info : breakInfos) {
+          if (info.byteOffset == 0 || info.byteOffset >= word.size()) continue;
+          HyphenPoint point;
+          point.word = static_cast<uint32_t>(w);
+          point.byteOffset = static_cast<uint16_t>(info.byteOffset);
+          point.prefixWidth = measureWordWidth(renderer, fontId, word.substr(0, info.byteOffset), words[w].style,
+                                               info.requiresInsertedHyphen);
+          point.suffixWidth = measureWordWidth(renderer, fontId, word.substr(info.byteOffset), words[w].style);
+          point.insertsHyphen = info.requiresInsertedHyphen;
+          points.push_back(point);
         }
       }
-
-      if (cost < dp[i]) {
-        dp[i] = cost;
-        ans[i] = j;  // j is the index of the last word in this optimal line
+      if (!points.empty()) {
+        breaker.run(measureInside);
       }
     }
+  }
+#endif
 
-    // Handle oversized word: if no valid configuration found, force single-word line
-    // This prevents cascade failure where one oversized word breaks all preceding words
-    if (dp[i] == MAX_COST) {
-      ans[i] = i;  // Just this word on its own line
-      // Inherit cost from next word to allow subsequent words to find valid configurations
-      if (i + 1 < static_cast<int>(totalWordCount)) {
-        dp[i] = dp[i + 1];
-      } else {
-        dp[i] = 0;
-      }
-    }
+  // Walk the best path back from the paragraph end, then apply it front to back, splitting hyphenated words.
+  const auto& nodes = breaker.result();
+  std::vector<int32_t> path;
+  for (int32_t n = static_cast<int32_t>(nodes.size()) - 1; n > 0; n = nodes[n].prev) {
+    path.push_back(n);
   }
 
-  // Stores the index of the word that starts the next line (last_word_index + 1)
   std::vector<size_t> lineBreakIndices;
-  size_t currentWordIndex = 0;
-
-  while (currentWordIndex < totalWordCount) {
-    size_t nextBreakIndex = ans[currentWordIndex] + 1;
-
-    // Safety check: prevent infinite loop if nextBreakIndex doesn't advance
-    if (nextBreakIndex <= currentWordIndex) {
-      // Force advance by at least one word to avoid infinite loop
-      nextBreakIndex = currentWordIndex + 1;
+  lineBreakIndices.reserve(path.size());
+  size_t shift = 0;             // words inserted by earlier splits
+  int32_t lastSplitPoint = -1;  // previous split, for a second break inside the same word
+  for (auto it = path.rbegin(); it != path.rend(); ++it) {
+    const BreakNode& node = nodes[*it];
+    if (node.point < 0) {
+      lineBreakIndices.push_back(node.nextWord + shift);
+      continue;
     }
-
-    lineBreakIndices.push_back(nextBreakIndex);
-    currentWordIndex = nextBreakIndex;
+    const HyphenPoint& point = points[node.point];
+    size_t offset = point.byteOffset;
+    if (lastSplitPoint >= 0 && points[lastSplitPoint].word == point.word) {
+      offset -= points[lastSplitPoint].byteOffset;
+    }
+    const size_t index = point.word + shift;
+    splitWord(index, offset, point.insertsHyphen, renderer, fontId, wordWidths);
+    // The remainder starts a line, so the gap before it is never used
+    wordGaps.insert(wordGaps.begin() + index + 1, 0);
+    shift++;
+    lastSplitPoint = node.point;
+    lineBreakIndices.push_back(index + 1);
   }
 
   return lineBreakIndices;
@@ -273,91 +473,10 @@ void ParsedText::applyParagraphIndent() {
     // The actual indent positioning is handled in extractLine()
   } else if (blockStyle.alignment == CssTextAlign::Justify || blockStyle.alignment == CssTextAlign::Left) {
     // No CSS text-indent defined - use EmSpace fallback for visual indent
-    words.front().insert(0, "\xe2\x80\x83");
+    setWordText(0, "\xe2\x80\x83" + std::string(wordText(0)));
   }
 }
 
-#if ENABLE_HYPHENATION
-// Builds break indices while opportunistically splitting the word that would overflow the current line.
-std::vector<size_t> ParsedText::computeHyphenatedLineBreaks(const GfxRenderer& renderer, const int fontId,
-                                                            const int pageWidth, std::vector<uint16_t>& wordWidths,
-                                                            std::vector<bool>& continuesVec) {
-  // Calculate first line indent (only for left/justified text).
-  // Positive text-indent (paragraph indent) is suppressed when extraParagraphSpacing is on.
-  // Negative text-indent (hanging indent, e.g. margin-left:3em; text-indent:-1em) always applies —
-  // it is structural (positions the bullet/marker), not decorative.
-  const int firstLineIndent =
-      blockStyle.textIndentDefined && (blockStyle.textIndent < 0 || !extraParagraphSpacing) &&
-              (blockStyle.alignment == CssTextAlign::Justify || blockStyle.alignment == CssTextAlign::Left)
-          ? blockStyle.textIndent
-          : 0;
-
-  std::vector<size_t> lineBreakIndices;
-  size_t currentIndex = 0;
-  bool isFirstLine = true;
-
-  while (currentIndex < wordWidths.size()) {
-    const size_t lineStart = currentIndex;
-    int lineWidth = 0;
-
-    // First line has reduced width due to text-indent
-    const int effectivePageWidth = isFirstLine ? pageWidth - firstLineIndent : pageWidth;
-
-    // Consume as many words as possible for current line, splitting when prefixes fit
-    while (currentIndex < wordWidths.size()) {
-      const bool isFirstWord = currentIndex == lineStart;
-      int spacing = 0;
-      if (!isFirstWord && !continuesVec[currentIndex]) {
-        spacing = renderer.getSpaceAdvance(fontId, lastCodepoint(words[currentIndex - 1]),
-                                           firstCodepoint(words[currentIndex]), wordStyles[currentIndex - 1]);
-      } else if (!isFirstWord && continuesVec[currentIndex]) {
-        // Cross-boundary kerning for continuation words (e.g. nonbreaking spaces, attached punctuation)
-        spacing = renderer.getKerning(fontId, lastCodepoint(words[currentIndex - 1]),
-                                      firstCodepoint(words[currentIndex]), wordStyles[currentIndex - 1]);
-      }
-      const int candidateWidth = spacing + wordWidths[currentIndex];
-
-      // Word fits on current line
-      if (lineWidth + candidateWidth <= effectivePageWidth) {
-        lineWidth += candidateWidth;
-        ++currentIndex;
-        continue;
-      }
-
-      // Word would overflow — try to split based on hyphenation points
-      const int availableWidth = effectivePageWidth - lineWidth - spacing;
-      const bool allowFallbackBreaks = isFirstWord;  // Only for first word on line
-
-      if (availableWidth > 0 &&
-          hyphenateWordAtIndex(currentIndex, availableWidth, renderer, fontId, wordWidths, allowFallbackBreaks)) {
-        // Prefix now fits; append it to this line and move to next line
-        lineWidth += spacing + wordWidths[currentIndex];
-        ++currentIndex;
-        break;
-      }
-
-      // Could not split: force at least one word per line to avoid infinite loop
-      if (currentIndex == lineStart) {
-        lineWidth += candidateWidth;
-        ++currentIndex;
-      }
-      break;
-    }
-
-    // Don't break before a continuation word (e.g., orphaned "?" after "question").
-    // Backtrack to the start of the continuation group so the whole group moves to the next line.
-    while (currentIndex > lineStart + 1 && currentIndex < wordWidths.size() && continuesVec[currentIndex]) {
-      --currentIndex;
-    }
-
-    lineBreakIndices.push_back(currentIndex);
-    isFirstLine = false;
-  }
-
-  return lineBreakIndices;
-}
-#endif  // ENABLE_HYPHENATION
-
 // Splits words[wordIndex] into prefix (adding a hyphen only when needed) and remainder when a legal breakpoint fits the
 // available width.
 bool ParsedText::hyphenateWordAtIndex(const size_t wordIndex, const int availableWidth, const GfxRenderer& renderer,
@@ -371,8 +490,8 @@ bool ParsedText::hyphenateWordAtIndex(const size_t wordIndex, const int availabl
     return false;
   }
 
-  const std::string& word = words[wordIndex];
-  const auto style = wordStyles[wordIndex];
+  const std::string word(wordText(wordIndex));
+  const auto style = words[wordIndex].style;
 
   // Collect candidate breakpoints (byte offsets and hyphen requirements).
   auto breakInfos = Hyphenator::breakOffsets(word, allowFallbackBreaks);
@@ -407,16 +526,22 @@ bool ParsedText::hyphenateWordAtIndex(const size_t wordIndex, const int availabl
     return false;
   }
 
-  // Split the word at the selected breakpoint and append a hyphen if required.
-  std::string remainder = word.substr(chosenOffset);
-  words[wordIndex].resize(chosenOffset);
-  if (chosenNeedsHyphen) {
-    words[wordIndex].push_back('-');
-  }
+  splitWord(wordIndex, chosenOffset, chosenNeedsHyphen, renderer, fontId, wordWidths);
+  return true;
+#endif  // ENABLE_HYPHENATION
+}
 
-  // Insert the remainder word (with matching style and continuation flag) directly after the prefix.
-  words.insert(words.begin() + wordIndex + 1, remainder);
-  wordStyles.insert(wordStyles.begin() + wordIndex + 1, style);
+// Splits words[wordIndex] at byteOffset into prefix (plus a hyphen if insertHyphen) and remainder, re-measuring both.
+void ParsedText::splitWord(const size_t wordIndex, const size_t byteOffset, const bool insertHyphen,
+                           const GfxRenderer& renderer, const int fontId, std::vector<uint16_t>& wordWidths) {
+  const auto style = words[wordIndex].style;
+  const std::string_view word = wordText(wordIndex);
+  const std::string remainder(word.substr(byteOffset));
+  std::string prefix(word.substr(0, byteOffset));
+  if (insertHyphen) {
+    prefix.push_back('-');
+  }
+  setWordText(wordIndex, prefix);
 
   // Continuation flag handling after splitting a word into prefix + remainder.
   //
@@ -435,37 +560,29 @@ bool ParsedText::hyphenateWordAtIndex(const size_t wordIndex, const int availabl
   //   [2] "Quadrat-"    continues=true   (KEPT — still attached to the no-break group)
   //   [3] "kilometer"   continues=false  (NEW — starts fresh on the next line)
   //
-  // This lets the backtracking loop keep the entire prefix group ("200 Quadrat-") on one
-  // line, while "kilometer" moves to the next line.
-  // wordContinues[wordIndex] is intentionally left unchanged — the prefix keeps its original attachment.
-  wordContinues.insert(wordContinues.begin() + wordIndex + 1, false);
+  // This keeps the entire prefix group ("200 Quadrat-") on one line, while "kilometer" moves to the next line.
+  // words[wordIndex].continues is intentionally left unchanged — the prefix keeps its original attachment.
+  //
+  // The remainder goes to the end of the pool and its record directly after the prefix.
+  const Word remainderWord = {static_cast<uint32_t>(text.size()), static_cast<uint16_t>(remainder.size()), style,
+                              false};
+  text.append(remainder);
+  text.push_back('\0');
+  words.insert(words.begin() + wordIndex + 1, remainderWord);
 
   // Update cached widths to reflect the new prefix/remainder pairing.
-  wordWidths[wordIndex] = static_cast<uint16_t>(chosenWidth);
-  const uint16_t remainderWidth = measureWordWidth(renderer, fontId, remainder, style);
-  wordWidths.insert(wordWidths.begin() + wordIndex + 1, remainderWidth);
-  return true;
-#endif  // ENABLE_HYPHENATION
+  wordWidths[wordIndex] = measureWordWidth(renderer, fontId, wordText(wordIndex), style);
+  wordWidths.insert(wordWidths.begin() + wordIndex + 1, measureWordWidth(renderer, fontId, remainder, style));
 }
 
 void ParsedText::extractLine(const size_t breakIndex, const int pageWidth, const std::vector<uint16_t>& wordWidths,
-                             const std::vector<bool>& continuesVec, const std::vector<size_t>& lineBreakIndices,
-                             const std::function<void(std::shared_ptr<TextBlock>)>& processLine,
-                             const GfxRenderer& renderer, const int fontId) {
+                             const std::vector<int16_t>& wordGaps, const std::vector<size_t>& lineBreakIndices,
+                             const std::function<void(std::shared_ptr<TextBlock>)>& processLine) {
   const size_t lineBreak = lineBreakIndices[breakIndex];
   const size_t lastBreakAt = breakIndex > 0 ? lineBreakIndices[breakIndex - 1] : 0;
   const size_t lineWordCount = lineBreak - lastBreakAt;
 
-  // Calculate first line indent (only for left/justified text).
-  // Positive text-indent (paragraph indent) is suppressed when extraParagraphSpacing is on.
-  // Negative text-indent (hanging indent, e.g. margin-left:3em; text-indent:-1em) always applies —
-  // it is structural (positions the bullet/marker), not decorative.
-  const bool isFirstLine = breakIndex == 0;
-  const int firstLineIndent =
-      isFirstLine && blockStyle.textIndentDefined && (blockStyle.textIndent < 0 || !extraParagraphSpacing) &&
-              (blockStyle.alignment == CssTextAlign::Justify || blockStyle.alignment == CssTextAlign::Left)
-          ? blockStyle.textIndent
-          : 0;
+  const int lineIndent = breakIndex == 0 ? firstLineIndent() : 0;
 
   // Calculate total word width for this line, count actual word gaps,
   // and accumulate total natural gap widths (including space kerning adjustments).
@@ -476,21 +593,16 @@ void ParsedText::extractLine(const size_t breakIndex, const int pageWidth, const
   for (size_t wordIdx = 0; wordIdx < lineWordCount; wordIdx++) {
     lineWordWidthSum += wordWidths[lastBreakAt + wordIdx];
     // Count gaps: each word after the first creates a gap, unless it's a continuation
-    if (wordIdx > 0 && !continuesVec[lastBreakAt + wordIdx]) {
-      actualGapCount++;
-      totalNaturalGaps +=
-          renderer.getSpaceAdvance(fontId, lastCodepoint(words[lastBreakAt + wordIdx - 1]),
-                                   firstCodepoint(words[lastBreakAt + wordIdx]), wordStyles[lastBreakAt + wordIdx - 1]);
-    } else if (wordIdx > 0 && continuesVec[lastBreakAt + wordIdx]) {
-      // Cross-boundary kerning for continuation words (e.g. nonbreaking spaces, attached punctuation)
-      totalNaturalGaps +=
-          renderer.getKerning(fontId, lastCodepoint(words[lastBreakAt + wordIdx - 1]),
-                              firstCodepoint(words[lastBreakAt + wordIdx]), wordStyles[lastBreakAt + wordIdx - 1]);
+    if (wordIdx > 0) {
+      totalNaturalGaps += wordGaps[lastBreakAt + wordIdx];
+      if (!words[lastBreakAt + wordIdx].continues) {
+        actualGapCount++;
+      }
     }
   }
 
   // Calculate spacing (account for indent reducing effective page width on first line)
-  const int effectivePageWidth = pageWidth - firstLineIndent;
+  const int effectivePageWidth = pageWidth - lineIndent;
   const bool isLastLine = breakIndex == lineBreakIndices.size() - 1;
 
   // For justified text, compute per-gap extra to distribute remaining space evenly
@@ -501,54 +613,42 @@ void ParsedText::extractLine(const size_t breakIndex, const int pageWidth, const
 
   // Calculate initial x position (first line starts at indent for left/justified text;
   // may be negative for hanging indents, e.g. margin-left:3em; text-indent:-1em).
-  auto xpos = static_cast<int16_t>(firstLineIndent);
+  auto xpos = static_cast<int16_t>(lineIndent);
   if (blockStyle.alignment == CssTextAlign::Right) {
     xpos = effectivePageWidth - lineWordWidthSum - totalNaturalGaps;
   } else if (blockStyle.alignment == CssTextAlign::Center) {
     xpos = (effectivePageWidth - lineWordWidthSum - totalNaturalGaps) / 2;
   }
 
-  // Pre-calculate X positions for words
+  // Copy the line's words into the block's own pool, placing each one as we go.
   // Continuation words attach to the previous word with no space before them
-  std::vector<int16_t> lineXPos;
-  lineXPos.reserve(lineWordCount);
+  auto line = std::make_shared<TextBlock>(blockStyle);
+  size_t lineBytes = 0;
+  for (size_t i = lastBreakAt; i < lineBreak; i++) lineBytes += words[i].length;
+  line->reserve(lineWordCount, lineBytes);
 
+  std::string stripped;
   for (size_t wordIdx = 0; wordIdx < lineWordCount; wordIdx++) {
-    lineXPos.push_back(xpos);
-
-    const bool nextIsContinuation = wordIdx + 1 < lineWordCount && continuesVec[lastBreakAt + wordIdx + 1];
-    if (nextIsContinuation) {
-      int advance = wordWidths[lastBreakAt + wordIdx];
-      // Cross-boundary kerning for continuation words (e.g. nonbreaking spaces, attached punctuation)
-      advance +=
-          renderer.getKerning(fontId, lastCodepoint(words[lastBreakAt + wordIdx]),
-                              firstCodepoint(words[lastBreakAt + wordIdx + 1]), wordStyles[lastBreakAt + wordIdx]);
-      xpos += advance;
+    const size_t i = lastBreakAt + wordIdx;
+    const std::string_view word = wordText(i);
+    if (containsSoftHyphen(word)) {
+      stripped.assign(word);
+      stripSoftHyphensInPlace(stripped);
+      line->addWord(stripped, xpos, words[i].style);
     } else {
-      int gap = 0;
-      if (wordIdx + 1 < lineWordCount) {
-        gap = renderer.getSpaceAdvance(fontId, lastCodepoint(words[lastBreakAt + wordIdx]),
-                                       firstCodepoint(words[lastBreakAt + wordIdx + 1]),
-                                       wordStyles[lastBreakAt + wordIdx]);
-      }
-      if (blockStyle.alignment == CssTextAlign::Justify && !isLastLine) {
-        gap += justifyExtra;
-      }
-      xpos += wordWidths[lastBreakAt + wordIdx] + gap;
+      line->addWord(word, xpos, words[i].style);
     }
-  }
 
-  // Build line data by moving from the original vectors using index range
-  std::vector<std::string> lineWords(std::make_move_iterator(words.begin() + lastBreakAt),
-                                     std::make_move_iterator(words.begin() + lineBreak));
-  std::vector<EpdFontFamily::Style> lineWordStyles(wordStyles.begin() + lastBreakAt, wordStyles.begin() + lineBreak);
-
-  for (auto& word : lineWords) {
-    if (containsSoftHyphen(word)) {
-      stripSoftHyphensInPlace(word);
+    int advance = wordWidths[i];
+    if (wordIdx + 1 < lineWordCount) {
+      advance += wordGaps[i + 1];
+    }
+    const bool nextIsContinuation = wordIdx + 1 < lineWordCount && words[i + 1].continues;
+    if (!nextIsContinuation) {
+      advance += justifyExtra;
     }
+    xpos += advance;
   }
 
-  processLine(
-      std::make_shared<TextBlock>(std::move(lineWords), std::move(lineXPos), std::move(lineWordStyles), blockStyle));
+  processLine(std::move(line));
 }
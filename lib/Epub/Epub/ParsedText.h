@@ -5,6 +5,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "blocks/BlockStyle.h"
@@ -13,25 +14,39 @@
 class GfxRenderer;
 
 class ParsedText {
-  std::vector<std::string> words;
-  std::vector<EpdFontFamily::Style> wordStyles;
-  std::vector<bool> wordContinues;  // true = word attaches to previous (no space before it)
+ public:
+  struct Word {
+    uint32_t offset;  // start of the word in text
+    uint16_t length;
+    EpdFontFamily::Style style;
+    bool continues;  // true = word attaches to previous (no space before it)
+  };
+
+ private:
+  // The paragraph's words back to back in one pool, each NUL-terminated so it can be measured in place. A word that
+  // is rewritten (split, indented) is appended again and its old bytes left behind until the lines are consumed.
+  std::string text;
+  std::vector<Word> words;
   BlockStyle blockStyle;
   bool extraParagraphSpacing;
   bool hyphenationEnabled;
 
+  std::string_view wordText(size_t i) const { return {text.data() + words[i].offset, words[i].length}; }
+  void pushWord(std::string_view word, EpdFontFamily::Style style, bool continues);
+  void setWordText(size_t i, const std::string& word);
   void applyParagraphIndent();
+  int firstLineIndent() const;
   std::vector<size_t> computeLineBreaks(const GfxRenderer& renderer, int fontId, int pageWidth,
-                                        std::vector<uint16_t>& wordWidths, std::vector<bool>& continuesVec);
-  std::vector<size_t> computeHyphenatedLineBreaks(const GfxRenderer& renderer, int fontId, int pageWidth,
-                                                  std::vector<uint16_t>& wordWidths, std::vector<bool>& continuesVec);
+                                        std::vector<uint16_t>& wordWidths, std::vector<int16_t>& wordGaps);
   bool hyphenateWordAtIndex(size_t wordIndex, int availableWidth, const GfxRenderer& renderer, int fontId,
                             std::vector<uint16_t>& wordWidths, bool allowFallbackBreaks);
+  void splitWord(size_t wordIndex, size_t byteOffset, bool insertHyphen, const GfxRenderer& renderer, int fontId,
+                 std::vector<uint16_t>& wordWidths);
   void extractLine(size_t breakIndex, int pageWidth, const std::vector<uint16_t>& wordWidths,
-                   const std::vector<bool>& continuesVec, const std::vector<size_t>& lineBreakIndices,
-                   const std::function<void(std::shared_ptr<TextBlock>)>& processLine, const GfxRenderer& renderer,
-                   int fontId);
+                   const std::vector<int16_t>& wordGaps, const std::vector<size_t>& lineBreakIndices,
+                   const std::function<void(std::shared_ptr<TextBlock>)>& processLine);
   std::vector<uint16_t> calculateWordWidths(const GfxRenderer& renderer, int fontId);
+  std::vector<int16_t> calculateWordGaps(const GfxRenderer& renderer, int fontId) const;
 
  public:
   explicit ParsedText(const bool extraParagraphSpacing, const bool hyphenationEnabled = false,
@@ -39,7 +54,8 @@ class ParsedText {
       : blockStyle(blockStyle), extraParagraphSpacing(extraParagraphSpacing), hyphenationEnabled(hyphenationEnabled) {}
   ~ParsedText() = default;
 
-  void addWord(std::string word, EpdFontFamily::Style fontStyle, bool underline = false, bool attachToPrevious = false);
+  void addWord(std::string_view word, EpdFontFamily::Style fontStyle, bool underline = false,
+               bool attachToPrevious = false);
   void setBlockStyle(const BlockStyle& blockStyle) { this->blockStyle = blockStyle; }
   BlockStyle& getBlockStyle() { return blockStyle; }
   size_t size() const { return words.size(); }
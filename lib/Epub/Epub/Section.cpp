@@ -1,39 +1,115 @@
 #include "Section.h"
 
 #include <FeatureFlags.h>
+#include <FsHelpers.h>
+#include <GfxRenderer.h>
 #include <HalStorage.h>
 #include <Logging.h>
 #include <Serialization.h>
+#include <ZipFile.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <optional>
 
 #include "Epub/css/CssParser.h"
 #include "Page.h"
+#include "SpiBusMutex.h"
 #if ENABLE_HYPHENATION
+#include "hyphenation/HyphenationCache.h"
 #include "hyphenation/Hyphenator.h"
 #endif
 #include "parsers/ChapterHtmlSlimParser.h"
 
 namespace {
-constexpr uint8_t SECTION_FILE_VERSION = 19;
+constexpr uint8_t SECTION_FILE_VERSION = 22;
 constexpr uint32_t HEADER_SIZE = sizeof(uint8_t) + sizeof(int) + sizeof(float) + sizeof(bool) + sizeof(uint8_t) +
                                  sizeof(uint16_t) + sizeof(uint16_t) + sizeof(uint16_t) + sizeof(bool) + sizeof(bool) +
-                                 sizeof(uint8_t) + sizeof(uint32_t) + sizeof(uint32_t);
+                                 sizeof(uint8_t) + sizeof(uint32_t) + sizeof(uint32_t) + sizeof(uint32_t);
+// Anchor map: uint16_t count, then count records of (uint64_t FNV-1a hash of the anchor id, uint16_t page), sorted by
+// hash
+constexpr uint32_t ANCHOR_RECORD_SIZE = sizeof(uint64_t) + sizeof(uint16_t);
+// Glyph group table: uint8_t count, then count records of (uint8_t style, uint16_t group, uint16_t pages), most used
+// first
 }  // namespace
 
-uint32_t Section::onPageComplete(std::unique_ptr<Page> page) {
+uint8_t Section::fileVersion() { return SECTION_FILE_VERSION; }
+
+std::string Section::profileDir(const std::string& bookCachePath, const int fontId, const float lineCompression,
+                                const bool extraParagraphSpacing, const uint8_t paragraphAlignment,
+                                const uint16_t viewportWidth, const uint16_t viewportHeight,
+                                const bool hyphenationEnabled, const bool embeddedStyle, const uint8_t imageRendering) {
+  // FNV-1a over the same fields the header validates; a collision is still caught by that check
+  uint32_t hash = 2166136261u;
+  const auto mix = [&hash](const void* data, const size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++) {
+      hash = (hash ^ bytes[i]) * 16777619u;
+    }
+  };
+  mix(&SECTION_FILE_VERSION, sizeof(SECTION_FILE_VERSION));
+  mix(&fontId, sizeof(fontId));
+  mix(&lineCompression, sizeof(lineCompression));
+  mix(&extraParagraphSpacing, sizeof(extraParagraphSpacing));
+  mix(&paragraphAlignment, sizeof(paragraphAlignment));
+  mix(&viewportWidth, sizeof(viewportWidth));
+  mix(&viewportHeight, sizeof(viewportHeight));
+  mix(&hyphenationEnabled, sizeof(hyphenationEnabled));
+  mix(&embeddedStyle, sizeof(embeddedStyle));
+  mix(&imageRendering, sizeof(imageRendering));
+
+  char name[9];
+  snprintf(name, sizeof(name), "%08lx", static_cast<unsigned long>(hash));
+  return bookCachePath + "/sections/" + name;
+}
+
+Section::~Section() {
+  SpiBusMutex::Guard guard;
+  std::lock_guard<std::mutex> lock(readMutex);
+  if (reader) {
+    reader.close();
+  }
+}
+
+void Section::onPageComplete(std::unique_ptr<Page> page) {
+  if (pageWriteFailed) {
+    return;
+  }
+  const uint16_t index = pageCount.load();
   if (!file) {
-    LOG_ERR("SCT", "File not open for writing page %d", pageCount);
-    return 0;
+    LOG_ERR("SCT", "File not open for writing page %d", index);
+    pageWriteFailed = true;
+    return;
   }
 
-  const uint32_t position = file.position();
-  if (!page->serialize(file)) {
-    LOG_ERR("SCT", "Failed to serialize page %d", pageCount);
-    return 0;
+  for (const auto& element : page->elements) {
+    if (element->getTag() != TAG_PageLine) continue;
+    const auto& block = static_cast<const PageLine&>(*element).getBlock();
+    for (size_t i = 0; block && i < block->wordCount(); i++) {
+      glyphHistogram.addText(block->getWord(i), block->getWordStyle(i));
+    }
   }
-  LOG_DBG("SCT", "Page %d processed", pageCount);
+  glyphHistogram.endPage();
 
-  pageCount++;
-  return position;
+  uint32_t position;
+  {
+    SpiBusMutex::Guard guard;
+    position = file.position();
+    if (!page->serialize(file)) {
+      LOG_ERR("SCT", "Failed to serialize page %d", index);
+      pageWriteFailed = true;
+      return;
+    }
+    // Flush so a reader opening the file from another task sees the page before the chapter is finished
+    file.flush();
+  }
+  LOG_DBG("SCT", "Page %d processed", index);
+
+  {
+    std::lock_guard<std::mutex> lock(lutMutex);
+    pageLut.push_back(position);
+  }
+  pageCount.store(index + 1);
 }
 
 void Section::writeSectionFileHeader(const int fontId, const float lineCompression, const bool extraParagraphSpacing,
@@ -46,8 +122,9 @@ void Section::writeSectionFileHeader(const int fontId, const float lineCompressi
   }
   static_assert(HEADER_SIZE == sizeof(SECTION_FILE_VERSION) + sizeof(fontId) + sizeof(lineCompression) +
                                    sizeof(extraParagraphSpacing) + sizeof(paragraphAlignment) + sizeof(viewportWidth) +
-                                   sizeof(viewportHeight) + sizeof(pageCount) + sizeof(hyphenationEnabled) +
-                                   sizeof(embeddedStyle) + sizeof(imageRendering) + sizeof(uint32_t) + sizeof(uint32_t),
+                                   sizeof(viewportHeight) + sizeof(uint16_t) + sizeof(hyphenationEnabled) +
+                                   sizeof(embeddedStyle) + sizeof(imageRendering) + sizeof(uint32_t) + sizeof(uint32_t) +
+                                   sizeof(uint32_t),
                 "Header size mismatch");
   serialization::writePod(file, SECTION_FILE_VERSION);
   serialization::writePod(file, fontId);
@@ -59,15 +136,20 @@ void Section::writeSectionFileHeader(const int fontId, const float lineCompressi
   serialization::writePod(file, hyphenationEnabled);
   serialization::writePod(file, embeddedStyle);
   serialization::writePod(file, imageRendering);
-  serialization::writePod(file, pageCount);  // Placeholder for page count (will be initially 0, patched later)
+  serialization::writePod(file, static_cast<uint16_t>(0));  // Placeholder for page count (patched later)
   serialization::writePod(file, static_cast<uint32_t>(0));  // Placeholder for LUT offset (patched later)
   serialization::writePod(file, static_cast<uint32_t>(0));  // Placeholder for anchor map offset (patched later)
+  serialization::writePod(file, static_cast<uint32_t>(0));  // Placeholder for glyph group table offset (patched later)
 }
 
 bool Section::loadSectionFile(const int fontId, const float lineCompression, const bool extraParagraphSpacing,
                               const uint8_t paragraphAlignment, const uint16_t viewportWidth,
                               const uint16_t viewportHeight, const bool hyphenationEnabled, const bool embeddedStyle,
                               const uint8_t imageRendering) {
+  SpiBusMutex::Guard guard;
+  filePath = profileDir(epub->getCachePath(), fontId, lineCompression, extraParagraphSpacing, paragraphAlignment,
+                        viewportWidth, viewportHeight, hyphenationEnabled, embeddedStyle, imageRendering) +
+             "/" + std::to_string(spineIndex) + ".bin";
   if (!Storage.openFileForRead("SCT", filePath, file)) {
     return false;
   }
@@ -113,14 +195,78 @@ bool Section::loadSectionFile(const int fontId, const float lineCompression, con
     }
   }
 
-  serialization::readPod(file, pageCount);
-  file.close();
-  LOG_DBG("SCT", "Deserialization succeeded: %d pages", pageCount);
+  uint16_t filePageCount;
+  uint32_t lutOffset;
+  uint32_t fileAnchorMapOffset;
+  uint32_t glyphGroupsOffset;
+  serialization::readPod(file, filePageCount);
+  serialization::readPod(file, lutOffset);
+  serialization::readPod(file, fileAnchorMapOffset);
+  serialization::readPod(file, glyphGroupsOffset);
+
+  // The LUT offset is patched last, so a zero here means the build was interrupted (power loss, cancelled task) or is
+  // still running on another task. The file is left alone: the owner rebuilds it, which truncates it.
+  if (lutOffset == 0 || lutOffset + sizeof(uint32_t) * filePageCount > file.size()) {
+    file.close();
+    LOG_ERR("SCT", "Deserialization failed: Section file incomplete");
+    return false;
+  }
+
+  // Keep the LUT in RAM (4 bytes per page) so a page turn is a single seek
+  {
+    std::lock_guard<std::mutex> lock(lutMutex);
+    pageLut.resize(filePageCount);
+    file.seek(lutOffset);
+    const int lutBytes = static_cast<int>(sizeof(uint32_t) * filePageCount);
+    if (file.read(pageLut.data(), lutBytes) != lutBytes) {
+      pageLut.clear();
+      file.close();
+      LOG_ERR("SCT", "Deserialization failed: Could not read page LUT");
+      return false;
+    }
+  }
+
+  // The glyph group table is a font cache hint only; a bad one is dropped, not fatal
+  hotGlyphGroups.clear();
+  uint8_t groupCount = 0;
+  if (glyphGroupsOffset != 0 && file.seek(glyphGroupsOffset) && serialization::readPod(file, groupCount) &&
+      groupCount <= GlyphGroupHistogram::MAX_ENTRIES) {
+    hotGlyphGroups.resize(groupCount);
+    for (auto& entry : hotGlyphGroups) {
+      serialization::readPod(file, entry.style);
+      serialization::readPod(file, entry.group);
+      if (!serialization::readPod(file, entry.pages)) {
+        hotGlyphGroups.clear();
+        break;
+      }
+    }
+  }
+
+  // Hand the open file over as the section's read handle
+  {
+    std::lock_guard<std::mutex> lock(readMutex);
+    if (reader) {
+      reader.close();
+    }
+    reader = std::move(file);
+  }
+  anchorMapOffset = fileAnchorMapOffset;
+  pageCount.store(filePageCount);
+  buildState.store(BuildState::Complete);
+  LOG_DBG("SCT", "Deserialization succeeded: %d pages", filePageCount);
   return true;
 }
 
 // Your updated class method (assuming you are using the 'SD' object, which is a wrapper for a specific filesystem)
 bool Section::clearCache() const {
+  SpiBusMutex::Guard guard;
+  {
+    std::lock_guard<std::mutex> lock(readMutex);
+    if (reader) {
+      reader.close();
+    }
+  }
+
   if (!Storage.exists(filePath.c_str())) {
     LOG_DBG("SCT", "Cache does not exist, no action needed");
     return true;
@@ -138,59 +284,72 @@ bool Section::clearCache() const {
 bool Section::createSectionFile(const int fontId, const float lineCompression, const bool extraParagraphSpacing,
                                 const uint8_t paragraphAlignment, const uint16_t viewportWidth,
                                 const uint16_t viewportHeight, const bool hyphenationEnabled, const bool embeddedStyle,
-                                const uint8_t imageRendering, const std::function<void()>& popupFn) {
+                                const uint8_t imageRendering, const std::function<void()>& popupFn,
+                                const std::atomic<bool>* cancelFlag) {
+  {
+    SpiBusMutex::Guard guard;
+    std::lock_guard<std::mutex> lock(readMutex);
+    if (reader) {
+      reader.close();
+    }
+  }
+  {
+    std::lock_guard<std::mutex> lock(lutMutex);
+    pageLut.clear();
+  }
+  anchorMapOffset = 0;
+  hotGlyphGroups.clear();
+  pageCount.store(0);
+  pageWriteFailed = false;
+  buildState.store(BuildState::Building);
+
+  const bool success = buildSectionFile(fontId, lineCompression, extraParagraphSpacing, paragraphAlignment,
+                                        viewportWidth, viewportHeight, hyphenationEnabled, embeddedStyle,
+                                        imageRendering, popupFn, cancelFlag);
+  glyphHistogram.reset(nullptr);
+  buildState.store(success ? BuildState::Complete : BuildState::Failed);
+  return success;
+}
+
+bool Section::buildSectionFile(const int fontId, const float lineCompression, const bool extraParagraphSpacing,
+                               const uint8_t paragraphAlignment, const uint16_t viewportWidth,
+                               const uint16_t viewportHeight, const bool hyphenationEnabled, const bool embeddedStyle,
+                               const uint8_t imageRendering, const std::function<void()>& popupFn,
+                               const std::atomic<bool>* cancelFlag) {
   const auto localPath = epub->getSpineItem(spineIndex).href;
-  const auto tmpHtmlPath = epub->getCachePath() + "/.tmp_" + std::to_string(spineIndex) + ".html";
+  const std::string itemPath = FsHelpers::normalisePath(localPath);
 
-  // Create cache directory if it doesn't exist
+  // This runs on the layout task while the reader keeps using the card, so the SPI bus is taken around each SD
+  // access rather than for the whole build
+  ZipFile zip(epub->getPath(), epub->getZipIndexPath());
+  ZipFile::EntryReader chapterReader(zip);
   {
-    const auto sectionsDir = epub->getCachePath() + "/sections";
+    SpiBusMutex::Guard guard;
+    // Create the profile's directory if it doesn't exist
+    const auto sectionsDir = profileDir(epub->getCachePath(), fontId, lineCompression, extraParagraphSpacing,
+                                        paragraphAlignment, viewportWidth, viewportHeight, hyphenationEnabled,
+                                        embeddedStyle, imageRendering);
     Storage.mkdir(sectionsDir.c_str());
-  }
-
-  // Retry logic for SD card timing issues
-  bool success = false;
-  uint32_t fileSize = 0;
-  for (int attempt = 0; attempt < 3 && !success; attempt++) {
-    if (attempt > 0) {
-      LOG_DBG("SCT", "Retrying stream (attempt %d)...", attempt + 1);
-      delay(50);  // Brief delay before retry
-    }
+    filePath = sectionsDir + "/" + std::to_string(spineIndex) + ".bin";
 
-    // Remove any incomplete file from previous attempt before retrying
-    if (Storage.exists(tmpHtmlPath.c_str())) {
-      Storage.remove(tmpHtmlPath.c_str());
+    // The chapter is inflated straight into the parser's buffer, so indexing needs no temporary file on SD
+    if (!chapterReader.open(itemPath.c_str())) {
+      LOG_ERR("SCT", "Failed to open %s in epub", itemPath.c_str());
+      return false;
     }
+    LOG_DBG("SCT", "Streaming %s (%u bytes)", itemPath.c_str(), static_cast<unsigned>(chapterReader.size()));
 
-    FsFile tmpHtml;
-    if (!Storage.openFileForWrite("SCT", tmpHtmlPath, tmpHtml)) {
-      continue;
-    }
-    success = epub->readItemContentsToStream(localPath, tmpHtml, 1024);
-    fileSize = tmpHtml.size();
-    tmpHtml.close();
-
-    // If streaming failed, remove the incomplete file immediately
-    if (!success && Storage.exists(tmpHtmlPath.c_str())) {
-      Storage.remove(tmpHtmlPath.c_str());
-      LOG_DBG("SCT", "Removed incomplete temp file after failed attempt");
+    if (!Storage.openFileForWrite("SCT", filePath, file)) {
+      chapterReader.close();
+      return false;
     }
+    const auto& fonts = renderer.getFontMap();
+    const auto fontIt = fonts.find(fontId);
+    glyphHistogram.reset(fontIt != fonts.end() ? &fontIt->second : nullptr);
+    writeSectionFileHeader(fontId, lineCompression, extraParagraphSpacing, paragraphAlignment, viewportWidth,
+                           viewportHeight, hyphenationEnabled, embeddedStyle, imageRendering);
   }
 
-  if (!success) {
-    LOG_ERR("SCT", "Failed to stream item contents to temp file after retries");
-    return false;
-  }
-
-  LOG_DBG("SCT", "Streamed temp HTML to %s (%d bytes)", tmpHtmlPath.c_str(), fileSize);
-
-  if (!Storage.openFileForWrite("SCT", filePath, file)) {
-    return false;
-  }
-  writeSectionFileHeader(fontId, lineCompression, extraParagraphSpacing, paragraphAlignment, viewportWidth,
-                         viewportHeight, hyphenationEnabled, embeddedStyle, imageRendering);
-  std::vector<uint32_t> lut = {};
-
   // Derive the content base directory and image cache path prefix for the parser
   size_t lastSlash = localPath.find_last_of('/');
   std::string contentBase = (lastSlash != std::string::npos) ? localPath.substr(0, lastSlash + 1) : "";
@@ -200,6 +359,7 @@ bool Section::createSectionFile(const int fontId, const float lineCompression, c
   if (embeddedStyle) {
     cssParser = epub->getCssParser();
     if (cssParser) {
+      SpiBusMutex::Guard guard;
       if (!cssParser->loadFromCache()) {
         LOG_ERR("SCT", "Failed to load CSS from cache");
       }
@@ -207,17 +367,39 @@ bool Section::createSectionFile(const int fontId, const float lineCompression, c
   }
 
   ChapterHtmlSlimParser visitor(
-      epub, tmpHtmlPath, renderer, fontId, lineCompression, extraParagraphSpacing, paragraphAlignment, viewportWidth,
+      epub, itemPath, renderer, fontId, lineCompression, extraParagraphSpacing, paragraphAlignment, viewportWidth,
       viewportHeight, hyphenationEnabled,
-      [this, &lut](std::unique_ptr<Page> page) { lut.emplace_back(this->onPageComplete(std::move(page))); },
-      embeddedStyle, contentBase, imageBasePath, imageRendering, popupFn, cssParser);
+      [this](std::unique_ptr<Page> page) { this->onPageComplete(std::move(page)); }, embeddedStyle, contentBase,
+      imageBasePath, imageRendering, popupFn, cssParser);
+  visitor.setCancelFlag(cancelFlag);
+  visitor.setEntrySource(&chapterReader);
 #if ENABLE_HYPHENATION
   Hyphenator::setPreferredLanguage(epub->getLanguage());
+  // Words recurring in the chapter are hyphenated once
+  std::optional<HyphenationCache> hyphenationCache;
+  if (hyphenationEnabled) {
+    hyphenationCache.emplace();
+  }
 #endif
-  success = visitor.parseAndBuildPages();
-  Storage.remove(tmpHtmlPath.c_str());
+  const bool success = visitor.parseAndBuildPages();
+#if ENABLE_HYPHENATION
+  if (hyphenationCache) {
+    const auto& stats = hyphenationCache->getStats();
+    LOG_DBG("SCT", "Hyphenation cache: %u%% of %lu lookups hit, %lu evictions, %lu uncacheable",
+            static_cast<unsigned>(hyphenationCache->hitRatePercent()),
+            static_cast<unsigned long>(stats.hits + stats.misses), static_cast<unsigned long>(stats.evictions),
+            static_cast<unsigned long>(stats.uncacheable));
+    hyphenationCache.reset();
+  }
+#endif
+  SpiBusMutex::Guard guard;
+  chapterReader.close();
   if (!success) {
-    LOG_ERR("SCT", "Failed to parse XML and build pages");
+    if (cancelFlag && cancelFlag->load()) {
+      LOG_DBG("SCT", "Build of section %d cancelled", spineIndex);
+    } else {
+      LOG_ERR("SCT", "Failed to parse XML and build pages");
+    }
     file.close();
     Storage.remove(filePath.c_str());
     if (cssParser) {
@@ -226,92 +408,149 @@ bool Section::createSectionFile(const int fontId, const float lineCompression, c
     return false;
   }
 
-  const uint32_t lutOffset = file.position();
-  bool hasFailedLutRecords = false;
-  // Write LUT
-  for (const uint32_t& pos : lut) {
-    if (pos == 0) {
-      hasFailedLutRecords = true;
-      break;
-    }
-    serialization::writePod(file, pos);
-  }
-
-  if (hasFailedLutRecords) {
+  if (pageWriteFailed) {
     LOG_ERR("SCT", "Failed to write LUT due to invalid page positions");
     file.close();
     Storage.remove(filePath.c_str());
+    if (cssParser) {
+      cssParser->clear();
+    }
     return false;
   }
 
-  // Write anchor-to-page map for fragment navigation (e.g. footnote targets)
-  const uint32_t anchorMapOffset = file.position();
+  // Write LUT. Only this task appends to pageLut, so it can be read without the lock here.
+  const uint32_t lutOffset = file.position();
+  for (const uint32_t pos : pageLut) {
+    serialization::writePod(file, pos);
+  }
+
+  // Write anchor-to-page map for fragment navigation (e.g. footnote targets), sorted by hash for binary search.
+  // The first occurrence of a duplicated id wins, as it does in the browser.
+  const uint32_t mapOffset = file.position();
   const auto& anchors = visitor.getAnchors();
-  serialization::writePod(file, static_cast<uint16_t>(anchors.size()));
+  std::vector<std::pair<uint64_t, uint16_t>> anchorTable;
+  anchorTable.reserve(anchors.size());
   for (const auto& [anchor, page] : anchors) {
-    serialization::writeString(file, anchor);
+    anchorTable.emplace_back(ZipFile::fnvHash64(anchor.data(), anchor.size()), page);
+  }
+  std::stable_sort(anchorTable.begin(), anchorTable.end(),
+                   [](const auto& a, const auto& b) { return a.first < b.first; });
+  anchorTable.erase(std::unique(anchorTable.begin(), anchorTable.end(),
+                                [](const auto& a, const auto& b) { return a.first == b.first; }),
+                    anchorTable.end());
+  serialization::writePod(file, static_cast<uint16_t>(anchorTable.size()));
+  for (const auto& [hash, page] : anchorTable) {
+    serialization::writePod(file, hash);
     serialization::writePod(file, page);
   }
 
-  // Patch header with final pageCount, lutOffset, and anchorMapOffset
-  file.seek(HEADER_SIZE - sizeof(uint32_t) * 2 - sizeof(pageCount));
-  serialization::writePod(file, pageCount);
+  // Glyph groups used on the most pages, for the font decompressor to keep inflated while reading this chapter
+  const uint32_t glyphGroupsOffset = file.position();
+  auto groups = glyphHistogram.top();
+  serialization::writePod(file, static_cast<uint8_t>(groups.size()));
+  for (const auto& entry : groups) {
+    serialization::writePod(file, entry.style);
+    serialization::writePod(file, entry.group);
+    serialization::writePod(file, entry.pages);
+  }
+
+  // Patch header with final pageCount, lutOffset, anchorMapOffset and glyph group table offset
+  file.seek(HEADER_SIZE - sizeof(uint32_t) * 3 - sizeof(uint16_t));
+  serialization::writePod(file, pageCount.load());
   serialization::writePod(file, lutOffset);
-  serialization::writePod(file, anchorMapOffset);
+  serialization::writePod(file, mapOffset);
+  serialization::writePod(file, glyphGroupsOffset);
   file.close();
+  anchorMapOffset = mapOffset;
+  hotGlyphGroups = std::move(groups);
   if (cssParser) {
     cssParser->clear();
   }
   return true;
 }
 
-std::unique_ptr<Page> Section::loadPageFromSectionFile() {
-  if (!Storage.openFileForRead("SCT", filePath, file)) {
+std::unique_ptr<Page> Section::loadPageFromSectionFile() { return loadPage(currentPage); }
+
+std::unique_ptr<Page> Section::loadPage(const int index) const {
+  uint32_t pagePos = 0;
+  {
+    std::lock_guard<std::mutex> lock(lutMutex);
+    if (index >= 0 && index < static_cast<int>(pageLut.size())) {
+      pagePos = pageLut[index];
+    }
+  }
+  if (pagePos == 0) {
+    LOG_ERR("SCT", "Page %d not in section LUT", index);
     return nullptr;
   }
 
-  file.seek(HEADER_SIZE - sizeof(uint32_t) * 2);
-  uint32_t lutOffset;
-  serialization::readPod(file, lutOffset);
-  file.seek(lutOffset + sizeof(uint32_t) * currentPage);
-  uint32_t pagePos;
-  serialization::readPod(file, pagePos);
-  file.seek(pagePos);
+  SpiBusMutex::Guard guard;
+  if (isBuilding()) {
+    // The builder is still appending to the file: a fresh handle sees every page flushed so far
+    FsFile f;
+    if (!Storage.openFileForRead("SCT", filePath, f)) {
+      return nullptr;
+    }
+    f.seek(pagePos);
+    auto page = Page::deserialize(f);
+    f.close();
+    return page;
+  }
 
-  auto page = Page::deserialize(file);
-  file.close();
-  return page;
+  std::lock_guard<std::mutex> lock(readMutex);
+  if (!reader && !Storage.openFileForRead("SCT", filePath, reader)) {
+    return nullptr;
+  }
+  reader.seek(pagePos);
+  return Page::deserialize(reader);
+}
+
+bool Section::waitForPage(const uint16_t index, const uint32_t timeoutMs) const {
+  const uint32_t start = millis();
+  while (buildState.load() == BuildState::Building && pageCount.load() <= index) {
+    if (millis() - start >= timeoutMs) {
+      return false;
+    }
+    delay(10);
+  }
+  return true;
 }
 
 std::optional<uint16_t> Section::getPageForAnchor(const std::string& anchor) const {
-  FsFile f;
-  if (!Storage.openFileForRead("SCT", filePath, f)) {
+  if (isBuilding() || anchorMapOffset == 0) {
     return std::nullopt;
   }
 
-  const uint32_t fileSize = f.size();
-  f.seek(HEADER_SIZE - sizeof(uint32_t));
-  uint32_t anchorMapOffset;
-  serialization::readPod(f, anchorMapOffset);
-  if (anchorMapOffset == 0 || anchorMapOffset >= fileSize) {
-    f.close();
+  SpiBusMutex::Guard guard;
+  std::lock_guard<std::mutex> lock(readMutex);
+  if (!reader && !Storage.openFileForRead("SCT", filePath, reader)) {
     return std::nullopt;
   }
 
-  f.seek(anchorMapOffset);
+  reader.seek(anchorMapOffset);
   uint16_t count;
-  serialization::readPod(f, count);
-  for (uint16_t i = 0; i < count; i++) {
-    std::string key;
-    uint16_t page;
-    serialization::readString(f, key);
-    serialization::readPod(f, page);
-    if (key == anchor) {
-      f.close();
+  serialization::readPod(reader, count);
+  if (anchorMapOffset + sizeof(uint16_t) + ANCHOR_RECORD_SIZE * count > reader.size()) {
+    return std::nullopt;
+  }
+
+  const uint64_t hash = ZipFile::fnvHash64(anchor.data(), anchor.size());
+  uint16_t lo = 0;
+  uint16_t hi = count;
+  while (lo < hi) {
+    const uint16_t mid = lo + (hi - lo) / 2;
+    reader.seek(anchorMapOffset + sizeof(uint16_t) + ANCHOR_RECORD_SIZE * mid);
+    uint64_t midHash;
+    serialization::readPod(reader, midHash);
+    if (midHash < hash) {
+      lo = mid + 1;
+    } else if (midHash > hash) {
+      hi = mid;
+    } else {
+      uint16_t page;
+      serialization::readPod(reader, page);
       return page;
     }
   }
-
-  f.close();
   return std::nullopt;
 }
@@ -1,8 +1,13 @@
 #pragma once
+#include <GlyphGroupHistogram.h>
+
+#include <atomic>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "Epub.h"
 
@@ -10,36 +15,86 @@ class Page;
 class GfxRenderer;
 
 class Section {
+ public:
+  enum class BuildState : uint8_t { None, Building, Complete, Failed };
+
+ private:
   std::shared_ptr<Epub> epub;
   const int spineIndex;
   GfxRenderer& renderer;
+  // Set by loadSectionFile()/createSectionFile(): sections/<profile>/<spineIndex>.bin in the book's cache
   std::string filePath;
   FsFile file;
 
+  // Page offsets of a section built by this object, published page by page so another task can read finished pages
+  // while createSectionFile() is still running.
+  mutable std::mutex lutMutex;
+  std::vector<uint32_t> pageLut;
+  std::atomic<BuildState> buildState{BuildState::None};
+  bool pageWriteFailed = false;
+
+  // Read handle kept open for the life of the section once it is complete, so page turns and anchor lookups are a
+  // seek and a read instead of an SD open per call.
+  mutable std::mutex readMutex;
+  mutable FsFile reader;
+  uint32_t anchorMapOffset = 0;
+
+  // Glyph groups by number of pages using them: counted while building, the top entries stored in the section file.
+  GlyphGroupHistogram glyphHistogram;
+  std::vector<GlyphGroupHistogram::Entry> hotGlyphGroups;
+
   void writeSectionFileHeader(int fontId, float lineCompression, bool extraParagraphSpacing, uint8_t paragraphAlignment,
                               uint16_t viewportWidth, uint16_t viewportHeight, bool hyphenationEnabled,
                               bool embeddedStyle, uint8_t imageRendering);
-  uint32_t onPageComplete(std::unique_ptr<Page> page);
+  void onPageComplete(std::unique_ptr<Page> page);
+  bool buildSectionFile(int fontId, float lineCompression, bool extraParagraphSpacing, uint8_t paragraphAlignment,
+                        uint16_t viewportWidth, uint16_t viewportHeight, bool hyphenationEnabled, bool embeddedStyle,
+                        uint8_t imageRendering, const std::function<void()>& popupFn,
+                        const std::atomic<bool>* cancelFlag);
 
  public:
-  uint16_t pageCount = 0;
+  // Pages available so far. Grows while the section is being built, final once isBuilding() is false.
+  std::atomic<uint16_t> pageCount{0};
   int currentPage = 0;
 
   explicit Section(const std::shared_ptr<Epub>& epub, const int spineIndex, GfxRenderer& renderer)
-      : epub(epub),
-        spineIndex(spineIndex),
-        renderer(renderer),
-        filePath(epub->getCachePath() + "/sections/" + std::to_string(spineIndex) + ".bin") {}
-  ~Section() = default;
+      : epub(epub), spineIndex(spineIndex), renderer(renderer) {}
+  ~Section();
+  // Bumped whenever layout changes; files written by another version are rebuilt
+  static uint8_t fileVersion();
+  // Directory under the book's cache holding every section laid out with these parameters. Named after a hash of
+  // the parameters and the file version, so switching settings back and forth finds the earlier files again.
+  static std::string profileDir(const std::string& bookCachePath, int fontId, float lineCompression,
+                                bool extraParagraphSpacing, uint8_t paragraphAlignment, uint16_t viewportWidth,
+                                uint16_t viewportHeight, bool hyphenationEnabled, bool embeddedStyle,
+                                uint8_t imageRendering);
+  int getSpineIndex() const { return spineIndex; }
   bool loadSectionFile(int fontId, float lineCompression, bool extraParagraphSpacing, uint8_t paragraphAlignment,
                        uint16_t viewportWidth, uint16_t viewportHeight, bool hyphenationEnabled, bool embeddedStyle,
                        uint8_t imageRendering);
   bool clearCache() const;
+  // Lays out the chapter into the section file. Safe to run on a background task: every page is flushed and
+  // published as soon as it is serialized, and a set cancelFlag aborts the build and removes the partial file.
   bool createSectionFile(int fontId, float lineCompression, bool extraParagraphSpacing, uint8_t paragraphAlignment,
                          uint16_t viewportWidth, uint16_t viewportHeight, bool hyphenationEnabled, bool embeddedStyle,
-                         uint8_t imageRendering, const std::function<void()>& popupFn = nullptr);
+                         uint8_t imageRendering, const std::function<void()>& popupFn = nullptr,
+                         const std::atomic<bool>* cancelFlag = nullptr);
   std::unique_ptr<Page> loadPageFromSectionFile();
+  // Reads page `index` without touching currentPage. Safe to call from another task than the one rendering.
+  std::unique_ptr<Page> loadPage(int index) const;
+
+  // Build progress, for sections handed to another task. markBuildQueued() makes isBuilding() true before the
+  // build actually starts; markBuildDropped() fails a queued build that will never run.
+  void markBuildQueued() { buildState.store(BuildState::Building); }
+  void markBuildDropped() { buildState.store(BuildState::Failed); }
+  bool isBuilding() const { return buildState.load() == BuildState::Building; }
+  bool buildFailed() const { return buildState.load() == BuildState::Failed; }
+  // Blocks until page `index` exists or the build has ended. Returns false on timeout.
+  bool waitForPage(uint16_t index, uint32_t timeoutMs) const;
+
+  // The font's most used glyph groups in this chapter, most used first. Empty until the section is complete.
+  const std::vector<GlyphGroupHistogram::Entry>& getHotGlyphGroups() const { return hotGlyphGroups; }
 
-  // Look up the page number for an anchor id from the section cache file.
+  // Look up the page number for an anchor id: a binary search over the section file's sorted anchor hash table.
   std::optional<uint16_t> getPageForAnchor(const std::string& anchor) const;
 };
@@ -4,55 +4,81 @@
 #include <Logging.h>
 #include <Serialization.h>
 
-void TextBlock::render(const GfxRenderer& renderer, const int fontId, const int x, const int y) const {
-  // Validate iterator bounds before rendering
-  if (words.size() != wordXpos.size() || words.size() != wordStyles.size()) {
-    LOG_ERR("TXB", "Render skipped: size mismatch (words=%u, xpos=%u, styles=%u)\n", (uint32_t)words.size(),
-            (uint32_t)wordXpos.size(), (uint32_t)wordStyles.size());
-    return;
+#include <cstring>
+#include <limits>
+
+namespace {
+// Computes the underline span for word w drawn at wordX. A leading em-space indent is excluded from the line.
+void underlineSpan(const GfxRenderer& renderer, const int fontId, const char* w, const int wordX,
+                   const EpdFontFamily::Style style, int* startX, int* width) {
+  *startX = wordX;
+  *width = renderer.getTextWidth(fontId, w, style);
+
+  // if word starts with em-space ("\xe2\x80\x83"), account for the additional indent before drawing the line
+  if (std::strncmp(w, "\xe2\x80\x83", 3) == 0) {
+    const char* visiblePtr = w + 3;
+    const int prefixWidth = renderer.getTextAdvanceX(fontId, "\xe2\x80\x83", style);
+    *startX = wordX + prefixWidth;
+    *width = renderer.getTextWidth(fontId, visiblePtr, style);
   }
+}
+}  // namespace
 
-  for (size_t i = 0; i < words.size(); i++) {
-    const int wordX = wordXpos[i] + x;
-    const EpdFontFamily::Style currentStyle = wordStyles[i];
-    renderer.drawText(fontId, wordX, y, words[i].c_str(), true, currentStyle);
-
-    if ((currentStyle & EpdFontFamily::UNDERLINE) != 0) {
-      const std::string& w = words[i];
-      const int fullWordWidth = renderer.getTextWidth(fontId, w.c_str(), currentStyle);
-      // y is the top of the text line; add ascender to reach baseline, then offset 2px below
-      const int underlineY = y + renderer.getFontAscenderSize(fontId) + 2;
+void TextBlock::reserve(const size_t wordCount, const size_t textBytes) {
+  words.reserve(wordCount);
+  text.reserve(textBytes + wordCount);
+}
 
-      int startX = wordX;
-      int underlineWidth = fullWordWidth;
+bool TextBlock::addWord(const std::string_view word, const int16_t xPos, const EpdFontFamily::Style style) {
+  if (text.size() + word.size() + 1 > std::numeric_limits<uint16_t>::max()) {
+    LOG_ERR("TXB", "Line text exceeds %u bytes, dropping word", std::numeric_limits<uint16_t>::max());
+    return false;
+  }
+  words.push_back({static_cast<uint16_t>(text.size()), xPos, style});
+  text.append(word);
+  text.push_back('\0');
+  return true;
+}
 
-      // if word starts with em-space ("\xe2\x80\x83"), account for the additional indent before drawing the line
-      if (w.size() >= 3 && static_cast<uint8_t>(w[0]) == 0xE2 && static_cast<uint8_t>(w[1]) == 0x80 &&
-          static_cast<uint8_t>(w[2]) == 0x83) {
-        const char* visiblePtr = w.c_str() + 3;
-        const int prefixWidth = renderer.getTextAdvanceX(fontId, "\xe2\x80\x83", currentStyle);
-        const int visibleWidth = renderer.getTextWidth(fontId, visiblePtr, currentStyle);
-        startX = wordX + prefixWidth;
-        underlineWidth = visibleWidth;
-      }
+void TextBlock::render(const GfxRenderer& renderer, const int fontId, const int x, const int y) const {
+  for (const auto& word : words) {
+    const int wordX = word.xPos + x;
+    const char* w = text.c_str() + word.offset;
+    renderer.drawText(fontId, wordX, y, w, true, word.style);
 
+    if ((word.style & EpdFontFamily::UNDERLINE) != 0) {
+      // y is the top of the text line; add ascender to reach baseline, then offset 2px below
+      const int underlineY = y + renderer.getFontAscenderSize(fontId) + 2;
+      int startX, underlineWidth;
+      underlineSpan(renderer, fontId, w, wordX, word.style, &startX, &underlineWidth);
       renderer.drawLine(startX, underlineY, startX + underlineWidth, underlineY, true);
     }
   }
 }
 
-bool TextBlock::serialize(FsFile& file) const {
-  if (words.size() != wordXpos.size() || words.size() != wordStyles.size()) {
-    LOG_ERR("TXB", "Serialization failed: size mismatch (words=%u, xpos=%u, styles=%u)\n", words.size(),
-            wordXpos.size(), wordStyles.size());
-    return false;
+void TextBlock::appendToDisplayList(const GfxRenderer& renderer, GlyphDisplayList& list, const int fontId,
+                                    const int x, const int y) const {
+  for (const auto& word : words) {
+    const int wordX = word.xPos + x;
+    const char* w = text.c_str() + word.offset;
+    renderer.appendText(list, fontId, wordX, y, w, true, word.style);
+
+    if ((word.style & EpdFontFamily::UNDERLINE) != 0) {
+      const int underlineY = y + renderer.getFontAscenderSize(fontId) + 2;
+      int startX, underlineWidth;
+      underlineSpan(renderer, fontId, w, wordX, word.style, &startX, &underlineWidth);
+      GfxRenderer::appendLine(list, startX, startX + underlineWidth, underlineY, true);
+    }
   }
+}
 
-  // Word data
+bool TextBlock::serialize(FsFile& file) const {
+  // Word data: the NUL-separated text in one piece, then the per-word arrays. Offsets are implied by the separators.
   serialization::writePod(file, static_cast<uint16_t>(words.size()));
-  for (const auto& w : words) serialization::writeString(file, w);
-  for (auto x : wordXpos) serialization::writePod(file, x);
-  for (auto s : wordStyles) serialization::writePod(file, s);
+  serialization::writePod(file, static_cast<uint16_t>(text.size()));
+  file.write(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+  for (const auto& w : words) serialization::writePod(file, w.xPos);
+  for (const auto& w : words) serialization::writePod(file, w.style);
 
   // Style (alignment + margins/padding/indent)
   serialization::writePod(file, blockStyle.alignment);
@@ -73,13 +99,11 @@ bool TextBlock::serialize(FsFile& file) const {
 
 std::unique_ptr<TextBlock> TextBlock::deserialize(FsFile& file) {
   uint16_t wc;
-  std::vector<std::string> words;
-  std::vector<int16_t> wordXpos;
-  std::vector<EpdFontFamily::Style> wordStyles;
+  uint16_t textSize;
   BlockStyle blockStyle;
 
-  // Word count
   serialization::readPod(file, wc);
+  serialization::readPod(file, textSize);
 
   // Sanity check: prevent allocation of unreasonably large vectors (max 10000 words per block)
   if (wc > 10000) {
@@ -87,13 +111,29 @@ std::unique_ptr<TextBlock> TextBlock::deserialize(FsFile& file) {
     return nullptr;
   }
 
-  // Word data
-  words.resize(wc);
-  wordXpos.resize(wc);
-  wordStyles.resize(wc);
-  for (auto& w : words) serialization::readString(file, w);
-  for (auto& x : wordXpos) serialization::readPod(file, x);
-  for (auto& s : wordStyles) serialization::readPod(file, s);
+  auto block = std::unique_ptr<TextBlock>(new TextBlock());
+  block->text.resize(textSize);
+  if (file.read(reinterpret_cast<uint8_t*>(&block->text[0]), textSize) != textSize) {
+    LOG_ERR("TXB", "Deserialization failed: short read of %u text bytes", textSize);
+    return nullptr;
+  }
+
+  // Rebuild the word offsets from the separators
+  block->words.resize(wc);
+  uint16_t start = 0;
+  size_t found = 0;
+  for (uint16_t i = 0; i < textSize; i++) {
+    if (block->text[i] != '\0') continue;
+    if (found < wc) block->words[found].offset = start;
+    found++;
+    start = i + 1;
+  }
+  if (found != wc || start != textSize) {
+    LOG_ERR("TXB", "Deserialization failed: %u words declared, %u found", wc, static_cast<uint32_t>(found));
+    return nullptr;
+  }
+  for (auto& w : block->words) serialization::readPod(file, w.xPos);
+  for (auto& w : block->words) serialization::readPod(file, w.style);
 
   // Style (alignment + margins/padding/indent)
   serialization::readPod(file, blockStyle.alignment);
@@ -108,7 +148,7 @@ std::unique_ptr<TextBlock> TextBlock::deserialize(FsFile& file) {
   serialization::readPod(file, blockStyle.paddingRight);
   serialization::readPod(file, blockStyle.textIndent);
   serialization::readPod(file, blockStyle.textIndentDefined);
+  block->blockStyle = blockStyle;
 
-  return std::unique_ptr<TextBlock>(
-      new TextBlock(std::move(words), std::move(wordXpos), std::move(wordStyles), blockStyle));
+  return block;
 }
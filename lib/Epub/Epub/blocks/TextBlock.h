@@ -4,34 +4,48 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "Block.h"
 #include "BlockStyle.h"
 
-// Represents a line of text on a page
+class GlyphDisplayList;
+
+// Represents a line of text on a page.
+// All words share one string, each NUL-terminated so it can be drawn in place; per-word data is a small record.
 class TextBlock final : public Block {
+ public:
+  struct Word {
+    uint16_t offset;  // start of the word in text
+    int16_t xPos;
+    EpdFontFamily::Style style;
+  };
+
  private:
-  std::vector<std::string> words;
-  std::vector<int16_t> wordXpos;
-  std::vector<EpdFontFamily::Style> wordStyles;
+  std::string text;
+  std::vector<Word> words;
   BlockStyle blockStyle;
 
  public:
-  explicit TextBlock(std::vector<std::string> words, std::vector<int16_t> word_xpos,
-                     std::vector<EpdFontFamily::Style> word_styles, const BlockStyle& blockStyle = BlockStyle())
-      : words(std::move(words)),
-        wordXpos(std::move(word_xpos)),
-        wordStyles(std::move(word_styles)),
-        blockStyle(blockStyle) {}
+  explicit TextBlock(const BlockStyle& blockStyle = BlockStyle()) : blockStyle(blockStyle) {}
   ~TextBlock() override = default;
+  void reserve(size_t wordCount, size_t textBytes);
+  // Returns false (and drops the word) if the line's text would no longer be addressable by a 16-bit offset.
+  bool addWord(std::string_view word, int16_t xPos, EpdFontFamily::Style style);
   void setBlockStyle(const BlockStyle& blockStyle) { this->blockStyle = blockStyle; }
   const BlockStyle& getBlockStyle() const { return blockStyle; }
-  const std::vector<std::string>& getWords() const { return words; }
+  const char* getWord(const size_t i) const { return text.c_str() + words[i].offset; }
+  int16_t getWordXpos(const size_t i) const { return words[i].xPos; }
+  EpdFontFamily::Style getWordStyle(const size_t i) const { return words[i].style; }
+  // Bytes of word text, excluding terminators.
+  size_t textBytes() const { return text.size() - words.size(); }
   bool isEmpty() override { return words.empty(); }
   size_t wordCount() const { return words.size(); }
   // given a renderer works out where to break the words into lines
   void render(const GfxRenderer& renderer, int fontId, int x, int y) const;
+  // Same output as render(), recorded into a display list for multi-pass replay
+  void appendToDisplayList(const GfxRenderer& renderer, GlyphDisplayList& list, int fontId, int x, int y) const;
   BlockType getType() override { return TEXT_BLOCK; }
   bool serialize(FsFile& file) const;
   static std::unique_ptr<TextBlock> deserialize(FsFile& file);
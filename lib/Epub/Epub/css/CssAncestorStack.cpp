@@ -0,0 +1,50 @@
+#include "CssAncestorStack.h"
+
+uint16_t CssAncestorStack::filterKey(const uint16_t atom, const bool isClass) {
+  const uint32_t h = ((static_cast<uint32_t>(atom) << 1) | (isClass ? 1u : 0u)) * 0x9E3779B1u;
+  return static_cast<uint16_t>(h >> 16);
+}
+
+void CssAncestorStack::addKey(const uint16_t key) {
+  for (const uint8_t slot : {static_cast<uint8_t>(key & 0xFF), static_cast<uint8_t>(key >> 8)}) {
+    if (counts[slot] < UINT8_MAX) counts[slot]++;
+  }
+}
+
+void CssAncestorStack::removeKey(const uint16_t key) {
+  for (const uint8_t slot : {static_cast<uint8_t>(key & 0xFF), static_cast<uint8_t>(key >> 8)}) {
+    if (counts[slot] > 0 && counts[slot] < UINT8_MAX) counts[slot]--;
+  }
+}
+
+void CssAncestorStack::push(const int depth, const uint16_t tag, const uint16_t* classAtoms,
+                            const uint8_t classCount) {
+  if (entries.size() >= MAX_DEPTH) {
+    return;
+  }
+
+  entries.push_back({depth, tag, static_cast<uint16_t>(classPool.size()), classCount});
+  classPool.insert(classPool.end(), classAtoms, classAtoms + classCount);
+  if (tag != NO_ATOM) addKey(filterKey(tag, false));
+  for (uint8_t i = 0; i < classCount; ++i) {
+    addKey(filterKey(classAtoms[i], true));
+  }
+}
+
+void CssAncestorStack::popTo(const int depth) {
+  while (!entries.empty() && entries.back().depth >= depth) {
+    const Entry& entry = entries.back();
+    if (entry.tag != NO_ATOM) removeKey(filterKey(entry.tag, false));
+    for (uint8_t i = 0; i < entry.classCount; ++i) {
+      removeKey(filterKey(classPool[entry.classStart + i], true));
+    }
+    classPool.resize(entry.classStart);
+    entries.pop_back();
+  }
+}
+
+void CssAncestorStack::clear() {
+  entries.clear();
+  classPool.clear();
+  for (auto& count : counts) count = 0;
+}
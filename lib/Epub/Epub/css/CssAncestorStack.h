@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Open elements above the one being styled, for matching descendant (`div p`) and child (`div > p`) selectors.
+ *
+ * Entries hold the CssParser atoms of each element's tag and styled classes together with its document depth, so a
+ * child combinator can tell the parent from an ancestor further up. A counting Bloom filter over the same atoms lets
+ * the parser drop a selector whose ancestors cannot all be present without walking the stack.
+ *
+ * Filled by CssParser::resolveStyle() as elements start; the HTML parser pops it as they end.
+ */
+class CssAncestorStack {
+ public:
+  // Elements nested deeper than this are not tracked; selectors then only see their outer ancestors
+  static constexpr uint8_t MAX_DEPTH = 64;
+  static constexpr uint16_t NO_ATOM = 0xFFFF;
+
+  struct Entry {
+    int depth;
+    uint16_t tag;
+    uint16_t classStart;  // into classes()
+    uint8_t classCount;
+  };
+
+  // Both filter slots of a tag or class atom packed into 16 bits; precomputed per selector by CssParser
+  static uint16_t filterKey(uint16_t atom, bool isClass);
+
+  void push(int depth, uint16_t tag, const uint16_t* classAtoms, uint8_t classCount);
+  // Removes every entry at `depth` or deeper
+  void popTo(int depth);
+  void clear();
+
+  // False if no open element carries the atom behind key; true may be a false positive
+  bool mayContain(const uint16_t key) const { return counts[key & 0xFF] != 0 && counts[key >> 8] != 0; }
+
+  size_t size() const { return entries.size(); }
+  const Entry& at(const size_t index) const { return entries[index]; }
+  const uint16_t* classes(const Entry& entry) const { return classPool.data() + entry.classStart; }
+
+ private:
+  std::vector<Entry> entries;
+  std::vector<uint16_t> classPool;
+  // Saturated counters stay at 255 so they are never decremented below a live element's contribution
+  uint8_t counts[256] = {};
+
+  void addKey(uint16_t key);
+  void removeKey(uint16_t key);
+};
@@ -6,7 +6,9 @@
 #include <algorithm>
 #include <array>
 #include <cctype>
+#include <cstring>
 #include <string_view>
+#include <type_traits>
 
 namespace {
 
@@ -75,6 +77,56 @@ std::string_view stripTrailingImportant(std::string_view value) {
   return value;
 }
 
+// Below MIN_FREE_HEAP_FOR_CSS styles are skipped entirely; warns once
+bool heapAllowsCss() {
+  static bool lowHeapWarningLogged = false;
+  if (ESP.getFreeHeap() >= MIN_FREE_HEAP_FOR_CSS) {
+    return true;
+  }
+  if (!lowHeapWarningLogged) {
+    lowHeapWarningLogged = true;
+    LOG_DBG("CSS", "Warning: low heap (%u bytes) below MIN_FREE_HEAP_FOR_CSS (%u), returning empty style",
+            ESP.getFreeHeap(), static_cast<unsigned>(MIN_FREE_HEAP_FOR_CSS));
+  }
+  return false;
+}
+
+// Lowercases s into buf without allocating. Returns an empty view if it does not fit.
+std::string_view lowercaseInto(const std::string_view s, char* buf, const size_t capacity) {
+  if (s.size() > capacity) {
+    return {};
+  }
+  for (size_t i = 0; i < s.size(); ++i) {
+    buf[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(s[i])));
+  }
+  return {buf, s.size()};
+}
+
+// Splits a compound into `tag`, `.class` or `tag.class`. Compound classes (`.a.b`) are rejected: they can never
+// match a single class lookup.
+bool splitCompound(const std::string_view compound, std::string_view& tagName, std::string_view& className) {
+  const size_t dotPos = compound.find('.');
+  tagName = compound.substr(0, dotPos);
+  className = dotPos == std::string_view::npos ? std::string_view{} : compound.substr(dotPos + 1);
+  if (dotPos != std::string_view::npos && className.empty()) return false;
+  if (className.find('.') != std::string_view::npos) return false;
+  return !tagName.empty() || !className.empty();
+}
+
+// FNV-1a over 16-bit atoms, picks the memo slot of a (tag, class set) combination
+uint32_t hashAtoms(const uint16_t tagAtom, const uint16_t* classAtoms, const uint8_t classCount) {
+  uint32_t hash = 2166136261u;
+  auto mix = [&hash](const uint16_t atom) {
+    hash = (hash ^ (atom & 0xFF)) * 16777619u;
+    hash = (hash ^ (atom >> 8)) * 16777619u;
+  };
+  mix(tagAtom);
+  for (uint8_t i = 0; i < classCount; ++i) {
+    mix(classAtoms[i]);
+  }
+  return hash;
+}
+
 }  // anonymous namespace
 
 CssParser::CssParser(const std::string& cacheDir) : cacheDir_(cacheDir) {}
@@ -375,7 +427,7 @@ CssStyle CssParser::parseDeclarations(const std::string& declBlock) {
 
 void CssParser::processRuleBlockWithStyle(const std::string& selectorGroup, const CssStyle& style) {
   // Check if we've reached the rule limit before processing
-  if (rulesBySelector_.size() >= MAX_RULES) {
+  if (ruleCount() >= MAX_RULES) {
     LOG_DBG("CSS", "Reached max rules limit (%zu), stopping CSS parsing", MAX_RULES);
     return;
   }
@@ -400,12 +452,6 @@ void CssParser::processRuleBlockWithStyle(const std::string& selectorGroup, cons
       continue;
     }
 
-    // TODO: Consider adding support for direct nested css selectors in the future
-    // Ensure no > in selector as we don't support nested CSS selectors for now
-    if (key.find('>') != std::string_view::npos) {
-      continue;
-    }
-
     // TODO: Consider adding support for attribute css selectors in the future
     // Ensure no [ in selector as we don't support attribute CSS selectors for now
     if (key.find('[') != std::string_view::npos) {
@@ -436,28 +482,199 @@ void CssParser::processRuleBlockWithStyle(const std::string& selectorGroup, cons
       continue;
     }
 
-    // TODO: Add support for more complex selectors in the future
-    // At the moment, we only ever check for `tag`, `tag.class1` or `.class1`
-    // If the selector has whitespace in it, then it's either a CSS selector for a descendant element (e.g. `tag1 tag2`)
-    // or some other slightly more advanced CSS selector which we don't support yet
-    if (key.find(' ') != std::string_view::npos) {
-      continue;
-    }
-
     // Skip if this would exceed the rule limit
-    if (rulesBySelector_.size() >= MAX_RULES) {
+    if (ruleCount() >= MAX_RULES) {
       LOG_DBG("CSS", "Reached max rules limit, stopping selector processing");
       return;
     }
 
+    // Whitespace or `>` means a descendant or child selector (e.g. `div.chapter > p`)
+    if (key.find_first_of(" >") != std::string::npos) {
+      addComplexRule(key, style);
+      continue;
+    }
+
+    uint16_t tagAtom;
+    uint16_t classAtom;
+    if (!parseCompound(key, tagAtom, classAtom)) {
+      continue;
+    }
+
     // Store or merge with existing
-    auto it = rulesBySelector_.find(key);
-    if (it != rulesBySelector_.end()) {
-      it->second.applyOver(style);
-    } else {
-      rulesBySelector_[key] = style;
+    addRule(ruleKey(tagAtom, classAtom), style);
+  }
+}
+
+bool CssParser::parseCompound(const std::string_view compound, uint16_t& tagAtom, uint16_t& classAtom) {
+  std::string_view tagName;
+  std::string_view className;
+  if (!splitCompound(compound, tagName, className)) {
+    return false;
+  }
+  tagAtom = tagName.empty() ? NO_ATOM : internAtom(tagName);
+  classAtom = className.empty() ? NO_ATOM : internAtom(className);
+  return (tagName.empty() || tagAtom != NO_ATOM) && (className.empty() || classAtom != NO_ATOM);
+}
+
+bool CssParser::addComplexRule(const std::string_view selector, const CssStyle& style) {
+  // Split into compounds; combinators[i] relates compounds[i] to compounds[i + 1]
+  std::string_view compounds[MAX_SELECTOR_PARTS];
+  uint8_t combinators[MAX_SELECTOR_PARTS] = {};
+  uint8_t count = 0;
+  bool pendingChild = false;
+  size_t pos = 0;
+  while (pos < selector.size()) {
+    if (selector[pos] == ' ') {
+      ++pos;
+      continue;
+    }
+    if (selector[pos] == '>') {
+      if (count == 0 || pendingChild) return false;
+      pendingChild = true;
+      ++pos;
+      continue;
+    }
+    const size_t start = pos;
+    while (pos < selector.size() && selector[pos] != ' ' && selector[pos] != '>') ++pos;
+    if (count == MAX_SELECTOR_PARTS) {
+      LOG_DBG("CSS", "Selector has more than %u compounds, skipping", MAX_SELECTOR_PARTS);
+      return false;
+    }
+    if (count > 0) combinators[count - 1] = pendingChild ? CHILD : DESCENDANT;
+    pendingChild = false;
+    compounds[count++] = selector.substr(start, pos - start);
+  }
+  if (count < 2 || pendingChild) {
+    return false;
+  }
+
+  // Validate every compound before interning anything
+  std::string_view tagNames[MAX_SELECTOR_PARTS];
+  std::string_view classNames[MAX_SELECTOR_PARTS];
+  for (uint8_t i = 0; i < count; ++i) {
+    if (!splitCompound(compounds[i], tagNames[i], classNames[i])) return false;
+  }
+
+  uint16_t tagAtoms[MAX_SELECTOR_PARTS];
+  uint16_t classAtoms[MAX_SELECTOR_PARTS];
+  for (uint8_t i = 0; i < count; ++i) {
+    if (!parseCompound(compounds[i], tagAtoms[i], classAtoms[i])) return false;
+  }
+
+  ComplexRule rule{};
+  rule.subjectKey = ruleKey(tagAtoms[count - 1], classAtoms[count - 1]);
+  rule.firstPart = static_cast<uint16_t>(selectorParts_.size());
+  rule.partCount = count - 1;
+  rule.order = takeOrder();
+  rule.style = style;
+  for (uint8_t i = 0; i < count; ++i) {
+    rule.specificity += (classAtoms[i] != NO_ATOM ? 0x100 : 0) + (tagAtoms[i] != NO_ATOM ? 1 : 0);
+  }
+  // Filter keys from the nearest ancestor outwards, classes first as they are the more selective
+  for (int i = count - 2; i >= 0; --i) {
+    if (classAtoms[i] != NO_ATOM && rule.filterKeyCount < MAX_FILTER_KEYS) {
+      rule.filterKeys[rule.filterKeyCount++] = CssAncestorStack::filterKey(classAtoms[i], true);
     }
+    if (tagAtoms[i] != NO_ATOM && rule.filterKeyCount < MAX_FILTER_KEYS) {
+      rule.filterKeys[rule.filterKeyCount++] = CssAncestorStack::filterKey(tagAtoms[i], false);
+    }
+  }
+
+  for (uint8_t i = 0; i + 1 < count; ++i) {
+    selectorParts_.push_back({tagAtoms[i], classAtoms[i], combinators[i]});
+  }
+  complexRules_.push_back(rule);
+  return true;
+}
+
+// Atom and rule tables
+
+std::string_view CssParser::atomName(const uint16_t atom) const {
+  const uint32_t start = atomOffsets_[atom];
+  const uint32_t end = atom + 1u < atomOffsets_.size() ? atomOffsets_[atom + 1] - 1 : atomText_.size() - 1;
+  return {atomText_.data() + start, end - start};
+}
+
+uint16_t CssParser::findAtom(const std::string_view name) const {
+  const auto it =
+      std::lower_bound(atomsByName_.begin(), atomsByName_.end(), name,
+                       [this](const uint16_t atom, const std::string_view n) { return atomName(atom) < n; });
+  return it != atomsByName_.end() && atomName(*it) == name ? *it : NO_ATOM;
+}
+
+uint16_t CssParser::internAtom(const std::string_view name) {
+  const auto it =
+      std::lower_bound(atomsByName_.begin(), atomsByName_.end(), name,
+                       [this](const uint16_t atom, const std::string_view n) { return atomName(atom) < n; });
+  if (it != atomsByName_.end() && atomName(*it) == name) {
+    return *it;
   }
+  if (atomOffsets_.size() >= NO_ATOM) {
+    return NO_ATOM;
+  }
+
+  const auto atom = static_cast<uint16_t>(atomOffsets_.size());
+  atomOffsets_.push_back(static_cast<uint32_t>(atomText_.size()));
+  atomText_.append(name.data(), name.size());
+  atomText_.push_back('\0');
+  atomsByName_.insert(it, atom);
+  return atom;
+}
+
+const CssParser::Rule* CssParser::findRuleEntry(const uint32_t key) const {
+  const auto it = std::lower_bound(rules_.begin(), rules_.end(), key,
+                                   [](const Rule& rule, const uint32_t k) { return rule.key < k; });
+  return it != rules_.end() && it->key == key ? &*it : nullptr;
+}
+
+const CssStyle* CssParser::findRule(const uint32_t key) const {
+  const Rule* rule = findRuleEntry(key);
+  return rule ? &rule->style : nullptr;
+}
+
+uint16_t CssParser::takeOrder() { return nextOrder_ < UINT16_MAX ? nextOrder_++ : nextOrder_; }
+
+void CssParser::addRule(const uint32_t key, const CssStyle& style) {
+  const auto it = std::lower_bound(pendingOrder_.begin(), pendingOrder_.end(), key,
+                                   [this](const uint16_t index, const uint32_t k) { return rules_[index].key < k; });
+  // A repeated selector is merged into one rule, which then sorts at its last occurrence
+  if (it != pendingOrder_.end() && rules_[*it].key == key) {
+    rules_[*it].style.applyOver(style);
+    rules_[*it].order = takeOrder();
+    return;
+  }
+  pendingOrder_.insert(it, static_cast<uint16_t>(rules_.size()));
+  rules_.push_back({key, takeOrder(), style});
+}
+
+void CssParser::compileRules() {
+  // Keys are unique, so sorting in place needs no extra copy of the table
+  std::sort(rules_.begin(), rules_.end(), [](const Rule& a, const Rule& b) { return a.key < b.key; });
+  std::vector<uint16_t>().swap(pendingOrder_);
+  rules_.shrink_to_fit();
+  std::stable_sort(complexRules_.begin(), complexRules_.end(),
+                   [](const ComplexRule& a, const ComplexRule& b) { return a.subjectKey < b.subjectKey; });
+  complexRules_.shrink_to_fit();
+  selectorParts_.shrink_to_fit();
+  resetMemo();
+}
+
+void CssParser::resetMemo() const {
+  for (auto& entry : memo_) {
+    entry.used = false;
+  }
+}
+
+void CssParser::clear() {
+  std::vector<Rule>().swap(rules_);
+  std::vector<uint16_t>().swap(pendingOrder_);
+  std::string().swap(atomText_);
+  std::vector<uint32_t>().swap(atomOffsets_);
+  std::vector<uint16_t>().swap(atomsByName_);
+  std::vector<ComplexRule>().swap(complexRules_);
+  std::vector<SelectorPart>().swap(selectorParts_);
+  nextOrder_ = 1;
+  resetMemo();
 }
 
 // Main parsing entry point
@@ -470,6 +687,12 @@ bool CssParser::loadFromStream(FsFile& source) {
 
   size_t totalRead = 0;
 
+  // Rules from earlier stylesheets are already sorted; new ones are merged through pendingOrder_
+  pendingOrder_.resize(rules_.size());
+  for (size_t i = 0; i < rules_.size(); ++i) {
+    pendingOrder_[i] = static_cast<uint16_t>(i);
+  }
+
   // Use stack-allocated buffers for parsing to avoid heap reallocations
   StackBuffer selector;
   StackBuffer declBuffer;
@@ -604,58 +827,236 @@ bool CssParser::loadFromStream(FsFile& source) {
     handleChar('/');
   }
 
-  LOG_DBG("CSS", "Parsed %zu rules from %zu bytes", rulesBySelector_.size(), totalRead);
+  compileRules();
+  LOG_DBG("CSS", "Parsed %zu rules (%zu descendant/child, %zu names) from %zu bytes", ruleCount(),
+          complexRules_.size(), atomOffsets_.size(), totalRead);
   return true;
 }
 
 // Style resolution
 
 CssStyle CssParser::resolveStyle(const std::string& tagName, const std::string& classAttr) const {
-  static bool lowHeapWarningLogged = false;
-  if (ESP.getFreeHeap() < MIN_FREE_HEAP_FOR_CSS) {
-    if (!lowHeapWarningLogged) {
-      lowHeapWarningLogged = true;
-      LOG_DBG("CSS", "Warning: low heap (%u bytes) below MIN_FREE_HEAP_FOR_CSS (%u), returning empty style",
-              ESP.getFreeHeap(), static_cast<unsigned>(MIN_FREE_HEAP_FOR_CSS));
+  if (!heapAllowsCss() || empty()) {
+    return CssStyle{};
+  }
+
+  const uint32_t startUs = micros();
+  ElementAtoms element;
+  collectElementAtoms(tagName, classAttr, element);
+  CssStyle result = resolveElement(element, nullptr, 0);
+  stats_.resolves++;
+  stats_.resolveTimeUs += micros() - startUs;
+  return result;
+}
+
+CssStyle CssParser::resolveStyle(const std::string& tagName, const std::string& classAttr,
+                                 CssAncestorStack& ancestors, const int depth) const {
+  ancestors.popTo(depth);
+  if (!heapAllowsCss() || empty()) {
+    return CssStyle{};
+  }
+
+  const uint32_t startUs = micros();
+  ElementAtoms element;
+  collectElementAtoms(tagName, classAttr, element);
+  CssStyle result = resolveElement(element, &ancestors, depth);
+  ancestors.push(depth, element.tag, element.classes, element.classCount);
+  stats_.resolves++;
+  stats_.resolveTimeUs += micros() - startUs;
+  return result;
+}
+
+void CssParser::collectElementAtoms(const std::string& tagName, const std::string& classAttr,
+                                    ElementAtoms& out) const {
+  char nameBuf[MAX_SELECTOR_LENGTH];
+  out.tag = findAtom(lowercaseInto(tagName, nameBuf, sizeof(nameBuf)));
+
+  // Classes no rule mentions cannot contribute, so they are left out of the set
+  out.classCount = 0;
+  const std::string_view classes = classAttr;
+  size_t pos = 0;
+  while (pos < classes.size()) {
+    while (pos < classes.size() && isCssWhitespace(classes[pos])) ++pos;
+    const size_t start = pos;
+    while (pos < classes.size() && !isCssWhitespace(classes[pos])) ++pos;
+    if (pos == start) break;
+
+    const uint16_t classAtom = findAtom(lowercaseInto(classes.substr(start, pos - start), nameBuf, sizeof(nameBuf)));
+    if (classAtom == NO_ATOM) continue;
+    if (out.classCount == MAX_ELEMENT_CLASSES) {
+      LOG_DBG("CSS", "More than %u styled classes on <%s>, ignoring the rest", MAX_ELEMENT_CLASSES, tagName.c_str());
+      break;
     }
+    out.classes[out.classCount++] = classAtom;
+  }
+}
+
+CssStyle CssParser::resolveElement(const ElementAtoms& element, const CssAncestorStack* ancestors,
+                                   const int depth) const {
+  const uint16_t tagAtom = element.tag;
+  const uint16_t* classAtoms = element.classes;
+  const uint8_t classCount = element.classCount;
+  if (tagAtom == NO_ATOM && classCount == 0) {
     return CssStyle{};
   }
-  CssStyle result;
-  const std::string tag = normalized(tagName);
 
-  // 1. Apply element-level style (lowest priority)
-  const auto tagIt = rulesBySelector_.find(tag);
-  if (tagIt != rulesBySelector_.end()) {
-    result.applyOver(tagIt->second);
+  // Once a descendant/child rule matches, every matching rule is applied in specificity order, equal specificity in
+  // stylesheet order.
+  if (ancestors && !complexRules_.empty()) {
+    MatchedRule matched[MAX_MATCHED_RULES];
+    uint8_t matchedCount = 0;
+    collectComplexMatches(element, *ancestors, depth, matched, matchedCount);
+    if (matchedCount > 0) {
+      auto addSimple = [&](const uint32_t key, const uint16_t specificity) {
+        const Rule* rule = findRuleEntry(key);
+        if (rule && matchedCount < MAX_MATCHED_RULES) {
+          matched[matchedCount++] = {specificity, rule->order, &rule->style};
+        }
+      };
+      if (tagAtom != NO_ATOM) addSimple(ruleKey(tagAtom, NO_ATOM), 1);
+      for (uint8_t i = 0; i < classCount; ++i) addSimple(ruleKey(NO_ATOM, classAtoms[i]), 0x100);
+      if (tagAtom != NO_ATOM) {
+        for (uint8_t i = 0; i < classCount; ++i) addSimple(ruleKey(tagAtom, classAtoms[i]), 0x101);
+      }
+      std::stable_sort(matched, matched + matchedCount, [](const MatchedRule& a, const MatchedRule& b) {
+        return a.specificity != b.specificity ? a.specificity < b.specificity : a.order < b.order;
+      });
+
+      CssStyle result;
+      for (uint8_t i = 0; i < matchedCount; ++i) {
+        result.applyOver(*matched[i].style);
+      }
+      return result;
+    }
   }
 
-  // TODO: Support combinations of classes (e.g. style on .class1.class2)
-  // 2. Apply class styles (medium priority)
-  if (!classAttr.empty()) {
-    const auto classes = splitWhitespace(classAttr);
+  if (classCount > MEMO_MAX_CLASSES) {
+    CssStyle result;
+    applyRules(tagAtom, classAtoms, classCount, result);
+    return result;
+  }
+
+  MemoEntry& entry = memo_[hashAtoms(tagAtom, classAtoms, classCount) % MEMO_SLOTS];
+  if (entry.used && entry.tag == tagAtom && entry.classCount == classCount &&
+      std::equal(classAtoms, classAtoms + classCount, entry.classes)) {
+    stats_.memoHits++;
+    return entry.style;
+  }
+
+  entry.style = CssStyle{};
+  applyRules(tagAtom, classAtoms, classCount, entry.style);
+  entry.used = true;
+  entry.tag = tagAtom;
+  entry.classCount = classCount;
+  std::copy(classAtoms, classAtoms + classCount, entry.classes);
+  return entry.style;
+}
 
-    for (const auto& cls : classes) {
-      std::string classKey = "." + normalized(cls);
+void CssParser::collectComplexMatches(const ElementAtoms& element, const CssAncestorStack& ancestors, const int depth,
+                                      MatchedRule* matched, uint8_t& matchedCount) const {
+  if (ancestors.size() == 0) {
+    return;
+  }
+
+  auto matchSubject = [&](const uint32_t key) {
+    auto it = std::lower_bound(complexRules_.begin(), complexRules_.end(), key,
+                               [](const ComplexRule& rule, const uint32_t k) { return rule.subjectKey < k; });
+    for (; it != complexRules_.end() && it->subjectKey == key; ++it) {
+      const ComplexRule& rule = *it;
+      stats_.contextCandidates++;
 
-      auto classIt = rulesBySelector_.find(classKey);
-      if (classIt != rulesBySelector_.end()) {
-        result.applyOver(classIt->second);
+      bool possible = true;
+      for (uint8_t k = 0; k < rule.filterKeyCount && possible; ++k) {
+        possible = ancestors.mayContain(rule.filterKeys[k]);
       }
+      if (!possible) {
+        stats_.filterRejects++;
+        continue;
+      }
+
+      uint16_t budget = MATCH_BUDGET;
+      if (!matchAncestors(rule, rule.partCount - 1, static_cast<int>(ancestors.size()) - 1, depth, ancestors,
+                          budget)) {
+        continue;
+      }
+      stats_.contextMatches++;
+      if (matchedCount == MAX_MATCHED_RULES) {
+        continue;
+      }
+      matched[matchedCount++] = {rule.specificity, rule.order, &rule.style};
     }
+  };
 
-    // TODO: Support combinations of classes (e.g. style on p.class1.class2)
-    // 3. Apply element.class styles (higher priority)
-    for (const auto& cls : classes) {
-      std::string combinedKey = tag + "." + normalized(cls);
+  if (element.tag != NO_ATOM) matchSubject(ruleKey(element.tag, NO_ATOM));
+  for (uint8_t i = 0; i < element.classCount; ++i) {
+    matchSubject(ruleKey(NO_ATOM, element.classes[i]));
+    if (element.tag != NO_ATOM) matchSubject(ruleKey(element.tag, element.classes[i]));
+  }
+}
 
-      auto combinedIt = rulesBySelector_.find(combinedKey);
-      if (combinedIt != rulesBySelector_.end()) {
-        result.applyOver(combinedIt->second);
+bool CssParser::matchAncestors(const ComplexRule& rule, const int part, const int stackIndex, const int childDepth,
+                               const CssAncestorStack& ancestors, uint16_t& budget) const {
+  const SelectorPart& selectorPart = selectorParts_[rule.firstPart + part];
+  for (int i = stackIndex; i >= 0; --i) {
+    if (budget == 0) return false;
+    --budget;
+
+    const CssAncestorStack::Entry& entry = ancestors.at(i);
+    // Entries get shallower going down the stack, so only the top one can be the parent
+    if (selectorPart.combinator == CHILD && entry.depth != childDepth - 1) return false;
+
+    bool matches = selectorPart.tag == NO_ATOM || entry.tag == selectorPart.tag;
+    if (matches && selectorPart.cls != NO_ATOM) {
+      const uint16_t* classes = ancestors.classes(entry);
+      matches = std::find(classes, classes + entry.classCount, selectorPart.cls) != classes + entry.classCount;
+    }
+    if (matches && (part == 0 || matchAncestors(rule, part - 1, i - 1, entry.depth, ancestors, budget))) {
+      return true;
+    }
+    if (selectorPart.combinator == CHILD) return false;
+  }
+  return false;
+}
+
+void CssParser::applyRules(const uint16_t tagAtom, const uint16_t* classAtoms, const uint8_t classCount,
+                           CssStyle& out) const {
+  // 1. Apply element-level style (lowest priority)
+  if (tagAtom != NO_ATOM) {
+    if (const CssStyle* style = findRule(ruleKey(tagAtom, NO_ATOM))) {
+      out.applyOver(*style);
+    }
+  }
+
+  // TODO: Support combinations of classes (e.g. style on .class1.class2)
+  // 2. Apply class styles (medium priority)
+  for (uint8_t i = 0; i < classCount; ++i) {
+    if (const CssStyle* style = findRule(ruleKey(NO_ATOM, classAtoms[i]))) {
+      out.applyOver(*style);
+    }
+  }
+
+  // TODO: Support combinations of classes (e.g. style on p.class1.class2)
+  // 3. Apply element.class styles (higher priority)
+  if (tagAtom != NO_ATOM) {
+    for (uint8_t i = 0; i < classCount; ++i) {
+      if (const CssStyle* style = findRule(ruleKey(tagAtom, classAtoms[i]))) {
+        out.applyOver(*style);
       }
     }
   }
+}
 
-  return result;
+void CssParser::logStats(const char* label) const {
+  if (stats_.resolves == 0) {
+    return;
+  }
+  LOG_DBG("CSS", "[%s] resolved %lu elements in %luus (%luus avg), memo hits=%lu", label, stats_.resolves,
+          stats_.resolveTimeUs, stats_.resolveTimeUs / stats_.resolves, stats_.memoHits);
+  if (stats_.contextCandidates > 0) {
+    LOG_DBG("CSS", "[%s] descendant/child candidates=%lu filtered=%lu matched=%lu", label, stats_.contextCandidates,
+            stats_.filterRejects, stats_.contextMatches);
+  }
+  resetStats();
 }
 
 // Inline style parsing (static - doesn't need rule database)
@@ -680,68 +1081,30 @@ bool CssParser::saveToCache(FsFile& file) const {
     return false;
   }
 
-  // Write version
+  // Header: version, record sizes (guard against a CssStyle layout change without a version bump), table sizes
+  const auto recordSize = static_cast<uint16_t>(sizeof(Rule));
+  const auto complexRecordSize = static_cast<uint16_t>(sizeof(ComplexRule));
+  const auto atomCount = static_cast<uint16_t>(atomOffsets_.size());
+  const auto atomTextSize = static_cast<uint32_t>(atomText_.size());
+  const auto ruleCount = static_cast<uint16_t>(rules_.size());
+  const auto complexCount = static_cast<uint16_t>(complexRules_.size());
+  const auto partCount = static_cast<uint16_t>(selectorParts_.size());
   file.write(CssParser::CSS_CACHE_VERSION);
-
-  // Write rule count
-  const auto ruleCount = static_cast<uint16_t>(rulesBySelector_.size());
+  file.write(reinterpret_cast<const uint8_t*>(&recordSize), sizeof(recordSize));
+  file.write(reinterpret_cast<const uint8_t*>(&complexRecordSize), sizeof(complexRecordSize));
+  file.write(reinterpret_cast<const uint8_t*>(&atomCount), sizeof(atomCount));
+  file.write(reinterpret_cast<const uint8_t*>(&atomTextSize), sizeof(atomTextSize));
   file.write(reinterpret_cast<const uint8_t*>(&ruleCount), sizeof(ruleCount));
+  file.write(reinterpret_cast<const uint8_t*>(&complexCount), sizeof(complexCount));
+  file.write(reinterpret_cast<const uint8_t*>(&partCount), sizeof(partCount));
+
+  // Interned names (NUL-separated, in atom order), then the compiled tables as they sit in memory
+  file.write(reinterpret_cast<const uint8_t*>(atomText_.data()), atomTextSize);
+  file.write(reinterpret_cast<const uint8_t*>(rules_.data()), rules_.size() * sizeof(Rule));
+  file.write(reinterpret_cast<const uint8_t*>(complexRules_.data()), complexRules_.size() * sizeof(ComplexRule));
+  file.write(reinterpret_cast<const uint8_t*>(selectorParts_.data()), selectorParts_.size() * sizeof(SelectorPart));
 
-  // Write each rule: selector string + CssStyle fields
-  for (const auto& pair : rulesBySelector_) {
-    // Write selector string (length-prefixed)
-    const auto selectorLen = static_cast<uint16_t>(pair.first.size());
-    file.write(reinterpret_cast<const uint8_t*>(&selectorLen), sizeof(selectorLen));
-    file.write(reinterpret_cast<const uint8_t*>(pair.first.data()), selectorLen);
-
-    // Write CssStyle fields (all are POD types)
-    const CssStyle& style = pair.second;
-    file.write(static_cast<uint8_t>(style.textAlign));
-    file.write(static_cast<uint8_t>(style.fontStyle));
-    file.write(static_cast<uint8_t>(style.fontWeight));
-    file.write(static_cast<uint8_t>(style.textDecoration));
-
-    // Write CssLength fields (value + unit)
-    auto writeLength = [&file](const CssLength& len) {
-      file.write(reinterpret_cast<const uint8_t*>(&len.value), sizeof(len.value));
-      file.write(static_cast<uint8_t>(len.unit));
-    };
-
-    writeLength(style.textIndent);
-    writeLength(style.marginTop);
-    writeLength(style.marginBottom);
-    writeLength(style.marginLeft);
-    writeLength(style.marginRight);
-    writeLength(style.paddingTop);
-    writeLength(style.paddingBottom);
-    writeLength(style.paddingLeft);
-    writeLength(style.paddingRight);
-    writeLength(style.imageHeight);
-    writeLength(style.imageWidth);
-    file.write(static_cast<uint8_t>(style.display));
-
-    // Write defined flags as uint16_t
-    uint16_t definedBits = 0;
-    if (style.defined.textAlign) definedBits |= 1 << 0;
-    if (style.defined.fontStyle) definedBits |= 1 << 1;
-    if (style.defined.fontWeight) definedBits |= 1 << 2;
-    if (style.defined.textDecoration) definedBits |= 1 << 3;
-    if (style.defined.textIndent) definedBits |= 1 << 4;
-    if (style.defined.marginTop) definedBits |= 1 << 5;
-    if (style.defined.marginBottom) definedBits |= 1 << 6;
-    if (style.defined.marginLeft) definedBits |= 1 << 7;
-    if (style.defined.marginRight) definedBits |= 1 << 8;
-    if (style.defined.paddingTop) definedBits |= 1 << 9;
-    if (style.defined.paddingBottom) definedBits |= 1 << 10;
-    if (style.defined.paddingLeft) definedBits |= 1 << 11;
-    if (style.defined.paddingRight) definedBits |= 1 << 12;
-    if (style.defined.imageHeight) definedBits |= 1 << 13;
-    if (style.defined.imageWidth) definedBits |= 1 << 14;
-    if (style.defined.display) definedBits |= 1 << 15;
-    file.write(reinterpret_cast<const uint8_t*>(&definedBits), sizeof(definedBits));
-  }
-
-  LOG_DBG("CSS", "Saved %u rules to cache", ruleCount);
+  LOG_DBG("CSS", "Saved %u rules (%u descendant/child) to cache", ruleCount + complexCount, complexCount);
   return true;
 }
 
@@ -761,6 +1124,8 @@ bool CssParser::saveToCache() const {
 }
 
 bool CssParser::loadFromCache(FsFile& file) {
+  static_assert(std::is_trivially_copyable_v<CssStyle>, "compiled CSS rules are cached as raw bytes");
+
   if (!file) {
     return false;
   }
@@ -775,143 +1140,105 @@ bool CssParser::loadFromCache(FsFile& file) {
     return false;
   }
 
-  // Read rule count
+  uint16_t recordSize = 0;
+  uint16_t complexRecordSize = 0;
+  uint16_t atomCount = 0;
+  uint32_t atomTextSize = 0;
   uint16_t ruleCount = 0;
-  if (file.read(&ruleCount, sizeof(ruleCount)) != sizeof(ruleCount)) {
+  uint16_t complexCount = 0;
+  uint16_t partCount = 0;
+  if (file.read(&recordSize, sizeof(recordSize)) != sizeof(recordSize) ||
+      file.read(&complexRecordSize, sizeof(complexRecordSize)) != sizeof(complexRecordSize) ||
+      file.read(&atomCount, sizeof(atomCount)) != sizeof(atomCount) ||
+      file.read(&atomTextSize, sizeof(atomTextSize)) != sizeof(atomTextSize) ||
+      file.read(&ruleCount, sizeof(ruleCount)) != sizeof(ruleCount) ||
+      file.read(&complexCount, sizeof(complexCount)) != sizeof(complexCount) ||
+      file.read(&partCount, sizeof(partCount)) != sizeof(partCount)) {
     return false;
   }
 
-  if (ruleCount > MAX_RULES) {
-    LOG_DBG("CSS", "Invalid cache rule count (%u > %zu)", ruleCount, MAX_RULES);
-    rulesBySelector_.clear();
+  const size_t rulesBytes = static_cast<size_t>(ruleCount) * sizeof(Rule);
+  const size_t complexBytes = static_cast<size_t>(complexCount) * sizeof(ComplexRule);
+  const size_t partsBytes = static_cast<size_t>(partCount) * sizeof(SelectorPart);
+  if (recordSize != sizeof(Rule) || complexRecordSize != sizeof(ComplexRule) ||
+      ruleCount + complexCount > MAX_RULES || partCount > complexCount * (MAX_SELECTOR_PARTS - 1) ||
+      atomCount > 2 * MAX_SELECTOR_PARTS * MAX_RULES ||
+      atomTextSize > static_cast<uint32_t>(atomCount) * (MAX_SELECTOR_LENGTH + 1) ||
+      static_cast<size_t>(file.available()) < atomTextSize + rulesBytes + complexBytes + partsBytes) {
+    LOG_DBG("CSS", "Invalid cache header (record %u/%u, %u names, %u+%u rules)", recordSize, complexRecordSize,
+            atomCount, ruleCount, complexCount);
     return false;
   }
 
-  auto hasRemainingBytes = [&file](const size_t neededBytes) -> bool {
-    return static_cast<size_t>(file.available()) >= neededBytes;
-  };
-
-  constexpr size_t CSS_LENGTH_FIELD_COUNT = 11;
-  constexpr size_t CSS_LENGTH_BYTES = sizeof(float) + sizeof(uint8_t);
-  constexpr size_t CSS_FIXED_STYLE_BYTES =
-      4 * sizeof(uint8_t) + (CSS_LENGTH_FIELD_COUNT * CSS_LENGTH_BYTES) + sizeof(uint8_t) + sizeof(uint16_t);
-
-  // Read each rule
-  for (uint16_t i = 0; i < ruleCount; ++i) {
-    // Read selector string
-    uint16_t selectorLen = 0;
-    if (!hasRemainingBytes(sizeof(selectorLen))) {
-      rulesBySelector_.clear();
-      return false;
-    }
-    if (file.read(&selectorLen, sizeof(selectorLen)) != sizeof(selectorLen)) {
-      rulesBySelector_.clear();
-      return false;
-    }
-
-    if (selectorLen == 0 || selectorLen > MAX_SELECTOR_LENGTH || !hasRemainingBytes(selectorLen)) {
-      LOG_DBG("CSS", "Invalid selector length in cache: %u", selectorLen);
-      rulesBySelector_.clear();
-      return false;
-    }
-
-    std::string selector;
-    selector.resize(selectorLen);
-    if (file.read(&selector[0], selectorLen) != selectorLen) {
-      rulesBySelector_.clear();
-      return false;
-    }
-
-    if (!hasRemainingBytes(CSS_FIXED_STYLE_BYTES)) {
-      LOG_DBG("CSS", "Truncated CSS cache while reading style payload");
-      rulesBySelector_.clear();
-      return false;
-    }
-
-    // Read CssStyle fields
-    CssStyle style;
-    uint8_t enumVal;
-
-    if (file.read(&enumVal, 1) != 1) {
-      rulesBySelector_.clear();
-      return false;
-    }
-    style.textAlign = static_cast<CssTextAlign>(enumVal);
+  atomText_.resize(atomTextSize);
+  rules_.resize(ruleCount);
+  complexRules_.resize(complexCount);
+  selectorParts_.resize(partCount);
+  if (file.read(atomText_.data(), atomTextSize) != static_cast<int>(atomTextSize) ||
+      file.read(rules_.data(), rulesBytes) != static_cast<int>(rulesBytes) ||
+      file.read(complexRules_.data(), complexBytes) != static_cast<int>(complexBytes) ||
+      file.read(selectorParts_.data(), partsBytes) != static_cast<int>(partsBytes)) {
+    clear();
+    return false;
+  }
 
-    if (file.read(&enumVal, 1) != 1) {
-      rulesBySelector_.clear();
+  // Rebuild the name index from the NUL-separated names
+  atomOffsets_.reserve(atomCount);
+  for (uint32_t start = 0; start < atomTextSize && atomOffsets_.size() < atomCount;) {
+    const void* nul = std::memchr(atomText_.data() + start, '\0', atomTextSize - start);
+    if (!nul) break;
+    atomOffsets_.push_back(start);
+    start = static_cast<uint32_t>(static_cast<const char*>(nul) - atomText_.data()) + 1;
+  }
+  if (atomOffsets_.size() != atomCount || atomText_.empty() != (atomCount == 0) ||
+      (atomCount > 0 && atomText_.back() != '\0')) {
+    LOG_DBG("CSS", "Corrupt name table in CSS cache");
+    clear();
+    return false;
+  }
+  atomsByName_.resize(atomCount);
+  for (uint16_t i = 0; i < atomCount; ++i) {
+    atomsByName_[i] = i;
+  }
+  std::sort(atomsByName_.begin(), atomsByName_.end(),
+            [this](const uint16_t a, const uint16_t b) { return atomName(a) < atomName(b); });
+
+  // Keys must be strictly ascending and only reference known names
+  for (size_t i = 0; i < rules_.size(); ++i) {
+    const uint16_t tagAtom = rules_[i].key >> 16;
+    const uint16_t classAtom = rules_[i].key & 0xFFFF;
+    if ((i > 0 && rules_[i - 1].key >= rules_[i].key) || (tagAtom != NO_ATOM && tagAtom >= atomCount) ||
+        (classAtom != NO_ATOM && classAtom >= atomCount) || (tagAtom == NO_ATOM && classAtom == NO_ATOM)) {
+      LOG_DBG("CSS", "Corrupt rule table in CSS cache");
+      clear();
       return false;
     }
-    style.fontStyle = static_cast<CssFontStyle>(enumVal);
+  }
 
-    if (file.read(&enumVal, 1) != 1) {
-      rulesBySelector_.clear();
-      return false;
+  auto validAtom = [atomCount](const uint16_t atom) { return atom == NO_ATOM || atom < atomCount; };
+  for (size_t i = 0; i < complexRules_.size(); ++i) {
+    const ComplexRule& rule = complexRules_[i];
+    bool valid = (i == 0 || complexRules_[i - 1].subjectKey <= rule.subjectKey) && rule.subjectKey != UINT32_MAX &&
+                 validAtom(rule.subjectKey >> 16) && validAtom(rule.subjectKey & 0xFFFF) && rule.partCount > 0 &&
+                 rule.partCount < MAX_SELECTOR_PARTS && rule.firstPart + rule.partCount <= partCount &&
+                 rule.filterKeyCount <= MAX_FILTER_KEYS;
+    for (uint8_t p = 0; valid && p < rule.partCount; ++p) {
+      const SelectorPart& part = selectorParts_[rule.firstPart + p];
+      valid = validAtom(part.tag) && validAtom(part.cls) && part.combinator <= CHILD;
     }
-    style.fontWeight = static_cast<CssFontWeight>(enumVal);
-
-    if (file.read(&enumVal, 1) != 1) {
-      rulesBySelector_.clear();
-      return false;
-    }
-    style.textDecoration = static_cast<CssTextDecoration>(enumVal);
-
-    // Read CssLength fields
-    auto readLength = [&file](CssLength& len) -> bool {
-      if (file.read(&len.value, sizeof(len.value)) != sizeof(len.value)) {
-        return false;
-      }
-      uint8_t unitVal;
-      if (file.read(&unitVal, 1) != 1) {
-        return false;
-      }
-      len.unit = static_cast<CssUnit>(unitVal);
-      return true;
-    };
-
-    if (!readLength(style.textIndent) || !readLength(style.marginTop) || !readLength(style.marginBottom) ||
-        !readLength(style.marginLeft) || !readLength(style.marginRight) || !readLength(style.paddingTop) ||
-        !readLength(style.paddingBottom) || !readLength(style.paddingLeft) || !readLength(style.paddingRight) ||
-        !readLength(style.imageHeight) || !readLength(style.imageWidth)) {
-      rulesBySelector_.clear();
+    if (!valid) {
+      LOG_DBG("CSS", "Corrupt descendant/child rule table in CSS cache");
+      clear();
       return false;
     }
+  }
 
-    // Read display value
-    uint8_t displayVal;
-    if (file.read(&displayVal, 1) != 1) {
-      rulesBySelector_.clear();
-      return false;
-    }
-    style.display = static_cast<CssDisplay>(displayVal);
+  // Stylesheets loaded on top of the cache order after its rules
+  for (const Rule& rule : rules_) nextOrder_ = std::max<uint16_t>(nextOrder_, rule.order);
+  for (const ComplexRule& rule : complexRules_) nextOrder_ = std::max<uint16_t>(nextOrder_, rule.order);
+  if (nextOrder_ < UINT16_MAX) nextOrder_++;
 
-    // Read defined flags
-    uint16_t definedBits = 0;
-    if (file.read(&definedBits, sizeof(definedBits)) != sizeof(definedBits)) {
-      rulesBySelector_.clear();
-      return false;
-    }
-    style.defined.textAlign = (definedBits & 1 << 0) != 0;
-    style.defined.fontStyle = (definedBits & 1 << 1) != 0;
-    style.defined.fontWeight = (definedBits & 1 << 2) != 0;
-    style.defined.textDecoration = (definedBits & 1 << 3) != 0;
-    style.defined.textIndent = (definedBits & 1 << 4) != 0;
-    style.defined.marginTop = (definedBits & 1 << 5) != 0;
-    style.defined.marginBottom = (definedBits & 1 << 6) != 0;
-    style.defined.marginLeft = (definedBits & 1 << 7) != 0;
-    style.defined.marginRight = (definedBits & 1 << 8) != 0;
-    style.defined.paddingTop = (definedBits & 1 << 9) != 0;
-    style.defined.paddingBottom = (definedBits & 1 << 10) != 0;
-    style.defined.paddingLeft = (definedBits & 1 << 11) != 0;
-    style.defined.paddingRight = (definedBits & 1 << 12) != 0;
-    style.defined.imageHeight = (definedBits & 1 << 13) != 0;
-    style.defined.imageWidth = (definedBits & 1 << 14) != 0;
-    style.defined.display = (definedBits & 1 << 15) != 0;
-
-    rulesBySelector_[selector] = style;
-  }
-
-  LOG_DBG("CSS", "Loaded %u rules from cache", ruleCount);
+  LOG_DBG("CSS", "Loaded %u rules (%u descendant/child) from cache", ruleCount + complexCount, complexCount);
   return true;
 }
 
@@ -2,10 +2,12 @@
 
 #include <HalStorage.h>
 
+#include <array>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 
+#include "CssAncestorStack.h"
 #include "CssStyle.h"
 
 /**
@@ -19,10 +21,17 @@
  *   - Element selectors: p, div, h1, etc.
  *   - Class selectors: .classname
  *   - Combined: element.classname
+ *   - Descendant and child: div.chapter p, blockquote > p (up to MAX_SELECTOR_PARTS compounds of the forms above)
  *   - Grouped: selector1, selector2 { }
  *
+ * Tag and class names are interned into 16-bit atoms and rules are compiled into a table sorted by
+ * (tag atom, class atom), so resolving an element is a few binary searches over stack-lowercased names.
+ * Descendant/child rules are indexed by their rightmost compound and matched right to left against a
+ * CssAncestorStack, after its Bloom filter has ruled out the ones whose ancestors cannot be open.
+ * The CSS cache stores the compiled tables as-is.
+ *
  * Not supported (silently ignored):
- *   - Descendant/child selectors
+ *   - Sibling, attribute, ID and universal selectors
  *   - Pseudo-classes and pseudo-elements
  *   - Media queries (content is skipped)
  *   - @import, @font-face, etc.
@@ -30,7 +39,7 @@
 class CssParser {
  public:
   // Bump when CSS cache format or rules change; section caches are invalidated when this changes
-  static constexpr uint8_t CSS_CACHE_VERSION = 4;
+  static constexpr uint8_t CSS_CACHE_VERSION = 7;
 
   CssParser() = default;
   explicit CssParser(const std::string& cacheDir);
@@ -51,6 +60,8 @@ class CssParser {
   /**
    * Look up the style for an HTML element, considering tag name and class attributes.
    * Applies CSS cascade: element style < class style < element.class style
+   * Recently resolved (tag, class set) combinations are memoized, so repeated elements such as
+   * <p class="calibre1"> resolve without allocating. Not thread-safe: one layout task at a time.
    *
    * @param tagName The HTML element name (e.g., "p", "div")
    * @param classAttr The class attribute value (may contain multiple space-separated classes)
@@ -58,6 +69,15 @@ class CssParser {
    */
   [[nodiscard]] CssStyle resolveStyle(const std::string& tagName, const std::string& classAttr) const;
 
+  /**
+   * Same as above for an element at `depth` in a document walk, also applying descendant and child rules.
+   * Pops ancestors at `depth` or deeper, then pushes this element so its descendants can match against it;
+   * the caller pops it with ancestors.popTo(depth) when the element ends.
+   * Rules are applied in order of specificity, ties going to the rule later in the stylesheet.
+   */
+  [[nodiscard]] CssStyle resolveStyle(const std::string& tagName, const std::string& classAttr,
+                                      CssAncestorStack& ancestors, int depth) const;
+
   /**
    * Parse an inline style attribute string.
    * @param styleValue The value of a style="" attribute
@@ -68,17 +88,17 @@ class CssParser {
   /**
    * Check if any rules have been loaded
    */
-  [[nodiscard]] bool empty() const { return rulesBySelector_.empty(); }
+  [[nodiscard]] bool empty() const { return rules_.empty() && complexRules_.empty(); }
 
   /**
    * Get count of loaded rule sets
    */
-  [[nodiscard]] size_t ruleCount() const { return rulesBySelector_.size(); }
+  [[nodiscard]] size_t ruleCount() const { return rules_.size() + complexRules_.size(); }
 
   /**
-   * Clear all loaded rules
+   * Clear all loaded rules and release their memory
    */
-  void clear() { rulesBySelector_.clear(); }
+  void clear();
 
   /**
    * Save parsed CSS rules to a cache file.
@@ -100,11 +120,124 @@ class CssParser {
   bool saveToCache() const;
   bool loadFromCache();
 
+  // Style resolution cost, accumulated until logStats() or resetStats()
+  struct Stats {
+    uint32_t resolves = 0;
+    uint32_t memoHits = 0;
+    uint32_t contextCandidates = 0;  // descendant/child rules whose rightmost compound matched the element
+    uint32_t filterRejects = 0;      // of those, dropped by the ancestor Bloom filter
+    uint32_t contextMatches = 0;     // of those, whose ancestors matched
+    uint32_t resolveTimeUs = 0;
+  };
+  void logStats(const char* label) const;
+  void resetStats() const { stats_ = Stats{}; }
+  const Stats& getStats() const { return stats_; }
+
  private:
-  // Storage: maps normalized selector -> style properties
-  std::unordered_map<std::string, CssStyle> rulesBySelector_;
+  // Stands for "any tag" or "no class" in a rule key, and for names no rule mentions
+  static constexpr uint16_t NO_ATOM = CssAncestorStack::NO_ATOM;
+  // Most classes of one element that take part in resolution; further matching classes are ignored
+  static constexpr uint8_t MAX_ELEMENT_CLASSES = 16;
+  static constexpr size_t MEMO_SLOTS = 16;
+  static constexpr uint8_t MEMO_MAX_CLASSES = 4;
+  // Compounds in one descendant/child selector, and ancestor atoms checked against the Bloom filter per rule
+  static constexpr uint8_t MAX_SELECTOR_PARTS = 4;
+  static constexpr uint8_t MAX_FILTER_KEYS = 4;
+  // Most rules applied to a single element once descendant/child rules match; further matches are dropped
+  static constexpr uint8_t MAX_MATCHED_RULES = 32;
+  // Ancestor comparisons allowed per rule, bounding backtracking on selectors like `div > p span`
+  static constexpr uint16_t MATCH_BUDGET = 256;
+
+  // One selector: tag, .class or tag.class. Key is tagAtom << 16 | classAtom.
+  struct Rule {
+    uint32_t key;
+    uint16_t order;  // stylesheet order of the selector's last occurrence, shared with ComplexRule::order
+    CssStyle style;
+  };
+
+  enum Combinator : uint8_t { DESCENDANT = 0, CHILD = 1 };
+
+  // A compound left of the rightmost one; combinator relates it to the compound on its right
+  struct SelectorPart {
+    uint16_t tag;
+    uint16_t cls;
+    uint8_t combinator;
+  };
+
+  // Descendant/child selector, indexed by its rightmost compound (same key layout as Rule::key)
+  struct ComplexRule {
+    uint32_t subjectKey;
+    uint16_t firstPart;  // into selectorParts_, outermost first
+    uint8_t partCount;
+    uint8_t filterKeyCount;
+    uint16_t specificity;  // 0x100 per class, 1 per tag
+    uint16_t order;        // stylesheet order, from 1, counted across simple and descendant/child selectors
+    uint16_t filterKeys[MAX_FILTER_KEYS];
+    CssStyle style;
+  };
+
+  struct ElementAtoms {
+    uint16_t tag = NO_ATOM;
+    uint8_t classCount = 0;
+    uint16_t classes[MAX_ELEMENT_CLASSES];
+  };
+
+  struct MatchedRule {
+    uint16_t specificity;
+    uint16_t order;
+    const CssStyle* style;
+  };
+
+  struct MemoEntry {
+    bool used = false;
+    uint8_t classCount = 0;
+    uint16_t tag = NO_ATOM;
+    uint16_t classes[MEMO_MAX_CLASSES] = {};
+    CssStyle style;
+  };
+
+  // Interned lowercase names: atom id -> offset of its NUL-terminated name in atomText_
+  std::string atomText_;
+  std::vector<uint32_t> atomOffsets_;
+  std::vector<uint16_t> atomsByName_;  // atom ids in name order, for lookup
+
+  // Sorted by key outside of loadFromStream()
+  std::vector<Rule> rules_;
+  // Indices into rules_ in key order, only while loadFromStream() is adding rules
+  std::vector<uint16_t> pendingOrder_;
+  // Sorted by subjectKey (stable, so stylesheet order within a key) outside of loadFromStream()
+  std::vector<ComplexRule> complexRules_;
+  std::vector<SelectorPart> selectorParts_;
+  // Order given to the next selector added
+  uint16_t nextOrder_ = 1;
+
+  mutable std::array<MemoEntry, MEMO_SLOTS> memo_;
+  mutable Stats stats_;
+
   std::string cacheDir_;
 
+  static uint32_t ruleKey(const uint16_t tagAtom, const uint16_t classAtom) {
+    return static_cast<uint32_t>(tagAtom) << 16 | classAtom;
+  }
+  std::string_view atomName(uint16_t atom) const;
+  uint16_t findAtom(std::string_view name) const;
+  uint16_t internAtom(std::string_view name);
+  const Rule* findRuleEntry(uint32_t key) const;
+  const CssStyle* findRule(uint32_t key) const;
+  void addRule(uint32_t key, const CssStyle& style);
+  uint16_t takeOrder();
+  void compileRules();
+  void resetMemo() const;
+  void applyRules(uint16_t tagAtom, const uint16_t* classAtoms, uint8_t classCount, CssStyle& out) const;
+  bool parseCompound(std::string_view compound, uint16_t& tagAtom, uint16_t& classAtom);
+  bool addComplexRule(std::string_view selector, const CssStyle& style);
+  void collectElementAtoms(const std::string& tagName, const std::string& classAttr, ElementAtoms& out) const;
+  CssStyle resolveElement(const ElementAtoms& element, const CssAncestorStack* ancestors, int depth) const;
+  void collectComplexMatches(const ElementAtoms& element, const CssAncestorStack& ancestors, int depth,
+                             MatchedRule* matched, uint8_t& matchedCount) const;
+  bool matchAncestors(const ComplexRule& rule, int part, int stackIndex, int childDepth,
+                      const CssAncestorStack& ancestors, uint16_t& budget) const;
+
   // Internal parsing helpers
   void processRuleBlock(const std::string& selectorGroup, const std::string& declarations);
   void processRuleBlockWithStyle(const std::string& selectorGroup, const CssStyle& style);
@@ -0,0 +1,100 @@
+#include "HyphenationCache.h"
+
+#include <new>
+
+HyphenationCache::HyphenationCache()
+    : entries(new (std::nothrow) Entry[CAPACITY]()), previous(Hyphenator::activeCache_) {
+  Hyphenator::activeCache_ = this;
+}
+
+HyphenationCache::~HyphenationCache() { Hyphenator::activeCache_ = previous; }
+
+uint32_t HyphenationCache::hitRatePercent() const {
+  const uint32_t lookups = stats.hits + stats.misses;
+  return lookups == 0 ? 0 : static_cast<uint32_t>(static_cast<uint64_t>(stats.hits) * 100 / lookups);
+}
+
+uint64_t HyphenationCache::hashKey(const std::string& word, const void* language, const bool includeFallback) {
+  uint64_t hash = 14695981039346656037ull;
+  const auto mix = [&hash](const uint8_t byte) { hash = (hash ^ byte) * 1099511628211ull; };
+  for (const char c : word) {
+    mix(static_cast<uint8_t>(c));
+  }
+  const auto languageBits = reinterpret_cast<uintptr_t>(language);
+  for (size_t i = 0; i < sizeof(languageBits); i++) {
+    mix(static_cast<uint8_t>(languageBits >> (i * 8)));
+  }
+  mix(includeFallback ? 1 : 0);
+  return hash;
+}
+
+bool HyphenationCache::lookup(const std::string& word, const void* language, const bool includeFallback,
+                              std::vector<Hyphenator::BreakInfo>& out) {
+  if (!entries || word.size() > UINT8_MAX) {
+    stats.misses++;
+    return false;
+  }
+
+  const uint64_t hash = hashKey(word, language, includeFallback);
+  for (size_t probe = 0; probe < MAX_PROBES; probe++) {
+    Entry& entry = entries[(hash + probe) & (CAPACITY - 1)];
+    if (entry.length == 0) {
+      break;
+    }
+    if (entry.hash == hash && entry.length == word.size()) {
+      if (entry.uses < UINT8_MAX) {
+        entry.uses++;
+      }
+      out.clear();
+      for (uint8_t i = 0; i < entry.count; i++) {
+        out.push_back({entry.offsets[i], ((entry.hyphenMask >> i) & 1) != 0});
+      }
+      stats.hits++;
+      return true;
+    }
+  }
+  stats.misses++;
+  return false;
+}
+
+void HyphenationCache::store(const std::string& word, const void* language, const bool includeFallback,
+                             const std::vector<Hyphenator::BreakInfo>& breaks) {
+  if (!entries) {
+    return;
+  }
+  if (word.size() > UINT8_MAX || breaks.size() > MAX_BREAKS) {
+    stats.uncacheable++;
+    return;
+  }
+
+  const uint64_t hash = hashKey(word, language, includeFallback);
+  Entry* slot = nullptr;
+  Entry* victim = nullptr;
+  for (size_t probe = 0; probe < MAX_PROBES; probe++) {
+    Entry& entry = entries[(hash + probe) & (CAPACITY - 1)];
+    if (entry.length == 0) {
+      slot = &entry;
+      break;
+    }
+    if (!victim || entry.uses < victim->uses) {
+      victim = &entry;
+    }
+  }
+  if (!slot) {
+    slot = victim;
+    stats.evictions++;
+  }
+
+  slot->hash = hash;
+  slot->length = static_cast<uint16_t>(word.size());
+  slot->count = static_cast<uint8_t>(breaks.size());
+  slot->uses = 0;
+  slot->hyphenMask = 0;
+  for (size_t i = 0; i < breaks.size(); i++) {
+    // Offsets are inside the word, which is at most 255 bytes
+    slot->offsets[i] = static_cast<uint8_t>(breaks[i].byteOffset);
+    if (breaks[i].requiresInsertedHyphen) {
+      slot->hyphenMask |= static_cast<uint16_t>(1u << i);
+    }
+  }
+}
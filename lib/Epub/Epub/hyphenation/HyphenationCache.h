@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Hyphenator.h"
+
+// Break offsets of words already hyphenated during a section build, so a word that recurs in a chapter goes through
+// the Liang patterns once.
+//
+// While an instance is alive, Hyphenator::breakOffsets() looks words up here first. The table has a fixed capacity and
+// is allocated once by the constructor; lookups and stores never allocate. Entries are keyed by a 64-bit FNV-1a hash
+// of the word bytes, the language hyphenator and the fallback flag, plus the word length. Open addressing with a short
+// linear probe; when every probed slot is taken, the one with the fewest hits is overwritten, so frequent words stay
+// while one-off words churn. A build covers one chapter, where word frequencies hardly drift, so hits never decay.
+class HyphenationCache {
+ public:
+  static constexpr size_t CAPACITY = 512;  // Power of two; 32 bytes per entry
+  static constexpr size_t MAX_PROBES = 8;
+  // Words with more breaks than this, or longer than 255 bytes, are computed every time
+  static constexpr size_t MAX_BREAKS = 16;
+
+  struct Stats {
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+    uint32_t evictions = 0;    // Stores that overwrote another word
+    uint32_t uncacheable = 0;  // Misses too long or with too many breaks to store
+  };
+
+  HyphenationCache();
+  ~HyphenationCache();
+  HyphenationCache(const HyphenationCache&) = delete;
+  HyphenationCache& operator=(const HyphenationCache&) = delete;
+
+  // False if the table could not be allocated; breakOffsets() then works as without a cache.
+  bool enabled() const { return entries != nullptr; }
+  const Stats& getStats() const { return stats; }
+  // Hits per lookup in percent, 0 before the first lookup
+  uint32_t hitRatePercent() const;
+
+ private:
+  friend class Hyphenator;
+
+  struct Entry {
+    uint64_t hash;
+    uint16_t length;      // 0 = empty slot
+    uint16_t hyphenMask;  // Bit i set = breaks[i] needs an inserted hyphen
+    uint8_t count;
+    uint8_t uses;  // Hits since stored, saturating
+    uint8_t offsets[MAX_BREAKS];
+  };
+
+  std::unique_ptr<Entry[]> entries;
+  Stats stats;
+  HyphenationCache* previous;
+
+  static uint64_t hashKey(const std::string& word, const void* language, bool includeFallback);
+  bool lookup(const std::string& word, const void* language, bool includeFallback,
+              std::vector<Hyphenator::BreakInfo>& out);
+  void store(const std::string& word, const void* language, bool includeFallback,
+             const std::vector<Hyphenator::BreakInfo>& breaks);
+};
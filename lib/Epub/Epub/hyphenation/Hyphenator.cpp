@@ -4,11 +4,13 @@
 #include <cassert>
 #include <vector>
 
+#include "HyphenationCache.h"
 #include "HyphenationCommon.h"
 #include "LanguageHyphenator.h"
 #include "LanguageRegistry.h"
 
 const LanguageHyphenator* Hyphenator::cachedHyphenator_ = nullptr;
+HyphenationCache* Hyphenator::activeCache_ = nullptr;
 
 namespace {
 
@@ -172,10 +174,27 @@ void sortAndDedupeBreakInfos(std::vector<Hyphenator::BreakInfo>& infos) {
 }  // namespace
 
 std::vector<Hyphenator::BreakInfo> Hyphenator::breakOffsets(const std::string& word, const bool includeFallback) {
+  std::vector<BreakInfo> breaks;
+  breakOffsets(word, includeFallback, breaks);
+  return breaks;
+}
+
+void Hyphenator::breakOffsets(const std::string& word, const bool includeFallback, std::vector<BreakInfo>& out) {
+  out.clear();
   if (word.empty()) {
-    return {};
+    return;
   }
+  if (activeCache_ && activeCache_->lookup(word, cachedHyphenator_, includeFallback, out)) {
+    return;
+  }
+  out = computeBreakOffsets(word, includeFallback);
+  if (activeCache_) {
+    activeCache_->store(word, cachedHyphenator_, includeFallback, out);
+  }
+}
 
+std::vector<Hyphenator::BreakInfo> Hyphenator::computeBreakOffsets(const std::string& word,
+                                                                  const bool includeFallback) {
   // Convert to codepoints and normalize word boundaries.
   auto cps = collectCodepoints(word);
   trimSurroundingPunctuationAndFootnote(cps);
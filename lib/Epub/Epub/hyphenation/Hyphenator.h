@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 
+class HyphenationCache;
 class LanguageHyphenator;
 
 class Hyphenator {
@@ -35,9 +36,18 @@ class Hyphenator {
   //      word from overflowing the page width.
   static std::vector<BreakInfo> breakOffsets(const std::string& word, bool includeFallback);
 
+  // Same as above, written into out so its storage is reused. Words already seen by the live HyphenationCache, if
+  // any, are answered from it without decoding the word or walking the patterns.
+  static void breakOffsets(const std::string& word, bool includeFallback, std::vector<BreakInfo>& out);
+
   // Provide a publication-level language hint (e.g. "en", "en-US", "ru") used to select hyphenation rules.
   static void setPreferredLanguage(const std::string& lang);
 
  private:
+  friend class HyphenationCache;
+
+  static std::vector<BreakInfo> computeBreakOffsets(const std::string& word, bool includeFallback);
+
   static const LanguageHyphenator* cachedHyphenator_;
+  static HyphenationCache* activeCache_;
 };
\ No newline at end of file
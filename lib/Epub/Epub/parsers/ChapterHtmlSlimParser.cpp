@@ -12,6 +12,7 @@
 #include "../converters/ImageDecoderFactory.h"
 #include "../converters/ImageToFramebufferDecoder.h"
 #include "../htmlEntities.h"
+#include "SpiBusMutex.h"
 
 const char* HEADER_TAGS[] = {"h1", "h2", "h3", "h4", "h5", "h6"};
 constexpr int NUM_HEADER_TAGS = sizeof(HEADER_TAGS) / sizeof(HEADER_TAGS[0]);
@@ -119,7 +120,8 @@ void ChapterHtmlSlimParser::flushPartWordBuffer() {
 
   // flush the buffer
   partWordBuffer[partWordBufferIndex] = '\0';
-  currentTextBlock->addWord(partWordBuffer, fontStyle, false, nextWordContinues);
+  currentTextBlock->addWord(std::string_view(partWordBuffer, partWordBufferIndex), fontStyle, false,
+                            nextWordContinues);
   partWordBufferIndex = 0;
   nextWordContinues = false;
 }
@@ -186,7 +188,7 @@ void XMLCALL ChapterHtmlSlimParser::startElement(void* userData, const XML_Char*
   // before tag-specific branches emit any content or metadata.
   CssStyle cssStyle;
   if (self->cssParser) {
-    cssStyle = self->cssParser->resolveStyle(name, classAttr);
+    cssStyle = self->cssParser->resolveStyle(name, classAttr, self->cssAncestors, self->depth);
     if (!styleAttr.empty()) {
       CssStyle inlineStyle = CssParser::parseInlineStyle(styleAttr);
       cssStyle.applyOver(inlineStyle);
@@ -314,10 +316,15 @@ void XMLCALL ChapterHtmlSlimParser::startElement(void* userData, const XML_Char*
             // Extract image to cache file
             FsFile cachedImageFile;
             bool extractSuccess = false;
-            if (Storage.openFileForWrite("EHP", cachedImagePath, cachedImageFile)) {
-              extractSuccess = self->epub->readItemContentsToStream(resolvedPath, cachedImageFile, 4096);
-              cachedImageFile.flush();
-              cachedImageFile.close();
+            {
+              SpiBusMutex::Guard guard;
+              if (Storage.openFileForWrite("EHP", cachedImagePath, cachedImageFile)) {
+                extractSuccess = self->epub->readItemContentsToStream(resolvedPath, cachedImageFile, 4096);
+                cachedImageFile.flush();
+                cachedImageFile.close();
+              }
+            }
+            if (extractSuccess) {
               delay(50);  // Give SD card time to sync
             }
 
@@ -325,7 +332,12 @@ void XMLCALL ChapterHtmlSlimParser::startElement(void* userData, const XML_Char*
               // Get image dimensions
               ImageDimensions dims = {0, 0};
               ImageToFramebufferDecoder* decoder = ImageDecoderFactory::getDecoder(cachedImagePath);
-              if (decoder && decoder->getDimensions(cachedImagePath, dims)) {
+              bool haveDimensions = false;
+              if (decoder) {
+                SpiBusMutex::Guard guard;
+                haveDimensions = decoder->getDimensions(cachedImagePath, dims);
+              }
+              if (haveDimensions) {
                 LOG_DBG("EHP", "Image dimensions: %dx%d", dims.width, dims.height);
 
                 int displayWidth = 0;
@@ -463,6 +475,7 @@ void XMLCALL ChapterHtmlSlimParser::startElement(void* userData, const XML_Char*
                 return;
               } else {
                 LOG_ERR("EHP", "Failed to get image dimensions");
+                SpiBusMutex::Guard guard;
                 Storage.remove(cachedImagePath.c_str());
               }
             } else {
@@ -934,6 +947,7 @@ void XMLCALL ChapterHtmlSlimParser::endElement(void* userData, const XML_Char* n
   }
 
   self->depth -= 1;
+  self->cssAncestors.popTo(self->depth);
 
   // Closing a footnote link — create entry from collected text and href
   if (self->insideFootnoteLink && self->depth == self->footnoteLinkDepth) {
@@ -1035,14 +1049,21 @@ bool ChapterHtmlSlimParser::parseAndBuildPages() {
   // Using DefaultHandlerExpand preserves normal entity expansion from DOCTYPE
   XML_SetDefaultHandlerExpand(parser, defaultHandlerExpand);
 
+  // Input is either a ZIP entry inflated straight into expat's buffer, or a plain file on SD
   FsFile file;
-  if (!Storage.openFileForRead("EHP", filepath, file)) {
+  bool opened;
+  {
+    SpiBusMutex::Guard guard;
+    opened = entrySource || Storage.openFileForRead("EHP", filepath, file);
+  }
+  if (!opened) {
     XML_ParserFree(parser);
     return false;
   }
 
   // Get file size to decide whether to show indexing popup.
-  if (popupFn && file.size() >= MIN_SIZE_FOR_POPUP) {
+  const size_t inputSize = entrySource ? entrySource->size() : file.size();
+  if (popupFn && inputSize >= MIN_SIZE_FOR_POPUP) {
     popupFn();
   }
 
@@ -1052,7 +1073,19 @@ bool ChapterHtmlSlimParser::parseAndBuildPages() {
 
   // Compute the time taken to parse and build pages
   const uint32_t chapterStartTime = millis();
+  cssAncestors.clear();
+  if (cssParser) cssParser->resetStats();
   do {
+    if (cancelRequested && cancelRequested->load()) {
+      LOG_DBG("EHP", "Parse cancelled after %d pages", completedPageCount);
+      XML_StopParser(parser, XML_FALSE);                // Stop any pending processing
+      XML_SetElementHandler(parser, nullptr, nullptr);  // Clear callbacks
+      XML_SetCharacterDataHandler(parser, nullptr);
+      XML_ParserFree(parser);
+      if (file) file.close();
+      return false;
+    }
+
     void* const buf = XML_GetBuffer(parser, PARSE_BUFFER_SIZE);
     if (!buf) {
       LOG_ERR("EHP", "Couldn't allocate memory for buffer");
@@ -1060,42 +1093,56 @@ bool ChapterHtmlSlimParser::parseAndBuildPages() {
       XML_SetElementHandler(parser, nullptr, nullptr);  // Clear callbacks
       XML_SetCharacterDataHandler(parser, nullptr);
       XML_ParserFree(parser);
-      file.close();
+      if (file) file.close();
       return false;
     }
 
-    const size_t len = file.read(buf, PARSE_BUFFER_SIZE);
+    // The bus is taken per chunk only, so a build on the layout task never holds it while expat and the line
+    // breaker run
+    int len;
+    {
+      SpiBusMutex::Guard guard;
+      if (entrySource) {
+        len = entrySource->read(static_cast<uint8_t*>(buf), PARSE_BUFFER_SIZE);
+        done = entrySource->done();
+      } else {
+        len = file.read(buf, PARSE_BUFFER_SIZE);
+        if (len == 0 && file.available() > 0) {
+          len = -1;
+        }
+        done = file.available() == 0;
+      }
+    }
 
-    if (len == 0 && file.available() > 0) {
+    if (len < 0) {
       LOG_ERR("EHP", "File read error");
       XML_StopParser(parser, XML_FALSE);                // Stop any pending processing
       XML_SetElementHandler(parser, nullptr, nullptr);  // Clear callbacks
       XML_SetCharacterDataHandler(parser, nullptr);
       XML_ParserFree(parser);
-      file.close();
+      if (file) file.close();
       return false;
     }
 
-    done = file.available() == 0;
-
-    if (XML_ParseBuffer(parser, static_cast<int>(len), done) == XML_STATUS_ERROR) {
+    if (XML_ParseBuffer(parser, len, done) == XML_STATUS_ERROR) {
       LOG_ERR("EHP", "Parse error at line %lu:\n%s", XML_GetCurrentLineNumber(parser),
               XML_ErrorString(XML_GetErrorCode(parser)));
       XML_StopParser(parser, XML_FALSE);                // Stop any pending processing
       XML_SetElementHandler(parser, nullptr, nullptr);  // Clear callbacks
       XML_SetCharacterDataHandler(parser, nullptr);
       XML_ParserFree(parser);
-      file.close();
+      if (file) file.close();
       return false;
     }
   } while (!done);
   LOG_DBG("EHP", "Time to parse and build pages: %lu ms", millis() - chapterStartTime);
+  if (cssParser) cssParser->logStats("chapter");
 
   XML_StopParser(parser, XML_FALSE);                // Stop any pending processing
   XML_SetElementHandler(parser, nullptr, nullptr);  // Clear callbacks
   XML_SetCharacterDataHandler(parser, nullptr);
   XML_ParserFree(parser);
-  file.close();
+  if (file) file.close();
 
   // Process last page if there is still text
   if (currentTextBlock) {
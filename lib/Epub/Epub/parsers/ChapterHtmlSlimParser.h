@@ -1,7 +1,9 @@
 #pragma once
 
+#include <ZipFile.h>
 #include <expat.h>
 
+#include <atomic>
 #include <climits>
 #include <functional>
 #include <memory>
@@ -27,6 +29,8 @@ class ChapterHtmlSlimParser {
   GfxRenderer& renderer;
   std::function<void(std::unique_ptr<Page>)> completePageFn;
   std::function<void()> popupFn;  // Popup callback
+  const std::atomic<bool>* cancelRequested = nullptr;
+  ZipFile::EntryReader* entrySource = nullptr;
   int depth = 0;
   int skipUntilDepth = INT_MAX;
   int boldUntilDepth = INT_MAX;
@@ -48,6 +52,7 @@ class ChapterHtmlSlimParser {
   uint16_t viewportHeight;
   bool hyphenationEnabled;
   const CssParser* cssParser;
+  CssAncestorStack cssAncestors;  // open elements, for descendant/child selectors
   bool embeddedStyle;
   uint8_t imageRendering;
   std::string contentBase;
@@ -124,6 +129,10 @@ class ChapterHtmlSlimParser {
 
   ~ChapterHtmlSlimParser() = default;
   bool parseAndBuildPages();
+  // Checked between parse buffers; parseAndBuildPages() returns false once the flag is set.
+  void setCancelFlag(const std::atomic<bool>* cancelFlag) { cancelRequested = cancelFlag; }
+  // Parse an open ZIP entry instead of the file at `filepath`; expat's buffer is filled directly by the inflater.
+  void setEntrySource(ZipFile::EntryReader* source) { entrySource = source; }
   void addLineToPage(std::shared_ptr<TextBlock> line);
   const std::vector<std::pair<std::string, uint16_t>>& getAnchors() const { return anchorData; }
 };
@@ -3,7 +3,11 @@
 #include <FontDecompressor.h>
 #include <Logging.h>
 
+#include <algorithm>
 #include <cstring>
+#include <vector>
+
+#include "GlyphDisplayList.h"
 
 FontCacheManager::FontCacheManager(const std::map<int, EpdFontFamily>& fontMap) : fontMap_(fontMap) {}
 
@@ -28,8 +32,69 @@ void FontCacheManager::prewarmCache(int fontId, const char* utf8Text, uint8_t st
   }
 }
 
+void FontCacheManager::prewarmCache(const GlyphDisplayList& list) {
+  if (!fontDecompressor_) return;
+
+  std::vector<uint32_t> glyphIndices;
+  for (uint8_t slot = 0; slot < list.fontCount(); slot++) {
+    const EpdFontData* data = list.font(slot);
+    if (!data || !data->groups) continue;
+
+    glyphIndices.clear();
+    for (const auto& g : list.glyphs()) {
+      if (g.font == slot) glyphIndices.push_back(static_cast<uint32_t>(g.glyph - data->glyph));
+    }
+    std::sort(glyphIndices.begin(), glyphIndices.end());
+    glyphIndices.erase(std::unique(glyphIndices.begin(), glyphIndices.end()), glyphIndices.end());
+    if (glyphIndices.empty()) continue;
+
+    const uint16_t count = static_cast<uint16_t>(std::min<size_t>(glyphIndices.size(), UINT16_MAX));
+    const int missed = fontDecompressor_->prewarmGlyphs(data, glyphIndices.data(), count);
+    if (missed > 0) {
+      LOG_DBG("FCM", "prewarmCache: %d glyph(s) not cached for font slot %u", missed, slot);
+    }
+  }
+}
+
+void FontCacheManager::setPinnedGroups(const int fontId, const std::vector<GlyphGroupHistogram::Entry>& groups) {
+  if (!fontDecompressor_) return;
+  const auto it = fontMap_.find(fontId);
+  if (it == fontMap_.end()) {
+    fontDecompressor_->setPinCandidates(nullptr, 0);
+    return;
+  }
+
+  FontDecompressor::PinCandidate candidates[FontDecompressor::MAX_PIN_CANDIDATES];
+  uint8_t count = 0;
+  for (const auto& entry : groups) {
+    if (count >= FontDecompressor::MAX_PIN_CANDIDATES) break;
+    const EpdFontData* data = it->second.getData(static_cast<EpdFontFamily::Style>(entry.style));
+    if (!data || !data->groups || entry.group >= data->groupCount) continue;
+    candidates[count++] = {data, entry.group};
+  }
+  fontDecompressor_->setPinCandidates(candidates, count);
+}
+
+void FontCacheManager::releasePinnedGroups() {
+  if (!fontDecompressor_) return;
+  fontDecompressor_->setPinCandidates(nullptr, 0);
+}
+
 void FontCacheManager::logStats(const char* label) {
   if (fontDecompressor_) fontDecompressor_->logStats(label);
+  const uint32_t prefetchTotal = pagePrefetchHits_ + pagePrefetchMisses_;
+  if (prefetchTotal > 0) {
+    LOG_DBG("FCM", "[%s] page prefetch hits=%lu misses=%lu (%.1f%% hit rate)", label, pagePrefetchHits_,
+            pagePrefetchMisses_, 100.0f * pagePrefetchHits_ / prefetchTotal);
+  }
+}
+
+void FontCacheManager::recordPagePrefetch(const bool hit) {
+  if (hit) {
+    pagePrefetchHits_++;
+  } else {
+    pagePrefetchMisses_++;
+  }
 }
 
 void FontCacheManager::resetStats() {
@@ -81,6 +146,13 @@ void FontCacheManager::PrewarmScope::endScanAndPrewarm() {
   manager_->scanText_.shrink_to_fit();
 }
 
+void FontCacheManager::PrewarmScope::endScanAndPrewarm(const GlyphDisplayList& list) {
+  manager_->scanMode_ = ScanMode::None;
+  manager_->scanText_.clear();
+  manager_->scanText_.shrink_to_fit();
+  manager_->prewarmCache(list);
+}
+
 FontCacheManager::PrewarmScope::~PrewarmScope() {
   if (active_) {
     endScanAndPrewarm();  // no-op if already called (scanText_ is empty)
@@ -1,12 +1,15 @@
 #pragma once
 
 #include <EpdFontFamily.h>
+#include <GlyphGroupHistogram.h>
 
 #include <cstdint>
 #include <map>
 #include <string>
+#include <vector>
 
 class FontDecompressor;
+class GlyphDisplayList;
 
 class FontCacheManager {
  public:
@@ -16,8 +19,16 @@ class FontCacheManager {
 
   void clearCache();
   void prewarmCache(int fontId, const char* utf8Text, uint8_t styleMask = 0x0F);
+  // Prewarm straight from resolved glyphs; no text scan pass needed.
+  void prewarmCache(const GlyphDisplayList& list);
+  // Pins the glyph groups a section's histogram ranks highest (see FontDecompressor::setPinCandidates).
+  void setPinnedGroups(int fontId, const std::vector<GlyphGroupHistogram::Entry>& groups);
+  void releasePinnedGroups();
   void logStats(const char* label = "render");
   void resetStats();
+  // Page prefetch outcome for the page being rendered: hit = it was deserialized ahead of time. These counters are
+  // cumulative for the reading session; resetStats() leaves them alone.
+  void recordPagePrefetch(bool hit);
 
   // Scan-mode API: called by GfxRenderer::drawText() during scan pass
   bool isScanning() const;
@@ -32,6 +43,8 @@ class FontCacheManager {
     explicit PrewarmScope(FontCacheManager& manager);
     ~PrewarmScope();
     void endScanAndPrewarm();
+    // Ends the scan without rendering anything and prewarms the glyphs referenced by list.
+    void endScanAndPrewarm(const GlyphDisplayList& list);
     PrewarmScope(PrewarmScope&& other) noexcept;
     PrewarmScope& operator=(PrewarmScope&&) = delete;
     PrewarmScope(const PrewarmScope&) = delete;
@@ -52,4 +65,7 @@ class FontCacheManager {
   std::string scanText_;
   uint32_t scanStyleCounts_[4] = {};
   int scanFontId_ = -1;
+
+  uint32_t pagePrefetchHits_ = 0;
+  uint32_t pagePrefetchMisses_ = 0;
 };
@@ -9,6 +9,7 @@
 #include <cmath>
 
 #include "FontCacheManager.h"
+#include "GlyphBlitter.h"
 
 const uint8_t* GfxRenderer::getGlyphBitmap(const EpdFontData* fontData, const EpdGlyph* glyph) const {
   if (fontData->groups != nullptr) {
@@ -82,16 +83,9 @@ enum class TextRotation { None, Rotated90CW };
 // Shared glyph rendering logic for normal and rotated text.
 // Coordinate mapping and cursor advance direction are selected at compile time via the template parameter.
 template <TextRotation rotation>
-static void renderCharImpl(const GfxRenderer& renderer, GfxRenderer::RenderMode renderMode,
-                           const EpdFontFamily& fontFamily, const uint32_t cp, int cursorX, int cursorY,
-                           const bool pixelState, const EpdFontFamily::Style style) {
-  const EpdGlyph* glyph = fontFamily.getGlyph(cp, style);
-  if (!glyph) {
-    LOG_ERR("GFX", "No glyph for codepoint %d", cp);
-    return;
-  }
-
-  const EpdFontData* fontData = fontFamily.getData(style);
+static void drawGlyphImpl(const GfxRenderer& renderer, GfxRenderer::RenderMode renderMode,
+                          const EpdFontData* fontData, const EpdGlyph* glyph, int cursorX, int cursorY,
+                          const bool pixelState) {
   const bool is2Bit = fontData->is2Bit;
   const uint8_t width = glyph->width;
   const uint8_t height = glyph->height;
@@ -99,32 +93,27 @@ static void renderCharImpl(const GfxRenderer& renderer, GfxRenderer::RenderMode
   const int top = glyph->top;
 
   const uint8_t* bitmap = renderer.getGlyphBitmap(fontData, glyph);
+  if (bitmap == nullptr) {
+    return;
+  }
 
-  if (bitmap != nullptr) {
-    // For Normal:  outer loop advances screenY, inner loop advances screenX
-    // For Rotated: outer loop advances screenX, inner loop advances screenY (in reverse)
-    int outerBase, innerBase;
-    if constexpr (rotation == TextRotation::Rotated90CW) {
-      outerBase = cursorX + fontData->ascender - top;  // screenX = outerBase + glyphY
-      innerBase = cursorY - left;                      // screenY = innerBase - glyphX
-    } else {
-      outerBase = cursorY - top;   // screenY = outerBase + glyphY
-      innerBase = cursorX + left;  // screenX = innerBase + glyphX
-    }
+  if constexpr (rotation == TextRotation::None) {
+    // Horizontal text: clip once and write whole glyph rows straight into the framebuffer
+    const GlyphBlitter::Target target{renderer.getFrameBuffer(), renderer.getDisplayWidth(),
+                                      renderer.getDisplayHeight(), renderer.getDisplayWidthBytes()};
+    GlyphBlitter::draw(target, renderer.getOrientation(), renderMode, is2Bit, bitmap, width, height, cursorX + left,
+                       cursorY - top, pixelState);
+  } else {
+    // Rotated text (side button hints only): outer loop advances screenX, inner loop advances screenY in reverse
+    const int outerBase = cursorX + fontData->ascender - top;  // screenX = outerBase + glyphY
+    const int innerBase = cursorY - left;                      // screenY = innerBase - glyphX
 
     if (is2Bit) {
       int pixelPosition = 0;
       for (int glyphY = 0; glyphY < height; glyphY++) {
-        const int outerCoord = outerBase + glyphY;
+        const int screenX = outerBase + glyphY;
         for (int glyphX = 0; glyphX < width; glyphX++, pixelPosition++) {
-          int screenX, screenY;
-          if constexpr (rotation == TextRotation::Rotated90CW) {
-            screenX = outerCoord;
-            screenY = innerBase - glyphX;
-          } else {
-            screenX = innerBase + glyphX;
-            screenY = outerCoord;
-          }
+          const int screenY = innerBase - glyphX;
 
           const uint8_t byte = bitmap[pixelPosition >> 2];
           const uint8_t bit_index = (3 - (pixelPosition & 3)) * 2;
@@ -150,16 +139,9 @@ static void renderCharImpl(const GfxRenderer& renderer, GfxRenderer::RenderMode
     } else {
       int pixelPosition = 0;
       for (int glyphY = 0; glyphY < height; glyphY++) {
-        const int outerCoord = outerBase + glyphY;
+        const int screenX = outerBase + glyphY;
         for (int glyphX = 0; glyphX < width; glyphX++, pixelPosition++) {
-          int screenX, screenY;
-          if constexpr (rotation == TextRotation::Rotated90CW) {
-            screenX = outerCoord;
-            screenY = innerBase - glyphX;
-          } else {
-            screenX = innerBase + glyphX;
-            screenY = outerCoord;
-          }
+          const int screenY = innerBase - glyphX;
 
           const uint8_t byte = bitmap[pixelPosition >> 3];
           const uint8_t bit_index = 7 - (pixelPosition & 7);
@@ -173,6 +155,70 @@ static void renderCharImpl(const GfxRenderer& renderer, GfxRenderer::RenderMode
   }
 }
 
+template <TextRotation rotation>
+static void renderCharImpl(const GfxRenderer& renderer, GfxRenderer::RenderMode renderMode,
+                           const EpdFontFamily& fontFamily, const uint32_t cp, int cursorX, int cursorY,
+                           const bool pixelState, const EpdFontFamily::Style style) {
+  const EpdGlyph* glyph = fontFamily.getGlyph(cp, style);
+  if (!glyph) {
+    LOG_ERR("GFX", "No glyph for codepoint %d", cp);
+    return;
+  }
+  drawGlyphImpl<rotation>(renderer, renderMode, fontFamily.getData(style), glyph, cursorX, cursorY, pixelState);
+}
+
+// Horizontal text layout shared by drawText() and appendText(): combining-mark placement, ligatures and
+// differential-rounded kerning. Calls emit(cp, glyph, cursorX, baselineY) once per glyph, in drawing order.
+// glyph may be null when the font has no glyph for cp.
+template <typename Emit>
+static void layoutText(const EpdFontFamily& font, const int x, const int yPos, const char* text,
+                       const EpdFontFamily::Style style, Emit&& emit) {
+  int lastBaseX = x;
+  int lastBaseAdvanceFP = 0;  // 12.4 fixed-point
+  int lastBaseTop = 0;
+  int32_t prevAdvanceFP = 0;  // 12.4 fixed-point: prev glyph's advance + next kern for snap
+  constexpr int MIN_COMBINING_GAP_PX = 1;
+
+  uint32_t cp;
+  uint32_t prevCp = 0;
+  while ((cp = utf8NextCodepoint(reinterpret_cast<const uint8_t**>(&text)))) {
+    if (utf8IsCombiningMark(cp)) {
+      const EpdGlyph* combiningGlyph = font.getGlyph(cp, style);
+      int raiseBy = 0;
+      if (combiningGlyph) {
+        const int currentGap = combiningGlyph->top - combiningGlyph->height - lastBaseTop;
+        if (currentGap < MIN_COMBINING_GAP_PX) {
+          raiseBy = MIN_COMBINING_GAP_PX - currentGap;
+        }
+      }
+
+      const int combiningX = lastBaseX + fp4::toPixel(lastBaseAdvanceFP / 2);
+      const int combiningY = yPos - raiseBy;
+      emit(cp, combiningGlyph, combiningX, combiningY);
+      continue;
+    }
+
+    cp = font.applyLigatures(cp, text, style);
+
+    // Differential rounding: snap (previous advance + current kern) as one unit so
+    // identical character pairs always produce the same pixel step regardless of
+    // where they fall on the line.
+    if (prevCp != 0) {
+      const auto kernFP = font.getKerning(prevCp, cp, style);  // 4.4 fixed-point kern
+      lastBaseX += fp4::toPixel(prevAdvanceFP + kernFP);       // snap 12.4 fixed-point to nearest pixel
+    }
+
+    const EpdGlyph* glyph = font.getGlyph(cp, style);
+
+    lastBaseAdvanceFP = glyph ? glyph->advanceX : 0;
+    lastBaseTop = glyph ? glyph->top : 0;
+    prevAdvanceFP = lastBaseAdvanceFP;
+
+    emit(cp, glyph, lastBaseX, yPos);
+    prevCp = cp;
+  }
+}
+
 // IMPORTANT: This function is in critical rendering path and is called for every pixel. Please keep it as simple and
 // efficient as possible.
 void GfxRenderer::drawPixel(const int x, const int y, const bool state) const {
@@ -219,12 +265,6 @@ void GfxRenderer::drawCenteredText(const int fontId, const int y, const char* te
 
 void GfxRenderer::drawText(const int fontId, const int x, const int y, const char* text, const bool black,
                            const EpdFontFamily::Style style) const {
-  const int yPos = y + getFontAscenderSize(fontId);
-  int lastBaseX = x;
-  int lastBaseAdvanceFP = 0;  // 12.4 fixed-point
-  int lastBaseTop = 0;
-  int32_t prevAdvanceFP = 0;  // 12.4 fixed-point: prev glyph's advance + next kern for snap
-
   // cannot draw a NULL / empty string
   if (text == nullptr || *text == '\0') {
     return;
@@ -241,45 +281,64 @@ void GfxRenderer::drawText(const int fontId, const int x, const int y, const cha
     return;
   }
   const auto& font = fontIt->second;
-  constexpr int MIN_COMBINING_GAP_PX = 1;
-
-  uint32_t cp;
-  uint32_t prevCp = 0;
-  while ((cp = utf8NextCodepoint(reinterpret_cast<const uint8_t**>(&text)))) {
-    if (utf8IsCombiningMark(cp)) {
-      const EpdGlyph* combiningGlyph = font.getGlyph(cp, style);
-      int raiseBy = 0;
-      if (combiningGlyph) {
-        const int currentGap = combiningGlyph->top - combiningGlyph->height - lastBaseTop;
-        if (currentGap < MIN_COMBINING_GAP_PX) {
-          raiseBy = MIN_COMBINING_GAP_PX - currentGap;
-        }
-      }
-
-      const int combiningX = lastBaseX + fp4::toPixel(lastBaseAdvanceFP / 2);
-      const int combiningY = yPos - raiseBy;
-      renderCharImpl<TextRotation::None>(*this, renderMode, font, cp, combiningX, combiningY, black, style);
-      continue;
-    }
+  const EpdFontData* fontData = font.getData(style);
+  const int yPos = y + font.getData(EpdFontFamily::REGULAR)->ascender;
+
+  layoutText(font, x, yPos, text, style,
+             [&](const uint32_t cp, const EpdGlyph* glyph, const int glyphX, const int glyphY) {
+               if (!glyph) {
+                 LOG_ERR("GFX", "No glyph for codepoint %d", cp);
+                 return;
+               }
+               drawGlyphImpl<TextRotation::None>(*this, renderMode, fontData, glyph, glyphX, glyphY, black);
+             });
+}
 
-    cp = font.applyLigatures(cp, text, style);
+void GfxRenderer::appendText(GlyphDisplayList& list, const int fontId, const int x, const int y, const char* text,
+                             const bool black, const EpdFontFamily::Style style) const {
+  if (text == nullptr || *text == '\0') {
+    return;
+  }
 
-    // Differential rounding: snap (previous advance + current kern) as one unit so
-    // identical character pairs always produce the same pixel step regardless of
-    // where they fall on the line.
-    if (prevCp != 0) {
-      const auto kernFP = font.getKerning(prevCp, cp, style);  // 4.4 fixed-point kern
-      lastBaseX += fp4::toPixel(prevAdvanceFP + kernFP);       // snap 12.4 fixed-point to nearest pixel
-    }
+  const auto fontIt = fontMap.find(fontId);
+  if (fontIt == fontMap.end()) {
+    LOG_ERR("GFX", "Font %d not found", fontId);
+    return;
+  }
+  const auto& font = fontIt->second;
+  const EpdFontData* fontData = font.getData(style);
+  const uint8_t slot = list.fontSlot(fontData);
+  if (slot >= GlyphDisplayList::MAX_FONTS) {
+    LOG_ERR("GFX", "Display list font table full");
+    return;
+  }
+  const uint8_t flags =
+      (black ? GlyphDisplayList::FLAG_BLACK : 0) | (fontData->is2Bit ? GlyphDisplayList::FLAG_2BIT : 0);
+  const int yPos = y + font.getData(EpdFontFamily::REGULAR)->ascender;
+
+  layoutText(font, x, yPos, text, style,
+             [&](const uint32_t cp, const EpdGlyph* glyph, const int glyphX, const int glyphY) {
+               if (!glyph) {
+                 LOG_ERR("GFX", "No glyph for codepoint %d", cp);
+                 return;
+               }
+               list.addGlyph({glyph, static_cast<int16_t>(glyphX), static_cast<int16_t>(glyphY), slot, flags});
+             });
+}
 
-    const EpdGlyph* glyph = font.getGlyph(cp, style);
+void GfxRenderer::appendLine(GlyphDisplayList& list, const int x1, const int x2, const int y, const bool state) {
+  list.addRule({static_cast<int16_t>(x1), static_cast<int16_t>(x2), static_cast<int16_t>(y), state});
+}
 
-    lastBaseAdvanceFP = glyph ? glyph->advanceX : 0;
-    lastBaseTop = glyph ? glyph->top : 0;
-    prevAdvanceFP = lastBaseAdvanceFP;
+void GfxRenderer::drawDisplayList(const GlyphDisplayList& list) const {
+  if (fontCacheManager_ && fontCacheManager_->isScanning()) return;
 
-    renderCharImpl<TextRotation::None>(*this, renderMode, font, cp, lastBaseX, yPos, black, style);
-    prevCp = cp;
+  for (const auto& g : list.glyphs()) {
+    drawGlyphImpl<TextRotation::None>(*this, renderMode, list.font(g.font), g.glyph, g.x, g.y,
+                                      (g.flags & GlyphDisplayList::FLAG_BLACK) != 0);
+  }
+  for (const auto& r : list.rules()) {
+    drawLine(r.x1, r.y, r.x2, r.y, r.black);
   }
 }
 
@@ -1111,6 +1170,54 @@ int GfxRenderer::getTextAdvanceX(const int fontId, const char* text, EpdFontFami
   return widthPx;
 }
 
+size_t GfxRenderer::getWrapBreak(const int fontId, const char* text, const int maxWidth,
+                                 const EpdFontFamily::Style style) const {
+  const auto fontIt = fontMap.find(fontId);
+  if (fontIt == fontMap.end()) {
+    LOG_ERR("GFX", "Font %d not found", fontId);
+    return strlen(text);
+  }
+
+  const auto& font = fontIt->second;
+  const char* const start = text;
+  size_t fitBytes = 0;    // longest prefix ending on a glyph that fits
+  size_t spaceBreak = 0;  // bytes before the last space; every prefix seen so far fits
+  uint32_t cp;
+  uint32_t prevCp = 0;
+  int penX = 0;
+  int32_t prevAdvanceFP = 0;
+  while (true) {
+    const char* cpStart = text;
+    cp = utf8NextCodepoint(reinterpret_cast<const uint8_t**>(&text));
+    if (cp == 0) {
+      return text - start;
+    }
+    if (utf8IsCombiningMark(cp)) {
+      // Marks stay with their base glyph
+      if (fitBytes > 0) fitBytes = text - start;
+      continue;
+    }
+    if (cp == ' ' && cpStart != start) {
+      spaceBreak = cpStart - start;
+    }
+    cp = font.applyLigatures(cp, text, style);
+
+    // Differential rounding as in getTextAdvanceX, so the width checked here is the width drawText lays out
+    if (prevCp != 0) {
+      penX += fp4::toPixel(prevAdvanceFP + font.getKerning(prevCp, cp, style));
+    }
+    const EpdGlyph* glyph = font.getGlyph(cp, style);
+    prevAdvanceFP = glyph ? glyph->advanceX : 0;
+    prevCp = cp;
+
+    if (penX + fp4::toPixel(prevAdvanceFP) > maxWidth) {
+      if (spaceBreak > 0) return spaceBreak;
+      return fitBytes > 0 ? fitBytes : static_cast<size_t>(text - start);
+    }
+    fitBytes = text - start;
+  }
+}
+
 int GfxRenderer::getFontAscenderSize(const int fontId) const {
   const auto fontIt = fontMap.find(fontId);
   if (fontIt == fontMap.end()) {
@@ -10,6 +10,7 @@ class FontCacheManager;
 #include <vector>
 
 #include "Bitmap.h"
+#include "GlyphDisplayList.h"
 
 // Color representation: uint8_t mapped to 4x4 Bayer matrix dithering levels
 // 0 = transparent, 1-16 = gray levels (white to black)
@@ -129,6 +130,12 @@ class GfxRenderer {
                         EpdFontFamily::Style style = EpdFontFamily::REGULAR) const;
   void drawText(int fontId, int x, int y, const char* text, bool black = true,
                 EpdFontFamily::Style style = EpdFontFamily::REGULAR) const;
+  // Display-list text: lay out once with appendText()/appendLine(), then replay with drawDisplayList() for each
+  // render pass. Output is pixel-identical to drawText()/drawLine() with the same arguments.
+  void appendText(GlyphDisplayList& list, int fontId, int x, int y, const char* text, bool black = true,
+                  EpdFontFamily::Style style = EpdFontFamily::REGULAR) const;
+  static void appendLine(GlyphDisplayList& list, int x1, int x2, int y, bool state = true);
+  void drawDisplayList(const GlyphDisplayList& list) const;
   void drawButtonHints(int fontId, const char* btn1, const char* btn2, const char* btn3, const char* btn4) const;
   void drawSideButtonHints(int fontId, const char* topBtn, const char* bottomBtn) const;
   int getSpaceWidth(int fontId, EpdFontFamily::Style style = EpdFontFamily::REGULAR) const;
@@ -138,6 +145,11 @@ class GfxRenderer {
   int getKerning(int fontId, uint32_t leftCp, uint32_t rightCp, EpdFontFamily::Style style) const;
   int getTextAdvanceX(int fontId, const char* text) const;
   int getTextAdvanceX(int fontId, const char* text, EpdFontFamily::Style style) const;
+  /// Returns how many bytes of text fit in maxWidth, measured in one advance pass (same rounding as
+  /// getTextAdvanceX): strlen(text) if it all fits, else the bytes before the last fitting space, else the
+  /// longest fitting run of whole codepoints (at least one).
+  size_t getWrapBreak(int fontId, const char* text, int maxWidth,
+                      EpdFontFamily::Style style = EpdFontFamily::REGULAR) const;
   int getFontAscenderSize(int fontId) const;
   int getLineHeight(int fontId) const;
   std::string truncatedText(int fontId, const char* text, int maxWidth,
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "GfxRenderer.h"
+
+// Span-based glyph blitter for horizontal text.
+//
+// Replaces the per-pixel drawPixel() loop (orientation switch + bounds check + bit math for every set pixel) with
+// one specialisation per (Orientation, RenderMode, bit depth): the glyph is clipped against the logical screen
+// once, then each glyph row is written straight into the framebuffer.
+//   - Portrait / PortraitInverted: the panel is transposed, so a glyph row is a framebuffer column. The bit mask is
+//     fixed for the whole row and the pointer steps one panel row per pixel.
+//   - Landscape: a glyph row is a framebuffer row segment. Pixels are gathered into a bit string and merged into
+//     the row with one read-modify-write per framebuffer byte.
+//
+// Pixel selection matches the legacy renderer exactly (2-bit value v from the font, 0 = white .. 3 = black):
+//   BW:            v != 0          -> pixelState
+//   GRAYSCALE_MSB: v == 1 || v == 2 -> set bit
+//   GRAYSCALE_LSB: v == 2          -> set bit
+// 1-bit glyphs draw every set pixel with pixelState regardless of render mode.
+namespace GlyphBlitter {
+
+struct Target {
+  uint8_t* frameBuffer;
+  uint16_t panelWidth;
+  uint16_t panelHeight;
+  uint16_t panelWidthBytes;
+};
+
+template <GfxRenderer::RenderMode mode, bool is2Bit>
+inline bool pixelOn(const uint8_t* bitmap, const uint32_t pos) {
+  if constexpr (is2Bit) {
+    const uint8_t v = (bitmap[pos >> 2] >> ((3 - (pos & 3)) * 2)) & 0x3;
+    if constexpr (mode == GfxRenderer::BW) {
+      return v != 0;
+    } else if constexpr (mode == GfxRenderer::GRAYSCALE_MSB) {
+      return v == 1 || v == 2;
+    } else {
+      return v == 2;
+    }
+  } else {
+    return (bitmap[pos >> 3] >> (7 - (pos & 7))) & 1;
+  }
+}
+
+// Draws a width x height glyph bitmap whose top-left corner is at logical (x0, y0).
+template <GfxRenderer::Orientation orientation, GfxRenderer::RenderMode mode, bool is2Bit>
+void blit(const Target& t, const uint8_t* bitmap, const int width, const int height, const int x0, const int y0,
+          const bool pixelState) {
+  constexpr bool transposed = orientation == GfxRenderer::Portrait || orientation == GfxRenderer::PortraitInverted;
+  const int screenW = transposed ? t.panelHeight : t.panelWidth;
+  const int screenH = transposed ? t.panelWidth : t.panelHeight;
+
+  const int gx0 = std::max(0, -x0);
+  const int gx1 = std::min(width, screenW - x0);
+  const int gy0 = std::max(0, -y0);
+  const int gy1 = std::min(height, screenH - y0);
+  if (gx0 >= gx1 || gy0 >= gy1) return;
+
+  // Gray passes only ever flag pixels (set bit); BW and 1-bit glyphs draw in pixelState (true = clear bit)
+  const bool clearBits = (is2Bit && mode != GfxRenderer::BW) ? false : pixelState;
+  const ptrdiff_t stride = t.panelWidthBytes;
+
+  for (int gy = gy0; gy < gy1; gy++) {
+    const int sy = y0 + gy;
+    uint32_t pos = static_cast<uint32_t>(gy) * width + gx0;
+
+    if constexpr (transposed) {
+      const int sx0 = x0 + gx0;
+      constexpr bool inverted = orientation == GfxRenderer::PortraitInverted;
+      const int phyX = inverted ? t.panelWidth - 1 - sy : sy;
+      const int phyY = inverted ? sx0 : t.panelHeight - 1 - sx0;
+      const uint8_t mask = 0x80 >> (phyX & 7);
+      const ptrdiff_t step = inverted ? stride : -stride;
+      uint8_t* p = t.frameBuffer + phyY * stride + (phyX >> 3);
+      for (int gx = gx0; gx < gx1; gx++, pos++, p += step) {
+        if (pixelOn<mode, is2Bit>(bitmap, pos)) {
+          if (clearBits) {
+            *p &= ~mask;
+          } else {
+            *p |= mask;
+          }
+        }
+      }
+    } else {
+      // Gather up to 24 pixels into a bit string (leftmost physical pixel in the most significant bit), then merge
+      // it into the framebuffer row with at most four byte writes.
+      constexpr bool reversed = orientation == GfxRenderer::LandscapeClockwise;
+      const int phyY = reversed ? t.panelHeight - 1 - sy : sy;
+      uint8_t* row = t.frameBuffer + phyY * stride;
+      for (int gx = gx0; gx < gx1;) {
+        const int n = std::min(24, gx1 - gx);
+        uint32_t bits = 0;
+        for (int i = 0; i < n; i++, pos++) {
+          const uint32_t on = pixelOn<mode, is2Bit>(bitmap, pos);
+          if constexpr (reversed) {
+            bits |= on << i;  // the row runs right-to-left on the panel
+          } else {
+            bits = (bits << 1) | on;
+          }
+        }
+        if (bits != 0) {
+          const int sx = x0 + gx;
+          const int leftPhyX = reversed ? t.panelWidth - sx - n : sx;
+          const int offset = leftPhyX & 7;
+          const uint32_t aligned = bits << (32 - n - offset);
+          uint8_t* p = row + (leftPhyX >> 3);
+          const int byteCount = (offset + n + 7) >> 3;
+          for (int b = 0; b < byteCount; b++) {
+            const uint8_t m = static_cast<uint8_t>(aligned >> (24 - 8 * b));
+            if (m == 0) continue;
+            if (clearBits) {
+              p[b] &= ~m;
+            } else {
+              p[b] |= m;
+            }
+          }
+        }
+        gx += n;
+      }
+    }
+  }
+}
+
+template <GfxRenderer::Orientation orientation>
+inline void drawOriented(const Target& t, const GfxRenderer::RenderMode mode, const bool is2Bit, const uint8_t* bitmap,
+                         const int width, const int height, const int x0, const int y0, const bool pixelState) {
+  if (!is2Bit) {
+    blit<orientation, GfxRenderer::BW, false>(t, bitmap, width, height, x0, y0, pixelState);
+    return;
+  }
+  switch (mode) {
+    case GfxRenderer::BW:
+      blit<orientation, GfxRenderer::BW, true>(t, bitmap, width, height, x0, y0, pixelState);
+      break;
+    case GfxRenderer::GRAYSCALE_LSB:
+      blit<orientation, GfxRenderer::GRAYSCALE_LSB, true>(t, bitmap, width, height, x0, y0, pixelState);
+      break;
+    case GfxRenderer::GRAYSCALE_MSB:
+      blit<orientation, GfxRenderer::GRAYSCALE_MSB, true>(t, bitmap, width, height, x0, y0, pixelState);
+      break;
+  }
+}
+
+// Runtime entry point: one switch per glyph selects the specialised blitter.
+inline void draw(const Target& t, const GfxRenderer::Orientation orientation, const GfxRenderer::RenderMode mode,
+                 const bool is2Bit, const uint8_t* bitmap, const int width, const int height, const int x0,
+                 const int y0, const bool pixelState) {
+  switch (orientation) {
+    case GfxRenderer::Portrait:
+      drawOriented<GfxRenderer::Portrait>(t, mode, is2Bit, bitmap, width, height, x0, y0, pixelState);
+      break;
+    case GfxRenderer::LandscapeClockwise:
+      drawOriented<GfxRenderer::LandscapeClockwise>(t, mode, is2Bit, bitmap, width, height, x0, y0, pixelState);
+      break;
+    case GfxRenderer::PortraitInverted:
+      drawOriented<GfxRenderer::PortraitInverted>(t, mode, is2Bit, bitmap, width, height, x0, y0, pixelState);
+      break;
+    case GfxRenderer::LandscapeCounterClockwise:
+      drawOriented<GfxRenderer::LandscapeCounterClockwise>(t, mode, is2Bit, bitmap, width, height, x0, y0,
+                                                           pixelState);
+      break;
+  }
+}
+
+}  // namespace GlyphBlitter
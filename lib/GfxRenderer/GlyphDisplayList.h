@@ -0,0 +1,68 @@
+#pragma once
+
+#include <EpdFontData.h>
+
+#include <cstdint>
+#include <vector>
+
+// Pre-laid-out glyph runs for one page.
+//
+// Built once per page turn by GfxRenderer::appendText() (UTF-8 decoding, ligatures, kerning and glyph lookup
+// happen exactly once), then replayed by the prewarm scan, the BW pass and both grayscale passes via
+// GfxRenderer::drawDisplayList(). Coordinates are final logical screen coordinates (baseline-relative glyph origin).
+class GlyphDisplayList {
+ public:
+  enum Flags : uint8_t {
+    FLAG_BLACK = 1 << 0,  // pixelState passed to the renderer (false = draw white)
+    FLAG_2BIT = 1 << 1,   // glyph bitmap is 2-bit anti-aliased (otherwise 1-bit)
+  };
+
+  struct Glyph {
+    const EpdGlyph* glyph;
+    int16_t x;     // cursor X (before glyph->left)
+    int16_t y;     // baseline Y (before glyph->top)
+    uint8_t font;  // index into fonts()
+    uint8_t flags;
+  };
+
+  struct Rule {
+    int16_t x1;
+    int16_t x2;
+    int16_t y;
+    bool black;
+  };
+
+  static constexpr uint8_t MAX_FONTS = 16;
+
+  void clear() {
+    glyphs_.clear();
+    rules_.clear();
+    fontCount_ = 0;
+  }
+  void reserve(const size_t glyphCount) { glyphs_.reserve(glyphCount); }
+  bool empty() const { return glyphs_.empty() && rules_.empty(); }
+
+  // Returns the font slot for fontData, registering it on first use. Returns MAX_FONTS if the table is full.
+  uint8_t fontSlot(const EpdFontData* fontData) {
+    for (uint8_t i = 0; i < fontCount_; i++) {
+      if (fonts_[i] == fontData) return i;
+    }
+    if (fontCount_ >= MAX_FONTS) return MAX_FONTS;
+    fonts_[fontCount_] = fontData;
+    return fontCount_++;
+  }
+
+  void addGlyph(const Glyph& g) { glyphs_.push_back(g); }
+  void addRule(const Rule& r) { rules_.push_back(r); }
+
+  const std::vector<Glyph>& glyphs() const { return glyphs_; }
+  const std::vector<Rule>& rules() const { return rules_; }
+  const EpdFontData* font(const uint8_t slot) const { return fonts_[slot]; }
+  uint8_t fontCount() const { return fontCount_; }
+
+ private:
+  std::vector<Glyph> glyphs_;
+  std::vector<Rule> rules_;
+  const EpdFontData* fonts_[MAX_FONTS] = {};
+  uint8_t fontCount_ = 0;
+};
@@ -67,6 +67,9 @@ enum class StrId : uint16_t {
   STR_SLEEPING,
   STR_ENTERING_SLEEP,
   STR_BROWSE_FILES,
+  STR_TITLES,
+  STR_AUTHORS,
+  STR_SEARCH,
   STR_FILE_TRANSFER,
   STR_SETTINGS_TITLE,
   STR_CALIBRE_LIBRARY,
@@ -176,6 +179,11 @@ enum class StrId : uint16_t {
   STR_HYPHENATION,
   STR_TIME_TO_SLEEP,
   STR_SHOW_HIDDEN_FILES,
+  STR_SECTION_CACHE_LIMIT,
+  STR_SIZE_64MB,
+  STR_SIZE_256MB,
+  STR_SIZE_1GB,
+  STR_UNLIMITED,
   STR_REFRESH_FREQ,
   STR_CALIBRE_SETTINGS,
   STR_KOREADER_SYNC,
@@ -400,6 +408,7 @@ enum class StrId : uint16_t {
   STR_LOCAL_LABEL,
   STR_PAGE_OVERALL_FORMAT,
   STR_PAGE_TOTAL_OVERALL_FORMAT,
+  STR_BOOK_PAGE_FORMAT,
   STR_DEVICE_FROM_FORMAT,
   STR_APPLY_REMOTE,
   STR_UPLOAD_LOCAL,
@@ -122,7 +122,7 @@ const char* const CHARACTER_SETS[] = {
     "\n !\"%'()*+,-./0123456:=?ABCDEFGHIJKLMNOPQRSTUVWXY[]abcdefghijklmnopqrstuvwxyz|\xC2"
     "\xAB"
     "",  // English
-    "\n !\"%'()*+,-./012356:?ABCDEFGHIJKLMNOPQRSTUVWXY[]abcdefghijklmnopqrstuvwxyz|\xC2"
+    "\n !\"%'()*+,-./0123456:?ABCDEFGHIJKLMNOPQRSTUVWXY[]abcdefghijklmnopqrstuvwxyz|\xC2"
     "\xA1"
     "\xC2"
     "\xAB"
@@ -384,7 +384,7 @@ const char* const CHARACTER_SETS[] = {
     "\xD1"
     "\x91"
     "",  // Русский
-    "\n !%'()*+,-./012356:;=?ABCDEFGHIJKLMNOPQRSTUVWX[]abcdefghijklmnopqrstuvwxyz|\xC2"
+    "\n !%'()*+,-./0123456:;=?ABCDEFGHIJKLMNOPQRSTUVWX[]abcdefghijklmnopqrstuvwxyz|\xC2"
     "\xAB"
     "\xC3"
     "\x84"
@@ -988,6 +988,9 @@ const char* const STRINGS_EN[] = {
     "SLEEPING",
     "Going to sleep",
     "Browse Files",
+    "Titles",
+    "Authors",
+    "Search",
     "File Transfer",
     "Settings",
     "Calibre Library",
@@ -1097,6 +1100,11 @@ const char* const STRINGS_EN[] = {
     "Hyphenation",
     "Time to Sleep",
     "Show Hidden Files",
+    "Chapter Cache Limit",
+    "64 MB",
+    "256 MB",
+    "1 GB",
+    "Unlimited",
     "Refresh Frequency",
     "Calibre Settings",
     "KOReader Sync",
@@ -1329,6 +1337,7 @@ const char* const STRINGS_EN[] = {
     "Local:",
     "Page %d, %.2f%% overall",
     "Page %d/%d, %.2f%% overall",
+    "Page %u / %u",
     "  From: %s",
     "Apply remote progress",
     "Upload local progress",
@@ -1385,6 +1394,11 @@ const char* const STRINGS_ES[] = {
     "\xB3"
     "n",
     "Explorador de archivos",
+    "T\xC3"
+    "\xAD"
+    "tulos",
+    "Autores",
+    "Buscar",
     "Transferir archivos",
     "Ajustes",
     "Calibre Library",
@@ -1560,6 +1574,11 @@ const char* const STRINGS_ES[] = {
     "\xB3"
     "n",
     "Mostrar archivos ocultos",
+    "Chapter Cache Limit",
+    "64 MB",
+    "256 MB",
+    "1 GB",
+    "Unlimited",
     "Frecuencia de refresco",
     "Calibre Settings",
     "Sincronizaci\xC3"
@@ -1936,6 +1955,9 @@ const char* const STRINGS_ES[] = {
     "P\xC3"
     "\xA1"
     "gina %d / %d, %.2f%% completado",
+    "P\xC3"
+    "\xA1"
+    "gina %u / %u",
     "  De: %s",
     "Aplicar progreso remoto",
     "Subir progreso local",
@@ -2010,6 +2032,9 @@ const char* const STRINGS_FR[] = {
     "VEILLE",
     "Mise en veille",
     "Fichiers",
+    "Titres",
+    "Auteurs",
+    "Rechercher",
     "Transfert",
     "R\xC3"
     "\xA9"
@@ -2328,6 +2353,11 @@ const char* const STRINGS_FR[] = {
     "Afficher les fichiers cach\xC3"
     "\xA9"
     "s",
+    "Chapter Cache Limit",
+    "64 MB",
+    "256 MB",
+    "1 GB",
+    "Unlimited",
     "Fr\xC3"
     "\xA9"
     "quence rafra\xC3"
@@ -2821,6 +2851,7 @@ const char* const STRINGS_FR[] = {
     "Locale :",
     "Page %d, %.2f%% au total",
     "Page %d/%d, %.2f%% au total",
+    "Page %u / %u",
     "  De : %s",
     "Appliquer la progression en ligne",
     "Envoyer la progression locale",
@@ -2887,6 +2918,9 @@ const char* const STRINGS_DE[] = {
     "STANDBY",
     "Standby",
     "Durchsuchen",
+    "Titel",
+    "Autoren",
+    "Suchen",
     "Datentransfer",
     "Einstellungen",
     "Calibre Library",
@@ -3037,6 +3071,11 @@ const char* const STRINGS_DE[] = {
     "Silbentrennung",
     "Standby nach",
     "Versteckte Dateien anzeigen",
+    "Chapter Cache Limit",
+    "64 MB",
+    "256 MB",
+    "1 GB",
+    "Unlimited",
     "Anti-Ghosting nach",
     "Calibre Settings",
     "KOReader-Synchr.",
@@ -3362,6 +3401,7 @@ const char* const STRINGS_DE[] = {
     "Lokal:",
     "  Seite %d, %.2f%% insgesamt",
     "  Seite %d/%d, %.2f%% insgesamt",
+    "Seite %u / %u",
     "  Von: %s",
     "Externen Fortschritt \xC3"
     "\xBC"
@@ -3440,6 +3480,13 @@ const char* const STRINGS_CS[] = {
     "Proch\xC3"
     "\xA1"
     "zet soubory",
+    "N\xC3"
+    "\xA1"
+    "zvy",
+    "Auto\xC5"
+    "\x99"
+    "i",
+    "Hledat",
     "P\xC5"
     "\x99"
     "enos soubor\xC5"
@@ -3909,6 +3956,11 @@ const char* const STRINGS_CS[] = {
     "\xAD"
     "",
     "Show Hidden Files",
+    "Chapter Cache Limit",
+    "64 MB",
+    "256 MB",
+    "1 GB",
+    "Unlimited",
     "Frekvence obnoven\xC3"
     "\xAD"
     "",
@@ -4834,6 +4886,9 @@ const char* const STRINGS_CS[] = {
     "nka %d/%d, celkov\xC4"
     "\x9B"
     " %.2f%%",
+    "Str\xC3"
+    "\xA1"
+    "nka %u / %u",
     "  Od: %s",
     "Pou\xC5"
     "\xBE"
@@ -4936,6 +4991,11 @@ const char* const STRINGS_PO[] = {
     "EM REPOUSO",
     "Entrando em repouso",
     "Arquivos",
+    "T\xC3"
+    "\xAD"
+    "tulos",
+    "Autores",
+    "Pesquisar",
     "Transfer\xC3"
     "\xAA"
     "ncia",
@@ -5120,6 +5180,11 @@ const char* const STRINGS_PO[] = {
     "o",
     "Tempo para repousar",
     "Show Hidden Files",
+    "Chapter Cache Limit",
+    "64 MB",
+    "256 MB",
+    "1 GB",
+    "Unlimited",
     "Frequ\xC3"
     "\xAA"
     "ncia atualiza\xC3"
@@ -5555,6 +5620,9 @@ const char* const STRINGS_PO[] = {
     "P\xC3"
     "\xA1"
     "gina %d/%d, %.2f%% total",
+    "P\xC3"
+    "\xA1"
+    "gina %u / %u",
     "De: %s",
     "Aplicar progresso remoto",
     "Enviar progresso local",
@@ -5704,6 +5772,47 @@ const char* const STRINGS_RU[] = {
     "\xB2"
     "",
     "\xD0"
+    "\x9D"
+    "\xD0"
+    "\xB0"
+    "\xD0"
+    "\xB7"
+    "\xD0"
+    "\xB2"
+    "\xD0"
+    "\xB0"
+    "\xD0"
+    "\xBD"
+    "\xD0"
+    "\xB8"
+    "\xD1"
+    "\x8F"
+    "",
+    "\xD0"
+    "\x90"
+    "\xD0"
+    "\xB2"
+    "\xD1"
+    "\x82"
+    "\xD0"
+    "\xBE"
+    "\xD1"
+    "\x80"
+    "\xD1"
+    "\x8B"
+    "",
+    "\xD0"
+    "\x9F"
+    "\xD0"
+    "\xBE"
+    "\xD0"
+    "\xB8"
+    "\xD1"
+    "\x81"
+    "\xD0"
+    "\xBA"
+    "",
+    "\xD0"
     "\x9F"
     "\xD0"
     "\xB5"
@@ -7886,6 +7995,11 @@ const char* const STRINGS_RU[] = {
     "\xD1"
     "\x8B"
     "",
+    "Chapter Cache Limit",
+    "64 MB",
+    "256 MB",
+    "1 GB",
+    "Unlimited",
     "\xD0"
     "\xA7"
     "\xD0"
@@ -12655,6 +12769,23 @@ const char* const STRINGS_RU[] = {
     "\xB0"
     " %d/%d",
     "\xD0"
+    "\xA1"
+    "\xD1"
+    "\x82"
+    "\xD1"
+    "\x80"
+    "\xD0"
+    "\xB0"
+    "\xD0"
+    "\xBD"
+    "\xD0"
+    "\xB8"
+    "\xD1"
+    "\x86"
+    "\xD0"
+    "\xB0"
+    " %u / %u",
+    "\xD0"
     "\x9E"
     "\xD1"
     "\x82"
@@ -13343,6 +13474,13 @@ const char* const STRINGS_SV[] = {
     "\x80"
     "\xA6"
     "",
+    "Titlar",
+    "F\xC3"
+    "\xB6"
+    "rfattare",
+    "S\xC3"
+    "\xB6"
+    "k",
     "Fil\xC3"
     "\xB6"
     "verf\xC3"
@@ -13617,6 +13755,11 @@ const char* const STRINGS_SV[] = {
     "\xA5"
     " i vila",
     "Visa dolda filer",
+    "Chapter Cache Limit",
+    "64 MB",
+    "256 MB",
+    "1 GB",
+    "Unlimited",
     "Uppdateringsfrekvens",
     "Calibre Settings",
     "KOReader-synkronisering",
@@ -14078,6 +14221,7 @@ const char* const STRINGS_SV[] = {
     "Lokalt:",
     "Sida %d, %.2f%% totalt",
     "Sida %d/%d, %.2f%% totalt",
+    "Sida %u / %u",
     "  Fr\xC3"
     "\xA5"
     "n: %s",
@@ -14168,6 +14312,11 @@ const char* const STRINGS_RO[] = {
     "te fi\xC5"
     "\x9F"
     "ierele",
+    "Titluri",
+    "Autori",
+    "C\xC4"
+    "\x83"
+    "utare",
     "Transfer de fi\xC5"
     "\x9F"
     "iere",
@@ -14459,6 +14608,11 @@ const char* const STRINGS_RO[] = {
     " fi\xC5"
     "\x9F"
     "ierele ascunse",
+    "Chapter Cache Limit",
+    "64 MB",
+    "256 MB",
+    "1 GB",
+    "Unlimited",
     "Frecven\xC5"
     "\xA3"
     "\xC4"
@@ -15013,6 +15167,7 @@ const char* const STRINGS_RO[] = {
     "Local:",
     "Pagina %d, %.2f%% din total",
     "Pagina %d/%d, %.2f%% din total",
+    "Pagina %u / %u",
     "  De la: %s",
     "Aplic\xC4"
     "\x83"
@@ -15127,6 +15282,11 @@ const char* const STRINGS_CA[] = {
     "\xB2"
     "s",
     "Explora fitxers",
+    "T\xC3"
+    "\xAD"
+    "tols",
+    "Autors",
+    "Cerca",
     "Transfer\xC3"
     "\xA8"
     "ncia",
@@ -15314,6 +15474,11 @@ const char* const STRINGS_CA[] = {
     "\xB2"
     "s",
     "Mostra fitxers ocults",
+    "Chapter Cache Limit",
+    "64 MB",
+    "256 MB",
+    "1 GB",
+    "Unlimited",
     "Freq\xC3"
     "\xBC"
     "\xC3"
@@ -15726,6 +15891,9 @@ const char* const STRINGS_CA[] = {
     "P\xC3"
     "\xA0"
     "gina %d/%d, %.2f%% total",
+    "P\xC3"
+    "\xA0"
+    "gina %u / %u",
     "  De: %s",
     "Aplica el progr\xC3"
     "\xA9"
@@ -15903,6 +16071,41 @@ const char* const STRINGS_UK[] = {
     "\xB2"
     "",
     "\xD0"
+    "\x9D"
+    "\xD0"
+    "\xB0"
+    "\xD0"
+    "\xB7"
+    "\xD0"
+    "\xB2"
+    "\xD0"
+    "\xB8"
+    "",
+    "\xD0"
+    "\x90"
+    "\xD0"
+    "\xB2"
+    "\xD1"
+    "\x82"
+    "\xD0"
+    "\xBE"
+    "\xD1"
+    "\x80"
+    "\xD0"
+    "\xB8"
+    "",
+    "\xD0"
+    "\x9F"
+    "\xD0"
+    "\xBE"
+    "\xD1"
+    "\x88"
+    "\xD1"
+    "\x83"
+    "\xD0"
+    "\xBA"
+    "",
+    "\xD0"
     "\x9F"
     "\xD0"
     "\xB5"
@@ -18435,6 +18638,11 @@ const char* const STRINGS_UK[] = {
     "\xD0"
     "\xB8"
     "",
+    "Chapter Cache Limit",
+    "64 MB",
+    "256 MB",
+    "1 GB",
+    "Unlimited",
     "\xD0"
     "\xA7"
     "\xD0"
@@ -23683,6 +23891,23 @@ const char* const STRINGS_UK[] = {
     "\xD0"
     "\xBC"
     "",
+    "\xD0"
+    "\xA1"
+    "\xD1"
+    "\x82"
+    "\xD0"
+    "\xBE"
+    "\xD1"
+    "\x80"
+    "\xD1"
+    "\x96"
+    "\xD0"
+    "\xBD"
+    "\xD0"
+    "\xBA"
+    "\xD0"
+    "\xB0"
+    " %u / %u",
     "  \xD0"
     "\x92"
     "\xD1"
@@ -24526,6 +24751,41 @@ const char* const STRINGS_BE[] = {
     "\x9E"
     "",
     "\xD0"
+    "\x9D"
+    "\xD0"
+    "\xB0"
+    "\xD0"
+    "\xB7"
+    "\xD0"
+    "\xB2"
+    "\xD1"
+    "\x8B"
+    "",
+    "\xD0"
+    "\x90"
+    "\xD1"
+    "\x9E"
+    "\xD1"
+    "\x82"
+    "\xD0"
+    "\xB0"
+    "\xD1"
+    "\x80"
+    "\xD1"
+    "\x8B"
+    "",
+    "\xD0"
+    "\x9F"
+    "\xD0"
+    "\xBE"
+    "\xD1"
+    "\x88"
+    "\xD1"
+    "\x83"
+    "\xD0"
+    "\xBA"
+    "",
+    "\xD0"
     "\x9F"
     "\xD0"
     "\xB5"
@@ -26780,6 +27040,11 @@ const char* const STRINGS_BE[] = {
     "\xD1"
     "\x8B"
     "",
+    "Chapter Cache Limit",
+    "64 MB",
+    "256 MB",
+    "1 GB",
+    "Unlimited",
     "\xD0"
     "\xA7"
     "\xD0"
@@ -31603,6 +31868,23 @@ const char* const STRINGS_BE[] = {
     "\xBE"
     "",
     "\xD0"
+    "\xA1"
+    "\xD1"
+    "\x82"
+    "\xD0"
+    "\xB0"
+    "\xD1"
+    "\x80"
+    "\xD0"
+    "\xBE"
+    "\xD0"
+    "\xBD"
+    "\xD0"
+    "\xBA"
+    "\xD0"
+    "\xB0"
+    " %u / %u",
+    "\xD0"
     "\x90"
     "\xD0"
     "\xB4"
@@ -32346,6 +32628,9 @@ const char* const STRINGS_IT[] = {
     "\xA0"
     " Sleep",
     "Sfoglia file",
+    "Titoli",
+    "Autori",
+    "Cerca",
     "Trasferimento file",
     "Impostazioni",
     "Calibre Library",
@@ -32459,6 +32744,11 @@ const char* const STRINGS_IT[] = {
     "Sillabazione",
     "Tempo prima di sospensione",
     "Show Hidden Files",
+    "Chapter Cache Limit",
+    "64 MB",
+    "256 MB",
+    "1 GB",
+    "Unlimited",
     "Frequenza di aggiornamento",
     "Calibre Settings",
     "Sincronizzazione KOReader",
@@ -32719,6 +33009,7 @@ const char* const STRINGS_IT[] = {
     "Locale:",
     "Pagina %d, %.2f%% in totale",
     "Pagina %d/%d, %.2f%% in totale",
+    "Pagina %u / %u",
     "  Da: %s",
     "Applica progressi remoti",
     "Carica progressi locali",
@@ -32783,6 +33074,11 @@ const char* const STRINGS_PL[] = {
     "Przegl\xC4"
     "\x85"
     "daj pliki",
+    "Tytu\xC5"
+    "\x82"
+    "y",
+    "Autorzy",
+    "Szukaj",
     "Transfer plik\xC3"
     "\xB3"
     "w",
@@ -33056,6 +33352,11 @@ const char* const STRINGS_PL[] = {
     "Poka\xC5"
     "\xBC"
     " ukryte pliki",
+    "Chapter Cache Limit",
+    "64 MB",
+    "256 MB",
+    "1 GB",
+    "Unlimited",
     "Cz\xC4"
     "\x99"
     "stotliwo\xC5"
@@ -33674,6 +33975,7 @@ const char* const STRINGS_PL[] = {
     "o\xC5"
     "\x9B"
     "ci",
+    "Strona %u / %u",
     "  Od: %s",
     "Zastosuj zdalny post\xC4"
     "\x99"
@@ -33768,6 +34070,9 @@ const char* const STRINGS_FI[] = {
     "\xA4"
     "n lepotilaan",
     "Selaa tiedostoja",
+    "Nimet",
+    "Kirjailijat",
+    "Haku",
     "Tiedostonsiirto",
     "Asetukset",
     "Calibre Library",
@@ -33975,6 +34280,11 @@ const char* const STRINGS_FI[] = {
     "Tavutus",
     "Aika lepotilaan",
     "Show Hidden Files",
+    "Chapter Cache Limit",
+    "64 MB",
+    "256 MB",
+    "1 GB",
+    "Unlimited",
     "P\xC3"
     "\xA4"
     "ivitystaajuus",
@@ -34479,6 +34789,7 @@ const char* const STRINGS_FI[] = {
     "Paikallinen:",
     "Sivu %d, %.2f%% kokonaisuudesta",
     "Sivu %d/%d, %.2f%% kokonaisuudesta",
+    "Sivu %u / %u",
     "  L\xC3"
     "\xA4"
     "hde: %s",
@@ -34573,6 +34884,11 @@ const char* const STRINGS_DA[] = {
     "Gennems\xC3"
     "\xB8"
     "g filer",
+    "Titler",
+    "Forfattere",
+    "S\xC3"
+    "\xB8"
+    "g",
     "Filoverf\xC3"
     "\xB8"
     "relse",
@@ -34764,6 +35080,11 @@ const char* const STRINGS_DA[] = {
     "Orddeling",
     "Tid til hvile",
     "Vis skjulte filer",
+    "Chapter Cache Limit",
+    "64 MB",
+    "256 MB",
+    "1 GB",
+    "Unlimited",
     "Opdateringsfrekvens",
     "Calibre Settings",
     "KOReader Sync",
@@ -35100,6 +35421,7 @@ const char* const STRINGS_DA[] = {
     "Lokal:",
     "Side %d, %.2f%% samlet",
     "Side %d/%d, %.2f%% samlet",
+    "Side %u / %u",
     "  Fra: %s",
     "Anvend fjernfremskridt",
     "Upload lokalt fremskridt",
@@ -35162,6 +35484,9 @@ const char* const STRINGS_NL[] = {
     "SLAAPSTAND",
     "Gaat in slaapstand",
     "Bestanden bladeren",
+    "Titels",
+    "Auteurs",
+    "Zoeken",
     "Bestandsoverdracht",
     "Instellingen",
     "Calibre Library",
@@ -35271,6 +35596,11 @@ const char* const STRINGS_NL[] = {
     "Woordafbreking",
     "Tijd tot slaapstand",
     "Toon verborgen bestanden",
+    "Chapter Cache Limit",
+    "64 MB",
+    "256 MB",
+    "1 GB",
+    "Unlimited",
     "Verversingsfrequentie",
     "Calibre Settings",
     "KOReader Sync",
@@ -35507,6 +35837,7 @@ const char* const STRINGS_NL[] = {
     "Lokaal:",
     "Pagina %d, %.2f%% totaal",
     "Pagina %d/%d, %.2f%% totaal",
+    "Pagina %u / %u",
     "  Van: %s",
     "Externe voortgang toepassen",
     "Lokale voortgang uploaden",
@@ -35569,6 +35900,13 @@ const char* const STRINGS_TR[] = {
     "Dosyalara G\xC3"
     "\xB6"
     "z At",
+    "Ba\xC5"
+    "\x9F"
+    "l\xC4"
+    "\xB1"
+    "klar",
+    "Yazarlar",
+    "Ara",
     "Dosya Transferi",
     "Ayarlar",
     "Calibre Library",
@@ -35958,6 +36296,11 @@ const char* const STRINGS_TR[] = {
     " G\xC3"
     "\xB6"
     "ster",
+    "Chapter Cache Limit",
+    "64 MB",
+    "256 MB",
+    "1 GB",
+    "Unlimited",
     "Yenileme S\xC4"
     "\xB1"
     "kl\xC4"
@@ -36742,6 +37085,7 @@ const char* const STRINGS_TR[] = {
     "Yerel:",
     "Sayfa %d, genel %.2f%%",
     "Sayfa %d/%d, genel %.2f%%",
+    "Sayfa %u / %u",
     "  \xC5"
     "\x9E"
     "uradan: %s",
@@ -36927,6 +37271,49 @@ const char* const STRINGS_KK[] = {
     "\x80"
     "",
     "\xD0"
+    "\x90"
+    "\xD1"
+    "\x82"
+    "\xD0"
+    "\xB0"
+    "\xD1"
+    "\x83"
+    "\xD0"
+    "\xBB"
+    "\xD0"
+    "\xB0"
+    "\xD1"
+    "\x80"
+    "",
+    "\xD0"
+    "\x90"
+    "\xD0"
+    "\xB2"
+    "\xD1"
+    "\x82"
+    "\xD0"
+    "\xBE"
+    "\xD1"
+    "\x80"
+    "\xD0"
+    "\xBB"
+    "\xD0"
+    "\xB0"
+    "\xD1"
+    "\x80"
+    "",
+    "\xD0"
+    "\x86"
+    "\xD0"
+    "\xB7"
+    "\xD0"
+    "\xB4"
+    "\xD0"
+    "\xB5"
+    "\xD1"
+    "\x83"
+    "",
+    "\xD0"
     "\xA4"
     "\xD0"
     "\xB0"
@@ -39115,6 +39502,11 @@ const char* const STRINGS_KK[] = {
     "\x8B"
     "",
     "Show Hidden Files",
+    "Chapter Cache Limit",
+    "64 MB",
+    "256 MB",
+    "1 GB",
+    "Unlimited",
     "\xD0"
     "\x96"
     "\xD0"
@@ -43945,6 +44337,13 @@ const char* const STRINGS_KK[] = {
     "\xD1"
     "\x8B"
     " %.2f%%",
+    "%u / %u-\xD0"
+    "\xB1"
+    "\xD0"
+    "\xB5"
+    "\xD1"
+    "\x82"
+    "",
     "  \xD0"
     "\x91"
     "\xD0"
@@ -44669,6 +45068,15 @@ const char* const STRINGS_HU[] = {
     "sz\xC3"
     "\xA9"
     "se",
+    "C\xC3"
+    "\xAD"
+    "mek",
+    "Szerz\xC5"
+    "\x91"
+    "k",
+    "Keres\xC3"
+    "\xA9"
+    "s",
     "F\xC3"
     "\xA1"
     "jl\xC3"
@@ -45094,6 +45502,11 @@ const char* const STRINGS_HU[] = {
     "t\xC3"
     "\xA9"
     "se",
+    "Chapter Cache Limit",
+    "64 MB",
+    "256 MB",
+    "1 GB",
+    "Unlimited",
     "Friss\xC3"
     "\xAD"
     "t\xC3"
@@ -45982,6 +46395,7 @@ const char* const STRINGS_HU[] = {
     "%d/%d. oldal, %.2f%% \xC3"
     "\xB6"
     "sszesen",
+    "%u / %u. oldal",
     "  Forr\xC3"
     "\xA1"
     "s: %s",
@@ -46108,6 +46522,11 @@ const char* const STRINGS_LT[] = {
     "\xBE"
     "miegama",
     "Failai",
+    "Pavadinimai",
+    "Autoriai",
+    "Paie\xC5"
+    "\xA1"
+    "ka",
     "Si\xC5"
     "\xB3"
     "sti failus",
@@ -46357,6 +46776,11 @@ const char* const STRINGS_LT[] = {
     "Rod. pasl\xC4"
     "\x97"
     "ptus failus",
+    "Chapter Cache Limit",
+    "64 MB",
+    "256 MB",
+    "1 GB",
+    "Unlimited",
     "Atnaujinimo da\xC5"
     "\xBE"
     "nis",
@@ -46789,6 +47213,7 @@ const char* const STRINGS_LT[] = {
     "Vietinis:",
     "Psl %d, %.2f%% bendrai",
     "Psl %d/%d, %.2f%% bendrai",
+    "Psl %u / %u",
     " I\xC5"
     "\xA1"
     ": %s",
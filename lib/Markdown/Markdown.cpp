@@ -280,6 +280,26 @@ bool isFenceEnd(const std::string& line, const std::string& fence) {
   return true;
 }
 
+// After a blank line, whether line opens a new top-level block rather than continuing a list item, a definition or
+// indented code, so the streaming pipeline may start a new chunk before it
+bool canStartChunk(const std::string& line) {
+  if (line.empty()) {
+    return false;
+  }
+  const char first = line[0];
+  if (first == ' ' || first == '\t' || first == ':') {
+    return false;
+  }
+  if ((first == '-' || first == '*' || first == '+') && line.size() > 1 && (line[1] == ' ' || line[1] == '\t')) {
+    return false;
+  }
+  size_t digits = 0;
+  while (digits < line.size() && digits < 9 && std::isdigit(static_cast<unsigned char>(line[digits]))) {
+    digits++;
+  }
+  return !(digits > 0 && digits < line.size() && (line[digits] == '.' || line[digits] == ')'));
+}
+
 std::string normalizeSlug(const std::string& input) {
   std::string slug;
   bool prevHyphen = false;
@@ -989,31 +1009,6 @@ std::string Markdown::stripBlockId(const std::string& line) {
   return line.substr(0, trim) + line.substr(end);
 }
 
-std::string Markdown::getContent() const {
-  if (!loaded) {
-    return "";
-  }
-
-  FsFile file;
-  if (!Storage.openFileForRead("MD ", filepath, file)) {
-    return "";
-  }
-
-  std::string content;
-  content.reserve(fileSize + 1);
-  uint8_t buffer[1024];
-  while (file.available()) {
-    const size_t readSize = file.read(buffer, sizeof(buffer));
-    if (readSize == 0) {
-      break;
-    }
-    content.append(reinterpret_cast<const char*>(buffer), readSize);
-  }
-  file.close();
-
-  return content;
-}
-
 std::string Markdown::preprocessContent(std::string content, int depth, std::vector<std::string>& stack) const {
   if (depth > MAX_EMBED_DEPTH) {
     return "[Embedded note omitted]";
@@ -1027,8 +1022,10 @@ std::string Markdown::preprocessContent(std::string content, int depth, std::vec
   content.clear();
   content.shrink_to_fit();
 
-  processed = stripComments(processed);
+  return preprocessBody(stripComments(processed), depth, stack);
+}
 
+std::string Markdown::preprocessBody(std::string processed, int depth, std::vector<std::string>& stack) const {
   bool inFence = false;
   std::string fence;
 
@@ -1365,33 +1362,204 @@ std::string Markdown::preprocessContent(std::string content, int depth, std::vec
   return output;
 }
 
-bool Markdown::parseToAst() {
+bool Markdown::streamBlocks(const BlockCallback& onBlock, const std::function<void(int)>& progressFn) const {
   if (!loaded) {
     return false;
   }
 
-  std::string content = getContent();
-  if (content.empty()) {
+  FsFile file;
+  if (!Storage.openFileForRead("MD ", filepath, file)) {
     return false;
   }
 
   MarkdownParser parser;
   std::vector<std::string> stack;
   stack.push_back(filepath);
-  std::string processed = preprocessContent(std::move(content), 0, stack);
+  bool aborted = false;
+  size_t blockCount = 0;
 
-  ast = parser.parse(processed);
+  // Stage 3: collect lines into chunks of whole top-level blocks and run each through preprocessing and md4c
+  std::string chunk;
+  chunk.reserve(STREAM_CHUNK_TARGET);
+  bool inFence = false;
+  bool afterBlank = false;
+  std::string fence;
+  std::string fenceOpenLine;
 
-  if (!ast) {
-    LOG_ERR("MD", "Failed to parse markdown to AST");
-    return false;
-  }
+  auto flushChunk = [&]() {
+    if (chunk.empty() || aborted) {
+      chunk.clear();
+      return;
+    }
+    const std::string processed = preprocessBody(std::move(chunk), 0, stack);
+    chunk.clear();
+    const bool parsed = parser.parseBlocks(processed, [&](const MdNode& block) {
+      blockCount++;
+      if (!onBlock(block)) {
+        aborted = true;
+      }
+      return !aborted;
+    });
+    if (!parsed && !aborted) {
+      // The blocks before the failure are already out; skip the rest of this chunk only
+      LOG_WRN("MD", "Skipped unparsable markdown after block %zu", blockCount);
+    }
+  };
+
+  auto addLine = [&](const std::string& line) {
+    const bool blank = line.find_first_not_of(" \t\r") == std::string::npos;
+    if (!inFence && afterBlank && !blank && chunk.size() >= STREAM_CHUNK_TARGET && canStartChunk(line)) {
+      flushChunk();
+    } else if (chunk.size() + line.size() >= STREAM_CHUNK_MAX) {
+      if (inFence) {
+        // Close the fence for this chunk and reopen it in the next so the code block survives the cut
+        chunk += fence;
+        chunk += '\n';
+        flushChunk();
+        chunk += fenceOpenLine;
+        chunk += '\n';
+      } else {
+        flushChunk();
+      }
+    }
+
+    chunk += line;
+    chunk += '\n';
 
-  // Build navigation data from AST
-  navigation = md_detail::make_unique<MarkdownNavigation>(*ast);
+    if (inFence) {
+      if (isFenceEnd(line, fence)) {
+        inFence = false;
+        fence.clear();
+      }
+    } else if (isFenceStart(line, fence)) {
+      inFence = true;
+      fenceOpenLine = line;
+    }
+    afterBlank = !inFence && blank;
+  };
 
-  LOG_INF("MD", "Parsed to AST: %zu TOC entries, %zu links", navigation->getTotalHeadings(),
-          navigation->getTotalLinks());
+  // Stage 2: drop %% comments, which may span lines
+  std::string logical;
+  bool inComment = false;
+  auto addContentLine = [&](const std::string& raw) {
+    size_t i = 0;
+    while (i < raw.size()) {
+      if (inComment) {
+        const size_t end = raw.find("%%", i);
+        if (end == std::string::npos) {
+          break;
+        }
+        inComment = false;
+        i = end + 2;
+        continue;
+      }
+      const size_t start = raw.find("%%", i);
+      if (start == std::string::npos) {
+        logical.append(raw, i, std::string::npos);
+        break;
+      }
+      logical.append(raw, i, start - i);
+      inComment = true;
+      i = start + 2;
+    }
+    if (!inComment || logical.size() >= STREAM_CHUNK_MAX) {
+      addLine(logical);
+      logical.clear();
+    }
+  };
 
+  // Stage 1: hold back a leading frontmatter block until its closing line shows it really is one
+  enum class Frontmatter : uint8_t { Unknown, Inside, Done };
+  Frontmatter frontmatter = Frontmatter::Unknown;
+  std::string frontmatterLines;
+  auto replayFrontmatter = [&]() {
+    size_t pos = 0;
+    while (pos < frontmatterLines.size()) {
+      const size_t end = frontmatterLines.find('\n', pos);
+      addContentLine(frontmatterLines.substr(pos, end - pos));
+      pos = end + 1;
+    }
+    frontmatterLines.clear();
+    frontmatterLines.shrink_to_fit();
+  };
+  auto addRawLine = [&](const std::string& raw) {
+    const bool isDelimiter = raw == "---" || raw == "---\r";
+    if (frontmatter == Frontmatter::Unknown) {
+      frontmatter = isDelimiter ? Frontmatter::Inside : Frontmatter::Done;
+      if (isDelimiter) {
+        frontmatterLines = raw + '\n';
+        return;
+      }
+    } else if (frontmatter == Frontmatter::Inside) {
+      if (isDelimiter) {
+        frontmatter = Frontmatter::Done;
+        frontmatterLines.clear();
+        frontmatterLines.shrink_to_fit();
+        return;
+      }
+      frontmatterLines += raw;
+      frontmatterLines += '\n';
+      if (frontmatterLines.size() >= STREAM_CHUNK_MAX) {
+        // Too long to be metadata; render it like the rest
+        frontmatter = Frontmatter::Done;
+        replayFrontmatter();
+      }
+      return;
+    }
+    addContentLine(raw);
+  };
+
+  uint8_t buffer[1024];
+  std::string raw;
+  size_t bytesRead = 0;
+  int lastProgress = -1;
+  while (!aborted && file.available()) {
+    const int readSize = file.read(buffer, sizeof(buffer));
+    if (readSize <= 0) {
+      break;
+    }
+    for (int i = 0; i < readSize && !aborted; i++) {
+      const char c = static_cast<char>(buffer[i]);
+      if (c == '\n') {
+        addRawLine(raw);
+        raw.clear();
+        continue;
+      }
+      // Cut overlong lines, but not inside a UTF-8 sequence
+      if (raw.size() >= STREAM_CHUNK_MAX && (static_cast<uint8_t>(c) & 0xC0) != 0x80) {
+        addRawLine(raw);
+        raw.clear();
+      }
+      raw.push_back(c);
+    }
+
+    bytesRead += static_cast<size_t>(readSize);
+    if (progressFn && fileSize > 0) {
+      const int progress = static_cast<int>(std::min<size_t>(100, bytesRead * 100 / fileSize));
+      if (progress != lastProgress) {
+        lastProgress = progress;
+        progressFn(progress);
+      }
+    }
+  }
+  file.close();
+
+  if (!raw.empty()) {
+    addRawLine(raw);
+  }
+  if (frontmatter == Frontmatter::Inside) {
+    // Never closed: not frontmatter after all
+    replayFrontmatter();
+  }
+  if (!logical.empty()) {
+    addLine(logical);
+  }
+  flushChunk();
+
+  if (aborted) {
+    LOG_ERR("MD", "Markdown stream stopped after %zu blocks", blockCount);
+    return false;
+  }
+  LOG_INF("MD", "Streamed %zu blocks from %zu bytes", blockCount, bytesRead);
   return true;
 }
@@ -1,11 +1,10 @@
 #pragma once
 
-#include <memory>
+#include <functional>
 #include <string>
 #include <vector>
 
 #include "MarkdownAST.h"
-#include "MarkdownNavigation.h"
 
 class Markdown {
  public:
@@ -23,15 +22,16 @@ class Markdown {
   // Legacy HTML-based pipeline
   bool ensureHtml();
 
-  // AST-based pipeline
-  bool parseToAst();
-  bool hasAst() const { return ast != nullptr; }
-  const MdNode* getAst() const { return ast.get(); }
-  MarkdownNavigation* getNavigation() { return navigation.get(); }
-  const MarkdownNavigation* getNavigation() const { return navigation.get(); }
+  // Streaming pipeline. Reads, preprocesses and parses the file a few kilobytes at a time, handing each top-level
+  // block to onBlock in document order; onBlock returning false stops the stream. progressFn gets 0-100 by bytes read.
+  // Memory use is bounded by STREAM_CHUNK_MAX whatever the file size.
+  using BlockCallback = std::function<bool(const MdNode& block)>;
+  bool streamBlocks(const BlockCallback& onBlock, const std::function<void(int)>& progressFn = nullptr) const;
 
-  // Get raw content (for AST parsing)
-  std::string getContent() const;
+  // Chunks handed to md4c end at a blank line before a top-level block once they reach this size
+  static constexpr size_t STREAM_CHUNK_TARGET = 8 * 1024;
+  // Chunks and single lines are cut at this size even inside a block
+  static constexpr size_t STREAM_CHUNK_MAX = 32 * 1024;
 
  private:
   std::string filepath;
@@ -40,10 +40,6 @@ class Markdown {
   size_t fileSize = 0;
   bool loaded = false;
 
-  // AST data
-  std::unique_ptr<MdNode> ast;
-  std::unique_ptr<MarkdownNavigation> navigation;
-
   bool renderToHtmlFile(const std::string& htmlPath) const;
   static std::string stripFrontmatter(const std::string& content);
   static std::string stripComments(const std::string& content);
@@ -52,4 +48,6 @@ class Markdown {
   static std::string stripBlockId(const std::string& line);
   static std::string formatCalloutLine(const std::string& line);
   std::string preprocessContent(std::string content, int depth, std::vector<std::string>& stack) const;
+  // preprocessContent() after frontmatter and comments are gone
+  std::string preprocessBody(std::string processed, int depth, std::vector<std::string>& stack) const;
 };
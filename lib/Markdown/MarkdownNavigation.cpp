@@ -2,6 +2,7 @@
 
 #include <Arduino.h>
 #include <Logging.h>
+#include <Serialization.h>
 
 #include <algorithm>
 #include <cctype>
@@ -28,11 +29,35 @@ std::string normalizeSlug(const std::string& input) {
   }
   return slug;
 }
+
+// Cuts text to MarkdownNavigation::MAX_ENTRY_TEXT bytes without splitting a UTF-8 sequence
+std::string clampText(std::string text) {
+  if (text.size() <= MarkdownNavigation::MAX_ENTRY_TEXT) {
+    return text;
+  }
+  size_t len = MarkdownNavigation::MAX_ENTRY_TEXT;
+  while (len > 0 && (static_cast<uint8_t>(text[len]) & 0xC0) == 0x80) {
+    len--;
+  }
+  text.resize(len);
+  return text;
+}
+
+constexpr uint8_t NAVIGATION_INDEX_VERSION = 1;
 }  // namespace
 
-MarkdownNavigation::MarkdownNavigation(const MdNode& root) {
-  size_t nodeIndex = 0;
-  extractFromNode(root, nodeIndex, 0);
+void MarkdownNavigation::addBlock(const MdNode& block, const size_t page) {
+  blockPage = page;
+  extractFromNode(block, nextNodeIndex, 0);
+}
+
+void MarkdownNavigation::clear() {
+  toc.clear();
+  links.clear();
+  headingRefs.clear();
+  nextNodeIndex = 0;
+  blockPage = 0;
+  depthLimitExceeded = false;
 }
 
 void MarkdownNavigation::extractFromNode(const MdNode& node, size_t& nodeIndex, size_t depth) {
@@ -75,21 +100,21 @@ void MarkdownNavigation::extractFromNode(const MdNode& node, size_t& nodeIndex,
 }
 
 void MarkdownNavigation::extractHeading(const MdNode& node, size_t nodeIndex) {
-  if (!node.heading) {
+  if (!node.heading || toc.size() >= MAX_TOC_ENTRIES) {
     return;
   }
 
   TocEntry entry;
   entry.level = node.heading->level;
-  entry.title = node.getPlainText();
+  entry.title = clampText(node.getPlainText());
   entry.nodeIndex = nodeIndex;
-  entry.estimatedPage = 0;  // Updated later
+  entry.estimatedPage = blockPage;
 
   toc.push_back(std::move(entry));
 
   HeadingRef ref;
   ref.nodeIndex = nodeIndex;
-  ref.pageNumber = 0;
+  ref.pageNumber = blockPage;
   ref.level = node.heading->level;
   headingRefs.push_back(ref);
 }
@@ -98,43 +123,39 @@ void MarkdownNavigation::extractLink(const MdNode& node, size_t nodeIndex) {
   if (!node.link) {
     return;
   }
-
-  LinkEntry entry;
-  entry.text = node.getPlainText();
-  entry.href = node.link->href;
-  entry.isInternal = isInternalLink(node.link->href);
-  entry.isImage = false;
-  entry.nodeIndex = nodeIndex;
-
-  links.push_back(std::move(entry));
+  addLink(node.getPlainText(), node.link->href, isInternalLink(node.link->href), false, nodeIndex);
 }
 
 void MarkdownNavigation::extractWikiLink(const MdNode& node, size_t nodeIndex) {
   if (!node.wikiLink) {
     return;
   }
-
-  LinkEntry entry;
-  entry.text = node.wikiLink->alias.empty() ? node.wikiLink->target : node.wikiLink->alias;
-  entry.href = node.wikiLink->target;
-  entry.isInternal = true;  // Wikilinks are always internal
-  entry.isImage = false;
-  entry.nodeIndex = nodeIndex;
-
-  links.push_back(std::move(entry));
+  // Wikilinks are always internal
+  addLink(node.wikiLink->alias.empty() ? node.wikiLink->target : node.wikiLink->alias, node.wikiLink->target, true,
+          false, nodeIndex);
 }
 
 void MarkdownNavigation::extractImage(const MdNode& node, size_t nodeIndex) {
   if (!node.image) {
     return;
   }
+  // Text is the alt text
+  addLink(node.getPlainText(), node.image->src, isInternalLink(node.image->src), true, nodeIndex);
+}
+
+void MarkdownNavigation::addLink(std::string text, std::string href, const bool isInternal, const bool isImage,
+                                 const size_t nodeIndex) {
+  if (links.size() >= MAX_LINK_ENTRIES) {
+    return;
+  }
 
   LinkEntry entry;
-  entry.text = node.getPlainText();  // Alt text
-  entry.href = node.image->src;
-  entry.isInternal = isInternalLink(node.image->src);
-  entry.isImage = true;
+  entry.text = clampText(std::move(text));
+  entry.href = clampText(std::move(href));
+  entry.isInternal = isInternal;
+  entry.isImage = isImage;
   entry.nodeIndex = nodeIndex;
+  entry.pageNumber = blockPage;
 
   links.push_back(std::move(entry));
 }
@@ -170,18 +191,75 @@ bool MarkdownNavigation::isInternalLink(const std::string& href) {
   return true;
 }
 
-void MarkdownNavigation::updatePageNumbers(const std::vector<size_t>& nodeToPage) {
-  for (auto& entry : toc) {
-    if (entry.nodeIndex < nodeToPage.size()) {
-      entry.estimatedPage = nodeToPage[entry.nodeIndex];
+bool MarkdownNavigation::serialize(FsFile& file) const {
+  serialization::writePod(file, NAVIGATION_INDEX_VERSION);
+  serialization::writePod(file, static_cast<uint16_t>(toc.size()));
+  for (const auto& entry : toc) {
+    serialization::writePod(file, entry.level);
+    serialization::writePod(file, static_cast<uint32_t>(entry.nodeIndex));
+    serialization::writePod(file, static_cast<uint32_t>(entry.estimatedPage));
+    serialization::writeString(file, entry.title);
+  }
+  serialization::writePod(file, static_cast<uint16_t>(links.size()));
+  for (const auto& entry : links) {
+    const uint8_t flags = (entry.isInternal ? 1 : 0) | (entry.isImage ? 2 : 0);
+    serialization::writePod(file, flags);
+    serialization::writePod(file, static_cast<uint32_t>(entry.nodeIndex));
+    serialization::writePod(file, static_cast<uint32_t>(entry.pageNumber));
+    serialization::writeString(file, entry.text);
+    serialization::writeString(file, entry.href);
+  }
+  return true;
+}
+
+bool MarkdownNavigation::deserialize(FsFile& file) {
+  clear();
+
+  uint8_t version;
+  uint16_t tocCount;
+  if (!serialization::readPod(file, version) || version != NAVIGATION_INDEX_VERSION ||
+      !serialization::readPod(file, tocCount) || tocCount > MAX_TOC_ENTRIES) {
+    return false;
+  }
+  toc.reserve(tocCount);
+  headingRefs.reserve(tocCount);
+  for (uint16_t i = 0; i < tocCount; i++) {
+    TocEntry entry;
+    uint32_t nodeIndex, page;
+    if (!serialization::readPod(file, entry.level) || !serialization::readPod(file, nodeIndex) ||
+        !serialization::readPod(file, page) || !serialization::readString(file, entry.title)) {
+      clear();
+      return false;
     }
+    entry.nodeIndex = nodeIndex;
+    entry.estimatedPage = page;
+    headingRefs.push_back({nodeIndex, page, entry.level});
+    toc.push_back(std::move(entry));
   }
 
-  for (auto& ref : headingRefs) {
-    if (ref.nodeIndex < nodeToPage.size()) {
-      ref.pageNumber = nodeToPage[ref.nodeIndex];
+  uint16_t linkCount;
+  if (!serialization::readPod(file, linkCount) || linkCount > MAX_LINK_ENTRIES) {
+    clear();
+    return false;
+  }
+  links.reserve(linkCount);
+  for (uint16_t i = 0; i < linkCount; i++) {
+    LinkEntry entry;
+    uint8_t flags;
+    uint32_t nodeIndex, page;
+    if (!serialization::readPod(file, flags) || !serialization::readPod(file, nodeIndex) ||
+        !serialization::readPod(file, page) || !serialization::readString(file, entry.text) ||
+        !serialization::readString(file, entry.href)) {
+      clear();
+      return false;
     }
+    entry.isInternal = (flags & 1) != 0;
+    entry.isImage = (flags & 2) != 0;
+    entry.nodeIndex = nodeIndex;
+    entry.pageNumber = page;
+    links.push_back(std::move(entry));
   }
+  return true;
 }
 
 MdOptional<size_t> MarkdownNavigation::findNextHeading(size_t currentPage) const {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <HalStorage.h>
+
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -12,7 +14,7 @@ struct TocEntry {
   uint8_t level;         // Heading level 1-6
   std::string title;     // Plain text of heading
   size_t nodeIndex;      // Index in flattened node list (for navigation)
-  size_t estimatedPage;  // Estimated page number (set after rendering)
+  size_t estimatedPage;  // Page the heading's block starts on
 };
 
 // Link entry for tracking document links
@@ -22,6 +24,7 @@ struct LinkEntry {
   bool isInternal;   // True for wikilinks and relative paths
   bool isImage;      // True if this is an image reference
   size_t nodeIndex;  // Index in flattened node list
+  size_t pageNumber;
 };
 
 // Heading reference for page-based navigation
@@ -31,20 +34,31 @@ struct HeadingRef {
   uint8_t level;
 };
 
+// Headings and links of a document with the page each one starts on.
+//
+// Filled one top-level block at a time while the pages are laid out, so the document never has to exist as a whole
+// tree; the entries are capped so a huge vault note keeps the index to a few kilobytes. The index is stored behind
+// the page table of the section file and read back with it.
 class MarkdownNavigation {
  public:
   static constexpr size_t MAX_NAVIGATION_DEPTH = 50;
+  static constexpr size_t MAX_TOC_ENTRIES = 512;
+  static constexpr size_t MAX_LINK_ENTRIES = 256;
+  static constexpr size_t MAX_ENTRY_TEXT = 64;  // Bytes kept of a title, link text or target
+
+  MarkdownNavigation() = default;
 
-  // Build navigation data from AST
-  explicit MarkdownNavigation(const MdNode& root);
+  // Record the headings and links of a top-level block that starts on page
+  void addBlock(const MdNode& block, size_t page);
+  void clear();
 
   // Access extracted data
   const std::vector<TocEntry>& getToc() const { return toc; }
   const std::vector<LinkEntry>& getLinks() const { return links; }
   const std::vector<HeadingRef>& getHeadingRefs() const { return headingRefs; }
 
-  // Update page numbers after rendering (call this after pages are generated)
-  void updatePageNumbers(const std::vector<size_t>& nodeToPage);
+  bool serialize(FsFile& file) const;
+  bool deserialize(FsFile& file);
 
   // Navigation helpers
   MdOptional<size_t> findNextHeading(size_t currentPage) const;
@@ -67,6 +81,8 @@ class MarkdownNavigation {
   std::vector<TocEntry> toc;
   std::vector<LinkEntry> links;
   std::vector<HeadingRef> headingRefs;
+  size_t nextNodeIndex = 0;
+  size_t blockPage = 0;  // Page of the block being added
   bool depthLimitExceeded = false;
 
   // Recursive extraction
@@ -75,6 +91,7 @@ class MarkdownNavigation {
   void extractLink(const MdNode& node, size_t nodeIndex);
   void extractWikiLink(const MdNode& node, size_t nodeIndex);
   void extractImage(const MdNode& node, size_t nodeIndex);
+  void addLink(std::string text, std::string href, bool isInternal, bool isImage, size_t nodeIndex);
 
   // Helper to determine if a link is internal
   static bool isInternalLink(const std::string& href);
@@ -120,6 +120,31 @@ std::unique_ptr<MdNode> MarkdownParser::parse(const std::string& markdown) {
     return nullptr;
   }
 
+  const int result = runParser(markdown);
+
+  if (result != 0 || limitExceeded) {
+    root.reset();
+    return nullptr;
+  }
+
+  return std::move(root);
+}
+
+bool MarkdownParser::parseBlocks(const std::string& markdown, const BlockCallback& onBlock) {
+  if (markdown.size() > MAX_INPUT_SIZE) {
+    LOG_ERR("MD", "Parse failed: input size %zu exceeds limit %zu", markdown.size(), MAX_INPUT_SIZE);
+    return false;
+  }
+
+  blockCallback = &onBlock;
+  const int result = runParser(markdown);
+  blockCallback = nullptr;
+  root.reset();
+
+  return result == 0 && !limitExceeded;
+}
+
+int MarkdownParser::runParser(const std::string& markdown) {
   root = MdNode::createDocument();
   nodeStack.clear();
   nodeStack.push_back(root.get());
@@ -137,16 +162,10 @@ std::unique_ptr<MdNode> MarkdownParser::parse(const std::string& markdown) {
   parser.debug_log = nullptr;
   parser.syntax = nullptr;
 
-  int result = md_parse(markdown.c_str(), static_cast<MD_SIZE>(markdown.size()), &parser, this);
+  const int result = md_parse(markdown.c_str(), static_cast<MD_SIZE>(markdown.size()), &parser, this);
 
   nodeStack.clear();
-
-  if (result != 0 || limitExceeded) {
-    root.reset();
-    return nullptr;
-  }
-
-  return std::move(root);
+  return result;
 }
 
 std::unique_ptr<MdNode> MarkdownParser::parseWithPreprocessing(const std::string& markdown) {
@@ -363,6 +382,16 @@ int MarkdownParser::onLeaveBlock(MD_BLOCKTYPE type, void* detail) {
     default:
       break;
   }
+
+  // Back at the document level: hand the finished block over and drop it
+  if (blockCallback && type != MD_BLOCK_DOC && nodeStack.size() == 1 && !root->children.empty()) {
+    const bool keepGoing = (*blockCallback)(*root->children.back());
+    root->children.clear();
+    nodeCount = 1;
+    if (!keepGoing) {
+      return -1;
+    }
+  }
   return 0;
 }
 
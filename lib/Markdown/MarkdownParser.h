@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -16,10 +17,18 @@ class MarkdownParser {
   static constexpr size_t MAX_AST_NODES = 10000;
   static constexpr size_t MAX_NESTING_DEPTH = 50;
 
+  // Called with each top-level block once md4c leaves it; return false to abort the parse
+  using BlockCallback = std::function<bool(const MdNode& block)>;
+
   // Parse markdown text and return AST root (Document node)
   // Returns nullptr on parse failure
   std::unique_ptr<MdNode> parse(const std::string& markdown);
 
+  // Parse markdown text one top-level block at a time. Each block is handed to onBlock as soon as it is complete and
+  // freed afterwards, so MAX_AST_NODES applies per block instead of per document. Blocks before a failure have
+  // already been delivered when this returns false.
+  bool parseBlocks(const std::string& markdown, const BlockCallback& onBlock);
+
   // Parse with Obsidian preprocessing (frontmatter, comments, callouts, wikilinks)
   std::unique_ptr<MdNode> parseWithPreprocessing(const std::string& markdown);
 
@@ -29,6 +38,7 @@ class MarkdownParser {
   std::vector<MdNode*> nodeStack;  // Path from root to current node
   size_t nodeCount = 0;
   bool limitExceeded = false;
+  const BlockCallback* blockCallback = nullptr;  // Set while parseBlocks() runs
 
   // md4c callback trampolines (static to match C callback signature)
   static int enterBlockCallback(MD_BLOCKTYPE type, void* detail, void* userdata);
@@ -44,6 +54,8 @@ class MarkdownParser {
   int onLeaveSpan(MD_SPANTYPE type, void* detail);
   int onText(MD_TEXTTYPE type, const char* text, MD_SIZE size);
 
+  int runParser(const std::string& markdown);
+
   // Helper to get current node (top of stack)
   MdNode* currentNode();
 
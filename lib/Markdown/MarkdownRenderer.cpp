@@ -311,28 +311,11 @@ MarkdownRenderer::~MarkdownRenderer() = default;
 
 bool MarkdownRenderer::render(const MdNode& root, const PageCallback& pageCallback,
                               const ProgressCallback& progressCallback) {
-  // Initialize state
-  onPageComplete = pageCallback;
+  begin(pageCallback);
   onProgress = progressCallback;
-  currentPage.reset();
-  currentTextBlock.reset();
-  currentPageNextY = 0;
-  pageCount = 0;
-  currentDepth = 0;
-  depthLimitExceeded = false;
-  isBold = false;
-  isItalic = false;
-  isPreformatted = false;
-  listDepth = 0;
-  blockquoteDepth = 0;
-  nodeToPage.clear();
-  currentNodeIndex = 0;
-  totalNodes = 0;
-  lastProgress = -1;
 
   // Count total nodes for progress (rough estimate) - iterative to avoid stack overflow
-  totalNodes = 0;
-  {
+  if (onProgress) {
     std::vector<const MdNode*> countStack;
     countStack.reserve(64);
     countStack.push_back(&root);
@@ -346,14 +329,49 @@ bool MarkdownRenderer::render(const MdNode& root, const PageCallback& pageCallba
     }
   }
 
-  // Reserve space for node mapping - bounded to avoid OOM
-  nodeToPage.reserve(std::min(totalNodes, MAX_NODE_MAPPING));
-
   updateProgress();
 
   // Render the document
   renderNode(root);
 
+  finish();
+  return true;
+}
+
+void MarkdownRenderer::begin(const PageCallback& pageCallback) {
+  // Initialize state
+  onPageComplete = pageCallback;
+  onProgress = nullptr;
+  currentPage.reset();
+  currentTextBlock.reset();
+  currentPageNextY = 0;
+  pageCount = 0;
+  currentDepth = 0;
+  depthLimitExceeded = false;
+  isBold = false;
+  isItalic = false;
+  isPreformatted = false;
+  listDepth = 0;
+  blockquoteDepth = 0;
+  blockStartPage = 0;
+  blockStarted = false;
+  currentNodeIndex = 0;
+  totalNodes = 0;
+  lastProgress = -1;
+}
+
+void MarkdownRenderer::renderBlock(const MdNode& block) {
+  // Every block starts by flushing; doing it here keeps the previous block's lines out of this one's start page
+  flushTextBlock();
+  blockStarted = false;
+  renderNode(block);
+  if (!blockStarted) {
+    // Nothing was placed; the next content goes on the current page
+    blockStartPage = static_cast<size_t>(pageCount);
+  }
+}
+
+void MarkdownRenderer::finish() {
   // Finalize any remaining content
   if (currentTextBlock && !currentTextBlock->isEmpty()) {
     flushTextBlock();
@@ -361,8 +379,6 @@ bool MarkdownRenderer::render(const MdNode& root, const PageCallback& pageCallba
   if (currentPage) {
     finalizePage();
   }
-
-  return true;
 }
 
 void MarkdownRenderer::renderNode(const MdNode& node) {
@@ -375,10 +391,6 @@ void MarkdownRenderer::renderNode(const MdNode& node) {
   }
   currentDepth++;
 
-  // Record which page this node starts on - bounded to avoid OOM
-  if (nodeToPage.size() < MAX_NODE_MAPPING) {
-    nodeToPage.push_back(static_cast<size_t>(pageCount));
-  }
   currentNodeIndex++;
   updateProgress();
   if (currentNodeIndex % 100 == 0) {
@@ -1099,6 +1111,7 @@ void MarkdownRenderer::addLineToPage(std::shared_ptr<TextBlock> line) {
     currentPageNextY = 0;
   }
 
+  markBlockStart();
   int xOffset = getIndentWidth();
   currentPage->elements.push_back(std::make_shared<PageLine>(line, xOffset, currentPageNextY));
   currentPageNextY += lineHeight;
@@ -1113,6 +1126,7 @@ void MarkdownRenderer::addImageToPage(std::shared_ptr<PageImage> image) {
     currentPageNextY = 0;
   }
 
+  markBlockStart();
   const int16_t xPos = (viewportWidth - image->getWidth()) / 2;
   image->xPos = xPos;
   image->yPos = currentPageNextY;
@@ -1131,6 +1145,13 @@ void MarkdownRenderer::finalizePage() {
   currentPage.reset();
 }
 
+void MarkdownRenderer::markBlockStart() {
+  if (!blockStarted) {
+    blockStarted = true;
+    blockStartPage = static_cast<size_t>(pageCount);
+  }
+}
+
 uint8_t MarkdownRenderer::getCurrentFontStyle() const {
   if (isBold && isItalic) {
     return EpdFontFamily::BOLD_ITALIC;
@@ -13,11 +13,10 @@ class PageImage;
 class ParsedText;
 class TextBlock;
 
-// Renderer that converts MarkdownAST to Page objects
+// Renderer that converts MarkdownAST to Page objects, either a whole tree at once or one top-level block at a time
 class MarkdownRenderer {
  public:
   static constexpr size_t MAX_RENDER_DEPTH = 50;
-  static constexpr size_t MAX_NODE_MAPPING = 10000;
 
   // Callback for completed pages
   using PageCallback = std::function<void(std::unique_ptr<Page>)>;
@@ -34,8 +33,14 @@ class MarkdownRenderer {
   // Returns true on success
   bool render(const MdNode& root, const PageCallback& pageCallback, const ProgressCallback& progressCallback = nullptr);
 
-  // Get mapping of node indices to page numbers (call after render)
-  const std::vector<size_t>& getNodeToPageMap() const { return nodeToPage; }
+  // Streaming use: begin(), renderBlock() for each top-level block in document order, then finish() to emit the last
+  // page. Layout state carries over between blocks, so the result matches render() on the whole document.
+  void begin(const PageCallback& pageCallback);
+  void renderBlock(const MdNode& block);
+  void finish();
+
+  // Page the last rendered block's first line or image landed on
+  size_t getBlockStartPage() const { return blockStartPage; }
 
  private:
   GfxRenderer& renderer;
@@ -63,8 +68,9 @@ class MarkdownRenderer {
   int listDepth = 0;
   int blockquoteDepth = 0;
 
-  // Node to page mapping
-  std::vector<size_t> nodeToPage;
+  // Progress and block tracking
+  size_t blockStartPage = 0;
+  bool blockStarted = false;
   size_t currentNodeIndex = 0;
   size_t totalNodes = 0;
   int lastProgress = -1;
@@ -110,6 +116,7 @@ class MarkdownRenderer {
   void addLineToPage(std::shared_ptr<TextBlock> line);
   void addImageToPage(std::shared_ptr<PageImage> image);
   void finalizePage();
+  void markBlockStart();
 
   // Helpers
   uint8_t getCurrentFontStyle() const;
@@ -8,11 +8,12 @@
 #include <vector>
 
 #include "Epub/Page.h"
+#include "Markdown.h"
 #include "MarkdownRenderer.h"
 #include "SpiBusMutex.h"
 
 namespace {
-constexpr uint8_t SECTION_FILE_VERSION = 1;
+constexpr uint8_t SECTION_FILE_VERSION = 2;
 constexpr uint32_t HEADER_SIZE = sizeof(uint8_t) + sizeof(int) + sizeof(float) + sizeof(bool) + sizeof(uint8_t) +
                                  sizeof(uint16_t) + sizeof(uint16_t) + sizeof(bool) + sizeof(uint32_t) +
                                  sizeof(uint16_t) + sizeof(uint32_t);
@@ -85,7 +86,7 @@ bool MarkdownSection::loadSectionFile(int fontId, float lineCompression, bool ex
                                       uint8_t paragraphAlignment, uint16_t viewportWidth, uint16_t viewportHeight,
                                       bool hyphenationEnabled, uint32_t sourceSize) {
   SpiBusMutex::Guard guard;
-  nodeToPageMap.clear();
+  navigation.clear();
   closeSectionFile();
   if (!Storage.openFileForRead("MSC", filePath, file)) {
     return false;
@@ -134,12 +135,21 @@ bool MarkdownSection::loadSectionFile(int fontId, float lineCompression, bool ex
     return false;
   }
 
-  if (!serialization::readPod(file, pageCount)) {
+  uint32_t lutOffset;
+  if (!serialization::readPod(file, pageCount) || !serialization::readPod(file, lutOffset)) {
     file.close();
     LOG_ERR("MSC", "Deserialization failed: truncated page count");
     clearCache();
     return false;
   }
+
+  // The navigation index follows the page table
+  if (!file.seek(lutOffset + sizeof(uint32_t) * pageCount) || !navigation.deserialize(file)) {
+    file.close();
+    LOG_ERR("MSC", "Deserialization failed: bad navigation index");
+    clearCache();
+    return false;
+  }
   file.close();
   LOG_DBG("MSC", "Deserialization succeeded: %d pages", pageCount);
   return true;
@@ -158,13 +168,15 @@ bool MarkdownSection::clearCache() const {
   return true;
 }
 
-bool MarkdownSection::createSectionFile(const MdNode& root, int fontId, float lineCompression,
+bool MarkdownSection::createSectionFile(const Markdown& markdown, int fontId, float lineCompression,
                                         bool extraParagraphSpacing, uint8_t paragraphAlignment, uint16_t viewportWidth,
                                         uint16_t viewportHeight, bool hyphenationEnabled, uint32_t sourceSize,
                                         const std::function<void()>& progressSetupFn,
                                         const std::function<void(int)>& progressFn) {
   SpiBusMutex::Guard guard;
   closeSectionFile();
+  navigation.clear();
+  pageCount = 0;
 
   if (!Storage.exists(cachePath.c_str())) {
     Storage.mkdir(cachePath.c_str());
@@ -177,7 +189,8 @@ bool MarkdownSection::createSectionFile(const MdNode& root, int fontId, float li
   writeSectionFileHeader(fontId, lineCompression, extraParagraphSpacing, paragraphAlignment, viewportWidth,
                          viewportHeight, hyphenationEnabled, sourceSize);
 
-  if (progressSetupFn && sourceSize >= MIN_SIZE_FOR_PROGRESS) {
+  const bool showProgress = progressSetupFn && sourceSize >= MIN_SIZE_FOR_PROGRESS;
+  if (showProgress) {
     progressSetupFn();
   }
 
@@ -185,41 +198,41 @@ bool MarkdownSection::createSectionFile(const MdNode& root, int fontId, float li
 
   MarkdownRenderer mdRenderer(renderer, fontId, viewportWidth, viewportHeight, lineCompression, extraParagraphSpacing,
                               paragraphAlignment, hyphenationEnabled, contentBasePath);
-
-  const bool success = mdRenderer.render(
-      root, [this, &lut](std::unique_ptr<Page> page) { lut.emplace_back(this->onPageComplete(std::move(page))); },
-      progressFn);
-
-  if (!success) {
+  bool pageWriteFailed = false;
+  mdRenderer.begin([this, &lut, &pageWriteFailed](std::unique_ptr<Page> page) {
+    const uint32_t position = this->onPageComplete(std::move(page));
+    pageWriteFailed |= position == 0;
+    lut.emplace_back(position);
+  });
+
+  const bool success = markdown.streamBlocks(
+      [this, &mdRenderer, &pageWriteFailed](const MdNode& block) {
+        mdRenderer.renderBlock(block);
+        navigation.addBlock(block, mdRenderer.getBlockStartPage());
+        return !pageWriteFailed;
+      },
+      showProgress ? progressFn : nullptr);
+  mdRenderer.finish();
+
+  if (!success || pageWriteFailed) {
     LOG_ERR("MSC", "Failed to render markdown pages");
     file.close();
     Storage.remove(filePath.c_str());
+    navigation.clear();
     return false;
   }
 
-  nodeToPageMap = mdRenderer.getNodeToPageMap();
-
   const uint32_t lutOffset = file.position();
-  bool hasFailedLutRecords = false;
   for (const uint32_t& pos : lut) {
-    if (pos == 0) {
-      hasFailedLutRecords = true;
-      break;
-    }
     serialization::writePod(file, pos);
   }
-
-  if (hasFailedLutRecords) {
-    LOG_ERR("MSC", "Failed to write LUT due to invalid page positions");
-    file.close();
-    Storage.remove(filePath.c_str());
-    return false;
-  }
+  navigation.serialize(file);
 
   file.seek(HEADER_SIZE - sizeof(uint32_t) - sizeof(pageCount));
   serialization::writePod(file, pageCount);
   serialization::writePod(file, lutOffset);
   file.close();
+  LOG_DBG("MSC", "Created section file: %d pages, %zu headings", pageCount, navigation.getTotalHeadings());
   return true;
 }
 
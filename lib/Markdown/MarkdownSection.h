@@ -5,13 +5,18 @@
 #include <functional>
 #include <memory>
 #include <string>
-#include <vector>
 
-#include "MarkdownAST.h"
+#include "MarkdownNavigation.h"
 
+class Markdown;
 class Page;
 class GfxRenderer;
 
+// Laid-out pages of a markdown file on the SD card, followed by the page table and the navigation index.
+//
+// createSectionFile() streams the file through md4c block by block and lays each block out as it arrives, so building
+// the pages takes a bounded amount of heap regardless of the file size.
+
 class MarkdownSection {
  public:
   MarkdownSection(const std::string& cachePath, const std::string& contentBasePath, GfxRenderer& renderer);
@@ -19,7 +24,7 @@ class MarkdownSection {
 
   bool loadSectionFile(int fontId, float lineCompression, bool extraParagraphSpacing, uint8_t paragraphAlignment,
                        uint16_t viewportWidth, uint16_t viewportHeight, bool hyphenationEnabled, uint32_t sourceSize);
-  bool createSectionFile(const MdNode& root, int fontId, float lineCompression, bool extraParagraphSpacing,
+  bool createSectionFile(const Markdown& markdown, int fontId, float lineCompression, bool extraParagraphSpacing,
                          uint8_t paragraphAlignment, uint16_t viewportWidth, uint16_t viewportHeight,
                          bool hyphenationEnabled, uint32_t sourceSize,
                          const std::function<void()>& progressSetupFn = nullptr,
@@ -27,8 +32,8 @@ class MarkdownSection {
   std::unique_ptr<Page> loadPageFromSectionFile();
   bool clearCache() const;
 
-  const std::vector<size_t>& getNodeToPageMap() const { return nodeToPageMap; }
-  bool hasNodeToPageMap() const { return !nodeToPageMap.empty(); }
+  // Headings and links with their pages; valid after loadSectionFile() or createSectionFile() succeeded
+  const MarkdownNavigation& getNavigation() const { return navigation; }
 
   uint16_t pageCount = 0;
   int currentPage = 0;
@@ -40,7 +45,7 @@ class MarkdownSection {
   std::string filePath;
   HalFile file;
   bool fileOpenForReading = false;
-  std::vector<size_t> nodeToPageMap;
+  MarkdownNavigation navigation;
 
   void writeSectionFileHeader(int fontId, float lineCompression, bool extraParagraphSpacing, uint8_t paragraphAlignment,
                               uint16_t viewportWidth, uint16_t viewportHeight, bool hyphenationEnabled,
@@ -0,0 +1,106 @@
+/**
+ * XtcBlit.cpp
+ *
+ * Byte-level copy of XTG/XTH page bitmaps into the panel framebuffer
+ * XTC ebook support for CrossPoint Reader
+ */
+
+#include "XtcBlit.h"
+
+#include <cstring>
+
+namespace xtc {
+
+namespace {
+
+// Transposes an 8x8 bit block (Hacker's Delight, transpose8rS32): in[i] is row i with column 0 in the MSB, out[j]
+// becomes column j with row 0 in the MSB.
+void transpose8(const uint8_t* in, const size_t inStride, uint8_t out[8]) {
+  uint32_t x = (in[0] << 24) | (in[inStride] << 16) | (in[2 * inStride] << 8) | in[3 * inStride];
+  uint32_t y = (in[4 * inStride] << 24) | (in[5 * inStride] << 16) | (in[6 * inStride] << 8) | in[7 * inStride];
+  uint32_t t;
+
+  t = (x ^ (x >> 7)) & 0x00AA00AA;
+  x = x ^ t ^ (t << 7);
+  t = (y ^ (y >> 7)) & 0x00AA00AA;
+  y = y ^ t ^ (t << 7);
+
+  t = (x ^ (x >> 14)) & 0x0000CCCC;
+  x = x ^ t ^ (t << 14);
+  t = (y ^ (y >> 14)) & 0x0000CCCC;
+  y = y ^ t ^ (t << 14);
+
+  t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+  y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+  x = t;
+
+  out[0] = x >> 24;
+  out[1] = x >> 16;
+  out[2] = x >> 8;
+  out[3] = x;
+  out[4] = y >> 24;
+  out[5] = y >> 16;
+  out[6] = y >> 8;
+  out[7] = y;
+}
+
+// XTG: page row y, pixel x lands at framebuffer row (pageWidth - 1 - x), column y. Each 8x8 block of page pixels
+// becomes an 8x8 block of the framebuffer, with its columns in reverse row order.
+void blitXtg(const uint8_t* page, const uint16_t pageWidth, const uint16_t pageHeight, uint8_t* frameBuffer,
+             const size_t fbRowBytes) {
+  const size_t srcRowBytes = (pageWidth + 7) / 8;
+  uint8_t block[8];
+  for (uint16_t by = 0; by < pageHeight / 8; by++) {
+    const uint8_t* srcRows = page + static_cast<size_t>(by) * 8 * srcRowBytes;
+    for (uint16_t bx = 0; bx < pageWidth / 8; bx++) {
+      transpose8(srcRows + bx, srcRowBytes, block);
+      // block[j] holds page column 8 * bx + j
+      uint8_t* dst = frameBuffer + static_cast<size_t>(pageWidth - 1 - 8 * bx) * fbRowBytes + by;
+      for (int j = 0; j < 8; j++) {
+        *dst = block[j];
+        dst -= fbRowBytes;
+      }
+    }
+  }
+}
+
+}  // namespace
+
+bool blitPage(const uint8_t* page, const uint8_t bitDepth, const uint16_t pageWidth, const uint16_t pageHeight,
+              const BlitPass pass, uint8_t* frameBuffer, const uint16_t panelWidth, const uint16_t panelHeight) {
+  // Portrait page on a landscape panel; whole bytes in both directions
+  if (pageWidth != panelHeight || pageHeight != panelWidth || pageWidth % 8 != 0 || pageHeight % 8 != 0) {
+    return false;
+  }
+  const size_t fbRowBytes = panelWidth / 8;
+  const size_t fbSize = fbRowBytes * panelHeight;
+
+  if (bitDepth != 2) {
+    if (pass == BlitPass::BW) {
+      blitXtg(page, pageWidth, pageHeight, frameBuffer, fbRowBytes);
+    } else {
+      memset(frameBuffer, 0x00, fbSize);
+    }
+    return true;
+  }
+
+  // XTH column (pageWidth - 1 - x) is page column x top to bottom, MSB first: exactly framebuffer row
+  // (pageWidth - 1 - x) under the Portrait mapping, so the planes line up with the framebuffer byte for byte.
+  // Pixel value = (bit1 << 1) | bit2: 0 white, 1 dark grey, 2 light grey, 3 black.
+  const uint8_t* plane1 = page;
+  const uint8_t* plane2 = page + fbSize;
+  switch (pass) {
+    case BlitPass::BW:
+      for (size_t i = 0; i < fbSize; i++) frameBuffer[i] = ~(plane1[i] | plane2[i]);
+      break;
+    case BlitPass::GrayLsb:
+      for (size_t i = 0; i < fbSize; i++) frameBuffer[i] = ~plane1[i] & plane2[i];
+      break;
+    case BlitPass::GrayMsb:
+      for (size_t i = 0; i < fbSize; i++) frameBuffer[i] = plane1[i] ^ plane2[i];
+      break;
+  }
+  return true;
+}
+
+}  // namespace xtc
@@ -0,0 +1,37 @@
+/**
+ * XtcBlit.h
+ *
+ * Byte-level copy of XTG/XTH page bitmaps into the panel framebuffer
+ * XTC ebook support for CrossPoint Reader
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace xtc {
+
+// Which pixels a framebuffer pass holds, in the conventions of the reader's render passes
+enum class BlitPass : uint8_t {
+  BW,       // 0 = black for every non-white pixel, 1 = white
+  GrayLsb,  // 1 = dark grey (XTH value 1), on a cleared (0x00) buffer
+  GrayMsb,  // 1 = dark or light grey (XTH value 1 or 2), on a cleared (0x00) buffer
+};
+
+/**
+ * Writes one pass of a page into a panel-native framebuffer (rows of panelWidth pixels, MSB first).
+ *
+ * Pages are portrait and the panel is landscape, so a page row is a framebuffer column: the page must be
+ * panelHeight x panelWidth pixels and is placed as GfxRenderer's Portrait orientation maps it. XTH planes are
+ * already stored in that order and are combined a byte at a time; XTG rows are transposed in 8x8 blocks. The whole
+ * framebuffer is overwritten, so no clear is needed first.
+ *
+ * @param page Page bitmap as read by Xtc::loadPage
+ * @param bitDepth 1 for XTG, 2 for XTH (GrayLsb/GrayMsb passes of an XTG page are all zero)
+ * @return false if the page size does not match the panel, leaving the framebuffer untouched
+ */
+bool blitPage(const uint8_t* page, uint8_t bitDepth, uint16_t pageWidth, uint16_t pageHeight, BlitPass pass,
+              uint8_t* frameBuffer, uint16_t panelWidth, uint16_t panelHeight);
+
+}  // namespace xtc
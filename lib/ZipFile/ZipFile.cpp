@@ -18,6 +18,46 @@ namespace {
 constexpr uint16_t ZIP_METHOD_STORED = 0;
 constexpr uint16_t ZIP_METHOD_DEFLATED = 8;
 
+// Entry index file layout: IndexHeader followed by entryCount ZipFile::IndexRecord, sorted by (hash, nameLen).
+// Bump on any layout change.
+constexpr uint32_t INDEX_VERSION = 2;
+
+// Central directory file header: fixed part before the entry name
+constexpr uint32_t CENTRAL_DIR_HEADER_SIZE = 46;
+
+// Size and FAT modify date/time of the zip the index was built from; a replaced book invalidates the index
+struct IndexHeader {
+  uint32_t version;
+  uint32_t zipSize;
+  uint32_t zipModified;  // FAT date << 16 | FAT time
+  uint32_t entryCount;
+};
+
+uint32_t modifyDateTime(FsFile& file) {
+  uint16_t date = 0;
+  uint16_t time = 0;
+  file.getModifyDateTime(&date, &time);
+  return (static_cast<uint32_t>(date) << 16) | time;
+}
+
+bool indexRecordLess(const ZipFile::IndexRecord& a, const ZipFile::IndexRecord& b) {
+  return a.hash < b.hash || (a.hash == b.hash && a.nameLen < b.nameLen);
+}
+
+// Opens an index file and checks it against the zip it claims to describe.
+bool openIndex(const std::string& path, FsFile& zipFile, FsFile& indexFile, IndexHeader& header) {
+  if (!Storage.exists(path.c_str()) || !Storage.openFileForRead("ZIP", path, indexFile)) {
+    return false;
+  }
+  if (indexFile.read(&header, sizeof(header)) != sizeof(header) || header.version != INDEX_VERSION ||
+      header.zipSize != zipFile.size() || header.zipModified != modifyDateTime(zipFile) ||
+      indexFile.size() != sizeof(IndexHeader) + static_cast<size_t>(header.entryCount) * sizeof(ZipFile::IndexRecord)) {
+    indexFile.close();
+    return false;
+  }
+  return true;
+}
+
 // RAII zip: opens the zip if not already open, closes on destruction only if
 // it performed the open.  Removes the wasOpen/close boilerplate from every method.
 class ScopedOpenClose final {
@@ -56,6 +96,12 @@ int zipReadCallback(uzlib_uncomp* uncomp) {
 }
 }  // namespace
 
+ZipFile::~ZipFile() {
+  if (indexFile) {
+    indexFile.close();
+  }
+}
+
 bool ZipFile::loadAllFileStatSlims() {
   const ScopedOpenClose zip{*this};
   if (!zip) return false;
@@ -107,6 +153,162 @@ bool ZipFile::loadAllFileStatSlims() {
   return true;
 }
 
+bool ZipFile::writeIndex(const std::string& path) {
+  const ScopedOpenClose zip{*this};
+  if (!zip) return false;
+
+  if (!loadZipDetails()) return false;
+
+  const uint16_t totalEntries = zipDetails.totalEntries;
+  auto* records = static_cast<IndexRecord*>(malloc(std::max<size_t>(1, totalEntries) * sizeof(IndexRecord)));
+  if (!records) {
+    LOG_ERR("ZIP", "Failed to allocate index for %u entries", totalEntries);
+    return false;
+  }
+
+  file.seek(zipDetails.centralDirOffset);
+
+  uint32_t count = 0;
+  uint32_t sig;
+  char itemName[256];
+
+  while (count < totalEntries && file.available()) {
+    const uint32_t entryStart = file.position();
+    file.read(&sig, 4);
+    if (sig != 0x02014b50) break;  // End of list
+
+    IndexRecord record = {};
+    record.centralDirOffset = entryStart;
+
+    file.seekCur(6);
+    file.read(&record.method, 2);
+    file.seekCur(8);
+    file.read(&record.compressedSize, 4);
+    file.read(&record.uncompressedSize, 4);
+    uint16_t m, k;
+    file.read(&record.nameLen, 2);
+    file.read(&m, 2);
+    file.read(&k, 2);
+    file.seekCur(8);
+    file.read(&record.localHeaderOffset, 4);
+
+    if (record.nameLen < sizeof(itemName)) {
+      file.read(itemName, record.nameLen);
+      record.hash = fnvHash64(itemName, record.nameLen);
+      records[count++] = record;
+    } else {
+      // Oversized names can't be looked up by loadFileStatSlim either
+      file.seekCur(record.nameLen);
+    }
+
+    file.seekCur(m + k);
+  }
+
+  std::sort(records, records + count, indexRecordLess);
+
+  FsFile indexFile;
+  if (!Storage.openFileForWrite("ZIP", path, indexFile)) {
+    free(records);
+    return false;
+  }
+  const IndexHeader header = {INDEX_VERSION, static_cast<uint32_t>(file.size()), modifyDateTime(file), count};
+  const size_t recordBytes = count * sizeof(IndexRecord);
+  const bool ok = indexFile.write(&header, sizeof(header)) == sizeof(header) &&
+                  indexFile.write(records, recordBytes) == recordBytes;
+  indexFile.close();
+  free(records);
+
+  if (!ok) {
+    LOG_ERR("ZIP", "Failed to write zip index %s", path.c_str());
+    Storage.remove(path.c_str());
+    return false;
+  }
+  LOG_DBG("ZIP", "Wrote zip index with %u entries", count);
+  return true;
+}
+
+bool ZipFile::hasValidIndex(const std::string& path) {
+  const ScopedOpenClose zip{*this};
+  if (!zip) return false;
+
+  FsFile pathFile;
+  IndexHeader header;
+  if (!openIndex(path, file, pathFile, header)) {
+    return false;
+  }
+  pathFile.close();
+  return true;
+}
+
+bool ZipFile::entryNameEquals(const uint32_t centralDirOffset, const char* filename, const size_t nameLen) {
+  char itemName[256];
+  if (nameLen >= sizeof(itemName) || !file.seek(centralDirOffset + CENTRAL_DIR_HEADER_SIZE) ||
+      file.read(itemName, nameLen) != static_cast<int>(nameLen)) {
+    return false;
+  }
+  return memcmp(itemName, filename, nameLen) == 0;
+}
+
+ZipFile::IndexLookup ZipFile::lookupIndex(const char* filename, FileStatSlim* fileStat) {
+  if (indexPath.empty()) {
+    return IndexLookup::Unavailable;
+  }
+
+  if (!indexFile) {
+    IndexHeader header;
+    if (!openIndex(indexPath, file, indexFile, header)) {
+      LOG_DBG("ZIP", "Zip index missing or stale, scanning central directory");
+      indexPath.clear();  // don't retry for the rest of this object's lifetime
+      return IndexLookup::Unavailable;
+    }
+    indexEntryCount = header.entryCount;
+  }
+
+  const size_t nameLen = strlen(filename);
+  IndexRecord key = {};
+  key.hash = fnvHash64(filename, nameLen);
+  key.nameLen = static_cast<uint16_t>(nameLen);
+
+  auto readRecord = [this](const uint32_t position, IndexRecord& record) {
+    return indexFile.seek(sizeof(IndexHeader) + static_cast<size_t>(position) * sizeof(IndexRecord)) &&
+           indexFile.read(&record, sizeof(record)) == sizeof(record);
+  };
+
+  // Binary search for the first record not below the key, reading one record per probe
+  uint32_t lo = 0;
+  uint32_t hi = indexEntryCount;
+  IndexRecord record;
+  while (lo < hi) {
+    const uint32_t mid = lo + (hi - lo) / 2;
+    if (!readRecord(mid, record)) {
+      return IndexLookup::Unavailable;
+    }
+    if (indexRecordLess(record, key)) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+
+  // Different names can share a hash and length; the name in the central directory decides
+  for (uint32_t position = lo; position < indexEntryCount; position++) {
+    if (!readRecord(position, record)) {
+      return IndexLookup::Unavailable;
+    }
+    if (indexRecordLess(key, record)) {
+      break;
+    }
+    if (entryNameEquals(record.centralDirOffset, filename, nameLen)) {
+      fileStat->method = record.method;
+      fileStat->compressedSize = record.compressedSize;
+      fileStat->uncompressedSize = record.uncompressedSize;
+      fileStat->localHeaderOffset = record.localHeaderOffset;
+      return IndexLookup::Found;
+    }
+  }
+  return IndexLookup::NotFound;
+}
+
 bool ZipFile::loadFileStatSlim(const char* filename, FileStatSlim* fileStat) {
   if (!fileStatSlimCache.empty()) {
     const auto it = fileStatSlimCache.find(filename);
@@ -120,6 +322,11 @@ bool ZipFile::loadFileStatSlim(const char* filename, FileStatSlim* fileStat) {
   const ScopedOpenClose zip{*this};
   if (!zip) return false;
 
+  const IndexLookup indexed = lookupIndex(filename, fileStat);
+  if (indexed != IndexLookup::Unavailable) {
+    return indexed == IndexLookup::Found;
+  }
+
   if (!loadZipDetails()) return false;
 
   // Phase 1: Try scanning from cursor position first
@@ -440,121 +647,137 @@ uint8_t* ZipFile::readFileToMemory(const char* filename, size_t* size, const boo
   return data;
 }
 
-bool ZipFile::readFileToStream(const char* filename, Print& out, const size_t chunkSize) {
-  const ScopedOpenClose zip{*this};
-  if (!zip) return false;
+ZipFile::EntryReader::EntryReader(ZipFile& zip) : zip(zip) {}
 
-  FileStatSlim fileStat = {};
-  if (!loadFileStatSlim(filename, &fileStat)) return false;
+ZipFile::EntryReader::~EntryReader() { close(); }
 
-  const long fileOffset = getDataOffset(fileStat);
-  if (fileOffset < 0) return false;
-
-  file.seek(fileOffset);
-  const auto deflatedDataSize = fileStat.compressedSize;
-  const auto inflatedDataSize = fileStat.uncompressedSize;
-
-  if (fileStat.method == ZIP_METHOD_STORED) {
-    // no deflation, just read content
-    const auto buffer = static_cast<uint8_t*>(malloc(chunkSize));
-    if (!buffer) {
-      LOG_ERR("ZIP", "Failed to allocate memory for buffer");
-      return false;
-    }
-
-    size_t remaining = inflatedDataSize;
-    while (remaining > 0) {
-      const size_t dataRead = file.read(buffer, remaining < chunkSize ? remaining : chunkSize);
-      if (dataRead == 0) {
-        LOG_ERR("ZIP", "Could not read more bytes");
-        free(buffer);
-        return false;
-      }
+bool ZipFile::EntryReader::open(const char* filename, const size_t inputChunkSize) {
+  close();
+  if (!zip.isOpen()) {
+    if (!zip.open()) return false;
+    openedZip = true;
+  }
 
-      if (out.write(buffer, dataRead) != dataRead) {
-        LOG_ERR("ZIP", "Failed to write all output bytes to stream");
-        free(buffer);
-        return false;
-      }
-      remaining -= dataRead;
-    }
+  FileStatSlim fileStat = {};
+  if (!zip.loadFileStatSlim(filename, &fileStat)) {
+    close();
+    return false;
+  }
 
-    free(buffer);
-    return true;
+  const long fileOffset = zip.getDataOffset(fileStat);
+  if (fileOffset < 0) {
+    close();
+    return false;
   }
+  zip.file.seek(fileOffset);
+
+  method = fileStat.method;
+  uncompressedSize = fileStat.uncompressedSize;
+  produced = 0;
+  finished = false;
 
-  if (fileStat.method == ZIP_METHOD_DEFLATED) {
-    auto* fileReadBuffer = static_cast<uint8_t*>(malloc(chunkSize));
-    if (!fileReadBuffer) {
+  if (method == ZIP_METHOD_DEFLATED) {
+    readBuf = static_cast<uint8_t*>(malloc(inputChunkSize));
+    if (!readBuf) {
       LOG_ERR("ZIP", "Failed to allocate memory for zip file read buffer");
+      close();
       return false;
     }
 
-    auto* outputBuffer = static_cast<uint8_t*>(malloc(chunkSize));
-    if (!outputBuffer) {
-      LOG_ERR("ZIP", "Failed to allocate memory for output buffer");
-      free(fileReadBuffer);
+    inflate.reset(new ZipInflateCtx());
+    inflate->file = &zip.file;
+    inflate->fileRemaining = fileStat.compressedSize;
+    inflate->readBuf = readBuf;
+    inflate->readBufSize = inputChunkSize;
+    if (!inflate->reader.init(true)) {
+      LOG_ERR("ZIP", "Failed to init inflate reader");
+      close();
       return false;
     }
+    inflate->reader.setReadCallback(zipReadCallback);
+  } else if (method != ZIP_METHOD_STORED) {
+    LOG_ERR("ZIP", "Unsupported compression method");
+    close();
+    return false;
+  }
 
-    ZipInflateCtx ctx;
-    ctx.file = &file;
-    ctx.fileRemaining = deflatedDataSize;
-    ctx.readBuf = fileReadBuffer;
-    ctx.readBufSize = chunkSize;
+  isOpen = true;
+  return true;
+}
 
-    if (!ctx.reader.init(true)) {
-      LOG_ERR("ZIP", "Failed to init inflate reader");
-      free(outputBuffer);
-      free(fileReadBuffer);
-      return false;
-    }
-    ctx.reader.setReadCallback(zipReadCallback);
+void ZipFile::EntryReader::close() {
+  inflate.reset();  // InflateReader destructor frees the ring buffer
+  free(readBuf);
+  readBuf = nullptr;
+  if (openedZip) {
+    zip.close();
+    openedZip = false;
+  }
+  isOpen = false;
+}
 
-    bool success = false;
-    size_t totalProduced = 0;
+int ZipFile::EntryReader::read(uint8_t* dest, const size_t maxLen) {
+  if (!isOpen) return -1;
+  if (done()) return 0;
 
-    while (true) {
-      size_t produced;
-      const InflateStatus status = ctx.reader.readAtMost(outputBuffer, chunkSize, &produced);
+  if (method == ZIP_METHOD_STORED) {
+    const size_t remaining = uncompressedSize - produced;
+    const size_t dataRead = zip.file.read(dest, remaining < maxLen ? remaining : maxLen);
+    if (dataRead == 0) {
+      LOG_ERR("ZIP", "Could not read more bytes");
+      return -1;
+    }
+    produced += dataRead;
+    return static_cast<int>(dataRead);
+  }
 
-      totalProduced += produced;
-      if (totalProduced > static_cast<size_t>(inflatedDataSize)) {
-        LOG_ERR("ZIP", "Decompressed size exceeds expected (%zu > %zu)", totalProduced,
-                static_cast<size_t>(inflatedDataSize));
-        break;
-      }
+  size_t chunk = 0;
+  const InflateStatus status = inflate->reader.readAtMost(dest, maxLen, &chunk);
+  produced += chunk;
+  if (produced > uncompressedSize) {
+    LOG_ERR("ZIP", "Decompressed size exceeds expected (%u > %u)", static_cast<unsigned>(produced),
+            static_cast<unsigned>(uncompressedSize));
+    return -1;
+  }
+  if (status == InflateStatus::Error) {
+    LOG_ERR("ZIP", "Decompression failed");
+    return -1;
+  }
+  if (status == InflateStatus::Done) {
+    if (produced != uncompressedSize) {
+      LOG_ERR("ZIP", "Decompressed size mismatch (expected %u, got %u)", static_cast<unsigned>(uncompressedSize),
+              static_cast<unsigned>(produced));
+      return -1;
+    }
+    finished = true;
+  }
+  return static_cast<int>(chunk);
+}
 
-      if (produced > 0) {
-        if (out.write(outputBuffer, produced) != produced) {
-          LOG_ERR("ZIP", "Failed to write all output bytes to stream");
-          break;
-        }
-      }
+bool ZipFile::readFileToStream(const char* filename, Print& out, const size_t chunkSize) {
+  EntryReader reader(*this);
+  if (!reader.open(filename, chunkSize)) return false;
 
-      if (status == InflateStatus::Done) {
-        if (totalProduced != static_cast<size_t>(inflatedDataSize)) {
-          LOG_ERR("ZIP", "Decompressed size mismatch (expected %zu, got %zu)", static_cast<size_t>(inflatedDataSize),
-                  totalProduced);
-          break;
-        }
-        LOG_DBG("ZIP", "Decompressed %d bytes into %d bytes", deflatedDataSize, inflatedDataSize);
-        success = true;
-        break;
-      }
+  auto* outputBuffer = static_cast<uint8_t*>(malloc(chunkSize));
+  if (!outputBuffer) {
+    LOG_ERR("ZIP", "Failed to allocate memory for output buffer");
+    return false;
+  }
 
-      if (status == InflateStatus::Error) {
-        LOG_ERR("ZIP", "Decompression failed");
-        break;
-      }
-      // InflateStatus::Ok: output buffer full, continue
+  bool success = true;
+  while (!reader.done()) {
+    const int produced = reader.read(outputBuffer, chunkSize);
+    if (produced < 0) {
+      success = false;
+      break;
+    }
+    if (produced > 0 && out.write(outputBuffer, produced) != static_cast<size_t>(produced)) {
+      LOG_ERR("ZIP", "Failed to write all output bytes to stream");
+      success = false;
+      break;
     }
-
-    free(outputBuffer);
-    free(fileReadBuffer);
-    return success;  // ctx.reader destructor frees the ring buffer
   }
 
-  LOG_ERR("ZIP", "Unsupported compression method");
-  return false;
+  free(outputBuffer);
+  return success;
 }
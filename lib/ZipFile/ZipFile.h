@@ -1,10 +1,14 @@
 #pragma once
 #include <HalStorage.h>
 
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+struct ZipInflateCtx;
+
 class ZipFile {
  public:
   struct FileStatSlim {
@@ -27,6 +31,48 @@ class ZipFile {
     uint16_t index;  // Caller's index (e.g. spine index)
   };
 
+  // Entry of the on-disk index written by writeIndex(), one per central directory entry, sorted by (hash, nameLen)
+  struct IndexRecord {
+    uint64_t hash;  // FNV-1a 64-bit hash of the entry name
+    uint32_t compressedSize;
+    uint32_t uncompressedSize;
+    uint32_t localHeaderOffset;
+    uint32_t centralDirOffset;  // Entry's central directory header, whose name settles hash collisions
+    uint16_t nameLen;
+    uint16_t method;
+    uint32_t reserved;  // Keeps the record free of padding
+  };
+  static_assert(sizeof(IndexRecord) == 32, "IndexRecord is written to disk as-is");
+
+  // Pull-based reader for a single entry. Inflates straight into the caller's buffer (e.g. expat's XML_GetBuffer), so
+  // an entry can be consumed without staging it on the SD card. Keeps the zip open until closed or destroyed.
+  class EntryReader {
+   public:
+    explicit EntryReader(ZipFile& zip);
+    ~EntryReader();
+    EntryReader(const EntryReader&) = delete;
+    EntryReader& operator=(const EntryReader&) = delete;
+
+    // inputChunkSize is the compressed-data read buffer; the inflater itself needs a 32KB window on top.
+    bool open(const char* filename, size_t inputChunkSize = 1024);
+    void close();
+    // Reads up to maxLen uncompressed bytes. Returns the count produced (0 once the entry is exhausted), -1 on error.
+    int read(uint8_t* dest, size_t maxLen);
+    bool done() const { return finished || produced >= uncompressedSize; }
+    uint32_t size() const { return uncompressedSize; }
+
+   private:
+    ZipFile& zip;
+    bool openedZip = false;
+    bool isOpen = false;
+    bool finished = false;
+    uint16_t method = 0;
+    uint32_t uncompressedSize = 0;
+    uint32_t produced = 0;
+    std::unique_ptr<ZipInflateCtx> inflate;
+    uint8_t* readBuf = nullptr;
+  };
+
   // FNV-1a 64-bit hash computed from char buffer (no std::string allocation)
   static uint64_t fnvHash64(const char* s, size_t len) {
     uint64_t hash = 14695981039346656037ull;
@@ -47,19 +93,36 @@ class ZipFile {
   uint32_t lastCentralDirPos = 0;
   bool lastCentralDirPosValid = false;
 
+  // Entry index written next to the book's other caches. Empty when the zip is used without one. Opened and checked
+  // on the first lookup, then kept open for the lifetime of this object.
+  std::string indexPath;
+  FsFile indexFile;
+  uint32_t indexEntryCount = 0;
+
+  enum class IndexLookup : uint8_t { Found, NotFound, Unavailable };
+
   bool loadFileStatSlim(const char* filename, FileStatSlim* fileStat);
+  IndexLookup lookupIndex(const char* filename, FileStatSlim* fileStat);
+  bool entryNameEquals(uint32_t centralDirOffset, const char* filename, size_t nameLen);
   long getDataOffset(const FileStatSlim& fileStat);
   bool loadZipDetails();
 
  public:
-  explicit ZipFile(const std::string& filePath) : filePath(filePath) {}
-  ~ZipFile() = default;
+  // indexPath is optional: when it names a file produced by writeIndex() for this zip, entry lookups binary search it
+  // instead of walking the central directory.
+  explicit ZipFile(const std::string& filePath, std::string indexPath = {})
+      : filePath(filePath), indexPath(std::move(indexPath)) {}
+  ~ZipFile();
   // Zip file can be opened and closed by hand in order to allow for quick calculation of inflated file size
   // It is NOT recommended to pre-open it for any kind of inflation due to memory constraints
   bool isOpen() const { return !!file; }
   bool open();
   bool close();
   bool loadAllFileStatSlims();
+  // Walks the central directory once and writes a sorted, hash-keyed index of every entry to `path`.
+  bool writeIndex(const std::string& path);
+  // True if `path` holds an index that matches this zip (same format version, zip size and modify time).
+  bool hasValidIndex(const std::string& path);
   bool getInflatedFileSize(const char* filename, size_t* size);
   // Batch lookup: scan ZIP central dir once and fill sizes for matching targets.
   // targets must be sorted by (hash, len). sizes[target.index] receives uncompressedSize.
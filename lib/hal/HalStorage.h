@@ -76,6 +76,8 @@ class HalFile : public Print {
   size_t getName(char* name, size_t len);
   size_t size();
   size_t fileSize();
+  // FAT-packed date and time of the last write
+  bool getModifyDateTime(uint16_t* pdate, uint16_t* ptime);
   bool seek(size_t pos);
   bool seekCur(int64_t offset);
   bool seekSet(size_t offset);
@@ -0,0 +1,286 @@
+#!/usr/bin/env python3
+"""
+Move files and firmware to or from a CrossPoint device over the USB serial
+protocol's binary transfer mode, and report throughput.
+
+The transfer is negotiated with the JSON command `binary_begin`; after that
+both sides exchange CRC32-checked frames (see "Binary transfer mode" in
+src/UsbSerialProtocol.cpp):
+
+    u8 0xA5 | u8 type | u32 seq | u16 length | payload | u32 crc32(type..payload)
+
+Usage:
+    python usb_binary_transfer.py PORT push book.epub --dest /Books
+    python usb_binary_transfer.py PORT pull /Books/book.epub ./book.epub
+    python usb_binary_transfer.py PORT ota firmware.bin
+
+The device must be in the USB session (locked "connected to computer"
+screen) and run firmware reporting protocolVersion >= 2.
+"""
+
+from __future__ import annotations
+
+import argparse
+import json
+import struct
+import sys
+import time
+import zlib
+from pathlib import Path
+
+try:
+    import serial
+except ImportError:
+    print("pyserial is required: pip install pyserial", file=sys.stderr)
+    sys.exit(1)
+
+SYNC = 0xA5
+HEADER = struct.Struct("<BBIH")  # sync, type, seq, length
+CRC = struct.Struct("<I")
+
+DATA = 0x01
+END = 0x02
+ABORT = 0x03
+ACK = 0x81
+NAK = 0x82
+DONE = 0x83
+
+# Unacknowledged frames are resent from the oldest after this long without progress
+RETRANSMIT_S = 1.0
+# Give up after this many retransmits without progress
+MAX_RETRIES = 10
+
+
+class TransferError(Exception):
+    """Raised when the device rejects or drops a transfer."""
+
+
+class FramedLink:
+    def __init__(self, port: serial.Serial) -> None:
+        self.port = port
+        self.buffer = bytearray()
+        # Longest payload the device sends; a longer length means a false sync byte
+        self.max_payload = 4096
+
+    def command(self, cmd: str, arg: object = None, timeout: float = 9.0) -> dict:
+        """Sends a JSON command and returns the first JSON reply, skipping log lines."""
+        message = {"cmd": cmd} if arg is None else {"cmd": cmd, "arg": arg}
+        self.port.write(json.dumps(message).encode() + b"\n")
+        deadline = time.monotonic() + timeout
+        line = bytearray()
+        while time.monotonic() < deadline:
+            chunk = self.port.read(1)
+            if not chunk:
+                continue
+            if chunk != b"\n":
+                line += chunk
+                continue
+            text = line.decode(errors="replace").strip()
+            line.clear()
+            if not text.startswith("{"):
+                continue
+            try:
+                reply = json.loads(text)
+            except json.JSONDecodeError:
+                continue
+            if "ok" in reply:
+                return reply
+        raise TransferError(f"no reply to {cmd}")
+
+    def send(self, frame_type: int, seq: int, payload: bytes = b"") -> None:
+        header = HEADER.pack(SYNC, frame_type, seq, len(payload))
+        crc = zlib.crc32(header[1:] + payload)
+        self.port.write(header + payload + CRC.pack(crc))
+
+    def receive(self, timeout: float) -> tuple[int, int, bytes] | None:
+        """Returns (type, seq, payload) of the next valid frame, or None on timeout."""
+        deadline = time.monotonic() + timeout
+        while True:
+            frame = self._parse()
+            if frame is not None:
+                return frame
+            remaining = deadline - time.monotonic()
+            if remaining <= 0:
+                return None
+            self.port.timeout = min(remaining, 0.05)
+            self.buffer += self.port.read(max(1, self.port.in_waiting))
+
+    def _parse(self) -> tuple[int, int, bytes] | None:
+        while True:
+            start = self.buffer.find(SYNC)
+            if start < 0:
+                self.buffer.clear()
+                return None
+            del self.buffer[:start]
+            if len(self.buffer) < HEADER.size:
+                return None
+            _, frame_type, seq, length = HEADER.unpack_from(self.buffer)
+            if length > self.max_payload:
+                del self.buffer[:1]
+                continue
+            end = HEADER.size + length + CRC.size
+            if len(self.buffer) < end:
+                return None
+            (crc,) = CRC.unpack_from(self.buffer, HEADER.size + length)
+            if zlib.crc32(self.buffer[1 : HEADER.size + length]) != crc:
+                # Log text or a damaged frame; look for the next sync byte
+                del self.buffer[:1]
+                continue
+            payload = bytes(self.buffer[HEADER.size : HEADER.size + length])
+            del self.buffer[:end]
+            return frame_type, seq, payload
+
+
+def send_stream(link: FramedLink, data: bytes, chunk: int, window: int) -> None:
+    """Go-back-N sender for uploads and OTA; returns after DONE reports success."""
+    frames = [data[i : i + chunk] for i in range(0, len(data), chunk)]
+    base = 0  # oldest unacknowledged frame
+    next_seq = 0
+    retries = 0
+    last_progress = time.monotonic()
+
+    while base < len(frames):
+        while next_seq < len(frames) and next_seq < base + window:
+            link.send(DATA, next_seq, frames[next_seq])
+            next_seq += 1
+
+        frame = link.receive(RETRANSMIT_S)
+        if frame is None or time.monotonic() - last_progress > RETRANSMIT_S:
+            retries += 1
+            if retries > MAX_RETRIES:
+                link.send(ABORT, base)
+                raise TransferError(f"no acknowledgement for frame {base}")
+            next_seq = base
+            last_progress = time.monotonic()
+            continue
+
+        frame_type, seq, payload = frame
+        if frame_type == ACK and seq > base:
+            base = seq
+            retries = 0
+            last_progress = time.monotonic()
+        elif frame_type == NAK and base <= seq <= next_seq:
+            base = seq
+            next_seq = seq
+        elif frame_type == DONE and payload[:1] != b"\x00":
+            raise TransferError(payload[1:].decode(errors="replace"))
+
+    for _ in range(MAX_RETRIES):
+        link.send(END, len(frames))
+        deadline = time.monotonic() + RETRANSMIT_S
+        while time.monotonic() < deadline:
+            frame = link.receive(deadline - time.monotonic())
+            if frame is None or frame[0] != DONE:
+                continue
+            if frame[2][:1] != b"\x00":
+                raise TransferError(frame[2][1:].decode(errors="replace"))
+            return
+    raise TransferError("no DONE after END")
+
+
+def receive_stream(link: FramedLink, size: int) -> bytes:
+    """Receiver for downloads; accepts frames in order and acknowledges each."""
+    parts: list[bytes] = []
+    expected = 0
+    nak_sent = False
+    silent_since = time.monotonic()
+
+    while True:
+        frame = link.receive(RETRANSMIT_S)
+        if frame is None:
+            if time.monotonic() - silent_since > RETRANSMIT_S * MAX_RETRIES:
+                link.send(ABORT, expected)
+                raise TransferError("device stopped sending")
+            link.send(ACK, expected)
+            continue
+        silent_since = time.monotonic()
+
+        frame_type, seq, payload = frame
+        if frame_type == ABORT:
+            raise TransferError("device aborted the download")
+        if frame_type == END and seq == expected:
+            link.send(ACK, expected + 1)
+            data = b"".join(parts)
+            (declared,) = struct.unpack("<I", payload)
+            if len(data) != declared or len(data) != size:
+                raise TransferError(f"received {len(data)} bytes, expected {size}")
+            return data
+        if frame_type not in (DATA, END):
+            continue
+        if seq == expected:
+            parts.append(payload)
+            expected += 1
+            nak_sent = False
+            link.send(ACK, expected)
+        elif seq < expected:
+            # Resent before our ACK arrived
+            link.send(ACK, expected)
+        elif not nak_sent:
+            link.send(NAK, expected)
+            nak_sent = True
+
+
+def begin(link: FramedLink, arg: dict) -> dict:
+    status = link.command("status")
+    if status.get("protocolVersion", 1) < 2:
+        raise TransferError("firmware does not support binary transfers (protocolVersion < 2)")
+    reply = link.command("binary_begin", arg)
+    if not reply.get("ok"):
+        raise TransferError(reply.get("error", "binary_begin rejected"))
+    link.max_payload = reply["chunk"]
+    return reply
+
+
+def report(action: str, size: int, elapsed: float) -> None:
+    rate = size / elapsed / 1024 if elapsed > 0 else 0.0
+    print(f"{action} {size} bytes in {elapsed:.2f} s ({rate:.1f} KiB/s)")
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("port", help="Serial port of the device, e.g. /dev/ttyACM0 or COM5")
+    sub = parser.add_subparsers(dest="action", required=True)
+
+    push = sub.add_parser("push", help="Upload a file")
+    push.add_argument("file", type=Path)
+    push.add_argument("--dest", default="/", help="Destination directory on the SD card")
+    push.add_argument("--name", help="Destination file name (default: local name)")
+
+    pull = sub.add_parser("pull", help="Download a file")
+    pull.add_argument("remote", help="Path on the SD card")
+    pull.add_argument("file", type=Path)
+
+    ota = sub.add_parser("ota", help="Flash a firmware image; the device reboots afterwards")
+    ota.add_argument("file", type=Path)
+
+    args = parser.parse_args()
+
+    with serial.Serial(args.port, 115200, timeout=0.05) as port:
+        port.reset_input_buffer()
+        link = FramedLink(port)
+        try:
+            if args.action == "pull":
+                reply = begin(link, {"op": "download", "path": args.remote})
+                started = time.monotonic()
+                data = receive_stream(link, reply["size"])
+                elapsed = time.monotonic() - started
+                args.file.write_bytes(data)
+                report("Downloaded", len(data), elapsed)
+            else:
+                data = args.file.read_bytes()
+                if args.action == "push":
+                    arg = {"op": "upload", "name": args.name or args.file.name, "path": args.dest, "size": len(data)}
+                else:
+                    arg = {"op": "ota", "size": len(data)}
+                reply = begin(link, arg)
+                started = time.monotonic()
+                send_stream(link, data, reply["chunk"], reply["window"])
+                report("Uploaded" if args.action == "push" else "Flashed", len(data), time.monotonic() - started)
+        except TransferError as e:
+            print(f"Transfer failed: {e}", file=sys.stderr)
+            return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -523,6 +523,20 @@ int CrossPointSettings::getRefreshFrequency() const {
   }
 }
 
+uint32_t CrossPointSettings::getSectionCacheLimitBytes() const {
+  switch (sectionCacheLimit) {
+    case SECTION_CACHE_64MB:
+      return 64UL * 1024 * 1024;
+    case SECTION_CACHE_256MB:
+    default:
+      return 256UL * 1024 * 1024;
+    case SECTION_CACHE_1GB:
+      return 1024UL * 1024 * 1024;
+    case SECTION_CACHE_UNLIMITED:
+      return 0;
+  }
+}
+
 int CrossPointSettings::getTimeZoneOffsetSeconds() const {
   const int offsetHours = static_cast<int>(timeZoneOffset) - 12;
   return offsetHours * 3600;
@@ -166,6 +166,15 @@ class CrossPointSettings {
   // Image rendering in EPUB reader
   enum IMAGE_RENDERING { IMAGES_DISPLAY = 0, IMAGES_PLACEHOLDER = 1, IMAGES_SUPPRESS = 2, IMAGE_RENDERING_COUNT };
 
+  // SD space for laid-out EPUB chapters across all books and layout profiles
+  enum SECTION_CACHE_LIMIT {
+    SECTION_CACHE_64MB = 0,
+    SECTION_CACHE_256MB = 1,
+    SECTION_CACHE_1GB = 2,
+    SECTION_CACHE_UNLIMITED = 3,
+    SECTION_CACHE_LIMIT_COUNT
+  };
+
   // Global status bar overlay position
   enum GLOBAL_STATUS_BAR_POSITION {
     STATUS_BAR_TOP = 0,
@@ -264,6 +273,8 @@ class CrossPointSettings {
   uint8_t showHiddenFiles = 0;
   // Image rendering mode in EPUB reader
   uint8_t imageRendering = IMAGES_DISPLAY;
+  // Least recently read layout profiles are evicted beyond this (see SectionCacheStore)
+  uint8_t sectionCacheLimit = SECTION_CACHE_256MB;
   // Global status bar overlay (battery + WiFi, always visible across all screens)
   uint8_t globalStatusBar = 0;          // 0 = disabled, 1 = enabled
   uint8_t globalStatusBarPosition = STATUS_BAR_TOP;  // 0 = top, 1 = bottom
@@ -342,6 +353,8 @@ class CrossPointSettings {
   float getReaderLineCompression() const;
   unsigned long getSleepTimeoutMs() const;
   int getRefreshFrequency() const;
+  // 0 = unlimited
+  uint32_t getSectionCacheLimitBytes() const;
   int getTimeZoneOffsetSeconds() const;
 };
 
@@ -108,6 +108,7 @@ bool JsonSettingsIO::saveSettings(const CrossPointSettings& s, const char* path)
   doc["wifiAutoConnect"] = s.wifiAutoConnect;
   doc["showHiddenFiles"] = s.showHiddenFiles;
   doc["imageRendering"] = s.imageRendering;
+  doc["sectionCacheLimit"] = s.sectionCacheLimit;
   doc["globalStatusBar"] = s.globalStatusBar;
   doc["globalStatusBarPosition"] = s.globalStatusBarPosition;
 
@@ -207,6 +208,8 @@ bool JsonSettingsIO::loadSettings(CrossPointSettings& s, const char* json, bool*
   s.wifiAutoConnect = doc["wifiAutoConnect"] | (uint8_t)0;
   s.showHiddenFiles = doc["showHiddenFiles"] | (uint8_t)0;
   s.imageRendering = clamp(doc["imageRendering"] | (uint8_t)S::IMAGES_DISPLAY, S::IMAGE_RENDERING_COUNT, S::IMAGES_DISPLAY);
+  s.sectionCacheLimit = clamp(doc["sectionCacheLimit"] | (uint8_t)S::SECTION_CACHE_256MB, S::SECTION_CACHE_LIMIT_COUNT,
+                              S::SECTION_CACHE_256MB);
   s.globalStatusBar = doc["globalStatusBar"] | (uint8_t)0;
   s.globalStatusBarPosition =
       clamp(doc["globalStatusBarPosition"] | (uint8_t)S::STATUS_BAR_TOP, S::GLOBAL_STATUS_BAR_POSITION_COUNT, S::STATUS_BAR_TOP);
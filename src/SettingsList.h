@@ -200,6 +200,9 @@ inline std::vector<SettingInfo> getSettingsList() {
                         "sleepTimeout", StrId::STR_CAT_SYSTEM),
       SettingInfo::Toggle(StrId::STR_SHOW_HIDDEN_FILES, &CrossPointSettings::showHiddenFiles, "showHiddenFiles",
                           StrId::STR_CAT_SYSTEM),
+      SettingInfo::Enum(StrId::STR_SECTION_CACHE_LIMIT, &CrossPointSettings::sectionCacheLimit,
+                        {StrId::STR_SIZE_64MB, StrId::STR_SIZE_256MB, StrId::STR_SIZE_1GB, StrId::STR_UNLIMITED},
+                        "sectionCacheLimit", StrId::STR_CAT_SYSTEM),
   };
 
   if (core::FeatureModules::hasCapability(core::Capability::TrmnlSwitch)) {
@@ -7,8 +7,11 @@
 #include <Logging.h>  // for logSerial (the real HWCDC)
 #include <ObfuscationUtils.h>
 #include <WiFi.h>
+#include <esp_rom_crc.h>
 #include <mbedtls/base64.h>
 
+#include <algorithm>
+
 #include "CrossPointSettings.h"
 #include "CrossPointState.h"
 #include "JsonSettingsIO.h"
@@ -26,7 +29,8 @@
 
 namespace {
 
-constexpr uint8_t CROSSPOINT_PROTOCOL_VERSION = 1;
+// 2: binary_begin and the framed binary transfer mode
+constexpr uint8_t CROSSPOINT_PROTOCOL_VERSION = 2;
 
 // Sized to fit the largest incoming command: ota_chunk with a 4096-char base64 payload
 // {"cmd":"ota_chunk","arg":{"data":"<4096 chars>"}}  ≈ 4130 bytes + null
@@ -376,31 +380,35 @@ static void handleDownload(const char* path) {
   logSerial.print(F("\"}\n"));
 }
 
-// Android sends: {"cmd":"upload_start","arg":{"name":"file.epub","path":"/dir","size":1234}}
-static void handleUploadStart(const char* name, const char* dir, uint32_t /*size*/) {
-  if (s_uploadInProgress) {
-    SpiBusMutex::Guard guard;
-    s_uploadFile.close();
-    s_uploadInProgress = false;
-  }
-
+// Opens dir/name for writing; returns nullptr or the error to report
+static const char* openUploadTarget(const char* name, const char* dir, FsFile& file) {
   String destPath(dir);
   if (!destPath.endsWith("/")) destPath += '/';
   destPath += name;
 
   if (!PathUtils::isValidSdPath(destPath)) {
-    sendError("invalid path");
-    return;
+    return "invalid path";
   }
 
   bool opened = false;
   {
     SpiBusMutex::Guard guard;
-    opened = Storage.openFileForWrite("USB", destPath.c_str(), s_uploadFile);
+    opened = Storage.openFileForWrite("USB", destPath.c_str(), file);
   }
+  return opened ? nullptr : "cannot open file for write";
+}
 
-  if (!opened) {
-    sendError("cannot open file for write");
+// Android sends: {"cmd":"upload_start","arg":{"name":"file.epub","path":"/dir","size":1234}}
+static void handleUploadStart(const char* name, const char* dir, uint32_t /*size*/) {
+  if (s_uploadInProgress) {
+    SpiBusMutex::Guard guard;
+    s_uploadFile.close();
+    s_uploadInProgress = false;
+  }
+
+  const char* error = openUploadTarget(name, dir, s_uploadFile);
+  if (error) {
+    sendError(error);
     return;
   }
 
@@ -858,7 +866,8 @@ static void handleWifiConnect(const char* ssid, const char* password) {
 //
 // After ota_end the device sends {"ok":true} then restarts ~200 ms later.
 
-static void handleOtaBegin(uint32_t /*sizeHint*/) {
+// Opens the next OTA partition; returns nullptr or the error to report
+static const char* beginOta() {
   // Clean up any previous partial OTA.
   if (s_otaInProgress) {
     esp_ota_abort(s_otaHandle);
@@ -867,16 +876,35 @@ static void handleOtaBegin(uint32_t /*sizeHint*/) {
   }
   s_otaPartition = esp_ota_get_next_update_partition(nullptr);
   if (!s_otaPartition) {
-    sendError("no OTA partition available");
-    return;
+    return "no OTA partition available";
   }
   // OTA_WITH_SEQUENTIAL_WRITES: erase sectors on demand — no upfront erase stall.
   const esp_err_t err = esp_ota_begin(s_otaPartition, OTA_WITH_SEQUENTIAL_WRITES, &s_otaHandle);
   if (err != ESP_OK) {
-    sendError(esp_err_to_name(err));
-    return;
+    return esp_err_to_name(err);
   }
   s_otaInProgress = true;
+  return nullptr;
+}
+
+// Validates the image and makes it the boot partition; returns nullptr or the error to report
+static const char* finishOta() {
+  esp_err_t err = esp_ota_end(s_otaHandle);
+  s_otaHandle = 0;
+  s_otaInProgress = false;
+  if (err != ESP_OK) {
+    return esp_err_to_name(err);
+  }
+  err = esp_ota_set_boot_partition(s_otaPartition);
+  return err == ESP_OK ? nullptr : esp_err_to_name(err);
+}
+
+static void handleOtaBegin(uint32_t /*sizeHint*/) {
+  const char* error = beginOta();
+  if (error) {
+    sendError(error);
+    return;
+  }
   sendOk();
 }
 
@@ -912,16 +940,9 @@ static void handleOtaEnd() {
     sendError("no OTA in progress");
     return;
   }
-  esp_err_t err = esp_ota_end(s_otaHandle);
-  s_otaHandle = 0;
-  s_otaInProgress = false;
-  if (err != ESP_OK) {
-    sendError(esp_err_to_name(err));
-    return;
-  }
-  err = esp_ota_set_boot_partition(s_otaPartition);
-  if (err != ESP_OK) {
-    sendError(esp_err_to_name(err));
+  const char* error = finishOta();
+  if (error) {
+    sendError(error);
     return;
   }
   // ACK before rebooting so Android receives the success response.
@@ -940,6 +961,445 @@ static void handleOtaAbort() {
   sendOk();  // idempotent: no-op if not in progress
 }
 
+// ── Binary transfer mode ───────────────────────────────────────────────────
+//
+// Negotiated per transfer (host → device):
+//   {"cmd":"binary_begin","arg":{"op":"upload","name":"file.epub","path":"/dir","size":<bytes>}}
+//   {"cmd":"binary_begin","arg":{"op":"ota","size":<bytes>}}
+//   {"cmd":"binary_begin","arg":{"op":"download","path":"/dir/file.epub"}}
+// The device answers {"ok":true,"chunk":4096,"window":8} (plus "size" for downloads) and from then on both sides
+// exchange frames instead of JSON lines until the transfer ends:
+//
+//   u8 0xA5 | u8 type | u32 seq | u16 length | payload[length] | u32 crc32(type .. payload)     (little-endian)
+//
+// The sender keeps up to BINARY_WINDOW DATA frames of at most BINARY_CHUNK bytes unacknowledged. The receiver only
+// accepts the frame it expects next and answers it with ACK(next expected seq); a bad CRC or a gap is answered once
+// with NAK(expected) and the sender goes back to that frame. No reorder buffer is needed on the device, and a
+// download rewinds by seeking the file. Anything between frames (log output, stray newlines) is skipped by waiting
+// for the sync byte.
+//
+// Upload/OTA: after the last DATA frame is acknowledged the host sends END(seq = frame count) and the device replies
+// DONE with payload u8 status (0 = ok) followed by an error message; after a successful OTA it then reboots.
+// Download: the device sends END(seq = frame count, payload u32 file size) as the frame after the last DATA frame
+// and the transfer ends once the host has acknowledged it.
+// Either side may send ABORT to drop the transfer. A transfer idle for BINARY_IDLE_TIMEOUT_MS is dropped as well.
+
+enum class FrameType : uint8_t {
+  Data = 0x01,
+  End = 0x02,
+  Abort = 0x03,
+  Ack = 0x81,
+  Nak = 0x82,
+  Done = 0x83,
+};
+
+enum class BinaryOp : uint8_t { None, Upload, Ota, Download };
+
+constexpr uint8_t BINARY_SYNC = 0xA5;
+constexpr size_t BINARY_HEADER_SIZE = 8;  // sync, type, seq, length
+constexpr size_t BINARY_CRC_SIZE = 4;
+constexpr uint16_t BINARY_CHUNK = 4096;
+constexpr uint32_t BINARY_WINDOW = 8;
+constexpr unsigned long BINARY_IDLE_TIMEOUT_MS = 10000;
+// Download frames not acknowledged within this time are sent again from the oldest one
+constexpr unsigned long BINARY_RETRANSMIT_MS = 1000;
+// loop() keeps pumping frames until the link has been quiet this long, so a transfer is not paced by the main loop
+constexpr unsigned long BINARY_PUMP_IDLE_MS = 30;
+
+// Incoming frames are assembled in s_lineBuf, which is unused while a binary transfer runs
+static_assert(BINARY_HEADER_SIZE + BINARY_CHUNK + BINARY_CRC_SIZE <= sizeof(s_lineBuf), "frame must fit s_lineBuf");
+
+static BinaryOp s_binaryOp = BinaryOp::None;
+static FsFile s_binaryFile;
+static size_t s_frameLen = 0;
+static uint32_t s_binaryDeclaredSize = 0;
+static uint32_t s_binaryBytes = 0;
+// Upload/OTA: seq of the next frame to accept. Download: oldest unacknowledged frame.
+static uint32_t s_binaryExpectedSeq = 0;
+static uint32_t s_binaryNextSendSeq = 0;
+static uint32_t s_binaryFrameCount = 0;
+static bool s_binaryNakSent = false;
+static unsigned long s_binaryLastFrameAt = 0;
+static unsigned long s_binaryLastAckAt = 0;
+
+static void putLe32(uint8_t* out, const uint32_t value) {
+  out[0] = value & 0xFF;
+  out[1] = (value >> 8) & 0xFF;
+  out[2] = (value >> 16) & 0xFF;
+  out[3] = (value >> 24) & 0xFF;
+}
+
+static uint32_t getLe32(const uint8_t* in) {
+  return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) | (static_cast<uint32_t>(in[2]) << 16) |
+         (static_cast<uint32_t>(in[3]) << 24);
+}
+
+// Writes the header and returns the CRC over it, to be continued over the payload
+static uint32_t writeFrameHeader(const FrameType type, const uint32_t seq, const uint16_t length) {
+  uint8_t header[BINARY_HEADER_SIZE];
+  header[0] = BINARY_SYNC;
+  header[1] = static_cast<uint8_t>(type);
+  putLe32(header + 2, seq);
+  header[6] = length & 0xFF;
+  header[7] = length >> 8;
+  logSerial.write(header, sizeof(header));
+  return esp_rom_crc32_le(0, header + 1, sizeof(header) - 1);
+}
+
+static void writeFrameCrc(const uint32_t crc) {
+  uint8_t trailer[BINARY_CRC_SIZE];
+  putLe32(trailer, crc);
+  logSerial.write(trailer, sizeof(trailer));
+}
+
+static void sendFrame(const FrameType type, const uint32_t seq, const uint8_t* payload = nullptr,
+                      const uint16_t length = 0) {
+  uint32_t crc = writeFrameHeader(type, seq, length);
+  if (length > 0) {
+    logSerial.write(payload, length);
+    crc = esp_rom_crc32_le(crc, payload, length);
+  }
+  writeFrameCrc(crc);
+}
+
+static void closeBinaryTransfer() {
+  if (s_binaryFile) {
+    SpiBusMutex::Guard guard;
+    s_binaryFile.close();
+  }
+  if (s_binaryOp == BinaryOp::Ota && s_otaInProgress) {
+    esp_ota_abort(s_otaHandle);
+    s_otaHandle = 0;
+    s_otaInProgress = false;
+  }
+  s_binaryOp = BinaryOp::None;
+  s_frameLen = 0;
+}
+
+// Ends an upload or OTA with DONE; error == nullptr reports success
+static void sendBinaryDone(const char* error) {
+  uint8_t payload[64];
+  payload[0] = error ? 1 : 0;
+  size_t length = 1;
+  if (error) {
+    const size_t messageLength = std::min(strlen(error), sizeof(payload) - 1);
+    memcpy(payload + 1, error, messageLength);
+    length += messageLength;
+  }
+  sendFrame(FrameType::Done, s_binaryExpectedSeq, payload, static_cast<uint16_t>(length));
+}
+
+static void failBinaryTransfer(const char* error) {
+  LOG_ERR("USB", "Binary transfer failed: %s", error);
+  if (s_binaryOp == BinaryOp::Download) {
+    sendFrame(FrameType::Abort, s_binaryExpectedSeq);
+  } else {
+    sendBinaryDone(error);
+  }
+  closeBinaryTransfer();
+}
+
+static bool writeBinaryPayload(const uint8_t* data, const uint16_t length) {
+  if (s_binaryOp == BinaryOp::Ota) {
+    return esp_ota_write(s_otaHandle, data, length) == ESP_OK;
+  }
+  SpiBusMutex::Guard guard;
+  return s_binaryFile.write(data, length) == length;
+}
+
+static void finishBinaryReceive() {
+  if (s_binaryDeclaredSize != 0 && s_binaryBytes != s_binaryDeclaredSize) {
+    failBinaryTransfer("size mismatch");
+    return;
+  }
+
+  if (s_binaryOp == BinaryOp::Ota) {
+    const char* error = finishOta();
+    s_binaryOp = BinaryOp::None;
+    if (error) {
+      failBinaryTransfer(error);
+      return;
+    }
+    LOG_INF("USB", "Binary OTA received: %lu bytes", static_cast<unsigned long>(s_binaryBytes));
+    sendBinaryDone(nullptr);
+    closeBinaryTransfer();
+    logSerial.flush();
+    delay(200);
+    esp_restart();
+    return;
+  }
+
+  {
+    SpiBusMutex::Guard guard;
+    s_binaryFile.close();
+  }
+  LOG_INF("USB", "Binary upload received: %lu bytes", static_cast<unsigned long>(s_binaryBytes));
+  sendBinaryDone(nullptr);
+  closeBinaryTransfer();
+}
+
+// Answers a frame that is not the next one expected, at most once until the expected one arrives
+static void nakBinaryFrame() {
+  if (!s_binaryNakSent) {
+    sendFrame(FrameType::Nak, s_binaryExpectedSeq);
+    s_binaryNakSent = true;
+  }
+}
+
+static void handleBinaryReceiveFrame(const FrameType type, const uint32_t seq, const uint8_t* payload,
+                                     const uint16_t length) {
+  if (seq < s_binaryExpectedSeq) {
+    // Resent after a NAK or timeout that crossed our ACK; acknowledge again so the host moves on
+    sendFrame(FrameType::Ack, s_binaryExpectedSeq);
+    return;
+  }
+  if (seq > s_binaryExpectedSeq) {
+    nakBinaryFrame();
+    return;
+  }
+
+  s_binaryNakSent = false;
+  if (type == FrameType::End) {
+    finishBinaryReceive();
+    return;
+  }
+  if (!writeBinaryPayload(payload, length)) {
+    failBinaryTransfer(s_binaryOp == BinaryOp::Ota ? "OTA write failed" : "write failed");
+    return;
+  }
+  s_binaryBytes += length;
+  s_binaryExpectedSeq++;
+  sendFrame(FrameType::Ack, s_binaryExpectedSeq);
+}
+
+static void handleBinaryDownloadFrame(const FrameType type, const uint32_t seq) {
+  // The END frame is seq s_binaryFrameCount, so the last acknowledgement is one past it
+  if (seq < s_binaryExpectedSeq || seq > s_binaryFrameCount + 1) {
+    return;  // stale
+  }
+  if (type == FrameType::Ack) {
+    // Repeated ACKs are the host asking for a resend, so only progress holds off the retransmit timer
+    if (seq > s_binaryExpectedSeq) {
+      s_binaryLastAckAt = millis();
+    }
+    // May be ahead of s_binaryNextSendSeq when it acknowledges frames sent before a retransmit rewound it
+    s_binaryExpectedSeq = seq;
+    s_binaryNextSendSeq = std::max(s_binaryNextSendSeq, seq);
+  } else if (type == FrameType::Nak) {
+    s_binaryExpectedSeq = seq;
+    s_binaryNextSendSeq = seq;
+    s_binaryLastAckAt = millis();
+  }
+}
+
+static void handleBinaryFrame(const uint8_t* frame) {
+  const auto type = static_cast<FrameType>(frame[1]);
+  const uint32_t seq = getLe32(frame + 2);
+  const uint16_t length = frame[6] | (frame[7] << 8);
+  const uint8_t* payload = frame + BINARY_HEADER_SIZE;
+
+  const uint32_t crc = esp_rom_crc32_le(0, frame + 1, BINARY_HEADER_SIZE - 1 + length);
+  if (crc != getLe32(payload + length)) {
+    if (s_binaryOp != BinaryOp::Download) {
+      nakBinaryFrame();
+    }
+    return;
+  }
+  s_binaryLastFrameAt = millis();
+
+  if (type == FrameType::Abort) {
+    LOG_INF("USB", "Binary transfer aborted by host");
+    closeBinaryTransfer();
+    return;
+  }
+  if (s_binaryOp == BinaryOp::Download) {
+    handleBinaryDownloadFrame(type, seq);
+  } else if (type == FrameType::Data || type == FrameType::End) {
+    handleBinaryReceiveFrame(type, seq, payload, length);
+  }
+}
+
+// Assembles frames from whatever has arrived; returns true if any byte was read
+static bool readBinaryFrames() {
+  auto* frame = reinterpret_cast<uint8_t*>(s_lineBuf);
+  bool gotData = false;
+  while (s_binaryOp != BinaryOp::None && logSerial.available() > 0) {
+    gotData = true;
+    if (s_frameLen == 0) {
+      const int c = logSerial.read();
+      if (c == BINARY_SYNC) {
+        frame[s_frameLen++] = BINARY_SYNC;
+      }
+      continue;
+    }
+
+    size_t frameSize = BINARY_HEADER_SIZE;
+    if (s_frameLen >= BINARY_HEADER_SIZE) {
+      const uint16_t length = frame[6] | (frame[7] << 8);
+      if (length > BINARY_CHUNK) {
+        s_frameLen = 0;  // not a real frame start; look for the next sync byte
+        continue;
+      }
+      frameSize += length + BINARY_CRC_SIZE;
+    }
+
+    const size_t wanted = std::min(frameSize - s_frameLen, static_cast<size_t>(logSerial.available()));
+    s_frameLen += logSerial.read(frame + s_frameLen, wanted);
+    if (s_frameLen == frameSize && frameSize > BINARY_HEADER_SIZE) {
+      s_frameLen = 0;
+      handleBinaryFrame(frame);
+    }
+  }
+  return gotData;
+}
+
+// Sends the download frames the window allows; payload is streamed from the file in s_rawBuf-sized pieces
+static void sendBinaryDownloadFrames() {
+  if (s_binaryNextSendSeq > s_binaryExpectedSeq && millis() - s_binaryLastAckAt > BINARY_RETRANSMIT_MS) {
+    s_binaryNextSendSeq = s_binaryExpectedSeq;
+    s_binaryLastAckAt = millis();
+  }
+
+  if (s_binaryExpectedSeq > s_binaryFrameCount) {
+    LOG_INF("USB", "Binary download sent: %lu bytes", static_cast<unsigned long>(s_binaryDeclaredSize));
+    closeBinaryTransfer();
+    return;
+  }
+
+  while (s_binaryNextSendSeq <= s_binaryFrameCount && s_binaryNextSendSeq < s_binaryExpectedSeq + BINARY_WINDOW) {
+    if (s_binaryNextSendSeq == s_binaryFrameCount) {
+      uint8_t size[4];
+      putLe32(size, s_binaryDeclaredSize);
+      sendFrame(FrameType::End, s_binaryFrameCount, size, sizeof(size));
+      s_binaryNextSendSeq++;
+      return;
+    }
+
+    const uint32_t offset = s_binaryNextSendSeq * BINARY_CHUNK;
+    const auto length = static_cast<uint16_t>(std::min<uint32_t>(BINARY_CHUNK, s_binaryDeclaredSize - offset));
+    {
+      SpiBusMutex::Guard guard;
+      if (!s_binaryFile.seek(offset)) {
+        failBinaryTransfer("seek failed");
+        return;
+      }
+    }
+
+    uint32_t crc = writeFrameHeader(FrameType::Data, s_binaryNextSendSeq, length);
+    bool readOk = true;
+    for (uint16_t sent = 0; sent < length;) {
+      const size_t piece = std::min(sizeof(s_rawBuf), static_cast<size_t>(length - sent));
+      int bytesRead = 0;
+      {
+        SpiBusMutex::Guard guard;
+        bytesRead = s_binaryFile.read(s_rawBuf, piece);
+      }
+      if (bytesRead != static_cast<int>(piece)) {
+        // The header is already out; pad the frame so the host stays in sync, the broken CRC makes it drop it
+        memset(s_rawBuf, 0, piece);
+        readOk = false;
+      }
+      logSerial.write(s_rawBuf, piece);
+      crc = esp_rom_crc32_le(crc, s_rawBuf, piece);
+      sent += piece;
+    }
+    writeFrameCrc(readOk ? crc : ~crc);
+    if (!readOk) {
+      failBinaryTransfer("read failed");
+      return;
+    }
+    s_binaryNextSendSeq++;
+  }
+}
+
+static void pumpBinaryTransfer() {
+  unsigned long lastDataAt = millis();
+  while (s_binaryOp != BinaryOp::None) {
+    if (readBinaryFrames()) {
+      lastDataAt = millis();
+    }
+    if (s_binaryOp == BinaryOp::Download) {
+      sendBinaryDownloadFrames();
+    }
+    if (s_binaryOp == BinaryOp::None) {
+      return;
+    }
+    if (millis() - s_binaryLastFrameAt > BINARY_IDLE_TIMEOUT_MS) {
+      LOG_ERR("USB", "Binary transfer timed out");
+      closeBinaryTransfer();
+      return;
+    }
+    if (millis() - lastDataAt > BINARY_PUMP_IDLE_MS) {
+      return;
+    }
+    delay(1);
+  }
+}
+
+static void handleBinaryBegin(JsonObjectConst arg) {
+  closeBinaryTransfer();
+  const char* op = arg["op"] | "";
+  s_binaryDeclaredSize = arg["size"] | (uint32_t)0;
+
+  if (strcmp(op, "upload") == 0) {
+    const char* error = openUploadTarget(arg["name"] | "", arg["path"] | "/", s_binaryFile);
+    if (error) {
+      sendError(error);
+      return;
+    }
+    s_binaryOp = BinaryOp::Upload;
+  } else if (strcmp(op, "ota") == 0) {
+    const char* error = beginOta();
+    if (error) {
+      sendError(error);
+      return;
+    }
+    s_binaryOp = BinaryOp::Ota;
+  } else if (strcmp(op, "download") == 0) {
+    const char* path = arg["path"] | "";
+    if (!PathUtils::isValidSdPath(String(path))) {
+      sendError("invalid path");
+      return;
+    }
+    bool opened = false;
+    bool isDir = false;
+    {
+      SpiBusMutex::Guard guard;
+      opened = Storage.openFileForRead("USB", path, s_binaryFile);
+      if (opened) isDir = s_binaryFile.isDirectory();
+      if (opened && !isDir) s_binaryDeclaredSize = s_binaryFile.size();
+    }
+    if (!opened || isDir) {
+      closeBinaryTransfer();
+      sendError("cannot open file");
+      return;
+    }
+    s_binaryOp = BinaryOp::Download;
+    s_binaryFrameCount = (s_binaryDeclaredSize + BINARY_CHUNK - 1) / BINARY_CHUNK;
+  } else {
+    sendError("unknown op");
+    return;
+  }
+
+  s_binaryBytes = 0;
+  s_binaryExpectedSeq = 0;
+  s_binaryNextSendSeq = 0;
+  s_binaryNakSent = false;
+  s_frameLen = 0;
+  s_binaryLastFrameAt = s_binaryLastAckAt = millis();
+
+  JsonDocument resp;
+  resp["ok"] = true;
+  resp["chunk"] = BINARY_CHUNK;
+  resp["window"] = BINARY_WINDOW;
+  if (s_binaryOp == BinaryOp::Download) {
+    resp["size"] = s_binaryDeclaredSize;
+  }
+  serializeJson(resp, logSerial);
+  logSerial.write('\n');
+  LOG_DBG("USB", "Binary %s started", op);
+}
+
 // ── Command dispatcher ─────────────────────────────────────────────────────
 
 static void processCommand(const char* line) {
@@ -1019,6 +1479,8 @@ static void processCommand(const char* line) {
     handleOtaEnd();
   } else if (strcmp(name, "ota_abort") == 0) {
     handleOtaAbort();
+  } else if (strcmp(name, "binary_begin") == 0) {
+    handleBinaryBegin(cmd["arg"].as<JsonObjectConst>());
   } else {
     sendError("unknown command");
   }
@@ -1029,6 +1491,11 @@ static void processCommand(const char* line) {
 // ── Public interface ───────────────────────────────────────────────────────
 
 void UsbSerialProtocol::loop() {
+  if (s_binaryOp != BinaryOp::None) {
+    pumpBinaryTransfer();
+    return;
+  }
+
   while (logSerial.available()) {
     const int c = logSerial.read();
     if (c < 0) break;
@@ -1049,6 +1516,7 @@ void UsbSerialProtocol::loop() {
 
 void UsbSerialProtocol::reset() {
   s_lineLen = 0;
+  closeBinaryTransfer();
   if (s_uploadInProgress) {
     SpiBusMutex::Guard guard;
     s_uploadFile.close();
@@ -20,6 +20,7 @@
 #include "images/Logo120.h"
 #include "network/BackgroundWifiService.h"
 #include "util/PokemonBookDataStore.h"
+#include "util/SleepScreenCache.h"
 
 namespace {
 
@@ -309,6 +310,7 @@ void invalidateSleepImageCache() {
   {
     SpiBusMutex::Guard spiGuard;
     Storage.remove(SLEEP_CACHE_FILE);
+    SleepScreenCache::clear();
   }
   LOG_INF("SLP", "Sleep image cache invalidated");
 }
@@ -355,7 +357,7 @@ void SleepActivity::renderCustomSleepScreen() const {
       if (Storage.openFileForRead("SLP", pinnedPath, file)) {
         Bitmap bitmap(file, true);
         if (bitmap.parseHeaders() == BmpReaderError::Ok) {
-          renderBitmapSleepScreen(bitmap);
+          renderBitmapSleepScreen(bitmap, pinnedPath);
           file.close();
           return;
         }
@@ -385,7 +387,7 @@ void SleepActivity::renderCustomSleepScreen() const {
           if (Storage.openFileForRead("SLP", partySleepImagePath, file)) {
             Bitmap bitmap(file, true);
             if (bitmap.parseHeaders() == BmpReaderError::Ok) {
-              renderBitmapSleepScreen(bitmap);
+              renderBitmapSleepScreen(bitmap, partySleepImagePath);
               file.close();
               return;
             }
@@ -429,7 +431,7 @@ void SleepActivity::renderCustomSleepScreen() const {
       if (Storage.openFileForRead("SLP", filename, file)) {
         Bitmap bitmap(file, true);
         if (bitmap.parseHeaders() == BmpReaderError::Ok) {
-          renderBitmapSleepScreen(bitmap);
+          renderBitmapSleepScreen(bitmap, filename);
           file.close();
           return;
         }
@@ -453,7 +455,7 @@ void SleepActivity::renderCustomSleepScreen() const {
           Bitmap bitmap(file, true);
           if (bitmap.parseHeaders() == BmpReaderError::Ok) {
             LOG_INF("SLP", "Loading: %s", sleepImagePath);
-            renderBitmapSleepScreen(bitmap);
+            renderBitmapSleepScreen(bitmap, sleepImagePath);
             file.close();
             return;
           }
@@ -524,7 +526,11 @@ void SleepActivity::renderDefaultSleepScreen() const {
   renderer.displayBuffer(HalDisplay::HALF_REFRESH);
 }
 
-void SleepActivity::renderBitmapSleepScreen(const Bitmap& bitmap) const {
+void SleepActivity::renderBitmapSleepScreen(const Bitmap& bitmap, const std::string& sourcePath) const {
+  if (SleepScreenCache::show(renderer, sourcePath)) {
+    return;
+  }
+
   int x, y;
   const auto pageWidth = renderer.getScreenWidth();
   const auto pageHeight = renderer.getScreenHeight();
@@ -570,12 +576,15 @@ void SleepActivity::renderBitmapSleepScreen(const Bitmap& bitmap) const {
   const bool hasGreyscale = bitmap.hasGreyscale() &&
                             SETTINGS.sleepScreenCoverFilter == CrossPointSettings::SLEEP_SCREEN_COVER_FILTER::NO_FILTER;
 
+  SleepScreenCache::Writer cacheWriter(renderer, sourcePath, hasGreyscale ? 3 : 1);
+
   renderer.drawBitmap(bitmap, x, y, pageWidth, pageHeight, cropX, cropY);
 
   if (SETTINGS.sleepScreenCoverFilter == CrossPointSettings::SLEEP_SCREEN_COVER_FILTER::INVERTED_BLACK_AND_WHITE) {
     renderer.invertScreen();
   }
 
+  cacheWriter.addPlane();
   renderer.displayBuffer(HalDisplay::HALF_REFRESH);
 
   if (hasGreyscale) {
@@ -583,20 +592,27 @@ void SleepActivity::renderBitmapSleepScreen(const Bitmap& bitmap) const {
     renderer.clearScreen(0x00);
     renderer.setRenderMode(GfxRenderer::GRAYSCALE_LSB);
     renderer.drawBitmap(bitmap, x, y, pageWidth, pageHeight, cropX, cropY);
+    cacheWriter.addPlane();
     renderer.copyGrayscaleLsbBuffers();
 
     bitmap.rewindToData();
     renderer.clearScreen(0x00);
     renderer.setRenderMode(GfxRenderer::GRAYSCALE_MSB);
     renderer.drawBitmap(bitmap, x, y, pageWidth, pageHeight, cropX, cropY);
+    cacheWriter.addPlane();
     renderer.copyGrayscaleMsbBuffers();
 
     renderer.displayGrayBuffer();
     renderer.setRenderMode(GfxRenderer::BW);
   }
+  cacheWriter.commit();
 }
 
 void SleepActivity::renderImageSleepScreen(const std::string& imagePath) const {
+  if (SleepScreenCache::show(renderer, imagePath)) {
+    return;
+  }
+
   const auto pageWidth = renderer.getScreenWidth();
   const auto pageHeight = renderer.getScreenHeight();
 
@@ -655,6 +671,8 @@ void SleepActivity::renderImageSleepScreen(const std::string& imagePath) const {
     renderer.invertScreen();
   }
 
+  SleepScreenCache::Writer cacheWriter(renderer, imagePath, useGrayscale ? 3 : 1);
+  cacheWriter.addPlane();
   renderer.displayBuffer(HalDisplay::HALF_REFRESH);
 
   // If grayscale is enabled, do additional passes for 4-level grayscale
@@ -663,15 +681,18 @@ void SleepActivity::renderImageSleepScreen(const std::string& imagePath) const {
     renderer.clearScreen(0x00);
     renderer.setRenderMode(GfxRenderer::GRAYSCALE_LSB);
     decoder->decodeToFramebuffer(imagePath, renderer, config);
+    cacheWriter.addPlane();
     renderer.copyGrayscaleLsbBuffers();
 
     // MSB pass
     renderer.clearScreen(0x00);
     renderer.setRenderMode(GfxRenderer::GRAYSCALE_MSB);
     decoder->decodeToFramebuffer(imagePath, renderer, config);
+    cacheWriter.addPlane();
     renderer.copyGrayscaleMsbBuffers();
 
     renderer.displayGrayBuffer();
     renderer.setRenderMode(GfxRenderer::BW);
   }
+  cacheWriter.commit();
 }
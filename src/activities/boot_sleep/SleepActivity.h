@@ -17,7 +17,7 @@ class SleepActivity final : public Activity {
  private:
   void renderDefaultSleepScreen() const;
   void renderCustomSleepScreen() const;
-  void renderBitmapSleepScreen(const Bitmap& bitmap) const;
+  void renderBitmapSleepScreen(const Bitmap& bitmap, const std::string& sourcePath) const;
   void renderImageSleepScreen(const std::string& imagePath) const;
   void renderTransparentSleepScreen() const;
 
@@ -11,6 +11,7 @@
 #include <utility>
 
 #include "../util/ConfirmationActivity.h"
+#include "../util/KeyboardEntryActivity.h"
 #include "MappedInputManager.h"
 #include "util/RecentBooksStore.h"
 #include "components/ScreenComponents.h"
@@ -24,6 +25,9 @@
 namespace {
 // Timing thresholds
 constexpr unsigned long GO_HOME_MS = 1000;
+// Catalog rows read per SD access; a screenful or two
+constexpr uint32_t CATALOG_PAGE_BOOKS = 12;
+constexpr size_t SEARCH_MAX_LENGTH = 64;
 
 std::string fallbackTitleFromPath(const std::string& path) {
   std::string title = path;
@@ -128,7 +132,14 @@ void MyLibraryActivity::loadFiles() {
 }
 
 void MyLibraryActivity::loadRecentBooks() {
+  {
+    SpiBusMutex::Guard guard;
+    catalogRecent = LIBRARY_CATALOG.count(LibraryCatalog::Order::Recent) > 0;
+  }
   recentBooks.clear();
+  if (catalogRecent) {
+    return;
+  }
   const auto& books = RECENT_BOOKS.getBooks();
   recentBooks.reserve(books.size());
   for (const auto& book : books) {
@@ -150,12 +161,85 @@ size_t MyLibraryActivity::findEntry(const std::string& name) const {
   return 0;
 }
 
+bool MyLibraryActivity::isCatalogTab() const {
+  return currentTab == Tab::Titles || currentTab == Tab::Authors || (currentTab == Tab::Recent && catalogRecent);
+}
+
+LibraryCatalog::Order MyLibraryActivity::catalogOrder() const {
+  switch (currentTab) {
+    case Tab::Authors:
+      return LibraryCatalog::Order::Author;
+    case Tab::Recent:
+      return LibraryCatalog::Order::Recent;
+    default:
+      return LibraryCatalog::Order::Title;
+  }
+}
+
+void MyLibraryActivity::loadCatalogRange() {
+  catalogPage.clear();
+  catalogPageStart = 0;
+  catalogGeneration = LIBRARY_CATALOG.getGeneration();
+  if (!isCatalogTab()) {
+    catalogFirst = 0;
+    catalogCount = 0;
+    return;
+  }
+  SpiBusMutex::Guard guard;
+  const auto range = LIBRARY_CATALOG.findPrefix(catalogOrder(), searchPrefix);
+  catalogFirst = range.first;
+  catalogCount = range.second - range.first;
+}
+
+const LibraryCatalog::Book& MyLibraryActivity::catalogBook(const int index) const {
+  static const LibraryCatalog::Book missing;
+  const uint32_t position = catalogFirst + index;
+  if (position < catalogPageStart || position >= catalogPageStart + catalogPage.size()) {
+    catalogPage.clear();
+    catalogPageStart = position;
+    SpiBusMutex::Guard guard;
+    LIBRARY_CATALOG.getBooks(catalogOrder(), position, CATALOG_PAGE_BOOKS, catalogPage);
+  }
+  const uint32_t offset = position - catalogPageStart;
+  return offset < catalogPage.size() ? catalogPage[offset] : missing;
+}
+
+std::string MyLibraryActivity::selectedCatalogPath() {
+  // catalogBook() may refill the page cache the render task is reading
+  RenderLock lock(*this);
+  return catalogBook(selectorIndex).path;
+}
+
+void MyLibraryActivity::switchTab(const Tab tab) {
+  RenderLock lock(*this);
+  currentTab = tab;
+  selectorIndex = 0;
+  searchPrefix.clear();
+  loadCatalogRange();
+  requestUpdate();
+}
+
+void MyLibraryActivity::openSearch() {
+  startActivityForResult(
+      std::make_unique<KeyboardEntryActivity>(renderer, mappedInput, tr(STR_SEARCH), searchPrefix, SEARCH_MAX_LENGTH,
+                                              false),
+      [this](const ActivityResult& result) {
+        if (!result.isCancelled) {
+          RenderLock lock(*this);
+          searchPrefix = std::get<KeyboardResult>(result.data).text;
+          selectorIndex = 0;
+          loadCatalogRange();
+        }
+        requestUpdate();
+      });
+}
+
 int MyLibraryActivity::getPageItems() const {
   auto metrics = UITheme::getInstance().getMetrics();
   const int contentHeight = renderer.getScreenHeight() - metrics.topPadding - metrics.headerHeight -
                             metrics.tabBarHeight - metrics.verticalSpacing - metrics.buttonHintsHeight -
                             metrics.verticalSpacing;
-  const int rowHeight = (currentTab == Tab::Recent) ? metrics.listWithSubtitleRowHeight : metrics.listRowHeight;
+  const int rowHeight = (currentTab != Tab::Files) ? metrics.listWithSubtitleRowHeight : metrics.listRowHeight;
   return std::max(1, contentHeight / rowHeight);
 }
 
@@ -180,11 +264,20 @@ void MyLibraryActivity::onEnter() {
 
   loadRecentBooks();
   loadFiles();
+  loadCatalogRange();
+  scanner.start();
 
   selectorIndex = 0;
   if (currentTab == Tab::Recent && !restoreRecentPath.empty()) {
-    for (size_t i = 0; i < recentBooks.size(); ++i) {
-      if (recentBooks[i].path == restoreRecentPath) {
+    std::vector<std::string> recentPaths;
+    if (catalogRecent) {
+      SpiBusMutex::Guard guard;
+      recentPaths = LIBRARY_CATALOG.getRecentPaths();
+    } else {
+      for (const auto& book : recentBooks) recentPaths.push_back(book.path);
+    }
+    for (size_t i = 0; i < recentPaths.size(); ++i) {
+      if (recentPaths[i] == restoreRecentPath) {
         selectorIndex = i;
         break;
       }
@@ -198,8 +291,10 @@ void MyLibraryActivity::onEnter() {
 
 void MyLibraryActivity::onExit() {
   Activity::onExit();
+  scanner.stop();
   recentBooks.clear();
   files.clear();
+  catalogPage.clear();
 }
 
 void MyLibraryActivity::clearFileMetadata(const std::string& fullPath) {
@@ -211,13 +306,32 @@ void MyLibraryActivity::clearFileMetadata(const std::string& fullPath) {
 }
 
 void MyLibraryActivity::loop() {
+  // A scan finished or the reading history changed; re-read the range the catalog tabs are showing. The render task
+  // reads the same lists and page cache, so they only change under the lock.
+  if (LIBRARY_CATALOG.getGeneration() != catalogGeneration) {
+    RenderLock lock(*this);
+    loadRecentBooks();
+    loadCatalogRange();
+    const int count = getCurrentItemCount();
+    if (selectorIndex >= static_cast<size_t>(std::max(count, 1))) {
+      selectorIndex = count > 0 ? count - 1 : 0;
+    }
+    if (currentTab != Tab::Files) {
+      requestUpdate();
+    }
+  }
+
   const int itemCount = getCurrentItemCount();
   const int pageItems = getPageItems();
 
   if (currentTab == Tab::Recent) {
     // Confirm button - open selected item
     if (mappedInput.wasReleased(MappedInputManager::Button::Confirm)) {
-      if (!recentBooks.empty() && selectorIndex < static_cast<int>(recentBooks.size())) {
+      if (catalogRecent) {
+        if (selectorIndex < catalogCount) {
+          activityManager.goToReader(selectedCatalogPath());
+        }
+      } else if (!recentBooks.empty() && selectorIndex < static_cast<int>(recentBooks.size())) {
         activityManager.goToReader(recentBooks[selectorIndex].path);
       }
       return;
@@ -231,9 +345,40 @@ void MyLibraryActivity::loop() {
 
     // Tab switching
     if (mappedInput.wasReleased(MappedInputManager::Button::Right)) {
-      currentTab = Tab::Files;
-      selectorIndex = 0;
-      requestUpdate();
+      switchTab(Tab::Titles);
+      return;
+    }
+  } else if (currentTab == Tab::Titles || currentTab == Tab::Authors) {
+    if (mappedInput.wasReleased(MappedInputManager::Button::Confirm)) {
+      if (mappedInput.getHeldTime() >= GO_HOME_MS) {
+        // Long press searches by the start of the title or author
+        openSearch();
+      } else if (selectorIndex < catalogCount) {
+        activityManager.goToReader(selectedCatalogPath());
+      }
+      return;
+    }
+
+    // Back clears the search first
+    if (mappedInput.wasReleased(MappedInputManager::Button::Back)) {
+      if (!searchPrefix.empty()) {
+        RenderLock lock(*this);
+        searchPrefix.clear();
+        selectorIndex = 0;
+        loadCatalogRange();
+        requestUpdate();
+      } else {
+        activityManager.goHome();
+      }
+      return;
+    }
+
+    if (mappedInput.wasReleased(MappedInputManager::Button::Left)) {
+      switchTab(currentTab == Tab::Titles ? Tab::Recent : Tab::Titles);
+      return;
+    }
+    if (mappedInput.wasReleased(MappedInputManager::Button::Right)) {
+      switchTab(currentTab == Tab::Titles ? Tab::Authors : Tab::Files);
       return;
     }
   } else {
@@ -315,9 +460,7 @@ void MyLibraryActivity::loop() {
 
     // Tab switching
     if (mappedInput.wasReleased(MappedInputManager::Button::Left)) {
-      currentTab = Tab::Recent;
-      selectorIndex = 0;
-      requestUpdate();
+      switchTab(Tab::Authors);
       return;
     }
   }
@@ -366,11 +509,20 @@ void MyLibraryActivity::render(RenderLock&&) {
   const auto pageWidth = renderer.getScreenWidth();
   const auto& metrics = UITheme::getInstance().getMetrics();
 
-  auto folderName = basepath == "/" ? tr(STR_SD_CARD) : basepath.substr(basepath.rfind('/') + 1).c_str();
-  GUI.drawHeader(renderer, Rect{0, metrics.topPadding, pageWidth, metrics.headerHeight}, folderName);
+  std::string headerTitle;
+  if (currentTab == Tab::Files) {
+    headerTitle = basepath == "/" ? tr(STR_SD_CARD) : basepath.substr(basepath.rfind('/') + 1);
+  } else if (!searchPrefix.empty()) {
+    headerTitle = "\"" + searchPrefix + "...\"";
+  } else {
+    headerTitle = tr(STR_SD_CARD);
+  }
+  GUI.drawHeader(renderer, Rect{0, metrics.topPadding, pageWidth, metrics.headerHeight}, headerTitle.c_str());
 
   std::vector<TabInfo> tabs = {
       {"Recent", currentTab == Tab::Recent},
+      {tr(STR_TITLES), currentTab == Tab::Titles},
+      {tr(STR_AUTHORS), currentTab == Tab::Authors},
       {"Files", currentTab == Tab::Files},
   };
   GUI.drawTabBar(renderer, Rect{0, metrics.topPadding + metrics.headerHeight, pageWidth, metrics.tabBarHeight}, tabs,
@@ -386,7 +538,9 @@ void MyLibraryActivity::render(RenderLock&&) {
     if (core::FeatureModules::hasCapability(core::Capability::VisualCoverPicker) && viewMode == ViewMode::Grid) {
       renderGrid();
     } else {
-      if (currentTab == Tab::Recent) {
+      if (isCatalogTab()) {
+        renderCatalogTab(contentTop, contentHeight);
+      } else if (currentTab == Tab::Recent) {
         renderRecentTab(contentTop, contentHeight);
       } else {
         renderFilesTab(contentTop, contentHeight);
@@ -432,6 +586,21 @@ void MyLibraryActivity::renderFilesTab(int contentTop, int contentHeight) const
       [this](int index) { return UITheme::getFileIcon(files[index]); });
 }
 
+void MyLibraryActivity::renderCatalogTab(int contentTop, int contentHeight) const {
+  const auto pageWidth = renderer.getScreenWidth();
+
+  GUI.drawList(
+      renderer, Rect{0, contentTop, pageWidth, contentHeight}, static_cast<int>(catalogCount), selectorIndex,
+      [this](int index) { return catalogBook(index).title; },
+      [this](int index) {
+        const auto& book = catalogBook(index);
+        if (book.progress == 0) return book.author;
+        const std::string percent = std::to_string(book.progress) + "%";
+        return book.author.empty() ? percent : book.author + " - " + percent;
+      },
+      [this](int index) { return UITheme::getFileIcon(catalogBook(index).path); });
+}
+
 MyLibraryActivity::GridMetrics MyLibraryActivity::getGridMetrics() const {
   const int pageWidth = renderer.getScreenWidth();
   auto metrics = UITheme::getInstance().getMetrics();
@@ -464,7 +633,11 @@ void MyLibraryActivity::renderGrid() const {
 
     std::string path;
     std::string title;
-    if (currentTab == Tab::Recent) {
+    if (isCatalogTab()) {
+      const auto& book = catalogBook(idx);
+      path = book.path;
+      title = book.title;
+    } else if (currentTab == Tab::Recent) {
       path = recentBooks[idx].path;
       title = recentBooks[idx].title;
     } else {
@@ -7,10 +7,12 @@
 #include "../Activity.h"
 #include "util/RecentBooksStore.h"
 #include "util/ButtonNavigator.h"
+#include "util/LibraryCatalog.h"
+#include "util/LibraryScanner.h"
 
 class MyLibraryActivity final : public Activity {
  public:
-  enum class Tab { Recent, Files };
+  enum class Tab { Recent, Titles, Authors, Files };
   enum class ViewMode { List, Grid };
 
  private:
@@ -31,14 +33,35 @@ class MyLibraryActivity final : public Activity {
   std::string basepath = "/";
   std::vector<std::string> files;
 
+  // Catalog state: the Titles and Authors tabs, and the Recent tab once the catalog has a reading history. Only the
+  // range of the current order (narrowed by the search prefix) is known up front; rows are read a page at a time.
+  LibraryScanner scanner;
+  bool catalogRecent = false;
+  std::string searchPrefix;
+  uint32_t catalogFirst = 0;
+  uint32_t catalogCount = 0;
+  uint32_t catalogGeneration = 0;
+  // Books around the last one drawn, refilled by catalogBook(). Shared with the render task, so loop() only touches
+  // the catalog state above and this cache under RenderLock.
+  mutable std::vector<LibraryCatalog::Book> catalogPage;
+  mutable uint32_t catalogPageStart = 0;
+
   // Data loading
   void loadRecentBooks();
   void loadFiles();
   size_t findEntry(const std::string& name) const;
+  bool isCatalogTab() const;
+  LibraryCatalog::Order catalogOrder() const;
+  void loadCatalogRange();
+  const LibraryCatalog::Book& catalogBook(int index) const;
+  std::string selectedCatalogPath();
+  void switchTab(Tab tab);
+  void openSearch();
 
   // Rendering
   void renderRecentTab(int contentTop, int contentHeight) const;
   void renderFilesTab(int contentTop, int contentHeight) const;
+  void renderCatalogTab(int contentTop, int contentHeight) const;
   void renderGrid() const;
   bool drawCoverAt(const std::string& path, int x, int y, int width, int height) const;
 
@@ -55,6 +78,7 @@ class MyLibraryActivity final : public Activity {
   GridMetrics getGridMetrics() const;
 
   int getCurrentItemCount() const {
+    if (isCatalogTab()) return static_cast<int>(catalogCount);
     return currentTab == Tab::Recent ? static_cast<int>(recentBooks.size()) : static_cast<int>(files.size());
   }
   int getPageItems() const;
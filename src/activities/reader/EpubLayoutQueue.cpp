@@ -0,0 +1,301 @@
+#include "EpubLayoutQueue.h"
+
+#include <Logging.h>
+
+#include "activities/TaskShutdown.h"
+
+namespace {
+// Below the render and input tasks: layout only runs while the reader is idle or the panel is refreshing.
+constexpr UBaseType_t LAYOUT_TASK_PRIORITY = tskIDLE_PRIORITY;
+constexpr int CANCEL_POLL_MS = 5;
+}  // namespace
+
+bool EpubLayoutQueue::start(const std::shared_ptr<Epub>& book) {
+  if (taskHandle != nullptr) {
+    return true;
+  }
+  epub = book;
+  pageMap = std::make_unique<PageMap>(epub->getCachePath());
+  paginateFrom = -1;
+  exitRequested.store(false);
+  taskHasExited.store(false);
+  if (xTaskCreate(&taskTrampoline, "EpubLayoutTask", TASK_STACK_SIZE, this, LAYOUT_TASK_PRIORITY, &taskHandle) !=
+      pdPASS) {
+    LOG_ERR("ELQ", "Failed to create layout task, chapters will be laid out in the foreground");
+    taskHandle = nullptr;
+    taskHasExited.store(true);
+    return false;
+  }
+  return true;
+}
+
+void EpubLayoutQueue::stop() {
+  if (taskHandle != nullptr) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      dropPendingLocked();
+      cancelRunning(lock);
+    }
+    exitRequested.store(true);
+    wake();
+    TaskShutdown::requestExit(exitRequested, taskHasExited, taskHandle);
+  }
+  if (pageMap && pageMap->isDirty()) {
+    pageMap->save();
+  }
+  pageMap.reset();
+  epub.reset();
+}
+
+void EpubLayoutQueue::taskTrampoline(void* param) {
+  auto* self = static_cast<EpubLayoutQueue*>(param);
+  self->taskLoop();
+}
+
+void EpubLayoutQueue::taskLoop() {
+  while (!exitRequested.load()) {
+    Job job;
+    if (!popJob(job)) {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      continue;
+    }
+
+    runJob(job);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!cancelRequested.load()) {
+      recordPageCountLocked(job.spineIndex, job.params, *job.section);
+    }
+    if (pageMap->isDirty()) {
+      pageMap->save();
+    }
+    running = Job();
+  }
+  taskHasExited.store(true);
+  vTaskDelete(nullptr);
+}
+
+bool EpubLayoutQueue::popJob(Job& out) {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (pendingCount > 0) {
+    out = std::move(pending[0]);
+    for (uint8_t i = 1; i < pendingCount; i++) {
+      pending[i - 1] = std::move(pending[i]);
+    }
+    pending[--pendingCount] = Job();
+  } else {
+    // Idle: continue the book-wide pass
+    const int spineIndex = paginateFrom >= 0 ? pageMap->nextUnknown(paginateFrom) : -1;
+    // acquire() wakes the task again once the foreground is done with the file
+    if (spineIndex < 0 || spineIndex == acquiringSpine) {
+      return false;
+    }
+    out = Job{nullptr, spineIndex, pageMap->getLayout(), true, true};
+    paginateFrom = spineIndex;
+  }
+
+  if (!out.section) {
+    out.section = std::make_shared<Section>(epub, out.spineIndex, renderer);
+    out.section->markBuildQueued();
+  }
+  cancelRequested.store(false);
+  running = out;
+  return true;
+}
+
+void EpubLayoutQueue::runJob(Job& job) {
+  const Params& p = job.params;
+  Section& section = *job.section;
+
+  if (job.prefetch && section.loadSectionFile(p.fontId, p.lineCompression, p.extraParagraphSpacing,
+                                              p.paragraphAlignment, p.viewportWidth, p.viewportHeight,
+                                              p.hyphenationEnabled, p.embeddedStyle, p.imageRendering)) {
+    return;
+  }
+
+  LOG_DBG("ELQ", "Laying out section %d%s", job.spineIndex,
+          job.paginate ? " (book pagination)" : (job.prefetch ? " (prefetch)" : ""));
+  const unsigned long start = millis();
+  if (section.createSectionFile(p.fontId, p.lineCompression, p.extraParagraphSpacing, p.paragraphAlignment,
+                                p.viewportWidth, p.viewportHeight, p.hyphenationEnabled, p.embeddedStyle,
+                                p.imageRendering, nullptr, &cancelRequested)) {
+    LOG_DBG("ELQ", "Section %d: %u pages in %lums", job.spineIndex, static_cast<unsigned>(section.pageCount.load()),
+            millis() - start);
+  } else if (!cancelRequested.load()) {
+    LOG_ERR("ELQ", "Failed to lay out section %d", job.spineIndex);
+  }
+}
+
+std::shared_ptr<Section> EpubLayoutQueue::acquire(const int spineIndex, const Params& params) {
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    dropPendingLocked();
+    if (running.spineIndex == spineIndex && running.params == params) {
+      return running.section;
+    }
+    cancelRunning(lock);
+    // Until the section is loaded or queued, the book-wide pass must not start on the same file: whichever side opened
+    // it second would see a half-written build.
+    acquiringSpine = spineIndex;
+  }
+
+  auto section = std::make_shared<Section>(epub, spineIndex, renderer);
+  if (section->loadSectionFile(params.fontId, params.lineCompression, params.extraParagraphSpacing,
+                               params.paragraphAlignment, params.viewportWidth, params.viewportHeight,
+                               params.hyphenationEnabled, params.embeddedStyle, params.imageRendering)) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      recordPageCountLocked(spineIndex, params, *section);
+      acquiringSpine = -1;
+    }
+    wake();
+    return section;
+  }
+
+  if (taskHandle == nullptr) {
+    // No layout task: build synchronously, as the reader did before the queue existed
+    section->createSectionFile(params.fontId, params.lineCompression, params.extraParagraphSpacing,
+                               params.paragraphAlignment, params.viewportWidth, params.viewportHeight,
+                               params.hyphenationEnabled, params.embeddedStyle, params.imageRendering);
+    std::lock_guard<std::mutex> lock(mutex);
+    recordPageCountLocked(spineIndex, params, *section);
+    acquiringSpine = -1;
+    return section;
+  }
+
+  section->markBuildQueued();
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    pending[0] = Job{section, spineIndex, params, false};
+    pendingCount = 1;
+    acquiringSpine = -1;
+  }
+  wake();
+  return section;
+}
+
+void EpubLayoutQueue::prefetch(const int spineIndex, const Params& params) {
+  if (taskHandle == nullptr || !epub || spineIndex < 0 || spineIndex >= epub->getSpineItemsCount()) {
+    return;
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (running.spineIndex >= 0 && running.params != params) {
+      cancelRunning(lock);
+    }
+    if (running.spineIndex == spineIndex) {
+      return;
+    }
+    for (uint8_t i = 0; i < pendingCount; i++) {
+      if (pending[i].spineIndex == spineIndex) {
+        pending[i].params = params;
+        return;
+      }
+    }
+    if (pendingCount >= MAX_PENDING) {
+      return;
+    }
+    pending[pendingCount++] = Job{nullptr, spineIndex, params, true};
+  }
+  wake();
+}
+
+void EpubLayoutQueue::cancelAll() {
+  std::unique_lock<std::mutex> lock(mutex);
+  dropPendingLocked();
+  cancelRunning(lock);
+}
+
+void EpubLayoutQueue::paginateBook(const Params& params, const int fromSpineIndex) {
+  if (!pageMap || !epub) {
+    return;
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (running.paginate && running.params != params) {
+      cancelRunning(lock);
+    }
+    if (pageMap->isOpen() && pageMap->getLayout() != params && pageMap->isDirty()) {
+      pageMap->save();
+    }
+    pageMap->open(params, epub->getSpineItemsCount());
+    if (pageMap->isComplete()) {
+      paginateFrom = -1;
+      return;
+    }
+    if (paginateFrom >= 0) {
+      return;
+    }
+    paginateFrom = fromSpineIndex;
+  }
+  LOG_DBG("ELQ", "Paginating book from section %d", fromSpineIndex);
+  wake();
+}
+
+bool EpubLayoutQueue::getBookPage(const int spineIndex, const int page, uint32_t& bookPage,
+                                  uint32_t& totalPages) const {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (!pageMap || !pageMap->isComplete() || pageMap->getTotalPages() == 0) {
+    return false;
+  }
+  bookPage = pageMap->getBookPage(spineIndex, page);
+  totalPages = pageMap->getTotalPages();
+  return true;
+}
+
+uint32_t EpubLayoutQueue::getBookPageCount() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return pageMap && pageMap->isComplete() ? pageMap->getTotalPages() : 0;
+}
+
+bool EpubLayoutQueue::locateBookPage(const uint32_t bookPage, int& spineIndex, int& page) const {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (!pageMap || !pageMap->isComplete() || pageMap->getTotalPages() == 0) {
+    return false;
+  }
+  pageMap->locate(bookPage, spineIndex, page);
+  return true;
+}
+
+void EpubLayoutQueue::recordPageCountLocked(const int spineIndex, const Params& params, const Section& section) {
+  if (!pageMap || !pageMap->isOpen() || pageMap->getLayout() != params || section.isBuilding()) {
+    return;
+  }
+  // A chapter that fails to lay out counts as empty, so the book-wide pass doesn't retry it forever
+  pageMap->setPageCount(spineIndex, section.buildFailed() ? 0 : section.pageCount.load());
+  if (pageMap->isComplete() && paginateFrom >= 0) {
+    LOG_INF("ELQ", "Book paginated: %lu pages", static_cast<unsigned long>(pageMap->getTotalPages()));
+    paginateFrom = -1;
+  }
+}
+
+void EpubLayoutQueue::dropPendingLocked() {
+  for (uint8_t i = 0; i < pendingCount; i++) {
+    if (pending[i].section) {
+      pending[i].section->markBuildDropped();
+    }
+    pending[i] = Job();
+  }
+  pendingCount = 0;
+}
+
+void EpubLayoutQueue::cancelRunning(std::unique_lock<std::mutex>& lock) {
+  if (running.spineIndex < 0) {
+    return;
+  }
+  LOG_DBG("ELQ", "Cancelling layout of section %d", running.spineIndex);
+  cancelRequested.store(true);
+  while (running.spineIndex >= 0) {
+    lock.unlock();
+    vTaskDelay(pdMS_TO_TICKS(CANCEL_POLL_MS));
+    lock.lock();
+  }
+}
+
+void EpubLayoutQueue::wake() {
+  if (taskHandle != nullptr) {
+    xTaskNotifyGive(taskHandle);
+  }
+}
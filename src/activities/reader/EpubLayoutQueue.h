@@ -0,0 +1,92 @@
+#pragma once
+
+#include <Epub.h>
+#include <Epub/PageMap.h>
+#include <Epub/Section.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+class GfxRenderer;
+
+// Lays out EPUB chapters on a low-priority FreeRTOS task.
+//
+// The reader asks for the chapter it needs with acquire(): the section comes back loaded from the cache, adopted from
+// the job already building it, or scheduled ahead of everything else. Pages become readable one by one while the
+// rest of the chapter keeps building (see Section::waitForPage). Neighbouring chapters are queued with prefetch()
+// and built whenever the reader is idle. Jobs laid out with different parameters than requested are cancelled, so a
+// settings change never waits for a stale build.
+//
+// With nothing else to do, the task paginates the rest of the book (see paginateBook): every spine item missing from
+// the book's PageMap is laid out in turn, so book-wide page numbers become available without a foreground pass.
+class EpubLayoutQueue {
+ public:
+  using Params = PageMap::Layout;
+
+  explicit EpubLayoutQueue(GfxRenderer& renderer) : renderer(renderer) {}
+  ~EpubLayoutQueue() { stop(); }
+  EpubLayoutQueue(const EpubLayoutQueue&) = delete;
+  EpubLayoutQueue& operator=(const EpubLayoutQueue&) = delete;
+
+  bool start(const std::shared_ptr<Epub>& epub);
+  // Cancels all work and waits for the task to exit.
+  void stop();
+
+  // Returns the section for spineIndex. Cancels any other running job and drops queued prefetches.
+  std::shared_ptr<Section> acquire(int spineIndex, const Params& params);
+  // Queues spineIndex for background layout unless it is cached, queued or already building.
+  void prefetch(int spineIndex, const Params& params);
+  // Cancels the running job and drops everything queued. Blocks until the task is idle.
+  void cancelAll();
+
+  // Switches the page map to params and lays out every spine item it doesn't know yet whenever the queue is idle,
+  // starting at fromSpineIndex. Spine items already cached with params are only opened to read their page count.
+  void paginateBook(const Params& params, int fromSpineIndex);
+  // Book-wide page index of `page` in spineIndex and the book's page count. False until the whole book is paginated.
+  bool getBookPage(int spineIndex, int page, uint32_t& bookPage, uint32_t& totalPages) const;
+  // Pages in the whole book, 0 until it is paginated.
+  uint32_t getBookPageCount() const;
+  // Spine item and page for a book-wide page index. False until the whole book is paginated.
+  bool locateBookPage(uint32_t bookPage, int& spineIndex, int& page) const;
+
+ private:
+  static constexpr uint8_t MAX_PENDING = 4;
+  static constexpr uint32_t TASK_STACK_SIZE = 8192;
+
+  struct Job {
+    std::shared_ptr<Section> section;  // null for prefetches; the task creates the section itself
+    int spineIndex = -1;
+    Params params;
+    bool prefetch = false;  // skip the build if the cache turns out to be valid
+    bool paginate = false;  // started by the book-wide pass rather than the reader
+  };
+
+  GfxRenderer& renderer;
+  std::shared_ptr<Epub> epub;
+
+  mutable std::mutex mutex;  // guards pending, pendingCount, running, pageMap, paginateFrom and acquiringSpine
+  Job pending[MAX_PENDING];
+  uint8_t pendingCount = 0;
+  Job running;
+  std::unique_ptr<PageMap> pageMap;
+  int paginateFrom = -1;    // -1 while the book-wide pass is off
+  int acquiringSpine = -1;  // spine item acquire() is loading in the foreground; the task starts no job on it
+
+  std::atomic<bool> cancelRequested{false};
+  std::atomic<bool> exitRequested{false};
+  std::atomic<bool> taskHasExited{true};
+  TaskHandle_t taskHandle = nullptr;
+
+  static void taskTrampoline(void* param);
+  void taskLoop();
+  void runJob(Job& job);
+  bool popJob(Job& out);
+  void dropPendingLocked();
+  void recordPageCountLocked(int spineIndex, const Params& params, const Section& section);
+  // Requires `mutex` held via `lock`; releases it while waiting for the running job to stop.
+  void cancelRunning(std::unique_lock<std::mutex>& lock);
+  void wake();
+};
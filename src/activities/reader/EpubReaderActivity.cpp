@@ -5,6 +5,7 @@
 #include <FontCacheManager.h>
 #include <FsHelpers.h>
 #include <GfxRenderer.h>
+#include <GlyphDisplayList.h>
 #include <HalStorage.h>
 #include <I18n.h>
 #include <Logging.h>
@@ -22,6 +23,7 @@
 #include "QrDisplayActivity.h"
 #include "ReaderUtils.h"
 #include "util/RecentBooksStore.h"
+#include "util/SectionCacheStore.h"
 #include "SpiBusMutex.h"
 #include "components/UITheme.h"
 #include "fontIds.h"
@@ -33,6 +35,8 @@ constexpr unsigned long skipChapterMs = 700;
 // pages per minute, first item is 1 to prevent division by zero if accessed
 const std::vector<int> PAGE_TURN_LABELS = {1, 1, 3, 6, 12};
 constexpr uint8_t maxPageLoadRetryCount = 1;
+// How long a page may take to come out of the layout task before the indexing popup is shown.
+constexpr uint32_t layoutPopupDelayMs = 300;
 
 int clampPercent(int percent) {
   if (percent < 0) {
@@ -70,6 +74,8 @@ void EpubReaderActivity::onEnter() {
   ReaderUtils::applyOrientation(renderer, SETTINGS.orientation);
 
   epub->setupCacheDir();
+  layoutQueue.start(epub);
+  pagePrefetcher.start();
 
   FsFile f;
   if (Storage.openFileForRead("ERS", epub->getCachePath() + "/progress.bin", f)) {
@@ -113,6 +119,11 @@ void EpubReaderActivity::onExit() {
 
   APP_STATE.readerActivityLoadCount = 0;
   APP_STATE.saveToFile();
+  pagePrefetcher.stop();
+  layoutQueue.stop();
+  releaseSectionProfile();
+  renderer.getFontCacheManager()->releasePinnedGroups();
+  pinnedGroupsSection.reset();
   section.reset();
   epub.reset();
 }
@@ -152,14 +163,11 @@ void EpubReaderActivity::loop() {
 
   // Enter reader menu activity.
   if (mappedInput.wasReleased(MappedInputManager::Button::Confirm)) {
+    // Whatever the menu does next (settings, jumps), the prefetched page is unlikely to be wanted
+    pagePrefetcher.discard();
     const int currentPage = section ? section->currentPage + 1 : 0;
-    const int totalPages = section ? section->pageCount : 0;
-    float bookProgress = 0.0f;
-    if (epub->getBookSize() > 0 && section && section->pageCount > 0) {
-      const float chapterProgress = static_cast<float>(section->currentPage) / static_cast<float>(section->pageCount);
-      bookProgress = epub->calculateProgress(currentSpineIndex, chapterProgress) * 100.0f;
-    }
-    const int bookProgressPercent = clampPercent(static_cast<int>(bookProgress + 0.5f));
+    const int totalPages = section ? section->pageCount.load() : 0;
+    const int bookProgressPercent = clampPercent(static_cast<int>(bookProgress() + 0.5f));
     startActivityForResult(std::make_unique<EpubReaderMenuActivity>(
                                renderer, mappedInput, epub->getTitle(), currentPage, totalPages, bookProgressPercent,
                                SETTINGS.orientation, !currentPageFootnotes.empty()),
@@ -222,12 +230,6 @@ void EpubReaderActivity::loop() {
     return;
   }
 
-  // No current section, attempt to rerender the book
-  if (!section) {
-    requestUpdate();
-    return;
-  }
-
   if (prevTriggered) {
     pageTurn(false);
   } else {
@@ -250,6 +252,20 @@ void EpubReaderActivity::jumpToPercent(int percent) {
   // Normalize input to 0-100 to avoid invalid jumps.
   percent = clampPercent(percent);
 
+  // With the book paginated the percent maps straight to a page
+  const uint32_t bookPages = layoutQueue.getBookPageCount();
+  int targetSpine = 0;
+  int targetPage = 0;
+  const auto targetBookPage = static_cast<uint32_t>(static_cast<uint64_t>(bookPages) * percent / 100);
+  if (bookPages > 0 && layoutQueue.locateBookPage(targetBookPage, targetSpine, targetPage)) {
+    RenderLock lock(*this);
+    currentSpineIndex = targetSpine;
+    nextPageNumber = targetPage;
+    pendingPercentJump = false;
+    section.reset();
+    return;
+  }
+
   // Convert percent into a byte-like absolute position across the spine sizes.
   // Use an overflow-safe computation: (bookSize / 100) * percent + (bookSize % 100) * percent / 100
   size_t targetSize =
@@ -303,7 +319,7 @@ void EpubReaderActivity::onReaderMenuConfirm(EpubReaderMenuActivity::MenuAction
     case EpubReaderMenuActivity::MenuAction::SELECT_CHAPTER: {
       const int spineIdx = currentSpineIndex;
       const int currentPage = section ? section->currentPage : 0;
-      const int totalPages = section ? section->pageCount : 0;
+      const int totalPages = section ? section->pageCount.load() : 0;
       const std::string path = epub->getPath();
       startActivityForResult(
           std::make_unique<EpubReaderChapterSelectionActivity>(renderer, mappedInput, epub, path, spineIdx, currentPage,
@@ -330,14 +346,10 @@ void EpubReaderActivity::onReaderMenuConfirm(EpubReaderMenuActivity::MenuAction
       break;
     }
     case EpubReaderMenuActivity::MenuAction::GO_TO_PERCENT: {
-      float bookProgress = 0.0f;
-      if (epub && epub->getBookSize() > 0 && section && section->pageCount > 0) {
-        const float chapterProgress = static_cast<float>(section->currentPage) / static_cast<float>(section->pageCount);
-        bookProgress = epub->calculateProgress(currentSpineIndex, chapterProgress) * 100.0f;
-      }
-      const int initialPercent = clampPercent(static_cast<int>(bookProgress + 0.5f));
+      const int initialPercent = clampPercent(static_cast<int>(bookProgress() + 0.5f));
       startActivityForResult(
-          std::make_unique<EpubReaderPercentSelectionActivity>(renderer, mappedInput, initialPercent),
+          std::make_unique<EpubReaderPercentSelectionActivity>(renderer, mappedInput, initialPercent,
+                                                               layoutQueue.getBookPageCount()),
           [this](const ActivityResult& result) {
             if (!result.isCancelled) {
               jumpToPercent(std::get<PercentResult>(result.data).percent);
@@ -354,10 +366,10 @@ void EpubReaderActivity::onReaderMenuConfirm(EpubReaderMenuActivity::MenuAction
             if (el->getTag() == TAG_PageLine) {
               const auto& line = static_cast<const PageLine&>(*el);
               if (line.getBlock()) {
-                const auto& words = line.getBlock()->getWords();
-                for (const auto& w : words) {
+                const auto& block = *line.getBlock();
+                for (size_t i = 0; i < block.wordCount(); i++) {
                   if (!fullText.empty()) fullText += " ";
-                  fullText += w;
+                  fullText += block.getWord(i);
                 }
               }
             }
@@ -383,9 +395,10 @@ void EpubReaderActivity::onReaderMenuConfirm(EpubReaderMenuActivity::MenuAction
             if (el->getTag() == TAG_PageLine) {
               const auto& line = static_cast<const PageLine&>(*el);
               if (line.getBlock()) {
-                for (const auto& w : line.getBlock()->getWords()) {
+                const auto& block = *line.getBlock();
+                for (size_t i = 0; i < block.wordCount(); i++) {
                   if (!firstWords.empty()) firstWords += " ";
-                  firstWords += w;
+                  firstWords += block.getWord(i);
                   if (++wordCount >= 10) break;
                 }
               }
@@ -415,6 +428,7 @@ void EpubReaderActivity::onReaderMenuConfirm(EpubReaderMenuActivity::MenuAction
           uint16_t backupSpine = currentSpineIndex;
           uint16_t backupPage = section->currentPage;
           uint16_t backupPageCount = section->pageCount;
+          layoutQueue.cancelAll();
           section.reset();
           epub->clearCache();
           epub->setupCacheDir();
@@ -435,7 +449,7 @@ void EpubReaderActivity::onReaderMenuConfirm(EpubReaderMenuActivity::MenuAction
     case EpubReaderMenuActivity::MenuAction::SYNC: {
       if (KOREADER_STORE.hasCredentials()) {
         const int currentPage = section ? section->currentPage : 0;
-        const int totalPages = section ? section->pageCount : 0;
+        const int totalPages = section ? section->pageCount.load() : 0;
         startActivityForResult(
             std::make_unique<KOReaderSyncActivity>(renderer, mappedInput, epub, epub->getPath(), currentSpineIndex,
                                                    currentPage, totalPages),
@@ -467,7 +481,8 @@ void EpubReaderActivity::applyOrientation(const uint8_t orientation) {
     RenderLock lock(*this);
     if (section) {
       cachedSpineIndex = currentSpineIndex;
-      cachedChapterTotalPageCount = section->pageCount;
+      // A chapter still being laid out has no final page count to scale the position from
+      cachedChapterTotalPageCount = section->isBuilding() ? 0 : section->pageCount.load();
       nextPageNumber = section->currentPage;
     }
 
@@ -503,7 +518,8 @@ void EpubReaderActivity::toggleAutoPageTurn(const uint8_t selectedPageTurnOption
     RenderLock lock(*this);
     if (section) {
       cachedSpineIndex = currentSpineIndex;
-      cachedChapterTotalPageCount = section->pageCount;
+      // A chapter still being laid out has no final page count to scale the position from
+      cachedChapterTotalPageCount = section->isBuilding() ? 0 : section->pageCount.load();
       nextPageNumber = section->currentPage;
     }
     section.reset();
@@ -511,29 +527,34 @@ void EpubReaderActivity::toggleAutoPageTurn(const uint8_t selectedPageTurnOption
 }
 
 void EpubReaderActivity::pageTurn(bool isForwardTurn) {
-  if (isForwardTurn) {
-    if (section->currentPage < section->pageCount - 1) {
-      section->currentPage++;
-    } else {
-      // We don't want to delete the section mid-render, so grab the semaphore
-      {
-        RenderLock lock(*this);
+  if (!isForwardTurn) {
+    pagePrefetcher.discard();
+  }
+  {
+    // render() loads the section and sets its current page on the render task, and must not have the section
+    // deleted mid-render, so grab the semaphore
+    RenderLock lock(*this);
+    if (!section) {
+      // No current section, attempt to rerender the book
+      lock.unlock();
+      requestUpdate();
+      return;
+    }
+    if (isForwardTurn) {
+      if (section->currentPage < section->pageCount - 1 || section->isBuilding()) {
+        // Past the last laid-out page of a chapter still building: render() waits for the page or moves on
+        section->currentPage++;
+      } else {
         nextPageNumber = 0;
         currentSpineIndex++;
         section.reset();
       }
-    }
-  } else {
-    if (section->currentPage > 0) {
+    } else if (section->currentPage > 0) {
       section->currentPage--;
     } else if (currentSpineIndex > 0) {
-      // We don't want to delete the section mid-render, so grab the semaphore
-      {
-        RenderLock lock(*this);
-        nextPageNumber = UINT16_MAX;
-        currentSpineIndex--;
-        section.reset();
-      }
+      nextPageNumber = UINT16_MAX;
+      currentSpineIndex--;
+      section.reset();
     }
   }
   lastPageTurnTime = millis();
@@ -598,32 +619,23 @@ void EpubReaderActivity::render(RenderLock&& lock) {
   const uint16_t viewportWidth = renderer.getScreenWidth() - orientedMarginLeft - orientedMarginRight;
   const uint16_t viewportHeight = renderer.getScreenHeight() - orientedMarginTop - orientedMarginBottom;
 
+  const auto params = layoutParams(viewportWidth, viewportHeight);
+
   if (!section) {
     const auto filepath = epub->getSpineItem(currentSpineIndex).href;
     LOG_DBG("ERS", "Loading file: %s, index: %d", filepath.c_str(), currentSpineIndex);
-    section = std::unique_ptr<Section>(new Section(epub, currentSpineIndex, renderer));
-
-
-    if (!section->loadSectionFile(SETTINGS.getReaderFontId(), SETTINGS.getReaderLineCompression(),
-                                  SETTINGS.extraParagraphSpacing, SETTINGS.paragraphAlignment, viewportWidth,
-                                  viewportHeight, SETTINGS.hyphenationEnabled, SETTINGS.embeddedStyle,
-                                  SETTINGS.imageRendering)) {
-      LOG_DBG("ERS", "Cache not found, building...");
-
-      const auto popupFn = [this]() { GUI.drawPopup(renderer, tr(STR_INDEXING)); };
-
-      if (!section->createSectionFile(SETTINGS.getReaderFontId(), SETTINGS.getReaderLineCompression(),
-                                      SETTINGS.extraParagraphSpacing, SETTINGS.paragraphAlignment, viewportWidth,
-                                      viewportHeight, SETTINGS.hyphenationEnabled, SETTINGS.embeddedStyle,
-                                      SETTINGS.imageRendering, popupFn)) {
-        LOG_ERR("ERS", "Failed to persist page data to SD");
-        section.reset();
-        resetPageLoadRetryState();
-        renderReaderError(StrId::STR_LOAD_EPUB_FAILED);
-        return;
-      }
-    } else {
-      LOG_DBG("ERS", "Cache found, skipping build...");
+    section = layoutQueue.acquire(currentSpineIndex, params);
+
+    // Positions derived from the page count (last page, anchors, progress remaps) need the whole chapter; a plain
+    // page number only needs that page.
+    const bool needsWholeChapter = nextPageNumber == UINT16_MAX || !pendingAnchor.empty() ||
+                                   cachedChapterTotalPageCount > 0 || pendingPercentJump;
+    if (!waitForLayout(needsWholeChapter ? UINT16_MAX : static_cast<uint16_t>(nextPageNumber))) {
+      LOG_ERR("ERS", "Failed to persist page data to SD");
+      section.reset();
+      resetPageLoadRetryState();
+      renderReaderError(StrId::STR_LOAD_EPUB_FAILED);
+      return;
     }
 
     if (nextPageNumber == UINT16_MAX) {
@@ -662,6 +674,26 @@ void EpubReaderActivity::render(RenderLock&& lock) {
       section->currentPage = newPage;
       pendingPercentJump = false;
     }
+
+    prefetchNeighbourChapters(params);
+  }
+
+  if (section->currentPage >= section->pageCount && section->isBuilding()) {
+    if (!waitForLayout(static_cast<uint16_t>(section->currentPage))) {
+      LOG_ERR("ERS", "Failed to persist page data to SD");
+      section.reset();
+      resetPageLoadRetryState();
+      renderReaderError(StrId::STR_LOAD_EPUB_FAILED);
+      return;
+    }
+    if (section->currentPage == section->pageCount && section->pageCount > 0) {
+      // Turned past the end while the tail of the chapter was still being laid out
+      currentSpineIndex++;
+      nextPageNumber = 0;
+      section.reset();
+      requestUpdate();
+      return;
+    }
   }
 
   renderer.clearScreen();
@@ -676,7 +708,7 @@ void EpubReaderActivity::render(RenderLock&& lock) {
   }
 
   if (section->currentPage < 0 || section->currentPage >= section->pageCount) {
-    LOG_DBG("ERS", "Page out of bounds: %d (max %d)", section->currentPage, section->pageCount);
+    LOG_DBG("ERS", "Page out of bounds: %d (max %d)", section->currentPage, section->pageCount.load());
     renderer.drawCenteredText(UI_12_FONT_ID, 300, tr(STR_OUT_OF_BOUNDS), true, EpdFontFamily::BOLD);
     renderStatusBar();
     renderer.displayBuffer();
@@ -685,8 +717,9 @@ void EpubReaderActivity::render(RenderLock&& lock) {
   }
 
   {
-    std::unique_ptr<Page> p;
-    {
+    std::unique_ptr<Page> p = pagePrefetcher.take(section.get(), section->currentPage);
+    renderer.getFontCacheManager()->recordPagePrefetch(p != nullptr);
+    if (!p) {
       SpiBusMutex::Guard guard;
       p = section->loadPageFromSectionFile();
     }
@@ -696,6 +729,8 @@ void EpubReaderActivity::render(RenderLock&& lock) {
         pageLoadRetryCount = 0;
       }
 
+      // The layout task may still be writing this section's file; stop it before the file is deleted
+      layoutQueue.cancelAll();
       if (pageLoadRetryCount < maxPageLoadRetryCount) {
         pageLoadRetryCount++;
         LOG_ERR("ERS", "Failed to load page from SD - clearing section cache and retrying (%u/%u)",
@@ -720,12 +755,18 @@ void EpubReaderActivity::render(RenderLock&& lock) {
     // Collect footnotes from the loaded page
     currentPageFootnotes = std::move(p->footnotes);
 
+    // The histogram is only final once the chapter is laid out; until then pages render as before
+    if (!section->isBuilding() && pinnedGroupsSection.lock() != section) {
+      renderer.getFontCacheManager()->setPinnedGroups(SETTINGS.getReaderFontId(), section->getHotGlyphGroups());
+      pinnedGroupsSection = section;
+    }
+
     const auto start = millis();
     renderContents(std::move(p), orientedMarginTop, orientedMarginRight, orientedMarginBottom, orientedMarginLeft);
     LOG_DBG("ERS", "Rendered page in %dms", millis() - start);
   }
-  silentIndexNextChapterIfNeeded(viewportWidth, viewportHeight);
-  saveProgress(currentSpineIndex, section->currentPage, section->pageCount);
+  // Only a final page count is useful for rescaling the position after a settings change
+  saveProgress(currentSpineIndex, section->currentPage, section->isBuilding() ? 0 : section->pageCount.load());
 
   if (pendingScreenshot) {
     pendingScreenshot = false;
@@ -733,35 +774,63 @@ void EpubReaderActivity::render(RenderLock&& lock) {
   }
 }
 
-void EpubReaderActivity::silentIndexNextChapterIfNeeded(const uint16_t viewportWidth, const uint16_t viewportHeight) {
-  if (!epub || !section || section->pageCount < 2) {
-    return;
-  }
+EpubLayoutQueue::Params EpubReaderActivity::layoutParams(const uint16_t viewportWidth,
+                                                         const uint16_t viewportHeight) const {
+  EpubLayoutQueue::Params params;
+  params.fontId = SETTINGS.getReaderFontId();
+  params.lineCompression = SETTINGS.getReaderLineCompression();
+  params.extraParagraphSpacing = SETTINGS.extraParagraphSpacing;
+  params.paragraphAlignment = SETTINGS.paragraphAlignment;
+  params.viewportWidth = viewportWidth;
+  params.viewportHeight = viewportHeight;
+  params.hyphenationEnabled = SETTINGS.hyphenationEnabled;
+  params.embeddedStyle = SETTINGS.embeddedStyle;
+  params.imageRendering = SETTINGS.imageRendering;
+  return params;
+}
 
-  // Build the next chapter cache while the penultimate page is on screen.
-  if (section->currentPage != section->pageCount - 2) {
-    return;
+bool EpubReaderActivity::waitForLayout(const uint16_t pageIndex) {
+  if (!section->waitForPage(pageIndex, layoutPopupDelayMs)) {
+    GUI.drawPopup(renderer, tr(STR_INDEXING));
+    section->waitForPage(pageIndex, UINT32_MAX);
   }
+  return !section->buildFailed();
+}
+
+void EpubReaderActivity::prefetchNeighbourChapters(const EpubLayoutQueue::Params& params) {
+  // Reading forward is the common case; the previous chapter is queued too so turning back lands on its last page
+  // without a full layout in the foreground.
+  layoutQueue.prefetch(currentSpineIndex + 1, params);
+  layoutQueue.prefetch(currentSpineIndex - 1, params);
+  // Everything else, for book-wide page numbers; chapters ahead of the reader first
+  layoutQueue.paginateBook(params, currentSpineIndex + 1);
+  useSectionProfile(params);
+}
 
-  const int nextSpineIndex = currentSpineIndex + 1;
-  if (nextSpineIndex < 0 || nextSpineIndex >= epub->getSpineItemsCount()) {
+void EpubReaderActivity::useSectionProfile(const EpubLayoutQueue::Params& params) {
+  const std::string profileDir = params.profileDir(epub->getCachePath());
+  if (profileDir == sectionProfileDir) {
     return;
   }
+  // The new profile is marked in use first, so the eviction run by releasing the previous one keeps it. The previous
+  // profile's jobs were cancelled when the queue got the new parameters, so its size is final.
+  SECTION_CACHE.touch(profileDir);
+  releaseSectionProfile();
+  sectionProfileDir = profileDir;
+}
 
-  Section nextSection(epub, nextSpineIndex, renderer);
-  if (nextSection.loadSectionFile(SETTINGS.getReaderFontId(), SETTINGS.getReaderLineCompression(),
-                                  SETTINGS.extraParagraphSpacing, SETTINGS.paragraphAlignment, viewportWidth,
-                                  viewportHeight, SETTINGS.hyphenationEnabled, SETTINGS.embeddedStyle,
-                                  SETTINGS.imageRendering)) {
-    return;
+void EpubReaderActivity::releaseSectionProfile() {
+  if (!sectionProfileDir.empty()) {
+    SECTION_CACHE.release(sectionProfileDir);
+    sectionProfileDir.clear();
   }
+}
 
-  LOG_DBG("ERS", "Silently indexing next chapter: %d", nextSpineIndex);
-  if (!nextSection.createSectionFile(SETTINGS.getReaderFontId(), SETTINGS.getReaderLineCompression(),
-                                     SETTINGS.extraParagraphSpacing, SETTINGS.paragraphAlignment, viewportWidth,
-                                     viewportHeight, SETTINGS.hyphenationEnabled, SETTINGS.embeddedStyle,
-                                     SETTINGS.imageRendering)) {
-    LOG_ERR("ERS", "Failed silent indexing for chapter: %d", nextSpineIndex);
+void EpubReaderActivity::prefetchNextPage() {
+  // Only pages already laid out; the next chapter's first page is the layout queue's business
+  const int next = section->currentPage + 1;
+  if (next < section->pageCount.load()) {
+    pagePrefetcher.request(section, static_cast<uint16_t>(next));
   }
 }
 
@@ -790,27 +859,40 @@ void EpubReaderActivity::renderContents(std::unique_ptr<Page> page, const int or
   const auto t0 = millis();
   auto* fcm = renderer.getFontCacheManager();
   fcm->resetStats();
+  const int fontId = SETTINGS.getReaderFontId();
 
-  // Font prewarm: scan pass accumulates text, then prewarm, then real render
+  // Lay out the page text once (UTF-8 decode, ligatures, kerning, glyph lookup); the prewarm, BW and both
+  // grayscale passes below replay the same display list instead of re-walking every TextBlock.
+  GlyphDisplayList displayList;
+  page->buildDisplayList(renderer, fontId, orientedMarginLeft, orientedMarginTop, displayList);
+  const auto tLayout = millis();
+  const auto drawPage = [&]() {
+    renderer.drawDisplayList(displayList);
+    page->renderImages(renderer, fontId, orientedMarginLeft, orientedMarginTop);
+  };
+
+  // Font prewarm straight from the display list's glyphs, no scan pass
   const uint32_t heapBefore = esp_get_free_heap_size();
   auto scope = fcm->createPrewarmScope();
-  page->render(renderer, SETTINGS.getReaderFontId(), orientedMarginLeft, orientedMarginTop);  // scan pass
-  scope.endScanAndPrewarm();
+  scope.endScanAndPrewarm(displayList);
   const uint32_t heapAfter = esp_get_free_heap_size();
   fcm->logStats("prewarm");
   const auto tPrewarm = millis();
 
-  LOG_DBG("ERS", "Heap: before=%lu after=%lu delta=%ld", heapBefore, heapAfter,
-          (int32_t)heapAfter - (int32_t)heapBefore);
+  LOG_DBG("ERS", "Heap: before=%lu after=%lu delta=%ld glyphs=%u", heapBefore, heapAfter,
+          (int32_t)heapAfter - (int32_t)heapBefore, static_cast<unsigned>(displayList.glyphs().size()));
 
   // Force special handling for pages with images when anti-aliasing is on
   bool imagePageWithAA = page->hasImages() && SETTINGS.textAntiAliasing;
 
-  page->render(renderer, SETTINGS.getReaderFontId(), orientedMarginLeft, orientedMarginTop);
+  drawPage();
   renderStatusBar();
   fcm->logStats("bw_render");
   const auto tBwRender = millis();
 
+  // The page is fully laid out; read the next one from SD while the panel refreshes
+  prefetchNextPage();
+
   if (imagePageWithAA) {
     // Double FAST_REFRESH with selective image blanking (pablohc's technique):
     // HALF_REFRESH sets particles too firmly for the grayscale LUT to adjust.
@@ -824,7 +906,7 @@ void EpubReaderActivity::renderContents(std::unique_ptr<Page> page, const int or
 
       // Re-render page content to restore images into the blanked area
       // Status bar is not re-rendered here to avoid reading stale dynamic values (e.g. battery %)
-      page->render(renderer, SETTINGS.getReaderFontId(), orientedMarginLeft, orientedMarginTop);
+      drawPage();
       renderer.displayBuffer(HalDisplay::FAST_REFRESH);
     } else {
       renderer.displayBuffer(HalDisplay::HALF_REFRESH);
@@ -843,18 +925,17 @@ void EpubReaderActivity::renderContents(std::unique_ptr<Page> page, const int or
   // Skipped in dark mode: the EPD grayscale LUT assumes a normal-polarity starting state;
   // after a dark-mode BW refresh the pixel polarity is inverted, which confuses the waveform
   // and produces ghosting artefacts.
-  const int fontId = SETTINGS.getReaderFontId();
   if (SETTINGS.textAntiAliasing && !renderer.isDarkMode() && renderer.fontSupportsGrayscale(fontId)) {
     renderer.clearScreen(0x00);
     renderer.setRenderMode(GfxRenderer::GRAYSCALE_LSB);
-    page->render(renderer, fontId, orientedMarginLeft, orientedMarginTop);
+    drawPage();
     renderer.copyGrayscaleLsbBuffers();
     const auto tGrayLsb = millis();
 
     // Render and copy to MSB buffer
     renderer.clearScreen(0x00);
     renderer.setRenderMode(GfxRenderer::GRAYSCALE_MSB);
-    page->render(renderer, fontId, orientedMarginLeft, orientedMarginTop);
+    drawPage();
     renderer.copyGrayscaleMsbBuffers();
     const auto tGrayMsb = millis();
 
@@ -870,10 +951,10 @@ void EpubReaderActivity::renderContents(std::unique_ptr<Page> page, const int or
 
     const auto tEnd = millis();
     LOG_DBG("ERS",
-            "Page render: prewarm=%lums bw_render=%lums display=%lums bw_store=%lums "
+            "Page render: layout=%lums prewarm=%lums bw_render=%lums display=%lums bw_store=%lums "
             "gray_lsb=%lums gray_msb=%lums gray_display=%lums bw_restore=%lums total=%lums",
-            tPrewarm - t0, tBwRender - tPrewarm, tDisplay - tBwRender, tBwStore - tDisplay, tGrayLsb - tBwStore,
-            tGrayMsb - tGrayLsb, tGrayDisplay - tGrayMsb, tBwRestore - tGrayDisplay, tEnd - t0);
+            tLayout - t0, tPrewarm - tLayout, tBwRender - tPrewarm, tDisplay - tBwRender, tBwStore - tDisplay,
+            tGrayLsb - tBwStore, tGrayMsb - tGrayLsb, tGrayDisplay - tGrayMsb, tBwRestore - tGrayDisplay, tEnd - t0);
   } else {
     // restore the bw data
     renderer.restoreBwBuffer();
@@ -881,20 +962,45 @@ void EpubReaderActivity::renderContents(std::unique_ptr<Page> page, const int or
 
     const auto tEnd = millis();
     LOG_DBG("ERS",
-            "Page render: prewarm=%lums bw_render=%lums display=%lums bw_store=%lums bw_restore=%lums total=%lums",
-            tPrewarm - t0, tBwRender - tPrewarm, tDisplay - tBwRender, tBwStore - tDisplay, tBwRestore - tBwStore,
-            tEnd - t0);
+            "Page render: layout=%lums prewarm=%lums bw_render=%lums display=%lums bw_store=%lums bw_restore=%lums "
+            "total=%lums",
+            tLayout - t0, tPrewarm - tLayout, tBwRender - tPrewarm, tDisplay - tBwRender, tBwStore - tDisplay,
+            tBwRestore - tBwStore, tEnd - t0);
+  }
+}
+
+float EpubReaderActivity::bookProgress() const {
+  if (!epub || !section) {
+    return 0.0f;
+  }
+
+  // Exact once the whole book is paginated with the current settings
+  uint32_t bookPage = 0;
+  uint32_t bookPages = 0;
+  if (layoutQueue.getBookPage(currentSpineIndex, section->currentPage, bookPage, bookPages)) {
+    return static_cast<float>(bookPage) * 100.0f / static_cast<float>(bookPages);
+  }
+
+  // Until then, proportional to the chapters' sizes in bytes
+  if (epub->getBookSize() == 0 || section->pageCount == 0) {
+    return 0.0f;
   }
+  const float chapterProgress = static_cast<float>(section->currentPage) / static_cast<float>(section->pageCount);
+  return epub->calculateProgress(currentSpineIndex, chapterProgress) * 100.0f;
 }
 
 void EpubReaderActivity::renderStatusBar() const {
-  // Calculate progress in book
-  const float sectionChapterProg =
-      (section->pageCount > 0) ? static_cast<float>(section->currentPage) / section->pageCount : 0.0f;
-  const float bookProgress = epub->calculateProgress(currentSpineIndex, sectionChapterProg) * 100;
+  const float bookProgress = this->bookProgress();
 
   const int currentPage = section ? section->currentPage + 1 : 0;
-  const int pageCount = section ? section->pageCount : 0;
+  const int pageCount = section ? section->pageCount.load() : 0;
+
+  // Book-wide pages once the whole book is paginated with the current settings
+  uint32_t bookPage = 0;
+  uint32_t bookPageCount = 0;
+  if (section && layoutQueue.getBookPage(currentSpineIndex, section->currentPage, bookPage, bookPageCount)) {
+    bookPage++;
+  }
 
   std::string title;
 
@@ -923,7 +1029,7 @@ void EpubReaderActivity::renderStatusBar() const {
     title = epub->getTitle();
   }
 
-  GUI.drawStatusBar(renderer, bookProgress, currentPage, pageCount, title, 0, textYOffset);
+  GUI.drawStatusBar(renderer, bookProgress, currentPage, pageCount, title, 0, textYOffset, bookPage, bookPageCount);
 }
 
 void EpubReaderActivity::navigateToHref(const std::string& hrefStr, const bool savePosition) {
@@ -4,12 +4,20 @@
 #include <Epub/FootnoteEntry.h>
 #include <Epub/Section.h>
 
+#include "EpubLayoutQueue.h"
 #include "EpubReaderMenuActivity.h"
+#include "PagePrefetcher.h"
 #include "activities/Activity.h"
 
 class EpubReaderActivity final : public Activity {
   std::shared_ptr<Epub> epub;
-  std::unique_ptr<Section> section = nullptr;
+  EpubLayoutQueue layoutQueue;
+  // Shared with layoutQueue while the chapter is still being laid out in the background.
+  std::shared_ptr<Section> section = nullptr;
+  // Loads the next page while the panel refreshes the current one.
+  PagePrefetcher pagePrefetcher;
+  // Section whose glyph histogram the font decompressor is pinning groups for.
+  std::weak_ptr<Section> pinnedGroupsSection;
   int currentSpineIndex = 0;
   int nextPageNumber = 0;
   // Set when navigating to a footnote href with a fragment (e.g. #note1).
@@ -27,6 +35,8 @@ class EpubReaderActivity final : public Activity {
   bool automaticPageTurnActive = false;
   int pageLoadRetrySpineIndex = -1;
   uint8_t pageLoadRetryCount = 0;
+  // Section directory of the layout profile in use, for SectionCacheStore
+  std::string sectionProfileDir;
 
   std::vector<FootnoteEntry> currentPageFootnotes;
   struct SavedPosition {
@@ -40,7 +50,14 @@ class EpubReaderActivity final : public Activity {
   void renderContents(std::unique_ptr<Page> page, int orientedMarginTop, int orientedMarginRight,
                       int orientedMarginBottom, int orientedMarginLeft);
   void renderStatusBar() const;
-  void silentIndexNextChapterIfNeeded(uint16_t viewportWidth, uint16_t viewportHeight);
+  // Percent read: by book-wide page once the book is paginated, by chapter byte sizes until then
+  float bookProgress() const;
+  EpubLayoutQueue::Params layoutParams(uint16_t viewportWidth, uint16_t viewportHeight) const;
+  bool waitForLayout(uint16_t pageIndex);
+  void prefetchNeighbourChapters(const EpubLayoutQueue::Params& params);
+  void useSectionProfile(const EpubLayoutQueue::Params& params);
+  void releaseSectionProfile();
+  void prefetchNextPage();
   void saveProgress(int spineIndex, int currentPage, int pageCount);
   void jumpToPercent(int percent);
   void onReaderMenuConfirm(EpubReaderMenuActivity::MenuAction action);
@@ -54,7 +71,7 @@ class EpubReaderActivity final : public Activity {
 
  public:
   explicit EpubReaderActivity(GfxRenderer& renderer, MappedInputManager& mappedInput, std::unique_ptr<Epub> epub)
-      : Activity("EpubReader", renderer, mappedInput), epub(std::move(epub)) {}
+      : Activity("EpubReader", renderer, mappedInput), epub(std::move(epub)), layoutQueue(renderer) {}
 
   void onEnter() override;
   void onExit() override;
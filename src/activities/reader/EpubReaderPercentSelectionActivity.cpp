@@ -1,6 +1,10 @@
 #include "EpubReaderPercentSelectionActivity.h"
 
 #include <GfxRenderer.h>
+#include <I18n.h>
+
+#include <algorithm>
+#include <cstdio>
 
 #include "MappedInputManager.h"
 #include "components/UITheme.h"
@@ -62,6 +66,16 @@ void EpubReaderPercentSelectionActivity::render(RenderLock&&) {
   const std::string percentText = std::to_string(percent) + "%";
   renderer.drawCenteredText(UI_12_FONT_ID, 90, percentText.c_str(), true, EpdFontFamily::BOLD);
 
+  // Target page, same rounding as the jump itself.
+  if (bookPageCount > 0) {
+    const uint32_t targetPage =
+        std::min(static_cast<uint32_t>(static_cast<uint64_t>(bookPageCount) * percent / 100), bookPageCount - 1);
+    char pageText[48];
+    snprintf(pageText, sizeof(pageText), tr(STR_BOOK_PAGE_FORMAT), static_cast<unsigned>(targetPage + 1),
+             static_cast<unsigned>(bookPageCount));
+    renderer.drawCenteredText(SMALL_FONT_ID, 115, pageText, true);
+  }
+
   // Draw slider track.
   const int screenWidth = renderer.getScreenWidth();
   constexpr int barWidth = 360;
@@ -6,10 +6,12 @@
 
 class EpubReaderPercentSelectionActivity final : public Activity {
  public:
-  // Slider-style percent selector for jumping within a book.
+  // Slider-style percent selector for jumping within a book. bookPageCount, when known, shows the target page.
   explicit EpubReaderPercentSelectionActivity(GfxRenderer& renderer, MappedInputManager& mappedInput,
-                                              const int initialPercent)
-      : Activity("EpubReaderPercentSelection", renderer, mappedInput), percent(initialPercent) {}
+                                              const int initialPercent, const uint32_t bookPageCount = 0)
+      : Activity("EpubReaderPercentSelection", renderer, mappedInput),
+        percent(initialPercent),
+        bookPageCount(bookPageCount) {}
 
   void onEnter() override;
   void onExit() override;
@@ -19,6 +21,8 @@ class EpubReaderPercentSelectionActivity final : public Activity {
  private:
   // Current percent value (0-100) shown on the slider.
   int percent = 0;
+  // Pages in the paginated book, 0 if not paginated yet.
+  uint32_t bookPageCount = 0;
   ButtonNavigator buttonNavigator;
 
   // Change the current percent by a delta and clamp within bounds.
@@ -3,7 +3,6 @@
 #include <Epub/Page.h>
 #include <GfxRenderer.h>
 #include <HalStorage.h>
-#include <MarkdownRenderer.h>
 #include <esp_task_wdt.h>
 
 #include <algorithm>
@@ -49,12 +48,8 @@ void MarkdownReaderActivity::onEnter() {
   }
 
   markdown->setupCacheDir();
-  // Parse AST for Obsidian rendering and navigation (best effort)
-  astReady.store(markdown->parseToAst());
-  useAstRenderer.store(astReady.load());
-  if (!useAstRenderer.load()) {
-    htmlReady.store(markdown->ensureHtml());
-  }
+  // Pages and navigation are streamed from the file when the section is built; HTML is only the fallback
+  useAstRenderer.store(true);
 
   APP_STATE.openEpubPath = markdown->getPath();
   APP_STATE.saveToFile();
@@ -99,8 +94,8 @@ void MarkdownReaderActivity::loop() {
     return;
   }
 
-  // Long press for heading navigation (when enabled and AST is available)
-  if (SETTINGS.longPressChapterSkip && astReady.load()) {
+  // Long press for heading navigation (when enabled and the section has an index)
+  if (SETTINGS.longPressChapterSkip && getNavigation()) {
     constexpr unsigned long headingSkipMs = 500;
     const bool leftHeld = mappedInput.isPressed(MappedInputManager::Button::Left) ||
                           mappedInput.isPressed(MappedInputManager::Button::PageBack);
@@ -165,14 +160,7 @@ void MarkdownReaderActivity::renderScreen() {
     return;
   }
 
-  if (useAstRenderer.load()) {
-    if (!astReady.load() || !markdown->getAst()) {
-      renderer.clearScreen();
-      renderer.drawCenteredText(UI_12_FONT_ID, 300, "Markdown error", true, EpdFontFamily::BOLD);
-      renderer.displayBuffer();
-      return;
-    }
-  } else if (!htmlReady.load()) {
+  if (!useAstRenderer.load() && !htmlReady.load()) {
     renderer.clearScreen();
     renderer.drawCenteredText(UI_12_FONT_ID, 300, "Markdown error", true, EpdFontFamily::BOLD);
     renderer.displayBuffer();
@@ -197,8 +185,6 @@ void MarkdownReaderActivity::renderScreen() {
   const uint16_t viewportWidth = renderer.getScreenWidth() - orientedMarginLeft - orientedMarginRight;
   const uint16_t viewportHeight = renderer.getScreenHeight() - orientedMarginTop - orientedMarginBottom;
 
-  bool sectionInitialized = false;
-
   auto progressSetup = [this] {
     constexpr int barWidth = 200;
     constexpr int barHeight = 10;
@@ -236,7 +222,6 @@ void MarkdownReaderActivity::renderScreen() {
 
   if (useAstRenderer.load()) {
     if (!mdSection) {
-      sectionInitialized = true;
       mdSection.reset(new MarkdownSection(markdown->getCachePath(), markdown->getContentBasePath(), renderer));
 
       bool sectionLoaded = false;
@@ -253,12 +238,12 @@ void MarkdownReaderActivity::renderScreen() {
         renderer.displayBuffer();
         pagesUntilFullRefresh = 0;
 
-        if (!mdSection->createSectionFile(*markdown->getAst(), SETTINGS.getReaderFontId(),
-                                          SETTINGS.getReaderLineCompression(), SETTINGS.extraParagraphSpacing,
-                                          SETTINGS.paragraphAlignment, viewportWidth, viewportHeight,
-                                          SETTINGS.hyphenationEnabled, static_cast<uint32_t>(markdown->getFileSize()),
-                                          progressSetup, progressCallback)) {
-          LOG_ERR("MDR", "Failed to build markdown AST cache, falling back to HTML");
+        if (!mdSection->createSectionFile(*markdown, SETTINGS.getReaderFontId(), SETTINGS.getReaderLineCompression(),
+                                          SETTINGS.extraParagraphSpacing, SETTINGS.paragraphAlignment, viewportWidth,
+                                          viewportHeight, SETTINGS.hyphenationEnabled,
+                                          static_cast<uint32_t>(markdown->getFileSize()), progressSetup,
+                                          progressCallback)) {
+          LOG_ERR("MDR", "Failed to build markdown section, falling back to HTML");
           mdSection.reset();
           useAstRenderer.store(false);
         }
@@ -274,25 +259,6 @@ void MarkdownReaderActivity::renderScreen() {
         }
         hasSavedPage = false;
       }
-
-      if (sectionInitialized && astReady.load()) {
-        auto* nav = markdown->getNavigation();
-        if (nav) {
-          if (mdSection->hasNodeToPageMap()) {
-            nav->updatePageNumbers(mdSection->getNodeToPageMap());
-          } else {
-            MarkdownRenderer mdRenderer(renderer, SETTINGS.getReaderFontId(), viewportWidth, viewportHeight,
-                                        SETTINGS.getReaderLineCompression(), SETTINGS.extraParagraphSpacing,
-                                        SETTINGS.paragraphAlignment, SETTINGS.hyphenationEnabled,
-                                        markdown->getContentBasePath());
-            {
-              SpiBusMutex::Guard guard;
-              mdRenderer.render(*markdown->getAst(), [](std::unique_ptr<Page> page) { (void)page; });
-            }
-            nav->updatePageNumbers(mdRenderer.getNodeToPageMap());
-          }
-        }
-      }
     }
   }
 
@@ -308,7 +274,6 @@ void MarkdownReaderActivity::renderScreen() {
     }
 
     if (!htmlSection) {
-      sectionInitialized = true;
       htmlSection.reset(
           new HtmlSection(markdown->getHtmlPath(), markdown->getCachePath(), markdown->getContentBasePath(), renderer));
 
@@ -344,22 +309,6 @@ void MarkdownReaderActivity::renderScreen() {
         }
         hasSavedPage = false;
       }
-
-      if (sectionInitialized && astReady.load() && markdown->getAst()) {
-        auto* nav = markdown->getNavigation();
-        if (nav) {
-          MarkdownRenderer mdRenderer(renderer, SETTINGS.getReaderFontId(), viewportWidth, viewportHeight,
-                                      SETTINGS.getReaderLineCompression(), SETTINGS.extraParagraphSpacing,
-                                      SETTINGS.paragraphAlignment, SETTINGS.hyphenationEnabled,
-                                      markdown->getContentBasePath());
-          // Full render is required to compute accurate node->page mapping based on layout.
-          {
-            SpiBusMutex::Guard guard;
-            mdRenderer.render(*markdown->getAst(), [](std::unique_ptr<Page> page) { (void)page; });
-          }
-          nav->updatePageNumbers(mdRenderer.getNodeToPageMap());
-        }
-      }
     }
   }
 
@@ -575,12 +524,16 @@ std::unique_ptr<Page> MarkdownReaderActivity::loadActivePage() {
   return htmlSection ? htmlSection->loadPageFromSectionFile() : nullptr;
 }
 
-void MarkdownReaderActivity::jumpToNextHeading() {
-  if (!astReady.load() || !markdown || !hasActiveSection()) {
-    return;
+const MarkdownNavigation* MarkdownReaderActivity::getNavigation() const {
+  // The HTML fallback has no navigation index
+  if (!markdown || !useAstRenderer.load() || !mdSection) {
+    return nullptr;
   }
+  return &mdSection->getNavigation();
+}
 
-  const auto* nav = markdown->getNavigation();
+void MarkdownReaderActivity::jumpToNextHeading() {
+  const auto* nav = getNavigation();
   if (!nav) {
     return;
   }
@@ -593,11 +546,7 @@ void MarkdownReaderActivity::jumpToNextHeading() {
 }
 
 void MarkdownReaderActivity::jumpToPrevHeading() {
-  if (!astReady.load() || !markdown || !hasActiveSection()) {
-    return;
-  }
-
-  const auto* nav = markdown->getNavigation();
+  const auto* nav = getNavigation();
   if (!nav) {
     return;
   }
@@ -610,11 +559,7 @@ void MarkdownReaderActivity::jumpToPrevHeading() {
 }
 
 void MarkdownReaderActivity::showTableOfContents() {
-  if (!astReady.load() || !markdown || !hasActiveSection()) {
-    return;
-  }
-
-  auto* nav = markdown->getNavigation();
+  const auto* nav = getNavigation();
   if (!nav || nav->getToc().empty()) {
     return;
   }
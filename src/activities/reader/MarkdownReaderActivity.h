@@ -17,7 +17,6 @@ class MarkdownReaderActivity final : public ActivityWithSubactivity {
   std::atomic<bool> useAstRenderer{false};
   int pagesUntilFullRefresh = 0;
   std::atomic<bool> htmlReady{false};
-  std::atomic<bool> astReady{false};  // AST parsed for navigation
   int savedPage = 0;
   bool hasSavedPage = false;
   void* callbackCtx;
@@ -38,6 +37,7 @@ class MarkdownReaderActivity final : public ActivityWithSubactivity {
   std::unique_ptr<Page> loadActivePage();
 
   // Navigation helpers
+  const MarkdownNavigation* getNavigation() const;
   void jumpToNextHeading();
   void jumpToPrevHeading();
   void showTableOfContents();
@@ -55,4 +55,5 @@ class MarkdownReaderActivity final : public ActivityWithSubactivity {
   void onEnter() override;
   void onExit() override;
   void loop() override;
+  bool isReaderActivity() const override { return true; }
 };
@@ -0,0 +1,121 @@
+#include "PagePrefetcher.h"
+
+#include <Logging.h>
+
+#include "SpiBusMutex.h"
+#include "activities/TaskShutdown.h"
+
+namespace {
+// Same priority as the render task: it runs while the render task sleeps on the panel's busy line, and ahead of the
+// idle-priority chapter layout.
+constexpr UBaseType_t PREFETCH_TASK_PRIORITY = tskIDLE_PRIORITY + 1;
+constexpr int LOAD_POLL_MS = 2;
+}  // namespace
+
+bool PagePrefetcher::start() {
+  if (taskHandle != nullptr) {
+    return true;
+  }
+  exitRequested.store(false);
+  taskHasExited.store(false);
+  if (xTaskCreate(&taskTrampoline, "PagePrefetchTask", TASK_STACK_SIZE, this, PREFETCH_TASK_PRIORITY, &taskHandle) !=
+      pdPASS) {
+    LOG_ERR("PPF", "Failed to create page prefetch task, pages will load on demand");
+    taskHandle = nullptr;
+    taskHasExited.store(true);
+    return false;
+  }
+  return true;
+}
+
+void PagePrefetcher::stop() {
+  if (taskHandle != nullptr) {
+    exitRequested.store(true);
+    xTaskNotifyGive(taskHandle);
+    TaskShutdown::requestExit(exitRequested, taskHasExited, taskHandle);
+  }
+  std::lock_guard<std::mutex> lock(mutex);
+  clearLocked();
+}
+
+void PagePrefetcher::taskTrampoline(void* param) {
+  auto* self = static_cast<PagePrefetcher*>(param);
+  self->taskLoop();
+}
+
+void PagePrefetcher::taskLoop() {
+  while (!exitRequested.load()) {
+    std::shared_ptr<Section> target;
+    uint16_t targetIndex = 0;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (state == State::Pending) {
+        target = section;
+        targetIndex = index;
+        state = State::Loading;
+      }
+    }
+    if (!target) {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      continue;
+    }
+
+    std::unique_ptr<Page> loaded;
+    {
+      SpiBusMutex::Guard guard;
+      loaded = target->loadPage(targetIndex);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    // A request(), take() or discard() in the meantime owns the slot now; drop what was loaded
+    if (state == State::Loading && section == target && index == targetIndex) {
+      page = std::move(loaded);
+      state = page ? State::Ready : State::Empty;
+    }
+  }
+  taskHasExited.store(true);
+  vTaskDelete(nullptr);
+}
+
+void PagePrefetcher::request(const std::shared_ptr<Section>& target, const uint16_t targetIndex) {
+  if (taskHandle == nullptr) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    clearLocked();
+    section = target;
+    index = targetIndex;
+    state = State::Pending;
+  }
+  xTaskNotifyGive(taskHandle);
+}
+
+std::unique_ptr<Page> PagePrefetcher::take(const Section* target, const uint16_t targetIndex) {
+  std::unique_lock<std::mutex> lock(mutex);
+  if (section.get() != target || index != targetIndex) {
+    clearLocked();
+    return nullptr;
+  }
+  // Turning the page right after the refresh can catch the load halfway; finishing it beats reading the page twice
+  while (state == State::Loading) {
+    lock.unlock();
+    vTaskDelay(pdMS_TO_TICKS(LOAD_POLL_MS));
+    lock.lock();
+  }
+  std::unique_ptr<Page> result = state == State::Ready && section.get() == target ? std::move(page) : nullptr;
+  clearLocked();
+  return result;
+}
+
+void PagePrefetcher::discard() {
+  std::lock_guard<std::mutex> lock(mutex);
+  clearLocked();
+}
+
+void PagePrefetcher::clearLocked() {
+  state = State::Empty;
+  section.reset();
+  index = 0;
+  page.reset();
+}
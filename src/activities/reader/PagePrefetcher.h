@@ -0,0 +1,56 @@
+#pragma once
+
+#include <Epub/Page.h>
+#include <Epub/Section.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+// Deserializes the page after the one on screen while the panel is refreshing.
+//
+// displayBuffer() spends most of its time polling the panel's busy line, so the render task is asleep for the
+// whole refresh. The reader calls request() right before it hands the frame to the panel; this task reads the next
+// page from the section file in that window, and the next forward turn picks it up with take() instead of going to
+// the SD card. A prefetched page is only ever returned for the exact (section, page) it was loaded for, so a
+// backward turn, a chapter change or a settings change (which replaces the section) can never show a stale page;
+// discard() just frees it early.
+class PagePrefetcher {
+ public:
+  PagePrefetcher() = default;
+  ~PagePrefetcher() { stop(); }
+  PagePrefetcher(const PagePrefetcher&) = delete;
+  PagePrefetcher& operator=(const PagePrefetcher&) = delete;
+
+  bool start();
+  void stop();
+
+  // Replaces any earlier request or result with page `index` of `section`.
+  void request(const std::shared_ptr<Section>& section, uint16_t index);
+  // Returns the prefetched page if it is page `index` of `section`, waiting for a load already in flight. Returns
+  // null otherwise. Either way the slot is emptied.
+  std::unique_ptr<Page> take(const Section* section, uint16_t index);
+  void discard();
+
+ private:
+  static constexpr uint32_t TASK_STACK_SIZE = 4096;
+
+  enum class State : uint8_t { Empty, Pending, Loading, Ready };
+
+  std::mutex mutex;  // guards everything below up to taskHandle
+  State state = State::Empty;
+  std::shared_ptr<Section> section;
+  uint16_t index = 0;
+  std::unique_ptr<Page> page;
+
+  std::atomic<bool> exitRequested{false};
+  std::atomic<bool> taskHasExited{true};
+  TaskHandle_t taskHandle = nullptr;
+
+  static void taskTrampoline(void* param);
+  void taskLoop();
+  void clearLocked();
+};
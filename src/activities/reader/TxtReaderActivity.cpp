@@ -25,7 +25,12 @@ namespace {
 constexpr size_t CHUNK_SIZE = 8 * 1024;  // 8KB chunk for reading
 // Cache file magic and version
 constexpr uint32_t CACHE_MAGIC = 0x54585449;  // "TXTI"
-constexpr uint8_t CACHE_VERSION = 3;          // Increment when cache format changes
+constexpr uint8_t CACHE_VERSION = 4;          // Increment when cache format changes
+// Below the render and input tasks, like the EPUB layout queue: indexing only runs while the reader is idle
+constexpr UBaseType_t INDEX_TASK_PRIORITY = tskIDLE_PRIORITY;
+constexpr uint32_t INDEX_TASK_STACK_SIZE = 4096;
+constexpr size_t CHECKPOINT_PAGES = 256;  // index.bin is rewritten every this many new pages
+constexpr int INDEX_POLL_MS = 10;
 
 }  // namespace
 
@@ -61,6 +66,7 @@ void TxtReaderActivity::onExit() {
   // Reset orientation back to portrait for the rest of the UI
   renderer.setOrientation(GfxRenderer::Orientation::Portrait);
 
+  stopIndexTask();
   pageOffsets.clear();
   currentPageLines.clear();
   APP_STATE.readerActivityLoadCount = 0;
@@ -91,7 +97,10 @@ void TxtReaderActivity::loop() {
     currentPage--;
     requestUpdate();
   } else if (nextTriggered) {
-    if (currentPage < totalPages - 1) {
+    bool complete = false;
+    const int indexedPages = indexedPageCount(&complete);
+    // Past the indexed pages while the index is still growing: render waits for the page (see waitForPage)
+    if (currentPage < indexedPages - 1 || !complete) {
       currentPage++;
       requestUpdate();
     } else {
@@ -128,57 +137,118 @@ void TxtReaderActivity::initializeReader() {
 
   LOG_DBG("TRS", "Viewport: %dx%d, lines per page: %d", viewportWidth, viewportHeight, linesPerPage);
 
-  // Try to load cached page index first
+  // Try to load cached page index first; a partial one is resumed in the background
   if (!loadPageIndexCache()) {
-    // Cache not found, build page index
-    buildPageIndex();
-    // Save to cache for next time
-    savePageIndexCache();
+    std::lock_guard<std::mutex> lock(indexMutex);
+    pageOffsets.clear();
+    if (txt->getFileSize() > 0) {
+      pageOffsets.push_back(0);  // First page starts at offset 0
+    }
+    indexComplete = pageOffsets.empty();
   }
 
   // Load saved progress
   loadProgress();
 
+  if (!indexComplete) {
+    startIndexTask();
+  }
+
   initialized = true;
 }
 
-void TxtReaderActivity::buildPageIndex() {
-  pageOffsets.clear();
-  pageOffsets.push_back(0);  // First page starts at offset 0
-
-  size_t offset = 0;
-  const size_t fileSize = txt->getFileSize();
+void TxtReaderActivity::startIndexTask() {
+  indexExitRequested.store(false);
+  indexTaskHasExited.store(false);
+  if (xTaskCreate(&indexTaskTrampoline, "TxtIndexTask", INDEX_TASK_STACK_SIZE, this, INDEX_TASK_PRIORITY,
+                  &indexTaskHandle) != pdPASS) {
+    LOG_ERR("TRS", "Failed to create index task, indexing in the foreground");
+    indexTaskHandle = nullptr;
+    indexTaskHasExited.store(true);
+    GUI.drawPopup(renderer, tr(STR_INDEXING));
+    indexPages();
+  }
+}
 
-  LOG_DBG("TRS", "Building page index for %zu bytes...", fileSize);
+void TxtReaderActivity::stopIndexTask() {
+  if (indexTaskHandle != nullptr) {
+    TaskShutdown::requestExit(indexExitRequested, indexTaskHasExited, indexTaskHandle);
+  }
+}
 
-  GUI.drawPopup(renderer, tr(STR_INDEXING));
+void TxtReaderActivity::indexTaskTrampoline(void* param) {
+  auto* self = static_cast<TxtReaderActivity*>(param);
+  self->indexTaskLoop();
+}
 
-  while (offset < fileSize) {
-    std::vector<StyledLine> tempLines;
-    size_t nextOffset = offset;
+void TxtReaderActivity::indexTaskLoop() {
+  indexPages();
+  indexTaskHasExited.store(true);
+  vTaskDelete(nullptr);
+}
 
-    if (!loadPageAtOffset(offset, tempLines, nextOffset)) {
-      break;
-    }
+void TxtReaderActivity::indexPages() {
+  size_t offset = 0;
+  {
+    std::lock_guard<std::mutex> lock(indexMutex);
+    offset = pageOffsets.back();  // Start of the last known page; its end is the next page to find
+  }
+  const size_t fileSize = txt->getFileSize();
+  const unsigned long start = millis();
+  LOG_DBG("TRS", "Indexing %zu bytes from offset %zu", fileSize, offset);
 
-    if (nextOffset <= offset) {
-      // No progress made, avoid infinite loop
+  std::vector<StyledLine> tempLines;
+  size_t newPages = 0;
+  while (!indexExitRequested.load()) {
+    size_t nextOffset = offset;
+    // No progress or the end of the file: the index is complete
+    if (!loadPageAtOffset(offset, tempLines, nextOffset) || nextOffset <= offset || nextOffset >= fileSize) {
+      std::lock_guard<std::mutex> lock(indexMutex);
+      indexComplete = true;
       break;
     }
 
     offset = nextOffset;
-    if (offset < fileSize) {
+    {
+      std::lock_guard<std::mutex> lock(indexMutex);
       pageOffsets.push_back(offset);
     }
-
-    // Yield to other tasks periodically
-    if (pageOffsets.size() % 20 == 0) {
-      yield();
+    if (++newPages % CHECKPOINT_PAGES == 0) {
+      savePageIndexCache();
     }
   }
 
-  totalPages = pageOffsets.size();
-  LOG_DBG("TRS", "Built page index: %d pages", totalPages);
+  savePageIndexCache();
+  LOG_DBG("TRS", "Indexed %zu pages in %lums%s", newPages, millis() - start, indexComplete ? "" : " (paused)");
+}
+
+int TxtReaderActivity::indexedPageCount(bool* complete) const {
+  std::lock_guard<std::mutex> lock(indexMutex);
+  if (complete) {
+    *complete = indexComplete;
+  }
+  return static_cast<int>(pageOffsets.size());
+}
+
+bool TxtReaderActivity::waitForPage(const int page) {
+  bool complete = false;
+  if (page < indexedPageCount(&complete)) {
+    return true;
+  }
+  if (complete) {
+    return false;
+  }
+
+  GUI.drawPopup(renderer, tr(STR_INDEXING));
+  while (true) {
+    vTaskDelay(pdMS_TO_TICKS(INDEX_POLL_MS));
+    if (page < indexedPageCount(&complete)) {
+      return true;
+    }
+    if (complete) {
+      return false;
+    }
+  }
 }
 
 bool TxtReaderActivity::loadPageAtOffset(size_t offset, std::vector<StyledLine>& outLines, size_t& nextOffset) {
@@ -246,62 +316,41 @@ bool TxtReaderActivity::loadPageAtOffset(size_t offset, std::vector<StyledLine>&
       continue;
     }
 
-    std::string& lineText = processed.text;
+    const std::string& lineText = processed.text;
     const EpdFontFamily::Style lineStyle = processed.style;
 
-    // Track position within this source line (in bytes from pos) for non-markdown mode.
+    // Bytes of lineText already placed on the page; also the position within this source line for non-markdown mode
     size_t lineBytePos = 0;
 
-    // Word wrap if needed
-    while (!lineText.empty() && static_cast<int>(outLines.size()) < linesPerPage) {
-      int lineWidth = renderer.getTextWidth(cachedFontId, lineText.c_str(), lineStyle);
+    // Word wrap if needed: one advance pass per output line finds the break
+    while (lineBytePos < lineText.length() && static_cast<int>(outLines.size()) < linesPerPage) {
+      const char* rest = lineText.c_str() + lineBytePos;
+      const size_t restLen = lineText.length() - lineBytePos;
+      const size_t breakPos = renderer.getWrapBreak(cachedFontId, rest, viewportWidth, lineStyle);
 
-      if (lineWidth <= viewportWidth) {
-        outLines.push_back({lineText, lineStyle, false});
-        lineBytePos = displayLen;  // Consumed entire display content
-        lineText.clear();
+      if (breakPos >= restLen) {
+        outLines.push_back({std::string(rest, restLen), lineStyle, false});
+        lineBytePos = lineText.length();  // Consumed entire display content
         break;
       }
 
-      // Find break point
-      size_t breakPos = lineText.length();
-      while (breakPos > 0 &&
-             renderer.getTextWidth(cachedFontId, lineText.substr(0, breakPos).c_str(), lineStyle) > viewportWidth) {
-        // Try to break at space
-        size_t spacePos = lineText.rfind(' ', breakPos - 1);
-        if (spacePos != std::string::npos && spacePos > 0) {
-          breakPos = spacePos;
-        } else {
-          // Break at character boundary for UTF-8
-          breakPos--;
-          // Make sure we don't break in the middle of a UTF-8 sequence
-          while (breakPos > 0 && (lineText[breakPos] & 0xC0) == 0x80) {
-            breakPos--;
-          }
-        }
-      }
-
-      if (breakPos == 0) {
-        breakPos = 1;
-      }
-
-      outLines.push_back({lineText.substr(0, breakPos), lineStyle, false});
+      outLines.push_back({std::string(rest, breakPos), lineStyle, false});
 
       // Skip space at break point
       size_t skipChars = breakPos;
-      if (breakPos < lineText.length() && lineText[breakPos] == ' ') {
+      if (rest[breakPos] == ' ') {
         skipChars++;
       }
       lineBytePos += skipChars;
-      lineText = lineText.substr(skipChars);
     }
+    const bool lineDone = lineBytePos >= lineText.length();
 
     // Determine how much of the source buffer we consumed.
     // In markdown mode, always advance past the full raw line — inline stripping means
     // lineBytePos would be measured in cleaned-text bytes, which don't map to raw positions.
-    if (isMarkdown || lineText.empty()) {
+    if (isMarkdown || lineDone) {
       pos = lineEnd + 1;
-      if (!lineText.empty()) {
+      if (!lineDone) {
         // Markdown: page filled before finishing a long wrapped line; remaining text is skipped.
         break;
       }
@@ -337,19 +386,23 @@ void TxtReaderActivity::render(RenderLock&&) {
     initializeReader();
   }
 
-  if (pageOffsets.empty()) {
+  if (indexedPageCount() == 0) {
     renderer.clearScreen();
     renderer.drawCenteredText(UI_12_FONT_ID, 300, tr(STR_EMPTY_FILE), true, EpdFontFamily::BOLD);
     renderer.displayBuffer();
     return;
   }
 
-  // Bounds check
+  // Bounds check; pages past the index so far are waited for
   if (currentPage < 0) currentPage = 0;
-  if (currentPage >= totalPages) currentPage = totalPages - 1;
+  if (!waitForPage(currentPage)) currentPage = indexedPageCount() - 1;
 
   // Load current page content
-  size_t offset = pageOffsets[currentPage];
+  size_t offset = 0;
+  {
+    std::lock_guard<std::mutex> lock(indexMutex);
+    offset = pageOffsets[currentPage];
+  }
   size_t nextOffset;
   currentPageLines.clear();
   if (!loadPageAtOffset(offset, currentPageLines, nextOffset)) {
@@ -428,12 +481,24 @@ void TxtReaderActivity::renderPage() {
 }
 
 void TxtReaderActivity::renderStatusBar() const {
-  const float progress = totalPages > 0 ? (currentPage + 1) * 100.0f / totalPages : 0;
+  bool complete = false;
+  int pageCount = indexedPageCount(&complete);
+  if (!complete && pageCount > 1) {
+    // Still indexing: extrapolate the page count from the bytes the known pages cover
+    size_t lastPageStart = 0;
+    {
+      std::lock_guard<std::mutex> lock(indexMutex);
+      lastPageStart = pageOffsets.back();
+    }
+    const auto estimate = static_cast<int>(static_cast<uint64_t>(txt->getFileSize()) * (pageCount - 1) / lastPageStart);
+    pageCount = std::max(pageCount, estimate);
+  }
+  const float progress = pageCount > 0 ? (currentPage + 1) * 100.0f / pageCount : 0;
   std::string title;
   if (SETTINGS.statusBarTitle != CrossPointSettings::STATUS_BAR_TITLE::HIDE_TITLE) {
     title = txt->getTitle();
   }
-  GUI.drawStatusBar(renderer, progress, currentPage + 1, totalPages, title);
+  GUI.drawStatusBar(renderer, progress, currentPage + 1, pageCount, title);
 }
 
 void TxtReaderActivity::saveProgress() const {
@@ -457,13 +522,16 @@ void TxtReaderActivity::loadProgress() {
     uint8_t data[4];
     if (f.read(data, 4) == 4) {
       currentPage = data[0] + (data[1] << 8);
-      if (currentPage >= totalPages) {
-        currentPage = totalPages - 1;
+      // Against a partial index the page is checked once it has been indexed (see waitForPage)
+      bool complete = false;
+      const int indexedPages = indexedPageCount(&complete);
+      if (complete && currentPage >= indexedPages) {
+        currentPage = indexedPages - 1;
       }
       if (currentPage < 0) {
         currentPage = 0;
       }
-      LOG_DBG("TRS", "Loaded progress: page %d/%d", currentPage, totalPages);
+      LOG_DBG("TRS", "Loaded progress: page %d", currentPage);
     }
     f.close();
   }
@@ -480,6 +548,7 @@ bool TxtReaderActivity::loadPageIndexCache() {
   // - int32_t: screen margin (to invalidate cache on margin change)
   // - uint8_t: paragraph alignment (to invalidate cache on alignment change)
   // - uint8_t: markdown flag (1 = markdown mode, 0 = plain text)
+  // - uint8_t: complete flag (0 = checkpoint of an index still being built)
   // - uint32_t: total pages count
   // - N * uint32_t: page offsets
 
@@ -564,26 +633,47 @@ bool TxtReaderActivity::loadPageIndexCache() {
     return false;
   }
 
+  uint8_t completeFlag;
+  serialization::readPod(f, completeFlag);
+
   uint32_t numPages;
   serialization::readPod(f, numPages);
+  if (numPages == 0) {
+    LOG_DBG("TRS", "Cache has no pages, rebuilding");
+    f.close();
+    return false;
+  }
 
   // Read page offsets
-  pageOffsets.clear();
-  pageOffsets.reserve(numPages);
+  std::vector<size_t> offsets;
+  offsets.reserve(numPages);
 
   for (uint32_t i = 0; i < numPages; i++) {
     uint32_t offset;
     serialization::readPod(f, offset);
-    pageOffsets.push_back(offset);
+    offsets.push_back(offset);
   }
 
   f.close();
-  totalPages = pageOffsets.size();
-  LOG_DBG("TRS", "Loaded page index cache: %d pages", totalPages);
+  {
+    std::lock_guard<std::mutex> lock(indexMutex);
+    pageOffsets = std::move(offsets);
+    indexComplete = completeFlag != 0;
+  }
+  LOG_DBG("TRS", "Loaded page index cache: %u pages%s", numPages, completeFlag ? "" : " (partial)");
   return true;
 }
 
 void TxtReaderActivity::savePageIndexCache() const {
+  // Copied so the index task can keep appending while the file is written
+  std::vector<size_t> offsets;
+  bool complete = false;
+  {
+    std::lock_guard<std::mutex> lock(indexMutex);
+    offsets = pageOffsets;
+    complete = indexComplete;
+  }
+
   SpiBusMutex::Guard guard;
   std::string cachePath = txt->getCachePath() + "/index.bin";
   FsFile f;
@@ -602,13 +692,14 @@ void TxtReaderActivity::savePageIndexCache() const {
   serialization::writePod(f, static_cast<int32_t>(cachedScreenMargin));
   serialization::writePod(f, cachedParagraphAlignment);
   serialization::writePod(f, static_cast<uint8_t>(isMarkdown ? 1 : 0));
-  serialization::writePod(f, static_cast<uint32_t>(pageOffsets.size()));
+  serialization::writePod(f, static_cast<uint8_t>(complete ? 1 : 0));
+  serialization::writePod(f, static_cast<uint32_t>(offsets.size()));
 
   // Write page offsets
-  for (size_t offset : pageOffsets) {
+  for (size_t offset : offsets) {
     serialization::writePod(f, static_cast<uint32_t>(offset));
   }
 
   f.close();
-  LOG_DBG("TRS", "Saved page index cache: %d pages", totalPages);
+  LOG_DBG("TRS", "Saved page index cache: %zu pages%s", offsets.size(), complete ? "" : " (partial)");
 }
@@ -7,6 +7,7 @@
 #include <freertos/task.h>
 
 #include <atomic>
+#include <mutex>
 #include <vector>
 
 #include "CrossPointSettings.h"
@@ -25,17 +26,21 @@ class TxtReaderActivity final : public Activity {
 
  private:
   std::unique_ptr<Txt> txt;
-  TaskHandle_t displayTaskHandle = nullptr;
-  std::atomic<bool> exitTaskRequested{false};
-  std::atomic<bool> taskHasExited{false};
   int currentPage = 0;
-  int totalPages = 1;
   int pagesUntilFullRefresh = 0;
 
   bool isMarkdown = false;  // true when the open file has a .md extension
 
-  // Streaming text reader - stores file offsets for each page
+  // Streaming text reader - stores file offsets for each page. The index is built page by page on a background task
+  // (see indexTaskLoop) and checkpointed to index.bin as it grows, so the first page shows without waiting for it and
+  // an interrupted pass resumes where it stopped.
+  mutable std::mutex indexMutex;    // guards pageOffsets and indexComplete
   std::vector<size_t> pageOffsets;  // File offset for start of each page
+  bool indexComplete = false;
+  TaskHandle_t indexTaskHandle = nullptr;
+  std::atomic<bool> indexExitRequested{false};
+  std::atomic<bool> indexTaskHasExited{true};
+
   std::vector<StyledLine> currentPageLines;
   int linesPerPage = 0;
   int viewportWidth = 0;
@@ -50,8 +55,16 @@ class TxtReaderActivity final : public Activity {
   int cachedOrientedMarginBottom = 0;
   int cachedOrientedMarginLeft = 0;
 
-  static void taskTrampoline(void* param);
-  void displayTaskLoop();
+  static void indexTaskTrampoline(void* param);
+  void indexTaskLoop();
+  // Appends pages to the index until the file ends or indexExitRequested is set, checkpointing as it goes
+  void indexPages();
+  void startIndexTask();
+  void stopIndexTask();
+  // Blocks until `page` is indexed or the index is complete; false if the book has no such page
+  bool waitForPage(int page);
+  // Pages indexed so far and whether that is all of them
+  int indexedPageCount(bool* complete = nullptr) const;
   bool waitForRenderingMutex();
   void renderScreen();
   void renderPage();
@@ -59,7 +72,6 @@ class TxtReaderActivity final : public Activity {
 
   void initializeReader();
   bool loadPageAtOffset(size_t offset, std::vector<StyledLine>& outLines, size_t& nextOffset);
-  void buildPageIndex();
   bool loadPageIndexCache();
   void savePageIndexCache() const;
   void saveProgress() const;
@@ -0,0 +1,198 @@
+#include "XtcPageCache.h"
+
+#include <Arduino.h>
+#include <Logging.h>
+
+#include "activities/TaskShutdown.h"
+
+namespace {
+// Same priority as the render task, like the EPUB page prefetcher: loads run while the render task waits on the panel.
+constexpr UBaseType_t PREFETCH_TASK_PRIORITY = tskIDLE_PRIORITY + 1;
+constexpr int LOAD_POLL_MS = 2;
+// Left free after the slots for the renderer, SD reads and whatever the reader opens on top (chapter list, menus)
+constexpr size_t HEAP_HEADROOM = 64 * 1024;
+}  // namespace
+
+bool XtcPageCache::start(const std::shared_ptr<Xtc>& book, const size_t size) {
+  stop();
+  xtc = book;
+  pageSize = size;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    slots.reserve(MAX_SLOTS);
+    while (slots.size() < MAX_SLOTS) {
+      // The first slot is the page on screen and only needs to fit; read-ahead slots must leave headroom
+      if (!slots.empty() && ESP.getMaxAllocHeap() < pageSize + HEAP_HEADROOM) {
+        break;
+      }
+      ScopedBuffer buffer(pageSize);
+      if (!buffer) {
+        break;
+      }
+      slots.push_back(Slot{std::move(buffer)});
+    }
+    if (slots.empty()) {
+      LOG_ERR("XPC", "Failed to allocate page buffer (%lu bytes)", pageSize);
+      return false;
+    }
+  }
+  LOG_DBG("XPC", "Page cache: %u slots of %lu bytes", static_cast<unsigned>(slots.size()), pageSize);
+
+  if (slots.size() < 2) {
+    return true;
+  }
+  exitRequested.store(false);
+  taskHasExited.store(false);
+  if (xTaskCreate(&taskTrampoline, "XtcPrefetchTask", TASK_STACK_SIZE, this, PREFETCH_TASK_PRIORITY, &taskHandle) !=
+      pdPASS) {
+    LOG_ERR("XPC", "Failed to create page prefetch task, pages will load on demand");
+    taskHandle = nullptr;
+    taskHasExited.store(true);
+  }
+  return true;
+}
+
+void XtcPageCache::stop() {
+  if (taskHandle != nullptr) {
+    exitRequested.store(true);
+    xTaskNotifyGive(taskHandle);
+    TaskShutdown::requestExit(exitRequested, taskHasExited, taskHandle);
+  }
+  std::lock_guard<std::mutex> lock(mutex);
+  slots.clear();
+  currentIndex = NO_PAGE;
+  prefetchIndex = NO_PAGE;
+  xtc.reset();
+}
+
+void XtcPageCache::taskTrampoline(void* param) {
+  auto* self = static_cast<XtcPageCache*>(param);
+  self->taskLoop();
+}
+
+void XtcPageCache::taskLoop() {
+  while (!exitRequested.load()) {
+    Slot* slot = nullptr;
+    uint32_t target = NO_PAGE;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (prefetchIndex != NO_PAGE) {
+        const uint32_t pageCount = xtc->getPageCount();
+        const uint32_t next = prefetchIndex + 1 < pageCount ? prefetchIndex + 1 : NO_PAGE;
+        const uint32_t prev = prefetchIndex > 0 ? prefetchIndex - 1 : NO_PAGE;
+        for (const uint32_t candidate : {next, prev}) {
+          if (candidate == NO_PAGE || findLocked(candidate)) {
+            continue;
+          }
+          // The previous page may not push out the next one; with two slots that leaves it uncached
+          slot = victimLocked(candidate == prev ? next : NO_PAGE);
+          if (slot) {
+            target = candidate;
+            slot->index = target;
+            slot->state = State::Loading;
+          }
+          break;
+        }
+        if (!slot) {
+          prefetchIndex = NO_PAGE;
+        }
+      }
+    }
+    if (!slot) {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      continue;
+    }
+    if (!loadInto(slot, target)) {
+      // Don't keep retrying a page that can't be read; the turn to it will report the error
+      std::lock_guard<std::mutex> lock(mutex);
+      prefetchIndex = NO_PAGE;
+    }
+  }
+  taskHasExited.store(true);
+  vTaskDelete(nullptr);
+}
+
+bool XtcPageCache::loadInto(Slot* slot, const uint32_t index) {
+  // The slot is marked Loading, so nobody else touches its buffer; Xtc::loadPage serializes on the SPI bus itself
+  const bool ok = xtc->loadPage(index, slot->buffer.data(), pageSize) != 0;
+  std::lock_guard<std::mutex> lock(mutex);
+  slot->state = ok ? State::Ready : State::Empty;
+  if (!ok) {
+    LOG_ERR("XPC", "Failed to load page %lu", index);
+    slot->index = NO_PAGE;
+  }
+  return ok;
+}
+
+const uint8_t* XtcPageCache::acquire(const uint32_t index) {
+  std::unique_lock<std::mutex> lock(mutex);
+  if (slots.empty()) {
+    return nullptr;
+  }
+  currentIndex = index;
+
+  Slot* slot = findLocked(index);
+  // Turning the page right after the refresh can catch the load halfway; finishing it beats reading the page twice
+  while (slot && slot->state == State::Loading) {
+    lock.unlock();
+    vTaskDelay(pdMS_TO_TICKS(LOAD_POLL_MS));
+    lock.lock();
+    slot = findLocked(index);
+  }
+  if (slot) {
+    return slot->buffer.data();
+  }
+
+  slot = victimLocked(NO_PAGE);
+  if (!slot) {
+    return nullptr;
+  }
+  slot->index = index;
+  slot->state = State::Loading;
+  lock.unlock();
+  return loadInto(slot, index) ? slot->buffer.data() : nullptr;
+}
+
+void XtcPageCache::prefetchAround(const uint32_t index) {
+  if (taskHandle == nullptr) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    prefetchIndex = index;
+  }
+  xTaskNotifyGive(taskHandle);
+}
+
+XtcPageCache::Slot* XtcPageCache::findLocked(const uint32_t index) {
+  for (auto& slot : slots) {
+    if (slot.state != State::Empty && slot.index == index) {
+      return &slot;
+    }
+  }
+  return nullptr;
+}
+
+XtcPageCache::Slot* XtcPageCache::victimLocked(const uint32_t keep) {
+  // Empty slots first, then the cached page farthest from the one on screen
+  Slot* best = nullptr;
+  uint32_t bestDistance = 0;
+  for (auto& slot : slots) {
+    if (slot.state == State::Loading || slot.index == currentIndex) {
+      continue;
+    }
+    if (slot.state == State::Empty) {
+      return &slot;
+    }
+    if (slot.index == keep) {
+      continue;
+    }
+    const uint32_t distance = slot.index > currentIndex ? slot.index - currentIndex : currentIndex - slot.index;
+    if (!best || distance > bestDistance) {
+      best = &slot;
+      bestDistance = distance;
+    }
+  }
+  return best;
+}
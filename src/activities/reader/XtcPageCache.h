@@ -0,0 +1,73 @@
+#pragma once
+
+#include <Xtc.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ScopedBuffer.h"
+
+// Small ring of XTC page bitmaps held in RAM around the page on screen.
+//
+// Pre-rendered pages are read straight into the framebuffer, so on a page turn the SD read is most of the time not
+// spent waiting for the panel. The reader calls prefetchAround() right before it hands the frame to the panel; while
+// the render task sleeps on the busy line this task reads the next page and then the previous one into free slots,
+// and the following turn in either direction finds its page already loaded. The slot holding the page being drawn
+// is never reused until acquire() moves on to another page.
+//
+// An XTH page is 96KB, so the slot count is whatever the heap allows, up to MAX_SLOTS. With a single slot there is
+// nothing to read ahead into and no task is started; acquire() then just loads on demand.
+class XtcPageCache {
+ public:
+  XtcPageCache() = default;
+  ~XtcPageCache() { stop(); }
+  XtcPageCache(const XtcPageCache&) = delete;
+  XtcPageCache& operator=(const XtcPageCache&) = delete;
+
+  // Allocates the slots for pages of `pageSize` bytes and starts the read-ahead task. Returns false if not even one
+  // slot fits.
+  bool start(const std::shared_ptr<Xtc>& xtc, size_t pageSize);
+  void stop();
+
+  // Returns page `index`, from its slot if it is cached (waiting for a load in flight) or read now. The data stays
+  // valid until the next acquire() or stop(). Returns null if the page cannot be read.
+  const uint8_t* acquire(uint32_t index);
+  // Queues the neighbours of page `index` for loading, next page first.
+  void prefetchAround(uint32_t index);
+
+ private:
+  static constexpr uint32_t TASK_STACK_SIZE = 4096;
+  static constexpr int MAX_SLOTS = 3;
+  static constexpr uint32_t NO_PAGE = UINT32_MAX;
+
+  enum class State : uint8_t { Empty, Loading, Ready };
+
+  struct Slot {
+    ScopedBuffer buffer;
+    uint32_t index = NO_PAGE;
+    State state = State::Empty;
+  };
+
+  std::shared_ptr<Xtc> xtc;
+  size_t pageSize = 0;
+
+  std::mutex mutex;  // guards everything below up to taskHandle
+  std::vector<Slot> slots;
+  uint32_t currentIndex = NO_PAGE;  // pinned by acquire()
+  uint32_t prefetchIndex = NO_PAGE;  // centre of the pages the task should load
+
+  std::atomic<bool> exitRequested{false};
+  std::atomic<bool> taskHasExited{true};
+  TaskHandle_t taskHandle = nullptr;
+
+  static void taskTrampoline(void* param);
+  void taskLoop();
+  bool loadInto(Slot* slot, uint32_t index);
+  Slot* findLocked(uint32_t index);
+  Slot* victimLocked(uint32_t keep);
+};
@@ -11,9 +11,9 @@
 #include <GfxRenderer.h>
 #include <HalStorage.h>
 #include <Logging.h>
+#include <Xtc/XtcBlit.h>
 
 #include "CrossPointSettings.h"
-#include "ScopedBuffer.h"
 #include "CrossPointState.h"
 #include "MappedInputManager.h"
 #include "util/RecentBooksStore.h"
@@ -39,6 +39,16 @@ void XtcReaderActivity::onEnter() {
   // Load saved progress
   loadProgress();
 
+  // XTG (1-bit): Row-major, ((width+7)/8) * height bytes
+  // XTH (2-bit): Two bit planes, column-major, ((width * height + 7) / 8) * 2 bytes
+  size_t pageBufferSize;
+  if (xtc->getBitDepth() == 2) {
+    pageBufferSize = ((static_cast<size_t>(xtc->getPageWidth()) * xtc->getPageHeight() + 7) / 8) * 2;
+  } else {
+    pageBufferSize = ((xtc->getPageWidth() + 7) / 8) * xtc->getPageHeight();
+  }
+  pageCacheReady = pageCache.start(xtc, pageBufferSize);
+
   // Save current XTC as last opened book and add to recent books
   APP_STATE.openEpubPath = xtc->getPath();
   APP_STATE.saveToFile();
@@ -50,6 +60,7 @@ void XtcReaderActivity::onEnter() {
 void XtcReaderActivity::onExit() {
   Activity::onExit();
 
+  pageCache.stop();
   xtc.reset();
 }
 
@@ -155,29 +166,16 @@ void XtcReaderActivity::renderPage() {
   const uint16_t pageHeight = xtc->getPageHeight();
   const uint8_t bitDepth = xtc->getBitDepth();
 
-  // Calculate buffer size for one page
-  // XTG (1-bit): Row-major, ((width+7)/8) * height bytes
-  // XTH (2-bit): Two bit planes, column-major, ((width * height + 7) / 8) * 2 bytes
-  size_t pageBufferSize;
-  if (bitDepth == 2) {
-    pageBufferSize = ((static_cast<size_t>(pageWidth) * pageHeight + 7) / 8) * 2;
-  } else {
-    pageBufferSize = ((pageWidth + 7) / 8) * pageHeight;
-  }
-
-  // Allocate page buffer
-  ScopedBuffer pageBuffer(pageBufferSize);
-  if (!pageBuffer) {
-    LOG_ERR("XTR", "Failed to allocate page buffer (%lu bytes)", pageBufferSize);
+  if (!pageCacheReady) {
     renderer.clearScreen();
     renderer.drawCenteredText(UI_12_FONT_ID, 300, "Memory error", true, EpdFontFamily::BOLD);
     renderer.displayBuffer();
     return;
   }
 
-  // Load page data
-  size_t bytesRead = xtc->loadPage(currentPage, pageBuffer.data(), pageBufferSize);
-  if (bytesRead == 0) {
+  // Load page data (usually already read ahead while the previous page was refreshing)
+  const uint8_t* page = pageCache.acquire(currentPage);
+  if (!page) {
     LOG_ERR("XTR", "Failed to load page %lu", currentPage);
     renderer.clearScreen();
     renderer.drawCenteredText(UI_12_FONT_ID, 300, "Page load error", true, EpdFontFamily::BOLD);
@@ -185,135 +183,69 @@ void XtcReaderActivity::renderPage() {
     return;
   }
 
-  // Clear screen first
-  renderer.clearScreen();
-
-  // Copy page bitmap using GfxRenderer's drawPixel
-  // XTC/XTCH pages are pre-rendered with status bar included, so render full page
-  const uint16_t maxSrcY = pageHeight;
-
-  if (bitDepth == 2) {
-    // XTH 2-bit mode: Two bit planes, column-major order
-    // - Columns scanned right to left (x = width-1 down to 0)
-    // - 8 vertical pixels per byte (MSB = topmost pixel in group)
-    // - First plane: Bit1, Second plane: Bit2
-    // - Pixel value = (bit1 << 1) | bit2
-    // - Grayscale: 0=White, 1=Dark Grey, 2=Light Grey, 3=Black
-
-    const size_t planeSize = (static_cast<size_t>(pageWidth) * pageHeight + 7) / 8;
-    const uint8_t* plane1 = pageBuffer.data();              // Bit1 plane
-    const uint8_t* plane2 = pageBuffer.data() + planeSize;  // Bit2 plane
-    const size_t colBytes = (pageHeight + 7) / 8;    // Bytes per column (100 for 800 height)
-
-    // Lambda to get pixel value at (x, y)
-    auto getPixelValue = [&](uint16_t x, uint16_t y) -> uint8_t {
-      const size_t colIndex = pageWidth - 1 - x;
-      const size_t byteInCol = y / 8;
-      const size_t bitInByte = 7 - (y % 8);
-      const size_t byteOffset = colIndex * colBytes + byteInCol;
-      const uint8_t bit1 = (plane1[byteOffset] >> bitInByte) & 1;
-      const uint8_t bit2 = (plane2[byteOffset] >> bitInByte) & 1;
-      return (bit1 << 1) | bit2;
-    };
-
-    // Optimized grayscale rendering without storeBwBuffer (saves 48KB peak memory)
-    // Flow: BW display → LSB/MSB passes → grayscale display → re-render BW for next frame
-
-    // Count pixel distribution for debugging
-    uint32_t pixelCounts[4] = {0, 0, 0, 0};
-    for (uint16_t y = 0; y < pageHeight; y++) {
-      for (uint16_t x = 0; x < pageWidth; x++) {
-        pixelCounts[getPixelValue(x, y)]++;
-      }
-    }
-    LOG_DBG("XTR", "Pixel distribution: White=%lu, DarkGrey=%lu, LightGrey=%lu, Black=%lu", pixelCounts[0],
-            pixelCounts[1], pixelCounts[2], pixelCounts[3]);
-
-    // Pass 1: BW buffer - draw all non-white pixels as black
-    for (uint16_t y = 0; y < pageHeight; y++) {
-      for (uint16_t x = 0; x < pageWidth; x++) {
-        if (getPixelValue(x, y) >= 1) {
-          renderer.drawPixel(x, y, true);
-        }
-      }
-    }
-
-    // Display BW with conditional refresh based on pagesUntilFullRefresh
-    if (pagesUntilFullRefresh <= 1) {
-      renderer.displayBuffer(HalDisplay::HALF_REFRESH);
-      pagesUntilFullRefresh = SETTINGS.getRefreshFrequency();
-    } else {
-      renderer.displayBuffer();
-      pagesUntilFullRefresh--;
+  // XTC/XTCH pages are pre-rendered with status bar included, so render full page.
+  // Panel-sized pages in portrait are copied into the framebuffer a byte at a time (see XtcBlit.h); anything else
+  // goes through drawPixel, which handles orientation and clipping per pixel.
+  bool blit = renderer.getOrientation() == GfxRenderer::Portrait;
+
+  // XTH 2-bit mode: Two bit planes, column-major order
+  // - Columns scanned right to left (x = width-1 down to 0)
+  // - 8 vertical pixels per byte (MSB = topmost pixel in group)
+  // - First plane: Bit1, Second plane: Bit2
+  // - Pixel value = (bit1 << 1) | bit2
+  // - Grayscale: 0=White, 1=Dark Grey, 2=Light Grey, 3=Black
+  // XTG 1-bit mode: Row-major, 8 pixels per byte, MSB first, 0 = black, 1 = white
+  const size_t planeSize = (static_cast<size_t>(pageWidth) * pageHeight + 7) / 8;
+  const size_t colBytes = (pageHeight + 7) / 8;    // Bytes per XTH column (100 for 800 height)
+  const size_t srcRowBytes = (pageWidth + 7) / 8;  // Bytes per XTG row (60 for 480 width)
+  auto getPixelValue = [&](const uint16_t x, const uint16_t y) -> uint8_t {
+    if (bitDepth != 2) {
+      const bool isWhite = (page[y * srcRowBytes + x / 8] >> (7 - x % 8)) & 1;
+      return isWhite ? 0 : 3;
     }
-
-    // Pass 2: LSB buffer - mark DARK gray only (XTH value 1)
-    // In LUT: 0 bit = apply gray effect, 1 bit = untouched
-    renderer.clearScreen(0x00);
-    for (uint16_t y = 0; y < pageHeight; y++) {
-      for (uint16_t x = 0; x < pageWidth; x++) {
-        if (getPixelValue(x, y) == 1) {  // Dark grey only
-          renderer.drawPixel(x, y, false);
-        }
+    const size_t byteOffset = (pageWidth - 1 - x) * colBytes + y / 8;
+    const size_t bitInByte = 7 - (y % 8);
+    const uint8_t bit1 = (page[byteOffset] >> bitInByte) & 1;
+    const uint8_t bit2 = (page[planeSize + byteOffset] >> bitInByte) & 1;
+    return (bit1 << 1) | bit2;
+  };
+
+  auto drawPass = [&](const xtc::BlitPass pass) {
+    if (blit) {
+      blit = xtc::blitPage(page, bitDepth, pageWidth, pageHeight, pass, renderer.getFrameBuffer(),
+                           renderer.getDisplayWidth(), renderer.getDisplayHeight());
+      if (blit) {
+        return;
       }
     }
-    renderer.copyGrayscaleLsbBuffers();
-
-    // Pass 3: MSB buffer - mark LIGHT AND DARK gray (XTH value 1 or 2)
-    // In LUT: 0 bit = apply gray effect, 1 bit = untouched
-    renderer.clearScreen(0x00);
+    // BW: all non-white pixels black. LSB: mark dark grey only (XTH value 1). MSB: mark light and dark grey
+    // (XTH value 1 or 2). In the gray LUTs a 0 bit applies the gray effect and a 1 bit leaves the pixel untouched.
+    renderer.clearScreen(pass == xtc::BlitPass::BW ? 0xFF : 0x00);
     for (uint16_t y = 0; y < pageHeight; y++) {
       for (uint16_t x = 0; x < pageWidth; x++) {
         const uint8_t pv = getPixelValue(x, y);
-        if (pv == 1 || pv == 2) {  // Dark grey or Light grey
-          renderer.drawPixel(x, y, false);
-        }
-      }
-    }
-    renderer.copyGrayscaleMsbBuffers();
-
-    // Display grayscale overlay
-    renderer.displayGrayBuffer();
-
-    // Pass 4: Re-render BW to framebuffer (restore for next frame, instead of restoreBwBuffer)
-    renderer.clearScreen();
-    for (uint16_t y = 0; y < pageHeight; y++) {
-      for (uint16_t x = 0; x < pageWidth; x++) {
-        if (getPixelValue(x, y) >= 1) {
-          renderer.drawPixel(x, y, true);
+        switch (pass) {
+          case xtc::BlitPass::BW:
+            if (pv >= 1) renderer.drawPixel(x, y, true);
+            break;
+          case xtc::BlitPass::GrayLsb:
+            if (pv == 1) renderer.drawPixel(x, y, false);
+            break;
+          case xtc::BlitPass::GrayMsb:
+            if (pv == 1 || pv == 2) renderer.drawPixel(x, y, false);
+            break;
         }
       }
     }
+  };
 
-    // Cleanup grayscale buffers with current frame buffer
-    renderer.cleanupGrayscaleWithFrameBuffer();
-
-    LOG_INF("XTR", "Rendered page %lu/%lu (2-bit grayscale)", currentPage + 1, xtc->getPageCount());
-    return;
-  } else {
-    // 1-bit mode: 8 pixels per byte, MSB first
-    const size_t srcRowBytes = (pageWidth + 7) / 8;  // 60 bytes for 480 width
-
-    for (uint16_t srcY = 0; srcY < maxSrcY; srcY++) {
-      const size_t srcRowStart = srcY * srcRowBytes;
-
-      for (uint16_t srcX = 0; srcX < pageWidth; srcX++) {
-        // Read source pixel (MSB first, bit 7 = leftmost pixel)
-        const size_t srcByte = srcRowStart + srcX / 8;
-        const size_t srcBit = 7 - (srcX % 8);
-        const bool isBlack = !((pageBuffer.data()[srcByte] >> srcBit) & 1);  // XTC: 0 = black, 1 = white
+  // Pass 1: BW buffer
+  drawPass(xtc::BlitPass::BW);
 
-        if (isBlack) {
-          renderer.drawPixel(srcX, srcY, true);
-        }
-      }
-    }
-  }
-  // White pixels are already cleared by clearScreen()
+  // Read the neighbouring pages while the panel refreshes; this page's slot stays put for the passes below
+  pageCache.prefetchAround(currentPage);
 
-  // XTC pages already have status bar pre-rendered, no need to add our own
-
-  // Display with appropriate refresh
+  // Display BW with conditional refresh based on pagesUntilFullRefresh
   if (pagesUntilFullRefresh <= 1) {
     renderer.displayBuffer(HalDisplay::HALF_REFRESH);
     pagesUntilFullRefresh = SETTINGS.getRefreshFrequency();
@@ -322,7 +254,32 @@ void XtcReaderActivity::renderPage() {
     pagesUntilFullRefresh--;
   }
 
-  LOG_INF("XTR", "Rendered page %lu/%lu (%u-bit)", currentPage + 1, xtc->getPageCount(), bitDepth);
+  if (bitDepth != 2) {
+    LOG_INF("XTR", "Rendered page %lu/%lu (%u-bit)", currentPage + 1, xtc->getPageCount(), bitDepth);
+    return;
+  }
+
+  // Optimized grayscale rendering without storeBwBuffer (saves 48KB peak memory)
+  // Flow: BW display → LSB/MSB passes → grayscale display → re-render BW for next frame
+
+  // Pass 2: LSB buffer
+  drawPass(xtc::BlitPass::GrayLsb);
+  renderer.copyGrayscaleLsbBuffers();
+
+  // Pass 3: MSB buffer
+  drawPass(xtc::BlitPass::GrayMsb);
+  renderer.copyGrayscaleMsbBuffers();
+
+  // Display grayscale overlay
+  renderer.displayGrayBuffer();
+
+  // Pass 4: Re-render BW to framebuffer (restore for next frame, instead of restoreBwBuffer)
+  drawPass(xtc::BlitPass::BW);
+
+  // Cleanup grayscale buffers with current frame buffer
+  renderer.cleanupGrayscaleWithFrameBuffer();
+
+  LOG_INF("XTR", "Rendered page %lu/%lu (2-bit grayscale)", currentPage + 1, xtc->getPageCount());
 }
 
 void XtcReaderActivity::saveProgress() const {
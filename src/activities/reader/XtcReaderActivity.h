@@ -14,6 +14,7 @@
 
 #include <atomic>
 
+#include "XtcPageCache.h"
 #include "activities/Activity.h"
 
 class XtcReaderActivity final : public Activity {
@@ -24,6 +25,8 @@ class XtcReaderActivity final : public Activity {
   std::atomic<bool> renderInProgress{false};
   uint32_t currentPage = 0;
   int pagesUntilFullRefresh = 0;
+  XtcPageCache pageCache;
+  bool pageCacheReady = false;
 
   void renderPage();
   void saveProgress() const;
@@ -10,6 +10,8 @@
 #include "MappedInputManager.h"
 #include "components/UITheme.h"
 #include "fontIds.h"
+#include "util/SectionCacheStore.h"
+#include "util/SleepScreenCache.h"
 
 void ClearCacheActivity::onEnter() {
   Activity::onEnter();
@@ -107,6 +109,8 @@ void ClearCacheActivity::clearCache() {
     }
   }
   root.close();
+  SECTION_CACHE.reset();
+  SleepScreenCache::clear();
 
   LOG_DBG("CLEAR_CACHE", "Cache cleared: %d removed, %d failed", clearedCount, failedCount);
   state = SUCCESS;
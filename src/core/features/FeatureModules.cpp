@@ -197,7 +197,8 @@ FeatureModules::HomeCardDataResult FeatureModules::resolveHomeCardData(const std
   return result;
 }
 
-FeatureModules::RecentBookDataResult FeatureModules::resolveRecentBookData(const std::string& path) {
+FeatureModules::RecentBookDataResult FeatureModules::resolveRecentBookData(const std::string& path,
+                                                                            const bool metadataOnly) {
   RecentBookDataResult result;
   if (path.empty()) {
     return result;
@@ -211,12 +212,14 @@ FeatureModules::RecentBookDataResult FeatureModules::resolveRecentBookData(const
 #if ENABLE_EPUB_SUPPORT
     Epub epub(path, "/.crosspoint");
     // Match resolveHomeCardData behavior: only expose metadata when the file loaded.
-    if (!epub.load(false)) {
+    if (!epub.load(false, metadataOnly)) {
       return result;
     }
     result.title = epub.getTitle();
     result.author = epub.getAuthor();
     result.coverPath = epub.getThumbBmpPath(kDefaultThumbHeight);
+#else
+    (void)metadataOnly;
 #endif
     return result;
   }
@@ -71,7 +71,8 @@ class FeatureModules {
   static String getFeatureMapJson();
   static bool supportsSettingAction(SettingAction action);
   static HomeCardDataResult resolveHomeCardData(const std::string& path, int thumbHeight);
-  static RecentBookDataResult resolveRecentBookData(const std::string& path);
+  // metadataOnly skips loading an EPUB's CSS, for callers that only want title and author.
+  static RecentBookDataResult resolveRecentBookData(const std::string& path, bool metadataOnly = false);
   static bool isSupportedLibraryFile(const std::string& path);
   static bool hasKoreaderSyncCredentials();
   static Activity* createTodoPlannerActivity(GfxRenderer& renderer, MappedInputManager& mappedInput,
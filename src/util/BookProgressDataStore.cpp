@@ -399,6 +399,10 @@ bool BookProgressDataStore::supportsBookPath(const std::string& bookPath) {
   return detectBookKind(bookPath) != BookKind::Unknown;
 }
 
+BookProgressDataStore::BookKind BookProgressDataStore::kindForPath(const std::string& bookPath) {
+  return detectBookKind(bookPath);
+}
+
 bool BookProgressDataStore::resolveCachePath(const std::string& bookPath, std::string& outCachePath) {
   const BookKind kind = detectBookKind(bookPath);
   outCachePath = buildCachePath(kind, bookPath);
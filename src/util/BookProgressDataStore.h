@@ -22,6 +22,7 @@ class BookProgressDataStore {
   };
 
   static bool supportsBookPath(const std::string& bookPath);
+  static BookKind kindForPath(const std::string& bookPath);
   static bool resolveCachePath(const std::string& bookPath, std::string& outCachePath);
   static bool loadProgress(const std::string& bookPath, ProgressData& outProgress);
   static const char* kindName(BookKind kind);
@@ -0,0 +1,591 @@
+#include "LibraryCatalog.h"
+
+#include <Logging.h>
+#include <Serialization.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+constexpr uint8_t LIBRARY_CATALOG_VERSION = 2;
+constexpr uint8_t RECENT_FILE_VERSION = 1;
+constexpr char CATALOG_DIR[] = "/.crosspoint/catalog";
+constexpr char BOOKS_FILE[] = "/.crosspoint/catalog/books.bin";
+constexpr char PATH_INDEX_FILE[] = "/.crosspoint/catalog/path.idx";
+constexpr char TITLE_INDEX_FILE[] = "/.crosspoint/catalog/title.idx";
+constexpr char AUTHOR_INDEX_FILE[] = "/.crosspoint/catalog/author.idx";
+constexpr char RECENT_FILE[] = "/.crosspoint/catalog/recent.bin";
+constexpr char TMP_SUFFIX[] = ".tmp";
+constexpr uint32_t MAX_RECENT = 100;
+
+// The records and every index start with the version and the id of the build that wrote them, and the indexes then
+// with their entry count. The recently read list is not part of a build and starts with its version and count.
+constexpr uint32_t INDEX_HEADER_SIZE = sizeof(uint8_t) + 2 * sizeof(uint32_t);
+constexpr uint32_t PATH_ENTRY_SIZE = 2 * sizeof(uint32_t);
+constexpr uint32_t ORDER_ENTRY_SIZE = sizeof(uint32_t);
+
+// Sorting an index keeps this many leading key bytes per book in RAM; books that tie on them are ordered by their
+// full keys afterwards, reading just those records again.
+constexpr size_t SORT_KEY_SIZE = 12;
+
+constexpr uint8_t FLAG_HAS_METADATA = 1 << 0;
+
+// Authors sort before titles within a key, and books without an author after every author
+constexpr char KEY_SEPARATOR = '\x1f';
+constexpr char NO_AUTHOR_KEY = '\xff';
+
+std::string tmpPath(const char* path) { return std::string(path) + TMP_SUFFIX; }
+
+std::string foldCase(const std::string& text) {
+  std::string folded = text;
+  for (char& c : folded) {
+    if (c >= 'A' && c <= 'Z') {
+      c = static_cast<char>(c - 'A' + 'a');
+    }
+  }
+  return folded;
+}
+
+// What a prefix search matches against
+std::string searchKey(const LibraryCatalog::Order order, const LibraryCatalog::Book& book) {
+  if (order == LibraryCatalog::Order::Author) {
+    return book.author.empty() ? std::string(1, NO_AUTHOR_KEY) : foldCase(book.author);
+  }
+  return foldCase(book.title);
+}
+
+// Full sort key; begins with searchKey() so every prefix match is one run of the index
+std::string sortKey(const LibraryCatalog::Order order, const LibraryCatalog::Book& book) {
+  std::string key = searchKey(order, book);
+  key += KEY_SEPARATOR;
+  key += order == LibraryCatalog::Order::Author ? foldCase(book.title) : foldCase(book.author);
+  key += KEY_SEPARATOR;
+  key += book.path;
+  return key;
+}
+
+void writeBook(FsFile& file, const uint32_t hash, const LibraryCatalog::Book& book) {
+  serialization::writePod(file, hash);
+  serialization::writePod(file, static_cast<uint8_t>(book.kind));
+  serialization::writePod(file, book.progress);
+  serialization::writePod(file, static_cast<uint8_t>(book.hasMetadata ? FLAG_HAS_METADATA : 0));
+  serialization::writePod(file, book.size);
+  serialization::writePod(file, book.modified);
+  serialization::writeString(file, book.path);
+  serialization::writeString(file, book.title);
+  serialization::writeString(file, book.author);
+}
+
+bool readBook(FsFile& file, const uint32_t offset, LibraryCatalog::Book& book) {
+  uint32_t hash;
+  uint8_t kind;
+  uint8_t flags;
+  if (!file.seekSet(offset) || !serialization::readPod(file, hash) || !serialization::readPod(file, kind) ||
+      !serialization::readPod(file, book.progress) || !serialization::readPod(file, flags) ||
+      !serialization::readPod(file, book.size) || !serialization::readPod(file, book.modified) ||
+      !serialization::readString(file, book.path) || !serialization::readString(file, book.title) ||
+      !serialization::readString(file, book.author)) {
+    return false;
+  }
+  book.kind = static_cast<BookProgressDataStore::BookKind>(kind);
+  book.hasMetadata = (flags & FLAG_HAS_METADATA) != 0;
+  return true;
+}
+
+void writeBuildHeader(FsFile& file, const uint32_t buildId) {
+  serialization::writePod(file, LIBRARY_CATALOG_VERSION);
+  serialization::writePod(file, buildId);
+}
+
+bool readBuildHeader(FsFile& file, uint32_t& buildId) {
+  uint8_t version;
+  return serialization::readPod(file, version) && version == LIBRARY_CATALOG_VERSION &&
+         serialization::readPod(file, buildId);
+}
+
+// Build id of the file at `path`, false if it is missing or from another version
+bool readBuildId(const char* path, uint32_t& buildId) {
+  FsFile file;
+  if (!Storage.openFileForRead("CAT", path, file)) {
+    return false;
+  }
+  const bool ok = readBuildHeader(file, buildId);
+  file.close();
+  return ok;
+}
+
+// Whether the index at `path` was written by build `buildId`, and its entry count if so
+bool readIndexCount(const char* path, const uint32_t buildId, uint32_t& count) {
+  FsFile file;
+  if (!Storage.openFileForRead("CAT", path, file)) {
+    return false;
+  }
+  uint32_t fileBuildId = 0;
+  const bool ok = readBuildHeader(file, fileBuildId) && fileBuildId == buildId && serialization::readPod(file, count);
+  file.close();
+  return ok;
+}
+
+bool readRecentHeader(FsFile& file, uint32_t& count) {
+  uint8_t version;
+  return serialization::readPod(file, version) && version == RECENT_FILE_VERSION && serialization::readPod(file, count);
+}
+
+bool readIndexEntry(FsFile& index, const uint32_t position, uint32_t& offset) {
+  return index.seekSet(INDEX_HEADER_SIZE + position * ORDER_ENTRY_SIZE) && serialization::readPod(index, offset);
+}
+
+void replaceFile(const char* path) {
+  const std::string tmp = tmpPath(path);
+  Storage.remove(path);
+  if (!Storage.rename(tmp.c_str(), path)) {
+    LOG_ERR("CAT", "Failed to replace %s", path);
+  }
+}
+
+void removeTmpFiles() {
+  for (const char* path : {BOOKS_FILE, PATH_INDEX_FILE, TITLE_INDEX_FILE, AUTHOR_INDEX_FILE}) {
+    Storage.remove(tmpPath(path).c_str());
+  }
+}
+
+struct SortEntry {
+  uint32_t offset;
+  char key[SORT_KEY_SIZE];
+};
+
+// Writes the index of `order` over the records in `books` listed in `pathEntries`.
+bool writeOrderIndex(FsFile& books, const std::vector<std::pair<uint32_t, uint32_t>>& pathEntries,
+                     const LibraryCatalog::Order order, const char* path, const uint32_t buildId) {
+  std::vector<SortEntry> entries;
+  entries.reserve(pathEntries.size());
+  LibraryCatalog::Book book;
+  for (const auto& pathEntry : pathEntries) {
+    if (!readBook(books, pathEntry.second, book)) {
+      return false;
+    }
+    SortEntry entry{pathEntry.second, {}};
+    const std::string key = sortKey(order, book);
+    memcpy(entry.key, key.data(), std::min(key.size(), SORT_KEY_SIZE));
+    entries.push_back(entry);
+  }
+
+  std::sort(entries.begin(), entries.end(), [](const SortEntry& a, const SortEntry& b) {
+    return memcmp(a.key, b.key, SORT_KEY_SIZE) < 0;
+  });
+
+  // Runs that tie on the truncated key are short (books sharing their first dozen letters); order them properly
+  std::vector<std::pair<std::string, uint32_t>> run;
+  for (size_t start = 0; start < entries.size();) {
+    size_t end = start + 1;
+    while (end < entries.size() && memcmp(entries[start].key, entries[end].key, SORT_KEY_SIZE) == 0) {
+      end++;
+    }
+    if (end - start > 1) {
+      run.clear();
+      for (size_t i = start; i < end; i++) {
+        if (!readBook(books, entries[i].offset, book)) {
+          return false;
+        }
+        run.emplace_back(sortKey(order, book), entries[i].offset);
+      }
+      std::sort(run.begin(), run.end());
+      for (size_t i = start; i < end; i++) {
+        entries[i].offset = run[i - start].second;
+      }
+    }
+    start = end;
+  }
+
+  FsFile file;
+  if (!Storage.openFileForWrite("CAT", tmpPath(path), file)) {
+    return false;
+  }
+  writeBuildHeader(file, buildId);
+  serialization::writePod(file, static_cast<uint32_t>(entries.size()));
+  for (const auto& entry : entries) {
+    serialization::writePod(file, entry.offset);
+  }
+  file.close();
+  return true;
+}
+}  // namespace
+
+LibraryCatalog LibraryCatalog::instance;
+
+uint32_t LibraryCatalog::pathHash(const std::string& path) {
+  uint32_t hash = 2166136261u;
+  for (const char c : path) {
+    hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+  }
+  return hash;
+}
+
+std::string LibraryCatalog::titleFromPath(const std::string& path) {
+  const size_t slash = path.find_last_of('/');
+  std::string title = slash == std::string::npos ? path : path.substr(slash + 1);
+  const size_t dot = title.find_last_of('.');
+  if (dot != std::string::npos && dot > 0) {
+    title.resize(dot);
+  }
+  return title;
+}
+
+LibraryCatalog::Builder::Builder() {
+  Storage.mkdir(CATALOG_DIR);
+  // Newer than any file on the card, so files left from an earlier build can never pass for this one
+  for (const char* path : {BOOKS_FILE, PATH_INDEX_FILE, TITLE_INDEX_FILE, AUTHOR_INDEX_FILE}) {
+    uint32_t fileBuildId = 0;
+    if (readBuildId(path, fileBuildId) && fileBuildId >= buildId) {
+      buildId = fileBuildId + 1;
+    }
+  }
+  ok = Storage.openFileForWrite("CAT", tmpPath(BOOKS_FILE), booksFile);
+  if (ok) {
+    writeBuildHeader(booksFile, buildId);
+  }
+}
+
+LibraryCatalog::Builder::~Builder() {
+  if (booksFile) {
+    booksFile.close();
+  }
+  if (ok) {
+    removeTmpFiles();
+  }
+}
+
+bool LibraryCatalog::Builder::add(const Book& book) {
+  if (!ok) {
+    return false;
+  }
+  const uint32_t hash = pathHash(book.path);
+  pathEntries.emplace_back(hash, booksFile.position());
+  writeBook(booksFile, hash, book);
+  return true;
+}
+
+bool LibraryCatalog::Builder::commit() {
+  if (!ok) {
+    return false;
+  }
+  booksFile.close();
+
+  std::sort(pathEntries.begin(), pathEntries.end());
+  FsFile pathIndex;
+  if (!Storage.openFileForWrite("CAT", tmpPath(PATH_INDEX_FILE), pathIndex)) {
+    return false;
+  }
+  writeBuildHeader(pathIndex, buildId);
+  serialization::writePod(pathIndex, static_cast<uint32_t>(pathEntries.size()));
+  for (const auto& entry : pathEntries) {
+    serialization::writePod(pathIndex, entry.first);
+    serialization::writePod(pathIndex, entry.second);
+  }
+  pathIndex.close();
+
+  FsFile books;
+  if (!Storage.openFileForRead("CAT", tmpPath(BOOKS_FILE), books)) {
+    return false;
+  }
+  const bool indexed = writeOrderIndex(books, pathEntries, Order::Title, TITLE_INDEX_FILE, buildId) &&
+                       writeOrderIndex(books, pathEntries, Order::Author, AUTHOR_INDEX_FILE, buildId);
+  books.close();
+  if (!indexed) {
+    LOG_ERR("CAT", "Failed to write catalog indexes");
+    return false;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(instance.mutex);
+    for (const char* path : {BOOKS_FILE, PATH_INDEX_FILE, TITLE_INDEX_FILE, AUTHOR_INDEX_FILE}) {
+      replaceFile(path);
+    }
+    instance.invalidateLocked();
+  }
+  LOG_DBG("CAT", "Catalog written: %lu books", static_cast<unsigned long>(pathEntries.size()));
+  ok = false;
+  return true;
+}
+
+void LibraryCatalog::invalidateLocked() {
+  countsLoaded = false;
+  generation++;
+}
+
+void LibraryCatalog::loadCountsLocked() {
+  if (countsLoaded) {
+    return;
+  }
+  countsLoaded = true;
+
+  // The four files are swapped in one at a time, so a scan interrupted mid-swap leaves files from different builds;
+  // treat that as no catalog until the next scan
+  uint32_t buildId = 0;
+  uint32_t pathCount = 0;
+  uint32_t titleCount = 0;
+  uint32_t authorCount = 0;
+  built = readBuildId(BOOKS_FILE, buildId) && readIndexCount(PATH_INDEX_FILE, buildId, pathCount) &&
+          readIndexCount(TITLE_INDEX_FILE, buildId, titleCount) &&
+          readIndexCount(AUTHOR_INDEX_FILE, buildId, authorCount) && titleCount == pathCount &&
+          authorCount == pathCount;
+  bookCount = built ? pathCount : 0;
+
+  recentCount = 0;
+  FsFile recent;
+  if (Storage.openFileForRead("CAT", RECENT_FILE, recent)) {
+    uint32_t count = 0;
+    if (readRecentHeader(recent, count)) {
+      recentCount = count;
+    }
+    recent.close();
+  }
+}
+
+bool LibraryCatalog::isBuilt() {
+  std::lock_guard<std::mutex> lock(mutex);
+  loadCountsLocked();
+  return built;
+}
+
+uint32_t LibraryCatalog::count(const Order order) {
+  std::lock_guard<std::mutex> lock(mutex);
+  loadCountsLocked();
+  return order == Order::Recent ? recentCount : bookCount;
+}
+
+bool LibraryCatalog::getBooks(const Order order, const uint32_t first, const uint32_t maxCount,
+                              std::vector<Book>& out) {
+  std::lock_guard<std::mutex> lock(mutex);
+  loadCountsLocked();
+
+  FsFile books;
+  if (built && !Storage.openFileForRead("CAT", BOOKS_FILE, books)) {
+    return false;
+  }
+
+  if (order == Order::Recent) {
+    FsFile pathIndex;
+    if (built && !Storage.openFileForRead("CAT", PATH_INDEX_FILE, pathIndex)) {
+      books.close();
+      return false;
+    }
+    const std::vector<std::string> paths = readRecentLocked();
+    for (uint32_t i = first; i < paths.size() && i - first < maxCount; i++) {
+      Book book;
+      if (!built || !findBookLocked(books, pathIndex, paths[i], book)) {
+        book = Book{};
+        book.path = paths[i];
+        book.title = titleFromPath(paths[i]);
+        book.kind = BookProgressDataStore::kindForPath(paths[i]);
+      }
+      out.push_back(std::move(book));
+    }
+    if (built) {
+      pathIndex.close();
+      books.close();
+    }
+    return true;
+  }
+
+  if (!built) {
+    return true;
+  }
+  FsFile index;
+  if (!Storage.openFileForRead("CAT", order == Order::Title ? TITLE_INDEX_FILE : AUTHOR_INDEX_FILE, index)) {
+    books.close();
+    return false;
+  }
+  bool ok = true;
+  for (uint32_t position = first; position < bookCount && position - first < maxCount; position++) {
+    uint32_t offset;
+    Book book;
+    if (!readIndexEntry(index, position, offset) || !readBook(books, offset, book)) {
+      LOG_ERR("CAT", "Failed to read catalog entry %lu", static_cast<unsigned long>(position));
+      ok = false;
+      break;
+    }
+    out.push_back(std::move(book));
+  }
+  index.close();
+  books.close();
+  return ok;
+}
+
+std::pair<uint32_t, uint32_t> LibraryCatalog::findPrefix(const Order order, const std::string& prefix) {
+  std::lock_guard<std::mutex> lock(mutex);
+  loadCountsLocked();
+  if (order == Order::Recent) {
+    return {0, recentCount};
+  }
+  if (!built || prefix.empty()) {
+    return {0, bookCount};
+  }
+
+  FsFile books;
+  FsFile index;
+  if (!Storage.openFileForRead("CAT", BOOKS_FILE, books)) {
+    return {0, 0};
+  }
+  if (!Storage.openFileForRead("CAT", order == Order::Title ? TITLE_INDEX_FILE : AUTHOR_INDEX_FILE, index)) {
+    books.close();
+    return {0, 0};
+  }
+
+  const std::string folded = foldCase(prefix);
+  // -1, 0 or 1 as the entry at `position` sorts before, matches or sorts after the prefix
+  auto compareAt = [&](const uint32_t position) {
+    uint32_t offset;
+    Book book;
+    if (!readIndexEntry(index, position, offset) || !readBook(books, offset, book)) {
+      return 1;
+    }
+    const int result = searchKey(order, book).compare(0, folded.size(), folded);
+    return result < 0 ? -1 : (result > 0 ? 1 : 0);
+  };
+
+  uint32_t low = 0;
+  uint32_t high = bookCount;
+  while (low < high) {
+    const uint32_t mid = low + (high - low) / 2;
+    if (compareAt(mid) < 0) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  const uint32_t first = low;
+  high = bookCount;
+  while (low < high) {
+    const uint32_t mid = low + (high - low) / 2;
+    if (compareAt(mid) <= 0) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  index.close();
+  books.close();
+  return {first, low};
+}
+
+bool LibraryCatalog::findBook(const std::string& path, Book& out) {
+  std::lock_guard<std::mutex> lock(mutex);
+  loadCountsLocked();
+  if (!built) {
+    return false;
+  }
+  FsFile books;
+  FsFile pathIndex;
+  if (!Storage.openFileForRead("CAT", BOOKS_FILE, books)) {
+    return false;
+  }
+  if (!Storage.openFileForRead("CAT", PATH_INDEX_FILE, pathIndex)) {
+    books.close();
+    return false;
+  }
+  const bool found = findBookLocked(books, pathIndex, path, out);
+  pathIndex.close();
+  books.close();
+  return found;
+}
+
+bool LibraryCatalog::findBookLocked(FsFile& books, FsFile& pathIndex, const std::string& path, Book& out) {
+  const uint32_t hash = pathHash(path);
+  uint32_t entryHash = 0;
+  uint32_t offset = 0;
+  auto readEntry = [&](const uint32_t position) {
+    return pathIndex.seekSet(INDEX_HEADER_SIZE + position * PATH_ENTRY_SIZE) &&
+           serialization::readPod(pathIndex, entryHash) && serialization::readPod(pathIndex, offset);
+  };
+
+  uint32_t low = 0;
+  uint32_t high = bookCount;
+  while (low < high) {
+    const uint32_t mid = low + (high - low) / 2;
+    if (!readEntry(mid)) {
+      return false;
+    }
+    if (entryHash < hash) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  // Hashes can collide; the record's path decides
+  for (uint32_t position = low; position < bookCount; position++) {
+    if (!readEntry(position) || entryHash != hash) {
+      break;
+    }
+    if (readBook(books, offset, out) && out.path == path) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::vector<std::string> LibraryCatalog::readRecentLocked() {
+  std::vector<std::string> paths;
+  FsFile file;
+  if (!Storage.openFileForRead("CAT", RECENT_FILE, file)) {
+    return paths;
+  }
+  uint32_t count = 0;
+  if (readRecentHeader(file, count)) {
+    paths.reserve(std::min(count, MAX_RECENT));
+    std::string path;
+    for (uint32_t i = 0; i < count && i < MAX_RECENT && serialization::readString(file, path); i++) {
+      paths.push_back(path);
+    }
+  }
+  file.close();
+  return paths;
+}
+
+void LibraryCatalog::writeRecentLocked(const std::vector<std::string>& paths) {
+  Storage.mkdir(CATALOG_DIR);
+  FsFile file;
+  const std::string tmp = tmpPath(RECENT_FILE);
+  if (!Storage.openFileForWrite("CAT", tmp, file)) {
+    return;
+  }
+  const uint32_t count = std::min(static_cast<uint32_t>(paths.size()), MAX_RECENT);
+  serialization::writePod(file, RECENT_FILE_VERSION);
+  serialization::writePod(file, count);
+  for (uint32_t i = 0; i < count; i++) {
+    serialization::writeString(file, paths[i]);
+  }
+  file.close();
+  replaceFile(RECENT_FILE);
+  recentCount = count;
+  generation++;
+}
+
+void LibraryCatalog::markOpened(const std::string& path) {
+  std::lock_guard<std::mutex> lock(mutex);
+  loadCountsLocked();
+  std::vector<std::string> paths = readRecentLocked();
+  const auto it = std::find(paths.begin(), paths.end(), path);
+  if (it == paths.begin() && it != paths.end()) {
+    return;
+  }
+  if (it != paths.end()) {
+    paths.erase(it);
+  }
+  paths.insert(paths.begin(), path);
+  writeRecentLocked(paths);
+}
+
+void LibraryCatalog::seedRecent(const std::vector<std::string>& paths) {
+  std::lock_guard<std::mutex> lock(mutex);
+  loadCountsLocked();
+  if (Storage.exists(RECENT_FILE)) {
+    return;
+  }
+  writeRecentLocked(paths);
+}
+
+std::vector<std::string> LibraryCatalog::getRecentPaths() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return readRecentLocked();
+}
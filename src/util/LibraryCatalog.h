@@ -0,0 +1,108 @@
+#pragma once
+#include <HalStorage.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "util/BookProgressDataStore.h"
+
+// Every book on the card with its title and author, kept on the card itself so the library never has to walk the
+// directories or hold the whole list in RAM.
+//
+// /.crosspoint/catalog/ holds one file of book records and a sorted index file per order: by title, by author and by
+// path hash. An index is an array of fixed-size entries pointing into the records, so showing a page of the library
+// reads that page's entries and records, and a prefix search is a binary search over the index. Neither depends on
+// how many books there are. The recently read list is a short file of paths, most recent first, updated whenever a
+// book is opened.
+//
+// The records are rewritten as a whole by a Builder (see LibraryScanner), which writes next to the current files and
+// swaps them in when done, so the catalog stays readable during a scan. Each file carries the id of the build that
+// wrote it and the catalog only counts as built while all of them agree.
+class LibraryCatalog {
+  // Static instance
+  static LibraryCatalog instance;
+
+ public:
+  enum class Order : uint8_t { Title, Author, Recent };
+
+  struct Book {
+    std::string path;
+    std::string title;
+    std::string author;
+    BookProgressDataStore::BookKind kind = BookProgressDataStore::BookKind::Unknown;
+    uint8_t progress = 0;        // Percent read, 0 if never opened
+    bool hasMetadata = false;    // False if title is only the file name because the book had no readable metadata
+    uint32_t size = 0;           // File size in bytes
+    uint32_t modified = 0;       // FAT date << 16 | FAT time of the last write
+  };
+
+  // Writes a new catalog from scratch. Books may be added in any order; commit() sorts the indexes and replaces the
+  // current catalog. Destroying an uncommitted builder drops what was written.
+  class Builder {
+   public:
+    Builder();
+    ~Builder();
+    Builder(const Builder&) = delete;
+    Builder& operator=(const Builder&) = delete;
+
+    bool add(const Book& book);
+    bool commit();
+
+   private:
+    FsFile booksFile;
+    std::vector<std::pair<uint32_t, uint32_t>> pathEntries;  // path hash, record offset
+    uint32_t buildId = 1;
+    bool ok = false;
+  };
+
+  ~LibraryCatalog() = default;
+
+  // Get singleton instance
+  static LibraryCatalog& getInstance() { return instance; }
+
+  // False until a scan has committed a catalog
+  bool isBuilt();
+  uint32_t count(Order order);
+  // Appends up to `maxCount` books starting at position `first` of `order`. Recent entries for books the catalog does
+  // not know yet come back with the file name as title.
+  bool getBooks(Order order, uint32_t first, uint32_t maxCount, std::vector<Book>& out);
+  // Range [first, last) of positions in `order` whose title (Order::Title) or author (Order::Author) starts with
+  // `prefix`, ignoring ASCII case. Order::Recent is not sorted by name and always returns the whole list.
+  std::pair<uint32_t, uint32_t> findPrefix(Order order, const std::string& prefix);
+  bool findBook(const std::string& path, Book& out);
+
+  // Moves `path` to the front of the recently read list.
+  void markOpened(const std::string& path);
+  // Writes the recently read list if there is none yet (most recent first), so history from before the catalog
+  // existed carries over.
+  void seedRecent(const std::vector<std::string>& paths);
+  std::vector<std::string> getRecentPaths();
+
+  // Bumped whenever the catalog or the recently read list changes, so views know to reload.
+  uint32_t getGeneration() const { return generation.load(); }
+
+  static uint32_t pathHash(const std::string& path);
+  // File name without directory and extension, shown for books without a title
+  static std::string titleFromPath(const std::string& path);
+
+ private:
+  std::mutex mutex;  // guards the files and everything below
+  bool countsLoaded = false;
+  bool built = false;
+  uint32_t bookCount = 0;
+  uint32_t recentCount = 0;
+  std::atomic<uint32_t> generation{0};
+
+  void loadCountsLocked();
+  void invalidateLocked();
+  bool findBookLocked(FsFile& books, FsFile& pathIndex, const std::string& path, Book& out);
+  std::vector<std::string> readRecentLocked();
+  void writeRecentLocked(const std::vector<std::string>& paths);
+};
+
+// Helper macro to access the library catalog
+#define LIBRARY_CATALOG LibraryCatalog::getInstance()
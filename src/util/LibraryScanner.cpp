@@ -0,0 +1,242 @@
+#include "LibraryScanner.h"
+
+#include <HalStorage.h>
+#include <Logging.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "SpiBusMutex.h"
+#include "core/features/FeatureModules.h"
+#include "util/RecentBooksStore.h"
+
+namespace {
+// Below the render and input tasks, like chapter layout: the scan only runs while the device is otherwise idle.
+constexpr UBaseType_t SCAN_TASK_PRIORITY = tskIDLE_PRIORITY;
+constexpr int EXIT_POLL_MS = 10;
+}  // namespace
+
+bool LibraryScanner::start() {
+  if (taskHandle != nullptr) {
+    return true;
+  }
+  exitRequested.store(false);
+  taskHasExited.store(false);
+  if (xTaskCreate(&taskTrampoline, "LibraryScanTask", TASK_STACK_SIZE, this, SCAN_TASK_PRIORITY, &taskHandle) !=
+      pdPASS) {
+    LOG_ERR("LSC", "Failed to create library scan task, catalog will not be refreshed");
+    taskHandle = nullptr;
+    taskHasExited.store(true);
+    return false;
+  }
+  return true;
+}
+
+void LibraryScanner::stop() {
+  if (taskHandle == nullptr) {
+    return;
+  }
+  // Unlike TaskShutdown::requestExit this never deletes the task: it may be inside a book loader holding the SD card
+  // and SPI bus locks, which would then never be released. The scan checks for exit between files, and no file takes
+  // longer than reading its cached metadata.
+  exitRequested.store(true);
+  while (!taskHasExited.load()) {
+    vTaskDelay(pdMS_TO_TICKS(EXIT_POLL_MS));
+  }
+  taskHandle = nullptr;
+}
+
+void LibraryScanner::taskTrampoline(void* param) {
+  auto* self = static_cast<LibraryScanner*>(param);
+  self->taskLoop();
+}
+
+void LibraryScanner::taskLoop() {
+  scan();
+  taskHasExited.store(true);
+  vTaskDelete(nullptr);
+}
+
+bool LibraryScanner::scan() {
+  const unsigned long startMs = millis();
+
+  // History from before the catalog existed
+  std::vector<std::string> recentPaths;
+  for (const auto& book : RECENT_BOOKS.getBooks()) {
+    recentPaths.push_back(book.path);
+  }
+  bool built;
+  {
+    SpiBusMutex::Guard guard;
+    LIBRARY_CATALOG.seedRecent(recentPaths);
+    recentPaths = LIBRARY_CATALOG.getRecentPaths();
+    built = LIBRARY_CATALOG.isBuilt();
+  }
+
+  if (built && catalogUpToDate(recentPaths)) {
+    LOG_DBG("LSC", "Catalog up to date, checked in %lu ms", millis() - startMs);
+    return true;
+  }
+
+  LibraryCatalog::Builder builder;
+  uint32_t bookCount = 0;
+  uint32_t resolved = 0;
+  const bool walked = walkBooks([&](LibraryCatalog::Book& book) {
+    describeBook(book, recentPaths, resolved);
+    builder.add(book);
+    bookCount++;
+    return true;
+  });
+  if (!walked) {
+    LOG_DBG("LSC", "Scan stopped after %lu books", bookCount);
+    return false;
+  }
+
+  bool committed;
+  {
+    SpiBusMutex::Guard guard;
+    committed = builder.commit();
+  }
+  LOG_INF("LSC", "Scanned %lu books (%lu read from their caches) in %lu ms", bookCount, resolved, millis() - startMs);
+  return committed;
+}
+
+bool LibraryScanner::walkBooks(const std::function<bool(LibraryCatalog::Book&)>& visit) const {
+  std::vector<std::string> dirs = {"/"};
+  char name[500];
+
+  while (!dirs.empty()) {
+    const std::string dir = std::move(dirs.back());
+    dirs.pop_back();
+    const std::string prefix = dir == "/" ? dir : dir + "/";
+
+    FsFile root;
+    {
+      SpiBusMutex::Guard guard;
+      root = Storage.open(dir.c_str());
+    }
+    if (!root || !root.isDirectory()) {
+      if (root) root.close();
+      continue;
+    }
+
+    while (true) {
+      if (exitRequested.load()) {
+        root.close();
+        return false;
+      }
+
+      LibraryCatalog::Book book;
+      {
+        SpiBusMutex::Guard guard;
+        auto file = root.openNextFile();
+        if (!file) {
+          break;
+        }
+        file.getName(name, sizeof(name));
+        if (name[0] == '.' || strcmp(name, "System Volume Information") == 0) {
+          file.close();
+          continue;
+        }
+        if (file.isDirectory()) {
+          dirs.push_back(prefix + name);
+          file.close();
+          continue;
+        }
+        book.path = prefix + name;
+        if (!core::FeatureModules::isSupportedLibraryFile(book.path)) {
+          file.close();
+          continue;
+        }
+        uint16_t date = 0;
+        uint16_t time = 0;
+        file.getModifyDateTime(&date, &time);
+        book.size = file.fileSize();
+        book.modified = (static_cast<uint32_t>(date) << 16) | time;
+        file.close();
+      }
+
+      if (!visit(book)) {
+        root.close();
+        return false;
+      }
+    }
+    root.close();
+  }
+  return true;
+}
+
+bool LibraryScanner::catalogUpToDate(const std::vector<std::string>& recentPaths) const {
+  uint32_t bookCount = 0;
+  const bool walked = walkBooks([&](const LibraryCatalog::Book& book) {
+    bookCount++;
+    LibraryCatalog::Book known;
+    {
+      SpiBusMutex::Guard guard;
+      if (!LIBRARY_CATALOG.findBook(book.path, known)) {
+        return false;
+      }
+    }
+    if (known.size != book.size || known.modified != book.modified) {
+      return false;
+    }
+    // Listed under its file name until the reader has cached its metadata
+    if (!known.hasMetadata && !core::FeatureModules::resolveRecentBookData(book.path, true).title.empty()) {
+      return false;
+    }
+    if (std::find(recentPaths.begin(), recentPaths.end(), book.path) != recentPaths.end()) {
+      SpiBusMutex::Guard guard;
+      BookProgressDataStore::ProgressData progress;
+      if (BookProgressDataStore::loadProgress(book.path, progress) &&
+          static_cast<uint8_t>(std::lround(progress.percent)) != known.progress) {
+        return false;
+      }
+    }
+    return true;
+  });
+
+  if (!walked) {
+    return false;
+  }
+  // Books removed from the card
+  SpiBusMutex::Guard guard;
+  return LIBRARY_CATALOG.count(LibraryCatalog::Order::Title) == bookCount;
+}
+
+void LibraryScanner::describeBook(LibraryCatalog::Book& book, const std::vector<std::string>& recentPaths,
+                                  uint32_t& resolved) const {
+  book.kind = BookProgressDataStore::kindForPath(book.path);
+
+  LibraryCatalog::Book known;
+  bool found;
+  {
+    SpiBusMutex::Guard guard;
+    found = LIBRARY_CATALOG.findBook(book.path, known);
+  }
+  if (found && known.hasMetadata && known.size == book.size && known.modified == book.modified) {
+    book.title = std::move(known.title);
+    book.author = std::move(known.author);
+    book.hasMetadata = true;
+    book.progress = known.progress;
+  } else {
+    // Cache only: the loaders take the bus themselves, for as long as reading the cache takes
+    const auto data = core::FeatureModules::resolveRecentBookData(book.path, true);
+    book.hasMetadata = !data.title.empty();
+    book.title = book.hasMetadata ? data.title : LibraryCatalog::titleFromPath(book.path);
+    book.author = data.author;
+    book.progress = found ? known.progress : 0;
+    if (book.hasMetadata) {
+      resolved++;
+    }
+  }
+
+  // Only books that have been opened have progress; reading moves it without touching the file
+  if (std::find(recentPaths.begin(), recentPaths.end(), book.path) != recentPaths.end()) {
+    SpiBusMutex::Guard guard;
+    BookProgressDataStore::ProgressData progress;
+    if (BookProgressDataStore::loadProgress(book.path, progress)) {
+      book.progress = static_cast<uint8_t>(std::lround(progress.percent));
+    }
+  }
+}
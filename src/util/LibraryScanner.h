@@ -0,0 +1,51 @@
+#pragma once
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "util/LibraryCatalog.h"
+
+// Walks the whole card in the background and rebuilds the library catalog from what it finds.
+//
+// A first pass only compares what it finds with the catalog and stops at the first difference, so while nothing on
+// the card has changed a scan reads the directories and writes nothing. Otherwise the catalog is rebuilt: books whose
+// size and modification time match their catalog record keep the title and author recorded there, so only new and
+// changed files are opened. Metadata comes from the cache the reader builds when a
+// book is first opened; the scan never builds it itself, since parsing a package document holds the card for the
+// whole parse while the library is on screen. Until then a book is listed under its file name, and the next scan
+// picks up the real title.
+class LibraryScanner {
+ public:
+  LibraryScanner() = default;
+  ~LibraryScanner() { stop(); }
+  LibraryScanner(const LibraryScanner&) = delete;
+  LibraryScanner& operator=(const LibraryScanner&) = delete;
+
+  // Starts one scan; the task ends by itself once the catalog is committed.
+  bool start();
+  void stop();
+  bool isRunning() const { return !taskHasExited.load(); }
+
+ private:
+  // Loading an EPUB's cached metadata runs on this stack
+  static constexpr uint32_t TASK_STACK_SIZE = 8192;
+
+  std::atomic<bool> exitRequested{false};
+  std::atomic<bool> taskHasExited{true};
+  TaskHandle_t taskHandle = nullptr;
+
+  static void taskTrampoline(void* param);
+  void taskLoop();
+  bool scan();
+  // Calls visit for every supported book on the card, with its path, size and modification time filled in. False if
+  // visit returned false or the scan was stopped.
+  bool walkBooks(const std::function<bool(LibraryCatalog::Book&)>& visit) const;
+  // True if every book matches its catalog record, including progress and newly cached metadata, and none is missing.
+  bool catalogUpToDate(const std::vector<std::string>& recentPaths) const;
+  void describeBook(LibraryCatalog::Book& book, const std::vector<std::string>& recentPaths, uint32_t& resolved) const;
+};
@@ -8,6 +8,7 @@
 #include <algorithm>
 
 #include "core/features/FeatureModules.h"
+#include "util/LibraryCatalog.h"
 
 namespace {
 constexpr uint8_t RECENT_BOOKS_FILE_VERSION = 3;
@@ -37,6 +38,7 @@ void RecentBooksStore::addBook(const std::string& path, const std::string& title
   }
 
   saveToFile();
+  LIBRARY_CATALOG.markOpened(path);
 }
 
 void RecentBooksStore::updateBook(const std::string& path, const std::string& title, const std::string& author,
@@ -0,0 +1,229 @@
+#include "SectionCacheStore.h"
+
+#include <HalStorage.h>
+#include <Logging.h>
+#include <Serialization.h>
+#include <SpiBusMutex.h>
+
+#include <algorithm>
+
+#include "CrossPointSettings.h"
+
+namespace {
+constexpr uint8_t SECTION_CACHE_FILE_VERSION = 1;
+constexpr char SECTION_CACHE_FILE[] = "/.crosspoint/section_cache.bin";
+constexpr char CACHE_ROOT[] = "/.crosspoint";
+
+// Names of the entries directly inside dir, split into subdirectories and files
+void listDir(const std::string& dir, std::vector<std::string>& subdirs, std::vector<std::string>& files) {
+  auto root = Storage.open(dir.c_str());
+  if (!root || !root.isDirectory()) {
+    if (root) {
+      root.close();
+    }
+    return;
+  }
+
+  char name[128];
+  for (auto file = root.openNextFile(); file; file = root.openNextFile()) {
+    file.getName(name, sizeof(name));
+    (file.isDirectory() ? subdirs : files).emplace_back(name);
+    file.close();
+  }
+  root.close();
+}
+
+uint32_t directorySize(const std::string& dir) {
+  auto root = Storage.open(dir.c_str());
+  if (!root || !root.isDirectory()) {
+    if (root) {
+      root.close();
+    }
+    return 0;
+  }
+
+  uint64_t total = 0;
+  for (auto file = root.openNextFile(); file; file = root.openNextFile()) {
+    if (!file.isDirectory()) {
+      total += file.size();
+    }
+    file.close();
+  }
+  root.close();
+  return total > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(total);
+}
+}  // namespace
+
+SectionCacheStore SectionCacheStore::instance;
+
+void SectionCacheStore::touch(const std::string& profileDir) {
+  SpiBusMutex::Guard guard;
+  ensureLoaded();
+  Entry* entry = find(profileDir);
+  if (!entry) {
+    entries.push_back({profileDir, 0, 0});
+    entry = &entries.back();
+  }
+  entry->lastUsed = ++useCounter;
+  activeDir = profileDir;
+  saveToFile();
+}
+
+void SectionCacheStore::release(const std::string& profileDir) {
+  SpiBusMutex::Guard guard;
+  ensureLoaded();
+  if (Entry* entry = find(profileDir)) {
+    if (Storage.exists(profileDir.c_str())) {
+      entry->bytes = directorySize(profileDir);
+    } else {
+      // The book's cache was deleted while it was open
+      entries.erase(entries.begin() + (entry - entries.data()));
+    }
+  }
+
+  const uint32_t limit = SETTINGS.getSectionCacheLimitBytes();
+  if (limit != 0) {
+    evictOver(limit, profileDir);
+  }
+  if (activeDir == profileDir) {
+    activeDir.clear();
+  }
+  saveToFile();
+  LOG_DBG("SCS", "Section cache: %u profiles, %llu bytes", static_cast<unsigned>(entries.size()),
+          static_cast<unsigned long long>(getTotalBytes()));
+}
+
+uint64_t SectionCacheStore::getTotalBytes() const {
+  uint64_t total = 0;
+  for (const auto& entry : entries) {
+    total += entry.bytes;
+  }
+  return total;
+}
+
+void SectionCacheStore::evictOver(const uint32_t limitBytes, const std::string& keepDir) {
+  uint64_t total = getTotalBytes();
+  if (total <= limitBytes) {
+    return;
+  }
+
+  std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.lastUsed < b.lastUsed; });
+  auto it = entries.begin();
+  while (total > limitBytes && it != entries.end()) {
+    // The profile being read is still open, and the layout queue may be writing into it
+    if (it->dir == keepDir || it->dir == activeDir) {
+      ++it;
+      continue;
+    }
+    LOG_DBG("SCS", "Evicting %s (%lu bytes)", it->dir.c_str(), static_cast<unsigned long>(it->bytes));
+    if (Storage.exists(it->dir.c_str()) && !Storage.removeDir(it->dir.c_str())) {
+      LOG_ERR("SCS", "Failed to evict %s", it->dir.c_str());
+      ++it;
+      continue;
+    }
+    total -= it->bytes;
+    it = entries.erase(it);
+  }
+}
+
+void SectionCacheStore::reset() {
+  SpiBusMutex::Guard guard;
+  entries.clear();
+  useCounter = 0;
+  loaded = false;
+  Storage.remove(SECTION_CACHE_FILE);
+}
+
+SectionCacheStore::Entry* SectionCacheStore::find(const std::string& dir) {
+  const auto it = std::find_if(entries.begin(), entries.end(), [&](const Entry& entry) { return entry.dir == dir; });
+  return it != entries.end() ? &*it : nullptr;
+}
+
+void SectionCacheStore::ensureLoaded() {
+  if (loaded) {
+    return;
+  }
+  loaded = true;
+  if (!loadFromFile()) {
+    scanCacheDirs();
+    saveToFile();
+  }
+}
+
+void SectionCacheStore::scanCacheDirs() {
+  entries.clear();
+  useCounter = 0;
+
+  std::vector<std::string> books;
+  std::vector<std::string> ignored;
+  listDir(CACHE_ROOT, books, ignored);
+  for (const auto& book : books) {
+    if (book.rfind("epub_", 0) != 0) {
+      continue;
+    }
+
+    const std::string sectionsDir = std::string(CACHE_ROOT) + "/" + book + "/sections";
+    std::vector<std::string> profiles;
+    std::vector<std::string> looseFiles;
+    listDir(sectionsDir, profiles, looseFiles);
+    for (const auto& profile : profiles) {
+      const std::string dir = sectionsDir + "/" + profile;
+      entries.push_back({dir, directorySize(dir), 0});
+    }
+    // Section files from before layout profiles had their own directories are never read again
+    for (const auto& file : looseFiles) {
+      Storage.remove((sectionsDir + "/" + file).c_str());
+    }
+  }
+  LOG_DBG("SCS", "Scanned section cache: %u profiles, %llu bytes", static_cast<unsigned>(entries.size()),
+          static_cast<unsigned long long>(getTotalBytes()));
+}
+
+bool SectionCacheStore::saveToFile() const {
+  FsFile file;
+  if (!Storage.openFileForWrite("SCS", SECTION_CACHE_FILE, file)) {
+    return false;
+  }
+  serialization::writePod(file, SECTION_CACHE_FILE_VERSION);
+  serialization::writePod(file, useCounter);
+  serialization::writePod(file, static_cast<uint16_t>(entries.size()));
+  for (const auto& entry : entries) {
+    serialization::writeString(file, entry.dir);
+    serialization::writePod(file, entry.bytes);
+    serialization::writePod(file, entry.lastUsed);
+  }
+  file.close();
+  return true;
+}
+
+bool SectionCacheStore::loadFromFile() {
+  FsFile file;
+  if (!Storage.openFileForRead("SCS", SECTION_CACHE_FILE, file)) {
+    return false;
+  }
+
+  uint8_t version = 0;
+  uint16_t count = 0;
+  if (!serialization::readPod(file, version) || version != SECTION_CACHE_FILE_VERSION ||
+      !serialization::readPod(file, useCounter) || !serialization::readPod(file, count)) {
+    LOG_ERR("SCS", "Deserialization failed: bad header");
+    file.close();
+    return false;
+  }
+
+  entries.clear();
+  entries.reserve(count);
+  for (uint16_t i = 0; i < count; i++) {
+    Entry entry;
+    if (!serialization::readString(file, entry.dir) || !serialization::readPod(file, entry.bytes) ||
+        !serialization::readPod(file, entry.lastUsed)) {
+      LOG_ERR("SCS", "Deserialization failed: truncated entry %u", i);
+      entries.clear();
+      file.close();
+      return false;
+    }
+    entries.push_back(std::move(entry));
+  }
+  file.close();
+  return true;
+}
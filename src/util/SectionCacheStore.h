@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Keeps the laid-out EPUB chapters on the SD card within SETTINGS.getSectionCacheLimitBytes().
+//
+// Every book keeps one directory of section files per layout profile (see Section::profileDir), so returning to an
+// earlier font or orientation reuses its chapters. The store remembers how large each profile directory is and when
+// it was last read, and once the total goes over the limit removes the least recently read ones. Progress, book
+// metadata and covers live outside these directories and are never evicted.
+class SectionCacheStore {
+  // Static instance
+  static SectionCacheStore instance;
+
+  struct Entry {
+    std::string dir;
+    uint32_t bytes = 0;
+    uint32_t lastUsed = 0;  // useCounter at the last touch(), 0 if never read since the store was created
+  };
+
+  std::vector<Entry> entries;
+  // Bumped on every touch(); an ordering, not a clock, so it works without the RTC being set
+  uint32_t useCounter = 0;
+  // The profile touch()ed last and not released yet; never evicted
+  std::string activeDir;
+  bool loaded = false;
+
+ public:
+  ~SectionCacheStore() = default;
+
+  // Get singleton instance
+  static SectionCacheStore& getInstance() { return instance; }
+
+  // Marks profileDir as the profile being read now. Touch a new profile before releasing the old one so that the
+  // eviction the release runs cannot remove it.
+  void touch(const std::string& profileDir);
+
+  // Measures profileDir once reading with it has stopped, then evicts other profiles, least recently read first,
+  // until the total fits the limit. Neither profileDir nor the profile being read is evicted.
+  void release(const std::string& profileDir);
+
+  uint64_t getTotalBytes() const;
+
+  // Forgets everything after the cache directories were removed wholesale; the next use rescans the card.
+  void reset();
+
+ private:
+  void ensureLoaded();
+  bool loadFromFile();
+  bool saveToFile() const;
+  // Builds the store from the directories on the card; profiles found this way count as least recently read.
+  void scanCacheDirs();
+  Entry* find(const std::string& dir);
+  void evictOver(uint32_t limitBytes, const std::string& keepDir);
+};
+
+// Helper macro to access the section cache store
+#define SECTION_CACHE SectionCacheStore::getInstance()
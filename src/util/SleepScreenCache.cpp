@@ -0,0 +1,194 @@
+#include "SleepScreenCache.h"
+
+#include <GfxRenderer.h>
+#include <Logging.h>
+#include <Serialization.h>
+
+#include <cstdio>
+
+#include "CrossPointSettings.h"
+
+namespace {
+constexpr uint8_t SLEEP_SCREEN_CACHE_VERSION = 2;
+constexpr char CACHE_DIR[] = "/.crosspoint/sleep_native";
+// Each slot is one BW and two gray planes (~144 KB on the X4), so the directory stays under 5 MB
+constexpr uint32_t SLOT_COUNT = 32;
+
+// Everything the planes depend on besides the pixels of the source image
+struct Header {
+  uint8_t planeCount = 0;
+  uint8_t orientation = 0;
+  uint8_t coverMode = 0;
+  uint8_t coverFilter = 0;
+  uint32_t sourceSize = 0;
+  uint32_t sourceModified = 0;  // FAT date << 16 | FAT time of the source's last write
+  uint32_t planeSize = 0;
+  std::string sourcePath;
+};
+
+std::string slotPath(const std::string& sourcePath) {
+  uint32_t hash = 2166136261u;
+  for (const char c : sourcePath) {
+    hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+  }
+  char name[16];
+  snprintf(name, sizeof(name), "/%02lu.bin", static_cast<unsigned long>(hash % SLOT_COUNT));
+  return std::string(CACHE_DIR) + name;
+}
+
+// Size and modify time of the source, so an image replaced under the same name is not shown from the cache. Both
+// stay 0 if the source cannot be opened, which never matches a written header.
+void readSourceStamp(const std::string& sourcePath, Header& header) {
+  FsFile source;
+  if (!Storage.openFileForRead("SLC", sourcePath, source)) {
+    return;
+  }
+  uint16_t date = 0;
+  uint16_t time = 0;
+  source.getModifyDateTime(&date, &time);
+  header.sourceSize = source.size();
+  header.sourceModified = (static_cast<uint32_t>(date) << 16) | time;
+  source.close();
+}
+
+Header currentHeader(const GfxRenderer& renderer, const std::string& sourcePath, const uint8_t planeCount) {
+  Header header;
+  header.planeCount = planeCount;
+  header.orientation = static_cast<uint8_t>(renderer.getOrientation());
+  header.coverMode = SETTINGS.sleepScreenCoverMode;
+  header.coverFilter = SETTINGS.sleepScreenCoverFilter;
+  readSourceStamp(sourcePath, header);
+  header.planeSize = renderer.getBufferSize();
+  header.sourcePath = sourcePath;
+  return header;
+}
+
+bool readHeader(FsFile& file, Header& header) {
+  uint8_t version = 0;
+  return serialization::readPod(file, version) && version == SLEEP_SCREEN_CACHE_VERSION &&
+         serialization::readPod(file, header.planeCount) && serialization::readPod(file, header.orientation) &&
+         serialization::readPod(file, header.coverMode) && serialization::readPod(file, header.coverFilter) &&
+         serialization::readPod(file, header.sourceSize) && serialization::readPod(file, header.sourceModified) &&
+         serialization::readPod(file, header.planeSize) && serialization::readString(file, header.sourcePath);
+}
+
+void writeHeader(FsFile& file, const Header& header) {
+  serialization::writePod(file, SLEEP_SCREEN_CACHE_VERSION);
+  serialization::writePod(file, header.planeCount);
+  serialization::writePod(file, header.orientation);
+  serialization::writePod(file, header.coverMode);
+  serialization::writePod(file, header.coverFilter);
+  serialization::writePod(file, header.sourceSize);
+  serialization::writePod(file, header.sourceModified);
+  serialization::writePod(file, header.planeSize);
+  serialization::writeString(file, header.sourcePath);
+}
+
+bool readPlane(FsFile& file, GfxRenderer& renderer) {
+  const size_t size = renderer.getBufferSize();
+  return file.read(renderer.getFrameBuffer(), size) == static_cast<int>(size);
+}
+}  // namespace
+
+bool SleepScreenCache::show(GfxRenderer& renderer, const std::string& sourcePath) {
+  const std::string path = slotPath(sourcePath);
+  if (!Storage.exists(path.c_str())) {
+    return false;
+  }
+  FsFile file;
+  if (!Storage.openFileForRead("SLC", path, file)) {
+    return false;
+  }
+
+  Header header;
+  if (!readHeader(file, header) || (header.planeCount != 1 && header.planeCount != 3)) {
+    file.close();
+    return false;
+  }
+  const Header expected = currentHeader(renderer, sourcePath, header.planeCount);
+  if (header.sourcePath != expected.sourcePath || header.sourceSize != expected.sourceSize ||
+      header.sourceModified != expected.sourceModified || header.orientation != expected.orientation ||
+      header.coverMode != expected.coverMode || header.coverFilter != expected.coverFilter ||
+      header.planeSize != expected.planeSize) {
+    file.close();
+    LOG_DBG("SLC", "No cached sleep screen for %s", sourcePath.c_str());
+    return false;
+  }
+
+  if (!readPlane(file, renderer)) {
+    file.close();
+    LOG_ERR("SLC", "Cached sleep screen truncated, removing");
+    Storage.remove(path.c_str());
+    return false;
+  }
+  renderer.displayBuffer(HalDisplay::HALF_REFRESH);
+
+  if (header.planeCount == 3) {
+    // The BW image is already up; a damaged file only costs the gray levels
+    if (readPlane(file, renderer)) {
+      renderer.copyGrayscaleLsbBuffers();
+      if (readPlane(file, renderer)) {
+        renderer.copyGrayscaleMsbBuffers();
+        renderer.displayGrayBuffer();
+      } else {
+        LOG_ERR("SLC", "Cached sleep screen truncated, removing");
+        Storage.remove(path.c_str());
+      }
+    } else {
+      LOG_ERR("SLC", "Cached sleep screen truncated, removing");
+      Storage.remove(path.c_str());
+    }
+  }
+  file.close();
+  LOG_DBG("SLC", "Showed cached sleep screen for %s", sourcePath.c_str());
+  return true;
+}
+
+void SleepScreenCache::clear() {
+  if (Storage.exists(CACHE_DIR)) {
+    Storage.removeDir(CACHE_DIR);
+  }
+}
+
+SleepScreenCache::Writer::Writer(const GfxRenderer& renderer, const std::string& sourcePath, const uint8_t planeCount)
+    : renderer(renderer), path(slotPath(sourcePath)), tmpPath(path + ".tmp"), planeCount(planeCount) {
+  Storage.mkdir(CACHE_DIR);
+  if (!Storage.openFileForWrite("SLC", tmpPath, file)) {
+    return;
+  }
+  writeHeader(file, currentHeader(renderer, sourcePath, planeCount));
+  ok = true;
+}
+
+SleepScreenCache::Writer::~Writer() {
+  if (file) {
+    file.close();
+    Storage.remove(tmpPath.c_str());
+  }
+}
+
+void SleepScreenCache::Writer::addPlane() {
+  if (!ok) {
+    return;
+  }
+  const size_t size = renderer.getBufferSize();
+  ok = planesWritten < planeCount && file.write(renderer.getFrameBuffer(), size) == size;
+  planesWritten++;
+}
+
+void SleepScreenCache::Writer::commit() {
+  if (!file) {
+    return;
+  }
+  file.close();
+  if (!ok || planesWritten != planeCount) {
+    LOG_ERR("SLC", "Failed to cache sleep screen");
+    Storage.remove(tmpPath.c_str());
+    return;
+  }
+  Storage.remove(path.c_str());
+  if (!Storage.rename(tmpPath.c_str(), path.c_str())) {
+    LOG_ERR("SLC", "Failed to store cached sleep screen %s", path.c_str());
+    Storage.remove(tmpPath.c_str());
+  }
+}
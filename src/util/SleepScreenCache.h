@@ -0,0 +1,48 @@
+#pragma once
+#include <HalStorage.h>
+
+#include <cstdint>
+#include <string>
+
+class GfxRenderer;
+
+// Sleep screens stored the way the panel takes them, so an image is only decoded, scaled and dithered the first time
+// it is shown.
+//
+// A cache file holds the BW plane and, for grayscale images, the LSB and MSB planes byte for byte as they were in the
+// framebuffer during the first render: already rotated, scaled, cropped and filtered. Showing the image again reads
+// each plane straight into the framebuffer. Files live in /.crosspoint/sleep_native/ in a fixed number of slots picked
+// by a hash of the source path, so the directory stays bounded however many sleep images there are.
+class SleepScreenCache {
+ public:
+  // Displays the cached screen for sourcePath and returns true, or returns false before anything was displayed if there
+  // is no file for it matching the source size and modify time, orientation and cover settings. The framebuffer is
+  // undefined on false.
+  static bool show(GfxRenderer& renderer, const std::string& sourcePath);
+
+  // Removes every cache file; called when sleep images may have been replaced.
+  static void clear();
+
+  // Records a first render: construct before drawing, call addPlane() after each pass has been drawn into the
+  // framebuffer (BW, then LSB and MSB if planeCount is 3), then commit(). Destroying an uncommitted writer drops the
+  // partial file.
+  class Writer {
+   public:
+    Writer(const GfxRenderer& renderer, const std::string& sourcePath, uint8_t planeCount);
+    ~Writer();
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    void addPlane();
+    void commit();
+
+   private:
+    const GfxRenderer& renderer;
+    std::string path;
+    std::string tmpPath;
+    FsFile file;
+    uint8_t planeCount;
+    uint8_t planesWritten = 0;
+    bool ok = false;
+  };
+};
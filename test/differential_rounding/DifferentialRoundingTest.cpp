@@ -94,6 +94,7 @@ static const EpdFontData kTestFontData = {
   .kernRightClassCount = 2,
   .ligaturePairs     = nullptr,
   .ligaturePairCount = 0,
+  .groupSource       = nullptr,
 };
 // clang-format on
 
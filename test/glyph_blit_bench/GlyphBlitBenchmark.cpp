@@ -0,0 +1,237 @@
+// Host microbenchmark for GlyphBlitter: renders a full page of Bookerly 14 in every orientation and render mode,
+// once through the legacy per-pixel drawPixel() path and once through the span blitter, checks that both produce
+// identical framebuffers and reports the per-page time of each.
+
+#include <EpdFont.h>
+#include <FontDecompressor.h>
+#include <GlyphBlitter.h>
+#include <Utf8.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "lib/EpdFont/builtinFonts/bookerly_14_regular.h"
+
+MockESP ESP;
+
+namespace {
+
+constexpr uint16_t PANEL_WIDTH = 800;
+constexpr uint16_t PANEL_HEIGHT = 480;
+constexpr uint16_t PANEL_WIDTH_BYTES = PANEL_WIDTH / 8;
+constexpr uint32_t BUFFER_SIZE = PANEL_WIDTH_BYTES * PANEL_HEIGHT;
+constexpr int MARGIN = 12;
+constexpr int ITERATIONS = 2000;
+
+const char* const SAMPLE_TEXT =
+    "It is a truth universally acknowledged, that a single man in possession of a good fortune, must be in want of "
+    "a wife. However little known the feelings or views of such a man may be on his first entering a neighbourhood, "
+    "this truth is so well fixed in the minds of the surrounding families, that he is considered the rightful "
+    "property of some one or other of their daughters. \"My dear Mr. Bennet,\" said his lady to him one day, \"have "
+    "you heard that Netherfield Park is let at last?\" Mr. Bennet replied that he had not. \"But it is,\" returned "
+    "she; \"for Mrs. Long has just been here, and she told me all about it.\" Mr. Bennet made no answer. \"Do you not "
+    "want to know who has taken it?\" cried his wife impatiently. \"You want to tell me, and I have no objection to "
+    "hearing it.\" This was invitation enough. ";
+
+struct PlacedGlyph {
+  const uint8_t* bitmap;
+  uint8_t width;
+  uint8_t height;
+  int x0;  // logical top-left
+  int y0;
+};
+
+const char* orientationName(const GfxRenderer::Orientation o) {
+  switch (o) {
+    case GfxRenderer::Portrait:
+      return "Portrait";
+    case GfxRenderer::LandscapeClockwise:
+      return "LandscapeCW";
+    case GfxRenderer::PortraitInverted:
+      return "PortraitInverted";
+    case GfxRenderer::LandscapeCounterClockwise:
+      return "LandscapeCCW";
+  }
+  return "?";
+}
+
+const char* modeName(const GfxRenderer::RenderMode m) {
+  switch (m) {
+    case GfxRenderer::BW:
+      return "BW";
+    case GfxRenderer::GRAYSCALE_LSB:
+      return "LSB";
+    case GfxRenderer::GRAYSCALE_MSB:
+      return "MSB";
+  }
+  return "?";
+}
+
+// Greedy word wrap of SAMPLE_TEXT (repeated) until the logical page is full.
+std::vector<PlacedGlyph> layoutPage(const EpdFont& font, FontDecompressor& decompressor, const int screenW,
+                                    const int screenH) {
+  std::vector<PlacedGlyph> out;
+  const EpdFontData* data = font.data;
+  const int lineHeight = data->advanceY;
+  int baseline = MARGIN + data->ascender;
+  int x = MARGIN;
+  const int spaceAdvance = fp4::toPixel(font.getGlyph(' ')->advanceX);
+
+  while (baseline + data->descender <= screenH - MARGIN) {
+    const char* p = SAMPLE_TEXT;
+    while (*p && baseline + data->descender <= screenH - MARGIN) {
+      const char* wordEnd = strchr(p, ' ');
+      if (!wordEnd) wordEnd = p + strlen(p);
+      const std::string word(p, wordEnd);
+      p = *wordEnd ? wordEnd + 1 : wordEnd;
+
+      int w = 0, h = 0;
+      font.getTextDimensions(word.c_str(), &w, &h);
+      if (x + w > screenW - MARGIN) {
+        x = MARGIN;
+        baseline += lineHeight;
+        if (baseline + data->descender > screenH - MARGIN) break;
+      }
+
+      const uint8_t* cursor = reinterpret_cast<const uint8_t*>(word.c_str());
+      uint32_t cp, prevCp = 0;
+      int32_t prevAdvanceFP = 0;
+      while ((cp = utf8NextCodepoint(&cursor))) {
+        if (prevCp != 0) x += fp4::toPixel(prevAdvanceFP + font.getKerning(prevCp, cp));
+        const EpdGlyph* glyph = font.getGlyph(cp);
+        if (!glyph) continue;
+        const uint32_t glyphIndex = static_cast<uint32_t>(glyph - data->glyph);
+        const uint8_t* bitmap = decompressor.getBitmap(data, glyph, glyphIndex);
+        if (bitmap && glyph->width > 0 && glyph->height > 0) {
+          out.push_back({bitmap, glyph->width, glyph->height, x + glyph->left, baseline - glyph->top});
+        }
+        prevAdvanceFP = glyph->advanceX;
+        prevCp = cp;
+      }
+      x += fp4::toPixel(prevAdvanceFP) + spaceAdvance;
+    }
+  }
+  return out;
+}
+
+// Verbatim copy of the pre-blitter GfxRenderer path: rotateCoordinates + bounds check + bit math per set pixel.
+struct LegacyRenderer {
+  uint8_t* frameBuffer;
+  GfxRenderer::Orientation orientation;
+
+  void drawPixel(const int x, const int y, const bool state) const {
+    int phyX = 0, phyY = 0;
+    switch (orientation) {
+      case GfxRenderer::Portrait:
+        phyX = y;
+        phyY = PANEL_HEIGHT - 1 - x;
+        break;
+      case GfxRenderer::LandscapeClockwise:
+        phyX = PANEL_WIDTH - 1 - x;
+        phyY = PANEL_HEIGHT - 1 - y;
+        break;
+      case GfxRenderer::PortraitInverted:
+        phyX = PANEL_WIDTH - 1 - y;
+        phyY = x;
+        break;
+      case GfxRenderer::LandscapeCounterClockwise:
+        phyX = x;
+        phyY = y;
+        break;
+    }
+    if (phyX < 0 || phyX >= PANEL_WIDTH || phyY < 0 || phyY >= PANEL_HEIGHT) return;
+    const uint32_t byteIndex = static_cast<uint32_t>(phyY) * PANEL_WIDTH_BYTES + (phyX / 8);
+    const uint8_t bitPosition = 7 - (phyX % 8);
+    if (state) {
+      frameBuffer[byteIndex] &= ~(1 << bitPosition);
+    } else {
+      frameBuffer[byteIndex] |= 1 << bitPosition;
+    }
+  }
+
+  void drawGlyph(const PlacedGlyph& g, const GfxRenderer::RenderMode renderMode) const {
+    int pixelPosition = 0;
+    for (int glyphY = 0; glyphY < g.height; glyphY++) {
+      for (int glyphX = 0; glyphX < g.width; glyphX++, pixelPosition++) {
+        const uint8_t byte = g.bitmap[pixelPosition >> 2];
+        const uint8_t bitIndex = (3 - (pixelPosition & 3)) * 2;
+        const uint8_t bmpVal = 3 - ((byte >> bitIndex) & 0x3);
+        if (renderMode == GfxRenderer::BW && bmpVal < 3) {
+          drawPixel(g.x0 + glyphX, g.y0 + glyphY, true);
+        } else if (renderMode == GfxRenderer::GRAYSCALE_MSB && (bmpVal == 1 || bmpVal == 2)) {
+          drawPixel(g.x0 + glyphX, g.y0 + glyphY, false);
+        } else if (renderMode == GfxRenderer::GRAYSCALE_LSB && bmpVal == 1) {
+          drawPixel(g.x0 + glyphX, g.y0 + glyphY, false);
+        }
+      }
+    }
+  }
+};
+
+template <typename Fn>
+double timePerPageUs(Fn&& renderPage) {
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < ITERATIONS; i++) renderPage();
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(end - start).count() / ITERATIONS;
+}
+
+}  // namespace
+
+int main() {
+  const EpdFont font(&bookerly_14_regular);
+  FontDecompressor decompressor;
+  decompressor.init();
+  if (decompressor.prewarmCache(&bookerly_14_regular, SAMPLE_TEXT) != 0) {
+    fprintf(stderr, "Failed to prewarm Bookerly 14 glyphs\n");
+    return 1;
+  }
+
+  std::vector<uint8_t> legacyFb(BUFFER_SIZE), blitFb(BUFFER_SIZE);
+  const GlyphBlitter::Target target{blitFb.data(), PANEL_WIDTH, PANEL_HEIGHT, PANEL_WIDTH_BYTES};
+  const GfxRenderer::Orientation orientations[] = {GfxRenderer::Portrait, GfxRenderer::LandscapeClockwise,
+                                                   GfxRenderer::PortraitInverted,
+                                                   GfxRenderer::LandscapeCounterClockwise};
+  const GfxRenderer::RenderMode modes[] = {GfxRenderer::BW, GfxRenderer::GRAYSCALE_LSB, GfxRenderer::GRAYSCALE_MSB};
+
+  int failures = 0;
+  printf("Bookerly 14, %d iterations per case\n", ITERATIONS);
+  printf("%-18s %-4s %7s %12s %12s %8s\n", "orientation", "mode", "glyphs", "legacy_us", "blit_us", "speedup");
+
+  for (const auto orientation : orientations) {
+    const bool transposed = orientation == GfxRenderer::Portrait || orientation == GfxRenderer::PortraitInverted;
+    const int screenW = transposed ? PANEL_HEIGHT : PANEL_WIDTH;
+    const int screenH = transposed ? PANEL_WIDTH : PANEL_HEIGHT;
+    const auto page = layoutPage(font, decompressor, screenW, screenH);
+    const LegacyRenderer legacy{legacyFb.data(), orientation};
+
+    for (const auto mode : modes) {
+      const uint8_t clearValue = mode == GfxRenderer::BW ? 0xFF : 0x00;
+
+      const double legacyUs = timePerPageUs([&]() {
+        memset(legacyFb.data(), clearValue, BUFFER_SIZE);
+        for (const auto& g : page) legacy.drawGlyph(g, mode);
+      });
+      const double blitUs = timePerPageUs([&]() {
+        memset(blitFb.data(), clearValue, BUFFER_SIZE);
+        for (const auto& g : page) {
+          GlyphBlitter::draw(target, orientation, mode, true, g.bitmap, g.width, g.height, g.x0, g.y0, true);
+        }
+      });
+
+      const bool identical = memcmp(legacyFb.data(), blitFb.data(), BUFFER_SIZE) == 0;
+      if (!identical) failures++;
+      printf("%-18s %-4s %7zu %12.1f %12.1f %7.2fx%s\n", orientationName(orientation), modeName(mode), page.size(),
+             legacyUs, blitUs, legacyUs / blitUs, identical ? "" : "  MISMATCH");
+    }
+  }
+
+  if (failures > 0) {
+    fprintf(stderr, "%d case(s) produced a different framebuffer than the legacy path\n", failures);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,166 @@
+#include "doctest/doctest.h"
+#include "src/util/LibraryCatalog.h"
+#include "test/mock/HalStorage.h"
+#include <string>
+#include <vector>
+
+namespace {
+LibraryCatalog::Book makeBook(const std::string& path, const std::string& title, const std::string& author) {
+  LibraryCatalog::Book book;
+  book.path = path;
+  book.title = title;
+  book.author = author;
+  book.kind = BookProgressDataStore::kindForPath(path);
+  book.hasMetadata = true;
+  book.size = static_cast<uint32_t>(path.size());
+  return book;
+}
+
+void buildCatalog(const std::vector<LibraryCatalog::Book>& books) {
+  LibraryCatalog::Builder builder;
+  for (const auto& book : books) {
+    CHECK(builder.add(book));
+  }
+  CHECK(builder.commit());
+}
+
+std::vector<std::string> titles(LibraryCatalog::Order order, uint32_t first, uint32_t count) {
+  std::vector<LibraryCatalog::Book> books;
+  CHECK(LIBRARY_CATALOG.getBooks(order, first, count, books));
+  std::vector<std::string> result;
+  for (const auto& book : books) {
+    result.push_back(book.title);
+  }
+  return result;
+}
+}  // namespace
+
+TEST_CASE("testLibraryCatalogSortsByTitleAndAuthor") {
+  Storage.reset();
+
+  buildCatalog({
+      makeBook("/b/dune.epub", "Dune", "Frank Herbert"),
+      makeBook("/a/emma.epub", "emma", "Jane Austen"),
+      makeBook("/notes.txt", "notes", ""),
+      makeBook("/c/persuasion.epub", "Persuasion", "Jane Austen"),
+      makeBook("/c/children.epub", "Children of Dune", "Frank Herbert"),
+  });
+
+  CHECK(LIBRARY_CATALOG.isBuilt());
+  CHECK(LIBRARY_CATALOG.count(LibraryCatalog::Order::Title) == 5);
+
+  const std::vector<std::string> byTitle = {"Children of Dune", "Dune", "emma", "notes", "Persuasion"};
+  CHECK(titles(LibraryCatalog::Order::Title, 0, 10) == byTitle);
+  CHECK(titles(LibraryCatalog::Order::Title, 1, 2) == std::vector<std::string>{"Dune", "emma"});
+
+  // Authors in order, their books by title, books without an author last
+  const std::vector<std::string> byAuthor = {"Children of Dune", "Dune", "emma", "Persuasion", "notes"};
+  CHECK(titles(LibraryCatalog::Order::Author, 0, 10) == byAuthor);
+}
+
+TEST_CASE("testLibraryCatalogOrdersTitlesSharingLongPrefixes") {
+  Storage.reset();
+
+  buildCatalog({
+      makeBook("/3.epub", "The Chronicles of Narnia 3", "C. S. Lewis"),
+      makeBook("/1.epub", "The Chronicles of Narnia 1", "C. S. Lewis"),
+      makeBook("/2.epub", "The Chronicles of Narnia 2", "C. S. Lewis"),
+      makeBook("/0.epub", "The Chronicles", "C. S. Lewis"),
+  });
+
+  const std::vector<std::string> expected = {"The Chronicles", "The Chronicles of Narnia 1",
+                                             "The Chronicles of Narnia 2", "The Chronicles of Narnia 3"};
+  CHECK(titles(LibraryCatalog::Order::Title, 0, 10) == expected);
+}
+
+TEST_CASE("testLibraryCatalogFindsPrefixes") {
+  Storage.reset();
+
+  std::vector<LibraryCatalog::Book> books;
+  for (int i = 0; i < 200; i++) {
+    const std::string name = "Book " + std::to_string(1000 + i);
+    books.push_back(makeBook("/" + name + ".epub", name, i % 2 ? "Odd Author" : "Even Author"));
+  }
+  books.push_back(makeBook("/zebra.epub", "Zebra", ""));
+  buildCatalog(books);
+
+  const auto all = LIBRARY_CATALOG.findPrefix(LibraryCatalog::Order::Title, "book");
+  CHECK(all.first == 0);
+  CHECK(all.second == 200);
+
+  const auto tens = LIBRARY_CATALOG.findPrefix(LibraryCatalog::Order::Title, "BOOK 105");
+  CHECK(tens.second - tens.first == 10);
+  CHECK(titles(LibraryCatalog::Order::Title, tens.first, 1) == std::vector<std::string>{"Book 1050"});
+
+  const auto odd = LIBRARY_CATALOG.findPrefix(LibraryCatalog::Order::Author, "odd");
+  CHECK(odd.second - odd.first == 100);
+
+  const auto none = LIBRARY_CATALOG.findPrefix(LibraryCatalog::Order::Title, "missing");
+  CHECK(none.first == none.second);
+
+  const auto empty = LIBRARY_CATALOG.findPrefix(LibraryCatalog::Order::Title, "");
+  CHECK(empty.second == 201);
+}
+
+TEST_CASE("testLibraryCatalogFindsBooksByPath") {
+  Storage.reset();
+
+  buildCatalog({makeBook("/a.epub", "A", "X"), makeBook("/b.xtc", "B", "Y")});
+
+  LibraryCatalog::Book book;
+  CHECK(LIBRARY_CATALOG.findBook("/b.xtc", book));
+  CHECK(book.title == "B");
+  CHECK(book.kind == BookProgressDataStore::BookKind::Xtc);
+  CHECK_FALSE(LIBRARY_CATALOG.findBook("/c.epub", book));
+}
+
+TEST_CASE("testLibraryCatalogRecentlyRead") {
+  Storage.reset();
+
+  LIBRARY_CATALOG.seedRecent({"/a.epub", "/new.txt"});
+  buildCatalog({makeBook("/a.epub", "A", "X"), makeBook("/b.epub", "B", "Y")});
+
+  const uint32_t generation = LIBRARY_CATALOG.getGeneration();
+  LIBRARY_CATALOG.markOpened("/b.epub");
+  CHECK(LIBRARY_CATALOG.getGeneration() != generation);
+
+  // Seeding only happens once
+  LIBRARY_CATALOG.seedRecent({"/ignored.epub"});
+
+  CHECK(LIBRARY_CATALOG.count(LibraryCatalog::Order::Recent) == 3);
+  // Books the catalog does not know yet show their file name
+  CHECK(titles(LibraryCatalog::Order::Recent, 0, 10) == std::vector<std::string>{"B", "A", "new"});
+
+  LIBRARY_CATALOG.markOpened("/a.epub");
+  CHECK(LIBRARY_CATALOG.getRecentPaths() == std::vector<std::string>{"/a.epub", "/b.epub", "/new.txt"});
+}
+
+TEST_CASE("testLibraryCatalogUncommittedBuilderKeepsCatalog") {
+  Storage.reset();
+
+  buildCatalog({makeBook("/a.epub", "A", "X")});
+  {
+    LibraryCatalog::Builder builder;
+    CHECK(builder.add(makeBook("/b.epub", "B", "Y")));
+  }
+  CHECK(titles(LibraryCatalog::Order::Title, 0, 10) == std::vector<std::string>{"A"});
+}
+
+TEST_CASE("testLibraryCatalogRejectsFilesFromAnotherBuild") {
+  Storage.reset();
+
+  // Same book count in both builds, so only the build id tells the title index apart
+  buildCatalog({makeBook("/a.epub", "A", "X"), makeBook("/b.epub", "B", "Y")});
+  CHECK(Storage.rename("/.crosspoint/catalog/title.idx", "/old-title.idx"));
+
+  // What a scan interrupted while swapping the files in leaves behind
+  buildCatalog({makeBook("/c.epub", "C", "X"), makeBook("/d.epub", "D", "Y")});
+  Storage.remove("/.crosspoint/catalog/title.idx");
+  CHECK(Storage.rename("/old-title.idx", "/.crosspoint/catalog/title.idx"));
+  CHECK_FALSE(LIBRARY_CATALOG.isBuilt());
+  CHECK(LIBRARY_CATALOG.count(LibraryCatalog::Order::Title) == 0);
+
+  buildCatalog({makeBook("/c.epub", "C", "X")});
+  CHECK(LIBRARY_CATALOG.isBuilt());
+  CHECK(titles(LibraryCatalog::Order::Title, 0, 10) == std::vector<std::string>{"C"});
+}
@@ -1,6 +1,7 @@
 #include "doctest/doctest.h"
 #include "lib/Markdown/MarkdownParser.h"
 #include <string>
+#include <vector>
 
 TEST_CASE("testMarkdownLimits") {
   MarkdownParser parser;
@@ -21,3 +22,31 @@ TEST_CASE("testMarkdownLimits") {
   auto resultMany = parser.parse(manyNodes);
   CHECK(resultMany == nullptr);
 }
+
+TEST_CASE("testMarkdownParseBlocks") {
+  MarkdownParser parser;
+  std::vector<MdNodeType> types;
+  const bool ok = parser.parseBlocks("# Title\n\nSome *text*.\n\n- one\n- two\n", [&](const MdNode& block) {
+    types.push_back(block.type);
+    return true;
+  });
+  CHECK(ok);
+  REQUIRE(types.size() == 3);
+  CHECK(types[0] == MdNodeType::Heading);
+  CHECK(types[1] == MdNodeType::Paragraph);
+  CHECK(types[2] == MdNodeType::UnorderedList);
+
+  // The node limit applies per block, so a document over it still streams
+  std::string manyNodes;
+  for (int i = 0; i < 6000; ++i) {
+    manyNodes += "p\n\n";
+  }
+  size_t blocks = 0;
+  CHECK(parser.parseBlocks(manyNodes, [&](const MdNode&) { return ++blocks > 0; }));
+  CHECK(blocks == 6000);
+
+  // Returning false stops the parse
+  blocks = 0;
+  CHECK_FALSE(parser.parseBlocks(manyNodes, [&](const MdNode&) { return ++blocks < 10; }));
+  CHECK(blocks == 10);
+}
@@ -2,15 +2,19 @@
 
 #include <algorithm>
 #include <cctype>
+#include <chrono>
 #include <cmath>
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <random>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#include "lib/Epub/Epub/hyphenation/HyphenationCache.h"
 #include "lib/Epub/Epub/hyphenation/HyphenationCommon.h"
+#include "lib/Epub/Epub/hyphenation/Hyphenator.h"
 #include "lib/Epub/Epub/hyphenation/LanguageHyphenator.h"
 #include "lib/Epub/Epub/hyphenation/LanguageRegistry.h"
 
@@ -302,7 +306,103 @@ void printResults(const std::string& language, const std::vector<TestCase>& test
   }
 }
 
+// Replays each word as many times as its frequency, shuffled, as a stand-in for the words of a chapter.
+std::vector<std::string> buildWordStream(const std::vector<TestCase>& testCases) {
+  std::vector<std::string> stream;
+  for (const auto& testCase : testCases) {
+    for (int i = 0; i < testCase.frequency; i++) {
+      stream.push_back(testCase.word);
+    }
+  }
+  std::mt19937 rng(1);
+  std::shuffle(stream.begin(), stream.end(), rng);
+  return stream;
+}
+
+bool sameBreaks(const std::vector<Hyphenator::BreakInfo>& a, const std::vector<Hyphenator::BreakInfo>& b) {
+  return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const auto& x, const auto& y) {
+    return x.byteOffset == y.byteOffset && x.requiresInsertedHyphen == y.requiresInsertedHyphen;
+  });
+}
+
+// Words per second through Hyphenator::breakOffsets() without and with a HyphenationCache, best of several passes.
+// Every pass starts from an empty cache, like a section build. Returns false if a cached result differs.
+bool benchmarkLanguage(const LanguageConfig& lang) {
+  const std::vector<TestCase> testCases = loadTestData(lang.testDataFile);
+  if (testCases.empty()) {
+    std::cerr << "No test cases loaded for " << lang.cliName << ". Skipping." << std::endl;
+    return true;
+  }
+  const std::vector<std::string> stream = buildWordStream(testCases);
+  Hyphenator::setPreferredLanguage(lang.primaryTag);
+
+  constexpr int kPasses = 5;
+  std::vector<Hyphenator::BreakInfo> breaks;
+  std::vector<std::vector<Hyphenator::BreakInfo>> expected(stream.size());
+  double uncachedSeconds = 0.0;
+  double cachedSeconds = 0.0;
+  HyphenationCache::Stats stats;
+  bool consistent = true;
+
+  for (int pass = 0; pass < kPasses; pass++) {
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < stream.size(); i++) {
+      Hyphenator::breakOffsets(stream[i], true, breaks);
+      if (pass == 0) {
+        expected[i] = breaks;
+      }
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    uncachedSeconds = pass == 0 ? elapsed.count() : std::min(uncachedSeconds, elapsed.count());
+  }
+
+  for (int pass = 0; pass < kPasses; pass++) {
+    HyphenationCache cache;
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto& word : stream) {
+      Hyphenator::breakOffsets(word, true, breaks);
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    cachedSeconds = pass == 0 ? elapsed.count() : std::min(cachedSeconds, elapsed.count());
+    stats = cache.getStats();
+
+    if (pass == 0) {
+      HyphenationCache check;
+      for (size_t i = 0; i < stream.size() && consistent; i++) {
+        Hyphenator::breakOffsets(stream[i], true, breaks);
+        if (!sameBreaks(breaks, expected[i])) {
+          std::cerr << lang.cliName << ": cached breaks differ for " << stream[i] << std::endl;
+          consistent = false;
+        }
+      }
+    }
+  }
+
+  const double uncachedRate = stream.size() / uncachedSeconds;
+  const double cachedRate = stream.size() / cachedSeconds;
+  const uint32_t lookups = stats.hits + stats.misses;
+  std::cout << lang.cliName << ": " << stream.size() << " words (" << testCases.size() << " distinct), "
+            << static_cast<long>(uncachedRate) << " -> " << static_cast<long>(cachedRate) << " words/s ("
+            << std::round(cachedRate / uncachedRate * 10.0) / 10.0 << "x), hit rate "
+            << (lookups ? stats.hits * 100 / lookups : 0) << "%, " << stats.evictions << " evictions, "
+            << stats.uncacheable << " uncacheable" << std::endl;
+  return consistent;
+}
+
 int main(int argc, char* argv[]) {
+  if (argc > 1 && std::string(argv[1]) == "bench") {
+    const std::vector<LanguageConfig> languages = resolveLanguages(argc > 2 ? argv[2] : "all");
+    if (languages.empty()) {
+      std::cerr << "Unknown language: " << argv[2] << std::endl;
+      return 1;
+    }
+    bool consistent = true;
+    for (const auto& lang : languages) {
+      consistent = benchmarkLanguage(lang) && consistent;
+    }
+    return consistent ? 0 : 1;
+  }
+
   const bool summaryMode = argc <= 1;
   const std::string languageSelection = summaryMode ? "all" : argv[1];
 
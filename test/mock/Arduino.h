@@ -14,3 +14,4 @@ struct MockESP {
 };
 extern MockESP ESP;
 inline unsigned long millis() { return 0; }
+inline unsigned long micros() { return 0; }
@@ -0,0 +1,10 @@
+#pragma once
+// Host test stub — only the panel geometry constants HalDisplay.h needs.
+
+#include <cstdint>
+
+class EInkDisplay {
+ public:
+  static constexpr uint16_t DISPLAY_WIDTH = 800;
+  static constexpr uint16_t DISPLAY_HEIGHT = 480;
+};
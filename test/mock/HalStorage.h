@@ -26,7 +26,9 @@ class FsFile {
   static FsFile forRead(std::shared_ptr<std::vector<uint8_t>> buf) { return forWrite(buf); }
 
   void write(const uint8_t* data, size_t len) {
-    if (buf_) buf_->insert(buf_->end(), data, data + len);
+    if (!buf_) return;
+    buf_->insert(buf_->end(), data, data + len);
+    pos_ = buf_->size();
   }
 
   size_t read(uint8_t* data, size_t len) {
@@ -38,6 +40,14 @@ class FsFile {
     return n;
   }
 
+  bool seekSet(size_t pos) {
+    if (!buf_ || pos > buf_->size()) return false;
+    pos_ = pos;
+    return true;
+  }
+  size_t position() const { return pos_; }
+  size_t size() const { return buf_ ? buf_->size() : 0; }
+
   void close() {}
   explicit operator bool() const { return buf_ != nullptr; }
 
@@ -0,0 +1,468 @@
+// Host benchmark for the EPUB pipeline. For every book in a directory (test/epubs by default) it times a cold
+// Epub::load, Section::createSectionFile for each spine item, page deserialization and the BW and grayscale passes the
+// reader runs per page, and counts heap allocations and peak live heap in each phase. Runs on the emulated HAL from
+// tools/emulator with the reader's default layout settings, so numbers only move when the code does.
+//
+//   RenderBenchmark [--books DIR] [--card DIR] [--repeat N] [--label TEXT] [--json FILE]
+//
+// Times are the median over the repeats. Allocation figures count every heap allocation: malloc and its relatives are
+// interposed below, which covers operator new as well as the C libraries and the firmware's direct malloc calls.
+
+#include <Epub.h>
+#include <Epub/Page.h>
+#include <Epub/Section.h>
+#include <FontCacheManager.h>
+#include <FontDecompressor.h>
+#include <GfxRenderer.h>
+#include <GlyphDisplayList.h>
+#include <HalDisplay.h>
+#include <HalStorage.h>
+#include <Logging.h>
+#include <malloc.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "CrossPointSettings.h"
+#include "Emulator.h"
+#include "core/fonts/BuiltinFontRegistry.h"
+#include "fontIds.h"
+
+// glibc's allocator under the names it exports for interposers
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+}
+
+namespace {
+
+std::atomic<uint64_t> allocCount{0};
+std::atomic<uint64_t> allocBytes{0};
+std::atomic<int64_t> liveBytes{0};
+std::atomic<int64_t> peakLiveBytes{0};
+
+void* recordAlloc(void* ptr, const size_t size) {
+  if (!ptr) return nullptr;
+  allocCount++;
+  allocBytes += size;
+  const int64_t live = liveBytes += static_cast<int64_t>(malloc_usable_size(ptr));
+  int64_t peak = peakLiveBytes.load();
+  while (live > peak && !peakLiveBytes.compare_exchange_weak(peak, live)) {
+  }
+  return ptr;
+}
+
+void recordFree(void* ptr) {
+  if (ptr) liveBytes -= static_cast<int64_t>(malloc_usable_size(ptr));
+}
+
+}  // namespace
+
+extern "C" {
+void* malloc(const size_t size) noexcept { return recordAlloc(__libc_malloc(size), size); }
+void* calloc(const size_t count, const size_t size) noexcept {
+  return recordAlloc(__libc_calloc(count, size), count * size);
+}
+// Counted as freeing the old block and allocating a new one
+void* realloc(void* ptr, const size_t size) noexcept {
+  const auto oldUsable = static_cast<int64_t>(ptr ? malloc_usable_size(ptr) : 0);
+  void* result = __libc_realloc(ptr, size);
+  if (result || size == 0) {
+    liveBytes -= oldUsable;
+  }
+  return recordAlloc(result, size);
+}
+void* memalign(const size_t alignment, const size_t size) noexcept {
+  return recordAlloc(__libc_memalign(alignment, size), size);
+}
+void* aligned_alloc(const size_t alignment, const size_t size) noexcept { return memalign(alignment, size); }
+int posix_memalign(void** out, const size_t alignment, const size_t size) noexcept {
+  void* ptr = memalign(alignment, size);
+  if (!ptr) return ENOMEM;
+  *out = ptr;
+  return 0;
+}
+void free(void* ptr) noexcept {
+  recordFree(ptr);
+  __libc_free(ptr);
+}
+}
+
+namespace {
+
+// Reader defaults from CrossPointSettings, as in tools/emulator/main.cpp
+constexpr int READER_FONT_ID = BOOKERLY_14_FONT_ID;
+constexpr float LINE_COMPRESSION = 1.0f;
+constexpr bool EXTRA_PARAGRAPH_SPACING = true;
+constexpr uint8_t PARAGRAPH_ALIGNMENT = CrossPointSettings::JUSTIFIED;
+constexpr bool HYPHENATION = false;
+constexpr bool EMBEDDED_STYLE = true;
+constexpr uint8_t IMAGE_RENDERING = CrossPointSettings::IMAGES_DISPLAY;
+constexpr int SCREEN_MARGIN = 5;
+// 2: allocation figures include malloc calls, not only operator new
+constexpr int BENCH_SCHEMA_VERSION = 2;
+
+GfxRenderer renderer(display);
+FontDecompressor fontDecompressor;
+FontCacheManager fontCacheManager(renderer.getFontMap());
+
+using Clock = std::chrono::steady_clock;
+
+// One phase of one book: wall time per repeat, allocation counts and peak heap from the last repeat
+struct Phase {
+  std::vector<double> runMs;
+  uint32_t units = 0;  // pages or spine items covered by one repeat
+  uint64_t allocs = 0;
+  uint64_t allocBytes = 0;
+  int64_t peakBytes = 0;
+
+  void startRepeat() {
+    runMs.push_back(0);
+    units = 0;
+    allocs = 0;
+    allocBytes = 0;
+    peakBytes = 0;
+  }
+
+  double medianMs() const {
+    if (runMs.empty()) return 0;
+    auto sorted = runMs;
+    std::sort(sorted.begin(), sorted.end());
+    return sorted[sorted.size() / 2];
+  }
+};
+
+// Charges the time, allocations and heap high-water mark between construction and destruction to a phase. Scopes do
+// not nest: the high-water mark is global.
+class PhaseScope {
+ public:
+  explicit PhaseScope(Phase& phase)
+      : phase(phase),
+        start(Clock::now()),
+        allocsAtStart(allocCount.load()),
+        bytesAtStart(allocBytes.load()),
+        liveAtStart(liveBytes.load()) {
+    peakLiveBytes = liveAtStart;
+  }
+
+  ~PhaseScope() {
+    phase.runMs.back() += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    phase.allocs += allocCount.load() - allocsAtStart;
+    phase.allocBytes += allocBytes.load() - bytesAtStart;
+    phase.peakBytes = std::max(phase.peakBytes, peakLiveBytes.load() - liveAtStart);
+  }
+
+ private:
+  Phase& phase;
+  Clock::time_point start;
+  uint64_t allocsAtStart;
+  uint64_t bytesAtStart;
+  int64_t liveAtStart;
+};
+
+struct BookResult {
+  std::string name;
+  bool ok = true;
+  int spineItems = 0;
+  std::vector<uint16_t> spinePages;
+  std::vector<std::vector<double>> spineMs;  // [spine][repeat]
+  Phase load;
+  Phase sections;
+  Phase deserialize;
+  Phase renderBw;
+  Phase renderGray;
+};
+
+struct Options {
+  std::string booksDir = "test/epubs";
+  std::string cardDir = "build/render_bench/card";
+  std::string label;
+  std::string jsonPath;
+  int repeat = 3;
+};
+
+struct Viewport {
+  int top = 0;
+  int left = 0;
+  uint16_t width = 0;
+  uint16_t height = 0;
+};
+
+Viewport readerViewport() {
+  int top, right, bottom, left;
+  renderer.getOrientedViewableTRBL(&top, &right, &bottom, &left);
+  Viewport viewport;
+  viewport.top = top + SCREEN_MARGIN;
+  viewport.left = left + SCREEN_MARGIN;
+  viewport.width = renderer.getScreenWidth() - left - right - SCREEN_MARGIN * 2;
+  viewport.height = renderer.getScreenHeight() - top - bottom - SCREEN_MARGIN * 2;
+  return viewport;
+}
+
+// BW pass, then both grayscale passes, as EpubReaderActivity::renderContents draws them (no panel refresh)
+void renderPage(const Page& page, const Viewport& viewport, BookResult& result) {
+  GlyphDisplayList displayList;
+  const auto drawPage = [&]() {
+    renderer.drawDisplayList(displayList);
+    page.renderImages(renderer, READER_FONT_ID, viewport.left, viewport.top);
+  };
+  {
+    PhaseScope scope(result.renderBw);
+    page.buildDisplayList(renderer, READER_FONT_ID, viewport.left, viewport.top, displayList);
+    auto prewarm = fontCacheManager.createPrewarmScope();
+    prewarm.endScanAndPrewarm(displayList);
+    renderer.clearScreen();
+    drawPage();
+  }
+  result.renderBw.units++;
+
+  if (!renderer.fontSupportsGrayscale(READER_FONT_ID)) {
+    return;
+  }
+  {
+    PhaseScope scope(result.renderGray);
+    auto prewarm = fontCacheManager.createPrewarmScope();
+    prewarm.endScanAndPrewarm(displayList);
+    renderer.clearScreen(0x00);
+    renderer.setRenderMode(GfxRenderer::GRAYSCALE_LSB);
+    drawPage();
+    renderer.copyGrayscaleLsbBuffers();
+    renderer.clearScreen(0x00);
+    renderer.setRenderMode(GfxRenderer::GRAYSCALE_MSB);
+    drawPage();
+    renderer.copyGrayscaleMsbBuffers();
+    renderer.setRenderMode(GfxRenderer::BW);
+  }
+  renderer.cleanupGrayscaleWithFrameBuffer();
+  result.renderGray.units++;
+}
+
+// One cold pass over a book: the card's cache directory is removed first so every repeat indexes from scratch
+bool runBook(const std::string& cardPath, const Viewport& viewport, BookResult& result) {
+  Storage.removeDir("/.crosspoint");
+  for (auto* phase : {&result.load, &result.sections, &result.deserialize, &result.renderBw, &result.renderGray}) {
+    phase->startRepeat();
+  }
+
+  auto epub = std::make_shared<Epub>(cardPath, "/.crosspoint");
+  {
+    PhaseScope scope(result.load);
+    if (!epub->load(true)) {
+      LOG_ERR("BENCH", "Failed to load %s", cardPath.c_str());
+      return false;
+    }
+  }
+  result.load.units = 1;
+
+  result.spineItems = epub->getSpineItemsCount();
+  result.spinePages.assign(result.spineItems, 0);
+  result.spineMs.resize(result.spineItems);
+  for (int spine = 0; spine < result.spineItems; spine++) {
+    Section section(epub, spine, renderer);
+    const auto start = Clock::now();
+    bool built;
+    {
+      PhaseScope scope(result.sections);
+      built = section.createSectionFile(READER_FONT_ID, LINE_COMPRESSION, EXTRA_PARAGRAPH_SPACING, PARAGRAPH_ALIGNMENT,
+                                        viewport.width, viewport.height, HYPHENATION, EMBEDDED_STYLE, IMAGE_RENDERING);
+    }
+    result.spineMs[spine].push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    result.sections.units++;
+    if (!built) {
+      LOG_ERR("BENCH", "Failed to build spine item %d of %s", spine, cardPath.c_str());
+      continue;
+    }
+
+    const uint16_t pageCount = section.pageCount.load();
+    result.spinePages[spine] = pageCount;
+    for (uint16_t i = 0; i < pageCount; i++) {
+      std::unique_ptr<Page> page;
+      {
+        PhaseScope scope(result.deserialize);
+        page = section.loadPage(i);
+      }
+      result.deserialize.units++;
+      if (!page) {
+        LOG_ERR("BENCH", "Failed to load page %u of spine item %d", i, spine);
+        return false;
+      }
+      renderPage(*page, viewport, result);
+    }
+  }
+  return true;
+}
+
+void writePhase(FILE* out, const char* name, const Phase& phase, const char* unit, const bool last) {
+  const double ms = phase.medianMs();
+  const double perUnitUs = phase.units ? ms * 1000.0 / phase.units : 0;
+  fprintf(out,
+          "      \"%s\": {\"ms\": %.3f, \"%s\": %u, \"usPer%s\": %.1f, \"allocs\": %llu, \"allocBytes\": %llu, "
+          "\"peakBytes\": %lld}%s\n",
+          name, ms, unit, phase.units, unit[0] == 'p' ? "Page" : "Item", perUnitUs,
+          static_cast<unsigned long long>(phase.allocs), static_cast<unsigned long long>(phase.allocBytes),
+          static_cast<long long>(phase.peakBytes), last ? "" : ",");
+}
+
+std::string jsonEscape(const std::string& text) {
+  std::string escaped;
+  for (const char c : text) {
+    if (c == '"' || c == '\\') escaped += '\\';
+    if (static_cast<unsigned char>(c) >= 0x20) escaped += c;
+  }
+  return escaped;
+}
+
+void writeJson(FILE* out, const Options& options, const std::vector<BookResult>& results) {
+  double totalLoad = 0, totalSections = 0, totalDeserialize = 0, totalBw = 0, totalGray = 0;
+  int64_t peakBytes = 0;
+  uint64_t allocs = 0;
+  uint32_t pages = 0;
+  for (const auto& book : results) {
+    totalLoad += book.load.medianMs();
+    totalSections += book.sections.medianMs();
+    totalDeserialize += book.deserialize.medianMs();
+    totalBw += book.renderBw.medianMs();
+    totalGray += book.renderGray.medianMs();
+    pages += book.renderBw.units;
+    for (const auto* phase : {&book.load, &book.sections, &book.deserialize, &book.renderBw, &book.renderGray}) {
+      peakBytes = std::max(peakBytes, phase->peakBytes);
+      allocs += phase->allocs;
+    }
+  }
+
+  fprintf(out, "{\n");
+  fprintf(out, "  \"schema\": %d,\n", BENCH_SCHEMA_VERSION);
+  fprintf(out, "  \"label\": \"%s\",\n", jsonEscape(options.label).c_str());
+  fprintf(out, "  \"repeat\": %d,\n", options.repeat);
+  fprintf(out,
+          "  \"totals\": {\"books\": %zu, \"pages\": %u, \"loadMs\": %.3f, \"sectionsMs\": %.3f, "
+          "\"deserializeMs\": %.3f, \"renderBwMs\": %.3f, \"renderGrayMs\": %.3f, \"allocs\": %llu, "
+          "\"peakBytes\": %lld},\n",
+          results.size(), pages, totalLoad, totalSections, totalDeserialize, totalBw, totalGray,
+          static_cast<unsigned long long>(allocs), static_cast<long long>(peakBytes));
+  fprintf(out, "  \"books\": [\n");
+  for (size_t b = 0; b < results.size(); b++) {
+    const auto& book = results[b];
+    fprintf(out, "    {\n");
+    fprintf(out, "      \"name\": \"%s\",\n", jsonEscape(book.name).c_str());
+    fprintf(out, "      \"ok\": %s,\n", book.ok ? "true" : "false");
+    fprintf(out, "      \"spineItems\": %d,\n", book.spineItems);
+    writePhase(out, "load", book.load, "items", false);
+    writePhase(out, "sections", book.sections, "items", false);
+    writePhase(out, "deserialize", book.deserialize, "pages", false);
+    writePhase(out, "renderBw", book.renderBw, "pages", false);
+    writePhase(out, "renderGray", book.renderGray, "pages", false);
+    fprintf(out, "      \"spine\": [");
+    for (int i = 0; i < book.spineItems; i++) {
+      auto runs = book.spineMs[i];
+      std::sort(runs.begin(), runs.end());
+      fprintf(out, "%s{\"index\": %d, \"pages\": %u, \"ms\": %.3f}", i ? ", " : "", i, book.spinePages[i],
+              runs.empty() ? 0.0 : runs[runs.size() / 2]);
+    }
+    fprintf(out, "]\n");
+    fprintf(out, "    }%s\n", b + 1 < results.size() ? "," : "");
+  }
+  fprintf(out, "  ]\n}\n");
+}
+
+bool parseArgs(const int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if (i + 1 >= argc) return false;
+    if (arg == "--books") {
+      options.booksDir = argv[++i];
+    } else if (arg == "--card") {
+      options.cardDir = argv[++i];
+    } else if (arg == "--repeat") {
+      options.repeat = std::max(1, atoi(argv[++i]));
+    } else if (arg == "--label") {
+      options.label = argv[++i];
+    } else if (arg == "--json") {
+      options.jsonPath = argv[++i];
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  namespace fs = std::filesystem;
+
+  Options options;
+  if (!parseArgs(argc, argv, options)) {
+    fprintf(stderr, "usage: %s [--books DIR] [--card DIR] [--repeat N] [--label TEXT] [--json FILE]\n", argv[0]);
+    return 2;
+  }
+
+  // The books are copied onto a scratch card so the section cache never lands next to the sources
+  std::vector<std::string> names;
+  std::error_code ec;
+  fs::create_directories(fs::path(options.cardDir) / "Books", ec);
+  for (const auto& entry : fs::directory_iterator(options.booksDir, ec)) {
+    if (entry.is_regular_file() && entry.path().extension() == ".epub") {
+      fs::copy_file(entry.path(), fs::path(options.cardDir) / "Books" / entry.path().filename(),
+                    fs::copy_options::overwrite_existing, ec);
+      names.push_back(entry.path().filename().string());
+    }
+  }
+  std::sort(names.begin(), names.end());
+  if (names.empty()) {
+    fprintf(stderr, "no .epub files in %s\n", options.booksDir.c_str());
+    return 1;
+  }
+
+  Emulator::setStorageRoot(options.cardDir);
+  if (!Storage.begin()) {
+    return 1;
+  }
+  display.begin();
+  renderer.begin();
+  fontCacheManager.setFontDecompressor(&fontDecompressor);
+  renderer.setFontCacheManager(&fontCacheManager);
+  if (!core::BuiltinFontRegistry::registerAllFonts(renderer)) {
+    LOG_ERR("BENCH", "Font initialization failed");
+    return 1;
+  }
+  const Viewport viewport = readerViewport();
+
+  std::vector<BookResult> results(names.size());
+  bool allOk = true;
+  for (size_t b = 0; b < names.size(); b++) {
+    results[b].name = names[b];
+    for (int r = 0; r < options.repeat && results[b].ok; r++) {
+      results[b].ok = runBook("/Books/" + names[b], viewport, results[b]);
+    }
+    allOk &= results[b].ok;
+    fprintf(stderr, "%-32s load %8.2fms  sections %8.2fms  pages %4u  bw %6.2fms/page  gray %6.2fms/page\n",
+            names[b].c_str(), results[b].load.medianMs(), results[b].sections.medianMs(), results[b].renderBw.units,
+            results[b].renderBw.units ? results[b].renderBw.medianMs() / results[b].renderBw.units : 0.0,
+            results[b].renderGray.units ? results[b].renderGray.medianMs() / results[b].renderGray.units : 0.0);
+  }
+  Storage.removeDir("/.crosspoint");
+
+  FILE* out = stdout;
+  if (!options.jsonPath.empty()) {
+    out = fopen(options.jsonPath.c_str(), "w");
+    if (!out) {
+      fprintf(stderr, "cannot write %s\n", options.jsonPath.c_str());
+      return 1;
+    }
+  }
+  writeJson(out, options, results);
+  if (out != stdout) fclose(out);
+  return allOk ? 0 : 1;
+}
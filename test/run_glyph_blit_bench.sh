@@ -0,0 +1,39 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+ROOT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+BUILD_DIR="$ROOT_DIR/build/glyph_blit_bench"
+BINARY="$BUILD_DIR/GlyphBlitBenchmark"
+
+mkdir -p "$BUILD_DIR"
+
+# uzlib_uncompress_chksum (unused) references checksum helpers the firmware gets from ROM; drop it at link time
+cc -c -O2 -ffunction-sections "$ROOT_DIR/lib/third_party/uzlib/src/tinflate.c" -I"$ROOT_DIR/lib/third_party/uzlib/src" \
+  -o "$BUILD_DIR/tinflate.o"
+
+SOURCES=(
+  "$ROOT_DIR/test/glyph_blit_bench/GlyphBlitBenchmark.cpp"
+  "$ROOT_DIR/lib/EpdFont/EpdFont.cpp"
+  "$ROOT_DIR/lib/EpdFont/FontDecompressor.cpp"
+  "$ROOT_DIR/lib/InflateReader/InflateReader.cpp"
+  "$ROOT_DIR/lib/Utf8/Utf8.cpp"
+)
+
+CXXFLAGS=(
+  -std=c++20
+  -O2
+  -Wall
+  -Wextra
+  -I"$ROOT_DIR"
+  -I"$ROOT_DIR/test/mock"
+  -I"$ROOT_DIR/lib/EpdFont"
+  -I"$ROOT_DIR/lib/GfxRenderer"
+  -I"$ROOT_DIR/lib/InflateReader"
+  -I"$ROOT_DIR/lib/Utf8"
+  -I"$ROOT_DIR/lib/hal"
+  -I"$ROOT_DIR/lib/third_party/uzlib/src"
+)
+
+c++ "${CXXFLAGS[@]}" "${SOURCES[@]}" "$BUILD_DIR/tinflate.o" -Wl,--gc-sections -o "$BINARY"
+
+"$BINARY" "$@"
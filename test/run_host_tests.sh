@@ -52,6 +52,7 @@ g++ -std=c++20 -O2 -Wno-narrowing \
   "$ROOT_DIR/src/util/ForkDriftNavigation.cpp" \
   "$ROOT_DIR/src/util/BookProgressDataStore.cpp" \
   "$ROOT_DIR/src/util/InputValidation.cpp" \
+  "$ROOT_DIR/src/util/LibraryCatalog.cpp" \
   "$ROOT_DIR/src/util/PathUtils.cpp" \
   "$ROOT_DIR/src/util/PokemonBookDataStore.cpp" \
   "$ROOT_DIR/src/CrossPointSettings.cpp" \
@@ -0,0 +1,37 @@
+#!/usr/bin/env bash
+# Turns pages while the layout task is still building chapters, on the emulated firmware built with ThreadSanitizer.
+# One card is read with rapid presses from the moment the reader opens, so page loads, spine and TOC lookups and the
+# background chapter builds all share book.bin and the card; a second card lays the same book out undisturbed. Fails
+# on a data race report, a crash or a hang, or when the sections laid out under page turns differ from the others.
+#   test/run_page_turn_race_test.sh [BOOK.epub]
+set -euo pipefail
+
+ROOT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+BUILD_DIR="$ROOT_DIR/build/page_turn_race"
+BINARY="$BUILD_DIR/emulator"
+BOOK="${1:-$ROOT_DIR/test/epubs/test_kerning_ligature.epub}"
+# Forward through several chapters, back across chapter starts, then on again
+SCRIPT="right*60 left*20 right*30"
+
+LOG_LEVEL=0 EMULATOR_CXXFLAGS=-fsanitize=thread "$ROOT_DIR/tools/emulator/build_emulator.sh" "" "$BINARY"
+
+# Races the firmware accepts by design are listed in page_turn_race/tsan_suppressions.txt
+SUPPRESSIONS="$ROOT_DIR/test/page_turn_race/tsan_suppressions.txt"
+export TSAN_OPTIONS="halt_on_error=1 exitcode=66 suppressions=$SUPPRESSIONS ${TSAN_OPTIONS:-}"
+
+for card in turned undisturbed; do
+  rm -rf "${BUILD_DIR:?}/$card"
+  mkdir -p "$BUILD_DIR/$card"
+  cp "$BOOK" "$BUILD_DIR/$card/book.epub"
+done
+
+echo "Turning pages while chapters build..."
+"$BINARY" --sd "$BUILD_DIR/turned" --rapid --script "$SCRIPT" /book.epub
+echo "Laying the book out undisturbed..."
+"$BINARY" --sd "$BUILD_DIR/undisturbed" /book.epub
+
+if ! diff -r "$BUILD_DIR"/turned/.crosspoint/epub_*/sections "$BUILD_DIR"/undisturbed/.crosspoint/epub_*/sections; then
+  echo "FAIL: sections laid out while turning pages differ from an undisturbed layout" >&2
+  exit 1
+fi
+echo "PASS: pages turned during chapter builds, sections match"
@@ -0,0 +1,17 @@
+#!/usr/bin/env bash
+# Times indexing and page rendering of every EPUB in test/epubs on the host and writes the results as JSON, e.g.
+#   test/run_render_bench.sh --repeat 5 --json build/render_bench/results.json
+set -euo pipefail
+
+ROOT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+BUILD_DIR="$ROOT_DIR/build/render_bench"
+BINARY="$BUILD_DIR/RenderBenchmark"
+
+mkdir -p "$BUILD_DIR"
+
+# Errors only, so logging does not show up in the timings
+LOG_LEVEL=0 "$ROOT_DIR/tools/emulator/build_emulator.sh" "$ROOT_DIR/test/render_bench/RenderBenchmark.cpp" "$BINARY"
+
+LABEL="$(git -C "$ROOT_DIR" rev-parse --short HEAD 2>/dev/null || echo unknown)"
+
+"$BINARY" --books "$ROOT_DIR/test/epubs" --card "$BUILD_DIR/card" --label "$LABEL" "$@"
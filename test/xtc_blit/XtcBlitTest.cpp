@@ -0,0 +1,157 @@
+// Checks xtc::blitPage against the per-pixel path XtcReaderActivity falls back to: every pixel of a random XTG or
+// XTH page drawn through GfxRenderer's Portrait drawPixel mapping, for all three passes.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "lib/Xtc/Xtc/XtcBlit.h"
+
+static int testsPassed = 0;
+static int testsFailed = 0;
+
+#define ASSERT_TRUE(cond)                                                \
+  do {                                                                   \
+    if (!(cond)) {                                                       \
+      fprintf(stderr, "  FAIL: %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+      testsFailed++;                                                     \
+      return;                                                            \
+    }                                                                    \
+  } while (0)
+
+#define PASS() testsPassed++
+
+static const char* passName(const xtc::BlitPass pass) {
+  switch (pass) {
+    case xtc::BlitPass::BW:
+      return "BW";
+    case xtc::BlitPass::GrayLsb:
+      return "GrayLsb";
+    case xtc::BlitPass::GrayMsb:
+      return "GrayMsb";
+  }
+  return "?";
+}
+
+static size_t pageSize(const uint8_t bitDepth, const uint16_t pageWidth, const uint16_t pageHeight) {
+  if (bitDepth == 2) {
+    return ((static_cast<size_t>(pageWidth) * pageHeight + 7) / 8) * 2;
+  }
+  return ((pageWidth + 7) / 8) * static_cast<size_t>(pageHeight);
+}
+
+// XtcReaderActivity's getPixelValue: 0 white, 1 dark grey, 2 light grey, 3 black
+static uint8_t pixelValue(const std::vector<uint8_t>& page, const uint8_t bitDepth, const uint16_t pageWidth,
+                          const uint16_t pageHeight, const uint16_t x, const uint16_t y) {
+  if (bitDepth != 2) {
+    const size_t srcRowBytes = (pageWidth + 7) / 8;
+    const bool isWhite = (page[y * srcRowBytes + x / 8] >> (7 - x % 8)) & 1;
+    return isWhite ? 0 : 3;
+  }
+  const size_t planeSize = (static_cast<size_t>(pageWidth) * pageHeight + 7) / 8;
+  const size_t colBytes = (pageHeight + 7) / 8;
+  const size_t byteOffset = (pageWidth - 1 - x) * colBytes + y / 8;
+  const size_t bitInByte = 7 - (y % 8);
+  const uint8_t bit1 = (page[byteOffset] >> bitInByte) & 1;
+  const uint8_t bit2 = (page[planeSize + byteOffset] >> bitInByte) & 1;
+  return (bit1 << 1) | bit2;
+}
+
+// XtcReaderActivity's per-pixel drawPass with GfxRenderer::drawPixel in Portrait: (x, y) -> panel (y, height-1-x)
+static void drawPassPerPixel(const std::vector<uint8_t>& page, const uint8_t bitDepth, const uint16_t pageWidth,
+                             const uint16_t pageHeight, const xtc::BlitPass pass, std::vector<uint8_t>& frameBuffer,
+                             const uint16_t panelWidth, const uint16_t panelHeight) {
+  const size_t panelWidthBytes = panelWidth / 8;
+  std::fill(frameBuffer.begin(), frameBuffer.end(), pass == xtc::BlitPass::BW ? 0xFF : 0x00);
+  auto drawPixel = [&](const int x, const int y, const bool state) {
+    const int phyX = y;
+    const int phyY = panelHeight - 1 - x;
+    const size_t byteIndex = static_cast<size_t>(phyY) * panelWidthBytes + phyX / 8;
+    const uint8_t bitPosition = 7 - (phyX % 8);
+    if (state) {
+      frameBuffer[byteIndex] &= ~(1 << bitPosition);
+    } else {
+      frameBuffer[byteIndex] |= 1 << bitPosition;
+    }
+  };
+  for (uint16_t y = 0; y < pageHeight; y++) {
+    for (uint16_t x = 0; x < pageWidth; x++) {
+      const uint8_t pv = pixelValue(page, bitDepth, pageWidth, pageHeight, x, y);
+      switch (pass) {
+        case xtc::BlitPass::BW:
+          if (pv >= 1) drawPixel(x, y, true);
+          break;
+        case xtc::BlitPass::GrayLsb:
+          if (pv == 1) drawPixel(x, y, false);
+          break;
+        case xtc::BlitPass::GrayMsb:
+          if (pv == 1 || pv == 2) drawPixel(x, y, false);
+          break;
+      }
+    }
+  }
+}
+
+static void testMatchesPerPixel(const uint8_t bitDepth, const uint16_t panelWidth, const uint16_t panelHeight,
+                                const uint32_t seed) {
+  const uint16_t pageWidth = panelHeight;
+  const uint16_t pageHeight = panelWidth;
+  printf("  %s page %ux%u, seed %u\n", bitDepth == 2 ? "XTH" : "XTG", pageWidth, pageHeight, seed);
+
+  std::mt19937 rng(seed);
+  std::vector<uint8_t> page(pageSize(bitDepth, pageWidth, pageHeight));
+  for (auto& byte : page) byte = static_cast<uint8_t>(rng());
+
+  const size_t fbSize = static_cast<size_t>(panelWidth / 8) * panelHeight;
+  std::vector<uint8_t> expected(fbSize);
+  std::vector<uint8_t> actual(fbSize);
+  for (const auto pass : {xtc::BlitPass::BW, xtc::BlitPass::GrayLsb, xtc::BlitPass::GrayMsb}) {
+    drawPassPerPixel(page, bitDepth, pageWidth, pageHeight, pass, expected, panelWidth, panelHeight);
+    // Garbage first: blitPage must overwrite the whole framebuffer
+    for (auto& byte : actual) byte = static_cast<uint8_t>(rng());
+    ASSERT_TRUE(xtc::blitPage(page.data(), bitDepth, pageWidth, pageHeight, pass, actual.data(), panelWidth,
+                              panelHeight));
+    if (actual != expected) {
+      const size_t at = std::mismatch(actual.begin(), actual.end(), expected.begin()).first - actual.begin();
+      fprintf(stderr, "  FAIL: %s pass differs at byte %zu (got 0x%02X, expected 0x%02X)\n", passName(pass), at,
+              actual[at], expected[at]);
+      testsFailed++;
+      return;
+    }
+  }
+  PASS();
+}
+
+static void testRejectsOtherSizes() {
+  printf("  page sizes that do not fill the panel\n");
+  const uint16_t panelWidth = 64;
+  const uint16_t panelHeight = 40;
+  std::vector<uint8_t> page(pageSize(2, 64, 64), 0x55);
+  std::vector<uint8_t> frameBuffer(static_cast<size_t>(panelWidth / 8) * panelHeight, 0xA5);
+  const std::vector<uint8_t> untouched = frameBuffer;
+
+  // Landscape page, wrong height, width not a whole byte
+  ASSERT_TRUE(!xtc::blitPage(page.data(), 1, 64, 40, xtc::BlitPass::BW, frameBuffer.data(), panelWidth, panelHeight));
+  ASSERT_TRUE(!xtc::blitPage(page.data(), 2, 40, 56, xtc::BlitPass::BW, frameBuffer.data(), panelWidth, panelHeight));
+  ASSERT_TRUE(!xtc::blitPage(page.data(), 1, 36, 64, xtc::BlitPass::BW, frameBuffer.data(), 64, 36));
+  ASSERT_TRUE(frameBuffer == untouched);
+  PASS();
+}
+
+int main() {
+  printf("XtcBlit equivalence tests\n");
+
+  // X4 panel, and a small panel whose sides are not multiples of 16
+  for (const uint8_t bitDepth : {1, 2}) {
+    for (uint32_t seed = 1; seed <= 3; seed++) {
+      testMatchesPerPixel(bitDepth, 800, 480, seed);
+    }
+    testMatchesPerPixel(bitDepth, 72, 40, 42);
+  }
+  testRejectsOtherSizes();
+
+  printf("%d passed, %d failed\n", testsPassed, testsFailed);
+  return testsFailed == 0 ? 0 : 1;
+}
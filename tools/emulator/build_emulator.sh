@@ -0,0 +1,168 @@
+#!/usr/bin/env bash
+# Builds a host program on top of the emulated HAL.
+#   build_emulator.sh [MAIN_SOURCE [BINARY]]
+# With no arguments this builds the whole firmware (src/ and every library, radio off) with the session driver
+# tools/emulator/main.cpp -> build/emulator/emulator. With MAIN_SOURCE, that program is linked against the reader
+# libraries only, for host tools that drive the libraries directly (test/render_bench).
+# Objects are kept next to the binary in BINARY.obj and rebuilt when a source, a header it includes or the flags change.
+# EMULATOR_CXXFLAGS adds compiler flags, e.g. EMULATOR_CXXFLAGS=-fsanitize=thread.
+set -euo pipefail
+
+ROOT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")/../.." && pwd)"
+BUILD_DIR="$ROOT_DIR/build/emulator"
+LIBDEPS_DIR="$ROOT_DIR/.pio/libdeps/default"
+
+mkdir -p "$BUILD_DIR"
+
+have_libdeps() {
+  [ -d "$LIBDEPS_DIR/JPEGDEC" ] && [ -d "$LIBDEPS_DIR/PNGdec" ] && [ -d "$LIBDEPS_DIR/ArduinoJson" ] &&
+    [ -d "$LIBDEPS_DIR/QRCode" ]
+}
+
+if ! have_libdeps; then
+  if command -v pio >/dev/null 2>&1; then
+    echo "Bootstrapping library dependencies for the emulator..."
+    (cd "$ROOT_DIR" && pio pkg install -e default)
+  fi
+fi
+
+if ! have_libdeps; then
+  echo "JPEGDEC/PNGdec/ArduinoJson/QRCode not found under $LIBDEPS_DIR" >&2
+  echo "Install them with: pio pkg install -e default" >&2
+  exit 1
+fi
+
+CC_BIN="${CC:-gcc}"
+CXX_BIN="${CXX:-g++}"
+MAIN_SOURCE="${1:-}"
+BIN_PATH="${2:-$BUILD_DIR/emulator}"
+OBJ_DIR="$BIN_PATH.obj"
+JOBS="${JOBS:-$(getconf _NPROCESSORS_ONLN 2>/dev/null || echo 4)}"
+read -r -a EXTRA_FLAGS <<<"${EMULATOR_CXXFLAGS:-}"
+mkdir -p "$(dirname "$BIN_PATH")" "$OBJ_DIR"
+
+# The radio stays off on the host: BLE provisioning is compiled out and the WiFi stubs never connect.
+DEFINES=(
+  -DCROSSPOINT_EMULATED=1
+  -DENABLE_SERIAL_LOG
+  "-DLOG_LEVEL=${LOG_LEVEL:-1}"
+  -DEINK_DISPLAY_SINGLE_BUFFER_MODE=1
+  -DENABLE_BLE_WIFI_PROVISIONING=0
+  -DXML_GE=0
+  -DXML_CONTEXT_BYTES=1024
+  -DPNG_MAX_BUFFERED_PIXELS=16416
+  '-DCROSSPOINT_VERSION="emulator"'
+)
+
+INCLUDES=(-Itools/emulator/stubs -Itools/emulator/hal -Iinclude -Isrc)
+for dir in "$ROOT_DIR"/lib/*/; do
+  INCLUDES+=("-Ilib/$(basename "$dir")")
+done
+INCLUDES+=(
+  -Ilib/third_party/uzlib/src
+  -Ilib/third_party/picojpeg
+  -Ilib/third_party/expat
+  -Ilib/third_party/md4c
+  -I"$LIBDEPS_DIR/JPEGDEC/src"
+  -I"$LIBDEPS_DIR/PNGdec/src"
+  -I"$LIBDEPS_DIR/ArduinoJson/src"
+  -I"$LIBDEPS_DIR/QRCode/src"
+)
+
+CFLAGS=(-O2 -g -ffunction-sections -fdata-sections "${EXTRA_FLAGS[@]}" "${DEFINES[@]}")
+CXXFLAGS=(-std=gnu++2a -O2 -g -pthread -ffunction-sections -fdata-sections -Wno-bidi-chars -Wno-narrowing
+  "${EXTRA_FLAGS[@]}" "${DEFINES[@]}" "${INCLUDES[@]}")
+
+# Objects built with other flags (LOG_LEVEL, EMULATOR_CXXFLAGS) are dropped
+FLAGS_STAMP="$OBJ_DIR/flags"
+if [ "$(cat "$FLAGS_STAMP" 2>/dev/null)" != "${CFLAGS[*]} ${CXXFLAGS[*]}" ]; then
+  rm -f "$OBJ_DIR"/*.o "$OBJ_DIR"/*.d
+  echo "${CFLAGS[*]} ${CXXFLAGS[*]}" >"$FLAGS_STAMP"
+fi
+
+# An object is stale when it is missing or older than anything its dependency file lists.
+stale() {
+  local obj="$1" dep="${1%.o}.d" prerequisite
+  [ -f "$obj" ] && [ -f "$dep" ] || return 0
+  for prerequisite in $(sed -e 's/^[^:]*://' -e 's/\\$//' "$dep"); do
+    [ "$prerequisite" -nt "$obj" ] && return 0
+  done
+  return 1
+}
+
+OBJECTS=()
+PIDS=()
+compile() {
+  local src="$1" obj="$OBJ_DIR/${1//\//_}.o"
+  OBJECTS+=("$obj")
+  stale "$obj" || return 0
+  while [ "$(jobs -rp | wc -l)" -ge "$JOBS" ]; do
+    sleep 0.1
+  done
+  echo "  CC $src"
+  case "$src" in
+    # md4c and expat do not compile as C++
+    *.c) "$CC_BIN" "${CFLAGS[@]}" -Ilib/third_party/expat -Ilib/third_party/md4c -MMD -c "$src" -o "$obj" & ;;
+    *) "$CXX_BIN" "${CXXFLAGS[@]}" -MMD -c "$src" -o "$obj" & ;;
+  esac
+  PIDS+=($!)
+}
+
+pushd "$ROOT_DIR" >/dev/null
+
+SOURCES=(tools/emulator/stubs/*.cpp tools/emulator/hal/*.cpp lib/hal/HalDisplay.cpp lib/hal/HalStorage.cpp)
+# uzlib_uncompress_chksum (unused) references checksum helpers the firmware gets from ROM, so sections are split and
+# dropped at link time.
+SOURCES+=(
+  lib/third_party/uzlib/src/tinflate.c
+  lib/third_party/picojpeg/picojpeg.c
+  lib/third_party/expat/xmlparse.c
+  lib/third_party/expat/xmlrole.c
+  lib/third_party/expat/xmltok.c
+  lib/third_party/md4c/md4c.c
+  lib/third_party/md4c/md4c-html.c
+  lib/third_party/md4c/entity.c
+  "$LIBDEPS_DIR"/JPEGDEC/src/JPEGDEC.cpp
+  "$LIBDEPS_DIR"/PNGdec/src/PNGdec.cpp
+)
+
+if [ -n "$MAIN_SOURCE" ]; then
+  SOURCES+=("$MAIN_SOURCE" src/SpiBusMutex.cpp src/core/fonts/BuiltinFontRegistry.cpp)
+  LIB_DIRS=(lib/Epub lib/Markdown lib/Html lib/ImageConverter lib/JpegToBmpConverter lib/PngToBmpConverter
+    lib/ZipFile lib/FsHelpers lib/GfxRenderer lib/EpdFont lib/Utf8 lib/InflateReader lib/Logging)
+else
+  # The firmware's web pages are generated from src/network/html, as the PlatformIO pre-build step does.
+  python3 scripts/build_html.py >/dev/null
+  SOURCES+=(tools/emulator/main.cpp "$LIBDEPS_DIR"/QRCode/src/qrcode.c)
+  while IFS= read -r src; do
+    SOURCES+=("$src")
+  done < <(find src -name '*.cpp' | sort)
+  LIB_DIRS=()
+  for dir in lib/*/; do
+    case "$dir" in
+      lib/hal/ | lib/third_party/) ;;
+      *) LIB_DIRS+=("${dir%/}") ;;
+    esac
+  done
+fi
+
+while IFS= read -r src; do
+  SOURCES+=("$src")
+done < <(find "${LIB_DIRS[@]}" -name '*.cpp' | sort)
+
+for src in "${SOURCES[@]}"; do
+  compile "$src"
+done
+
+FAILED=0
+for pid in "${PIDS[@]+"${PIDS[@]}"}"; do
+  wait "$pid" || FAILED=1
+done
+if [ "$FAILED" -ne 0 ]; then
+  echo "Emulator build failed" >&2
+  exit 1
+fi
+
+"$CXX_BIN" -pthread -Wl,--gc-sections "${EXTRA_FLAGS[@]}" "${OBJECTS[@]}" -o "$BIN_PATH"
+
+popd >/dev/null
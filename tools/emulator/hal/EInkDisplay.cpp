@@ -0,0 +1,169 @@
+#include "EInkDisplay.h"
+
+#include <Logging.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "Emulator.h"
+
+namespace {
+std::string frameDumpDir;
+uint32_t frameCounter = 0;
+Emulator::DisplayStats stats;
+
+bool bitAt(const uint8_t* plane, const uint32_t pixel) { return plane[pixel >> 3] & (0x80 >> (pixel & 7)); }
+
+void copyImage(uint8_t* frameBuffer, const uint8_t* imageData, const uint16_t x, const uint16_t y, const uint16_t w,
+               const uint16_t h, const bool blackOnly) {
+  const uint16_t imageWidthBytes = (w + 7) / 8;
+  for (uint16_t row = 0; row < h && y + row < EInkDisplay::DISPLAY_HEIGHT; row++) {
+    for (uint16_t col = 0; col < w && x + col < EInkDisplay::DISPLAY_WIDTH; col++) {
+      const bool white = imageData[row * imageWidthBytes + col / 8] & (0x80 >> (col & 7));
+      if (blackOnly && white) {
+        continue;
+      }
+      const uint32_t pixel = static_cast<uint32_t>(y + row) * EInkDisplay::DISPLAY_WIDTH + x + col;
+      uint8_t& byte = frameBuffer[pixel >> 3];
+      const uint8_t mask = 0x80 >> (pixel & 7);
+      byte = white ? (byte | mask) : (byte & ~mask);
+    }
+  }
+}
+
+bool writePbm(const char* path, const uint8_t* frameBuffer) {
+  FILE* out = fopen(path, "wb");
+  if (!out) {
+    return false;
+  }
+  // PBM marks black with 1, the framebuffer marks white with 1
+  fprintf(out, "P4\n%u %u\n", EInkDisplay::DISPLAY_WIDTH, EInkDisplay::DISPLAY_HEIGHT);
+  uint8_t row[EInkDisplay::DISPLAY_WIDTH_BYTES];
+  for (uint16_t y = 0; y < EInkDisplay::DISPLAY_HEIGHT; y++) {
+    const uint8_t* src = frameBuffer + y * EInkDisplay::DISPLAY_WIDTH_BYTES;
+    for (uint16_t i = 0; i < EInkDisplay::DISPLAY_WIDTH_BYTES; i++) {
+      row[i] = ~src[i];
+    }
+    fwrite(row, 1, sizeof(row), out);
+  }
+  return fclose(out) == 0;
+}
+}  // namespace
+
+void Emulator::setFrameDumpDir(const std::string& hostDir) { frameDumpDir = hostDir; }
+
+Emulator::DisplayStats Emulator::getDisplayStats() { return stats; }
+
+EInkDisplay::EInkDisplay(int8_t /*sclk*/, int8_t /*mosi*/, int8_t /*cs*/, int8_t /*dc*/, int8_t /*rst*/,
+                         int8_t /*busy*/)
+    : frameBuffer(new uint8_t[BUFFER_SIZE]),
+      lsbPlane(new uint8_t[BUFFER_SIZE]),
+      msbPlane(new uint8_t[BUFFER_SIZE]),
+      panel(new uint8_t[DISPLAY_WIDTH * DISPLAY_HEIGHT]) {}
+
+void EInkDisplay::begin() {
+  memset(frameBuffer.get(), 0xFF, BUFFER_SIZE);
+  memset(lsbPlane.get(), 0x00, BUFFER_SIZE);
+  memset(msbPlane.get(), 0x00, BUFFER_SIZE);
+  memset(panel.get(), 0xFF, DISPLAY_WIDTH * DISPLAY_HEIGHT);
+}
+
+void EInkDisplay::clearScreen(const uint8_t color) const { memset(frameBuffer.get(), color, BUFFER_SIZE); }
+
+void EInkDisplay::drawImage(const uint8_t* imageData, const uint16_t x, const uint16_t y, const uint16_t w,
+                            const uint16_t h, bool /*fromProgmem*/) const {
+  copyImage(frameBuffer.get(), imageData, x, y, w, h, false);
+}
+
+void EInkDisplay::drawImageTransparent(const uint8_t* imageData, const uint16_t x, const uint16_t y, const uint16_t w,
+                                       const uint16_t h, bool /*fromProgmem*/) const {
+  copyImage(frameBuffer.get(), imageData, x, y, w, h, true);
+}
+
+void EInkDisplay::displayBuffer(const RefreshMode mode, bool /*turnOffScreen*/) {
+  switch (mode) {
+    case FULL_REFRESH:
+      stats.fullRefreshes++;
+      break;
+    case HALF_REFRESH:
+      stats.halfRefreshes++;
+      break;
+    case FAST_REFRESH:
+      stats.fastRefreshes++;
+      break;
+  }
+  latchBwFrame();
+  dumpFrame("bw");
+}
+
+void EInkDisplay::refreshDisplay(const RefreshMode mode, const bool turnOffScreen) {
+  displayBuffer(mode, turnOffScreen);
+}
+
+void EInkDisplay::saveFrameBufferAsPBM(const char* filename) {
+  if (!writePbm(filename, frameBuffer.get())) {
+    LOG_ERR("EMU", "Could not write %s", filename);
+  }
+}
+
+void EInkDisplay::copyGrayscaleBuffers(const uint8_t* lsbBuffer, const uint8_t* msbBuffer) {
+  copyGrayscaleLsbBuffers(lsbBuffer);
+  copyGrayscaleMsbBuffers(msbBuffer);
+}
+
+void EInkDisplay::copyGrayscaleLsbBuffers(const uint8_t* lsbBuffer) { memcpy(lsbPlane.get(), lsbBuffer, BUFFER_SIZE); }
+
+void EInkDisplay::copyGrayscaleMsbBuffers(const uint8_t* msbBuffer) { memcpy(msbPlane.get(), msbBuffer, BUFFER_SIZE); }
+
+void EInkDisplay::cleanupGrayscaleBuffers(const uint8_t* /*bwBuffer*/) {
+  // The controller's planes go back to the BW image; the panel keeps showing the grays until the next refresh
+  memset(lsbPlane.get(), 0x00, BUFFER_SIZE);
+  memset(msbPlane.get(), 0x00, BUFFER_SIZE);
+}
+
+void EInkDisplay::displayGrayBuffer(bool /*turnOffScreen*/) {
+  stats.grayRefreshes++;
+  // A set bit in a gray plane moves that pixel from the BW image to a gray: MSB alone is light gray, LSB dark gray
+  for (uint32_t pixel = 0; pixel < static_cast<uint32_t>(DISPLAY_WIDTH) * DISPLAY_HEIGHT; pixel++) {
+    const bool lsb = bitAt(lsbPlane.get(), pixel);
+    const bool msb = bitAt(msbPlane.get(), pixel);
+    if (lsb) {
+      panel[pixel] = 85;
+    } else if (msb) {
+      panel[pixel] = 170;
+    }
+  }
+  dumpFrame("gray");
+}
+
+void EInkDisplay::latchBwFrame() {
+  for (uint32_t pixel = 0; pixel < static_cast<uint32_t>(DISPLAY_WIDTH) * DISPLAY_HEIGHT; pixel++) {
+    panel[pixel] = bitAt(frameBuffer.get(), pixel) ? 255 : 0;
+  }
+}
+
+void EInkDisplay::dumpFrame(const char* kind) const {
+  const uint32_t index = frameCounter++;
+  if (frameDumpDir.empty()) {
+    return;
+  }
+  char path[512];
+  const bool gray = strcmp(kind, "gray") == 0;
+  snprintf(path, sizeof(path), "%s/%05u-%s.%s", frameDumpDir.c_str(), static_cast<unsigned>(index), kind,
+           gray ? "pgm" : "pbm");
+  if (!gray) {
+    if (!writePbm(path, frameBuffer.get())) {
+      LOG_ERR("EMU", "Could not write %s", path);
+    }
+    return;
+  }
+  FILE* out = fopen(path, "wb");
+  if (!out) {
+    LOG_ERR("EMU", "Could not write %s", path);
+    return;
+  }
+  fprintf(out, "P5\n%u %u\n255\n", DISPLAY_WIDTH, DISPLAY_HEIGHT);
+  fwrite(panel.get(), 1, static_cast<size_t>(DISPLAY_WIDTH) * DISPLAY_HEIGHT, out);
+  fclose(out);
+}
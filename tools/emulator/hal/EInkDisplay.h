@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+// The X4 panel driver, emulated: the framebuffer and the two grayscale planes live in host memory and a refresh
+// records what the panel would show instead of driving the controller. The interface is the SDK driver's, so
+// lib/hal/HalDisplay.cpp builds against it unchanged.
+class EInkDisplay {
+ public:
+  static constexpr uint16_t DISPLAY_WIDTH = 800;
+  static constexpr uint16_t DISPLAY_HEIGHT = 480;
+  static constexpr uint16_t DISPLAY_WIDTH_BYTES = DISPLAY_WIDTH / 8;
+  static constexpr uint32_t BUFFER_SIZE = DISPLAY_WIDTH_BYTES * DISPLAY_HEIGHT;
+
+  enum RefreshMode { FULL_REFRESH, HALF_REFRESH, FAST_REFRESH };
+
+  EInkDisplay(int8_t sclk, int8_t mosi, int8_t cs, int8_t dc, int8_t rst, int8_t busy);
+
+  void begin();
+  void setDisplayX3() {}
+  void requestResync(uint8_t /*passes*/ = 1) {}
+
+  void clearScreen(uint8_t color = 0xFF) const;
+  void drawImage(const uint8_t* imageData, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                 bool fromProgmem = false) const;
+  void drawImageTransparent(const uint8_t* imageData, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                            bool fromProgmem = false) const;
+
+  void displayBuffer(RefreshMode mode = FAST_REFRESH, bool turnOffScreen = false);
+  void refreshDisplay(RefreshMode mode = FAST_REFRESH, bool turnOffScreen = false);
+  void deepSleep() {}
+
+  uint8_t* getFrameBuffer() const { return frameBuffer.get(); }
+  void saveFrameBufferAsPBM(const char* filename);
+
+  void copyGrayscaleBuffers(const uint8_t* lsbBuffer, const uint8_t* msbBuffer);
+  void copyGrayscaleLsbBuffers(const uint8_t* lsbBuffer);
+  void copyGrayscaleMsbBuffers(const uint8_t* msbBuffer);
+  void cleanupGrayscaleBuffers(const uint8_t* bwBuffer);
+  void displayGrayBuffer(bool turnOffScreen = false);
+
+  uint16_t getDisplayWidth() const { return DISPLAY_WIDTH; }
+  uint16_t getDisplayHeight() const { return DISPLAY_HEIGHT; }
+  uint16_t getDisplayWidthBytes() const { return DISPLAY_WIDTH_BYTES; }
+  uint32_t getBufferSize() const { return BUFFER_SIZE; }
+
+ private:
+  std::unique_ptr<uint8_t[]> frameBuffer;
+  std::unique_ptr<uint8_t[]> lsbPlane;
+  std::unique_ptr<uint8_t[]> msbPlane;
+  // One byte per pixel, what the panel currently shows: 0 black, 85 dark gray, 170 light gray, 255 white
+  std::unique_ptr<uint8_t[]> panel;
+
+  void latchBwFrame();
+  void dumpFrame(const char* kind) const;
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Controls for the host backends behind the HAL. The firmware code never includes this; the emulator's main() uses it
+// to point the backends at a card directory, an output directory and a button script, and to tell when the firmware
+// has settled.
+namespace Emulator {
+
+// Card: firmware paths resolve below this host directory ("/Books/a.epub" -> "<root>/Books/a.epub").
+void setStorageRoot(const std::string& hostDir);
+
+// Panel: when set, every BW refresh writes <dir>/NNNNN-bw.pbm with the framebuffer and every grayscale refresh writes
+// <dir>/NNNNN-gray.pgm with the four-level image the panel shows. Images are panel-native, 800x480 on the X4.
+void setFrameDumpDir(const std::string& hostDir);
+
+struct DisplayStats {
+  uint32_t fullRefreshes = 0;
+  uint32_t halfRefreshes = 0;
+  uint32_t fastRefreshes = 0;
+  uint32_t grayRefreshes = 0;
+};
+DisplayStats getDisplayStats();
+
+// Buttons: a whitespace separated list of presses, each `button`, `button*count` or `button@holdMs`, with button one of
+// back, confirm, left, right, up, down, power. Every HalGPIO::update() advances the script by one edge: a press, then
+// its release on the next update. Returns false (and loads nothing) if a token does not parse.
+bool loadButtonScript(const std::string& script);
+// True once every scripted press has been released
+bool buttonScriptFinished();
+// With pacing on, the next scripted press only starts after allowNextPress(), so a driver can wait for the firmware to
+// settle between presses. Off by default: presses follow each other on consecutive updates.
+void setButtonScriptPaced(bool paced);
+void allowNextPress();
+
+// Tasks: true when every task the firmware started is parked waiting for a notification with none pending, or has
+// returned. Together with an idle main loop this means nothing is being laid out or drawn.
+bool tasksIdle();
+
+}  // namespace Emulator
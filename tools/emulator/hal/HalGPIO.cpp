@@ -0,0 +1,157 @@
+#include <HalGPIO.h>
+#include <Logging.h>
+
+#include <cstdlib>
+#include <deque>
+#include <sstream>
+#include <string>
+
+#include "Emulator.h"
+
+// Host backend for HalGPIO: buttons follow the script loaded with Emulator::loadButtonScript(), USB is never
+// connected and the device is always an X4. Built with CROSSPOINT_EMULATED=1, which leaves InputManager out of
+// HalGPIO.
+
+// Global HalGPIO instance
+HalGPIO gpio;
+
+namespace {
+// A tap is reported as held this long, like a quick press on the device
+constexpr unsigned long DEFAULT_HOLD_MS = 80;
+
+struct ScriptedPress {
+  uint8_t button;
+  unsigned long holdMs;
+};
+
+std::deque<ScriptedPress> script;
+bool pressActive = false;
+bool paced = false;
+bool pressAllowed = false;
+ScriptedPress activePress{};
+uint8_t pressedMask = 0;
+uint8_t pressedEdges = 0;
+uint8_t releasedEdges = 0;
+unsigned long heldTime = 0;
+
+bool parseButton(const std::string& name, uint8_t& button) {
+  static constexpr const char* NAMES[] = {"back", "confirm", "left", "right", "up", "down", "power"};
+  for (uint8_t i = 0; i < sizeof(NAMES) / sizeof(NAMES[0]); i++) {
+    if (name == NAMES[i]) {
+      button = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool parseNumber(const std::string& text, unsigned long& value) {
+  if (text.empty()) {
+    return false;
+  }
+  char* end = nullptr;
+  value = strtoul(text.c_str(), &end, 10);
+  return *end == '\0';
+}
+}  // namespace
+
+bool Emulator::loadButtonScript(const std::string& text) {
+  std::deque<ScriptedPress> parsed;
+  std::istringstream tokens(text);
+  std::string token;
+  while (tokens >> token) {
+    const size_t modifiers = token.find_first_of("*@");
+    ScriptedPress press{0, DEFAULT_HOLD_MS};
+    unsigned long count = 1;
+    if (!parseButton(token.substr(0, modifiers), press.button)) {
+      LOG_ERR("EMU", "Unknown button in script: %s", token.c_str());
+      return false;
+    }
+    size_t pos = modifiers;
+    while (pos != std::string::npos) {
+      const size_t next = token.find_first_of("*@", pos + 1);
+      const std::string value = token.substr(pos + 1, next == std::string::npos ? std::string::npos : next - pos - 1);
+      if (!parseNumber(value, token[pos] == '*' ? count : press.holdMs)) {
+        LOG_ERR("EMU", "Bad modifier in script: %s", token.c_str());
+        return false;
+      }
+      pos = next;
+    }
+    parsed.insert(parsed.end(), count, press);
+  }
+  script = std::move(parsed);
+  return true;
+}
+
+bool Emulator::buttonScriptFinished() { return script.empty() && !pressActive; }
+
+void Emulator::setButtonScriptPaced(const bool enabled) { paced = enabled; }
+
+void Emulator::allowNextPress() { pressAllowed = true; }
+
+void HalGPIO::begin() { LOG_INF("EMU", "Emulated X4 buttons"); }
+
+void HalGPIO::update() {
+  pressedEdges = 0;
+  releasedEdges = 0;
+  if (pressActive) {
+    pressActive = false;
+    pressedMask = 0;
+    releasedEdges = static_cast<uint8_t>(1u << activePress.button);
+    heldTime = activePress.holdMs;
+  } else if (!script.empty() && (!paced || pressAllowed)) {
+    pressAllowed = false;
+    activePress = script.front();
+    script.pop_front();
+    pressActive = true;
+    pressedMask = static_cast<uint8_t>(1u << activePress.button);
+    pressedEdges = pressedMask;
+    heldTime = activePress.holdMs;
+  }
+
+  const bool connected = isUsbConnected();
+  usbStateChanged = (connected != lastUsbConnected);
+  lastUsbConnected = connected;
+}
+
+bool HalGPIO::wasUsbStateChanged() const { return usbStateChanged; }
+
+bool HalGPIO::isPressed(const uint8_t buttonIndex) const { return pressedMask & (1u << buttonIndex); }
+
+bool HalGPIO::wasPressed(const uint8_t buttonIndex) const {
+  const uint8_t bit = static_cast<uint8_t>(1u << buttonIndex);
+  if (virtualButtonMask & bit) {
+    virtualButtonMask &= static_cast<uint8_t>(~bit);
+    return true;
+  }
+  return pressedEdges & bit;
+}
+
+bool HalGPIO::wasAnyPressed() const { return virtualButtonMask != 0 || pressedEdges != 0; }
+
+bool HalGPIO::wasReleased(const uint8_t buttonIndex) const {
+  const uint8_t bit = static_cast<uint8_t>(1u << buttonIndex);
+  if (virtualButtonMask & bit) {
+    virtualButtonMask &= static_cast<uint8_t>(~bit);
+    return true;
+  }
+  return releasedEdges & bit;
+}
+
+bool HalGPIO::wasAnyReleased() const { return virtualButtonMask != 0 || releasedEdges != 0; }
+
+void HalGPIO::injectVirtualButton(uint8_t buttonIndex) { virtualButtonMask |= static_cast<uint8_t>(1u << buttonIndex); }
+
+unsigned long HalGPIO::getHeldTime() const { return heldTime; }
+
+void HalGPIO::startDeepSleep() {
+  LOG_INF("EMU", "Deep sleep, ending the session");
+  Serial.flush();
+  std::exit(0);
+}
+
+void HalGPIO::verifyPowerButtonWakeup(uint16_t /*requiredDurationMs*/, bool /*shortPressAllowed*/) {}
+
+bool HalGPIO::isUsbConnected() const { return false; }
+
+HalGPIO::WakeupReason HalGPIO::getWakeupReason() const { return WakeupReason::PowerButton; }
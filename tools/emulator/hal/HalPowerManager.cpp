@@ -0,0 +1,85 @@
+#include "HalPowerManager.h"
+
+#include <Logging.h>
+
+#include <cassert>
+#include <cstdlib>
+
+#include "HalGPIO.h"
+
+// Host backend for HalPowerManager: the lock bookkeeping is the device's, the clock switch only records the frequency,
+// the battery is always full and deep sleep ends the process.
+
+HalPowerManager powerManager;  // Singleton instance
+
+void HalPowerManager::begin() {
+  normalFreq = getCpuFrequencyMhz();
+  modeMutex = xSemaphoreCreateMutex();
+  assert(modeMutex != nullptr);
+}
+
+void HalPowerManager::setPowerSaving(bool enabled) {
+  if (normalFreq <= 0) {
+    return;  // invalid state
+  }
+
+  const int count = lockCount;
+
+  if (count == 0 && enabled && !isLowPower) {
+    LOG_DBG("PWR", "Going to low-power mode");
+    setCpuFrequencyMhz(LOW_POWER_FREQ);
+    isLowPower = true;
+  } else if ((!enabled || count > 0) && isLowPower) {
+    LOG_DBG("PWR", "Restoring normal CPU frequency");
+    setCpuFrequencyMhz(normalFreq);
+    isLowPower = false;
+  }
+}
+
+void HalPowerManager::startDeepSleep(HalGPIO& gpio) const {
+  // Like the device, wait for the power button to be released first
+  while (gpio.isPressed(HalGPIO::BTN_POWER)) {
+    delay(50);
+    gpio.update();
+  }
+  LOG_INF("EMU", "Deep sleep, ending the session");
+  Serial.flush();
+  std::exit(0);
+}
+
+uint16_t HalPowerManager::getBatteryPercentage() const { return 100; }
+
+HalPowerManager::Lock::Lock() {
+  if (powerManager.modeMutex == nullptr) {
+    LOG_ERR("PWR", "HalPowerManager used before begin(); skipping lock");
+    valid = false;
+    return;
+  }
+
+  xSemaphoreTake(powerManager.modeMutex, portMAX_DELAY);
+  powerManager.lockCount++;
+  valid = true;
+  xSemaphoreGive(powerManager.modeMutex);
+
+  powerManager.setPowerSaving(false);
+}
+
+HalPowerManager::Lock::~Lock() {
+  if (powerManager.modeMutex == nullptr) {
+    return;
+  }
+
+  bool shouldReEnable = false;
+  xSemaphoreTake(powerManager.modeMutex, portMAX_DELAY);
+  if (valid) {
+    if (powerManager.lockCount > 0) {
+      powerManager.lockCount--;
+    }
+    shouldReEnable = (powerManager.lockCount == 0);
+  }
+  xSemaphoreGive(powerManager.modeMutex);
+
+  if (shouldReEnable) {
+    powerManager.setPowerSaving(true);
+  }
+}
@@ -0,0 +1,13 @@
+#include "HalSystem.h"
+
+// Host backend for HalSystem: a crash in the emulator is a host crash, so there is no panic state to keep.
+
+void HalSystem::begin() {}
+
+void HalSystem::checkPanic() {}
+
+void HalSystem::clearPanic() {}
+
+std::string HalSystem::getPanicInfo(bool /*full*/) { return {}; }
+
+bool HalSystem::isRebootFromPanic() { return false; }
@@ -0,0 +1,377 @@
+#include "SDCardManager.h"
+
+#include <Logging.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <climits>
+#include <ctime>
+#include <cstring>
+#include <filesystem>
+#include <system_error>
+
+#include "Emulator.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+std::string childPath(const std::string& dirPath, const char* name) {
+  if (dirPath.empty() || dirPath.back() != '/') {
+    return dirPath + "/" + name;
+  }
+  return dirPath + name;
+}
+
+const char* fopenMode(const oflag_t oflag) {
+  switch (oflag & O_ACCMODE) {
+    case O_WRONLY:
+      return (oflag & O_APPEND) ? "ab" : "wb";
+    case O_RDWR:
+      return (oflag & O_APPEND) ? "a+b" : "r+b";
+    default:
+      return "rb";
+  }
+}
+}  // namespace
+
+void Emulator::setStorageRoot(const std::string& hostDir) { SDCardManager::getInstance().setRoot(hostDir); }
+
+// ---- FsFile ----
+
+FsFile::~FsFile() { close(); }
+
+FsFile::FsFile(FsFile&& other) noexcept { *this = std::move(other); }
+
+FsFile& FsFile::operator=(FsFile&& other) noexcept {
+  if (this != &other) {
+    close();
+    cardPath = std::move(other.cardPath);
+    file = other.file;
+    dir = other.dir;
+    writable = other.writable;
+    lastWasWrite = other.lastWasWrite;
+    other.file = nullptr;
+    other.dir = nullptr;
+  }
+  return *this;
+}
+
+FsFile FsFile::openPath(const std::string& cardPath, const oflag_t oflag) {
+  FsFile result;
+  const std::string host = SDCardManager::getInstance().hostPath(cardPath);
+  std::error_code ec;
+  if (fs::is_directory(host, ec)) {
+    result.dir = opendir(host.c_str());
+    if (result.dir) {
+      result.cardPath = cardPath;
+    }
+    return result;
+  }
+  const int fd = ::open(host.c_str(), oflag, 0644);
+  if (fd < 0) {
+    return result;
+  }
+  result.file = fdopen(fd, fopenMode(oflag));
+  if (!result.file) {
+    ::close(fd);
+    return result;
+  }
+  result.cardPath = cardPath;
+  result.writable = (oflag & O_ACCMODE) != O_RDONLY;
+  return result;
+}
+
+void FsFile::switchDirection(const bool toWrite) {
+  if (lastWasWrite != toWrite) {
+    fseek(file, 0, SEEK_CUR);
+    lastWasWrite = toWrite;
+  }
+}
+
+void FsFile::flush() {
+  if (file) {
+    fflush(file);
+  }
+}
+
+size_t FsFile::getName(char* name, const size_t len) {
+  const size_t slash = cardPath.find_last_of('/');
+  const std::string base = slash == std::string::npos ? cardPath : cardPath.substr(slash + 1);
+  if (!isOpen() || len == 0 || base.size() >= len) {
+    return 0;
+  }
+  memcpy(name, base.c_str(), base.size() + 1);
+  return base.size();
+}
+
+size_t FsFile::size() const {
+  if (!file) {
+    return 0;
+  }
+  if (writable) {
+    fflush(file);
+  }
+  struct stat st = {};
+  return fstat(fileno(file), &st) == 0 ? static_cast<size_t>(st.st_size) : 0;
+}
+
+bool FsFile::getModifyDateTime(uint16_t* pdate, uint16_t* ptime) {
+  struct stat st = {};
+  if (!isOpen() || stat(SDCardManager::getInstance().hostPath(cardPath).c_str(), &st) != 0) {
+    return false;
+  }
+  // FAT packing: years since 1980, month, day / hours, minutes, seconds / 2
+  struct tm local = {};
+  localtime_r(&st.st_mtime, &local);
+  *pdate = static_cast<uint16_t>(((local.tm_year - 80) << 9) | ((local.tm_mon + 1) << 5) | local.tm_mday);
+  *ptime = static_cast<uint16_t>((local.tm_hour << 11) | (local.tm_min << 5) | (local.tm_sec / 2));
+  return true;
+}
+
+bool FsFile::seekSet(const size_t offset) {
+  return file && fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+}
+
+bool FsFile::seekCur(const int64_t offset) { return file && fseeko(file, static_cast<off_t>(offset), SEEK_CUR) == 0; }
+
+int FsFile::available() const {
+  if (!file) {
+    return 0;
+  }
+  const size_t total = size();
+  const size_t pos = position();
+  return pos >= total ? 0 : static_cast<int>(std::min<size_t>(total - pos, INT_MAX));
+}
+
+size_t FsFile::position() const {
+  if (!file) {
+    return 0;
+  }
+  const off_t pos = ftello(file);
+  return pos < 0 ? 0 : static_cast<size_t>(pos);
+}
+
+int FsFile::read(void* buf, const size_t count) {
+  if (!file) {
+    return -1;
+  }
+  switchDirection(false);
+  const size_t n = fread(buf, 1, count, file);
+  return n == 0 && ferror(file) ? -1 : static_cast<int>(n);
+}
+
+int FsFile::read() {
+  uint8_t b;
+  return read(&b, 1) == 1 ? b : -1;
+}
+
+int FsFile::peek() {
+  const int b = read();
+  if (b >= 0) {
+    seekCur(-1);
+  }
+  return b;
+}
+
+size_t FsFile::write(const void* buf, const size_t count) {
+  if (!file || !writable) {
+    return 0;
+  }
+  switchDirection(true);
+  return fwrite(buf, 1, count, file);
+}
+
+size_t FsFile::write(const uint8_t b) { return write(&b, 1); }
+
+bool FsFile::rename(const char* newPath) {
+  if (!file) {
+    return false;
+  }
+  fflush(file);
+  auto& card = SDCardManager::getInstance();
+  if (::rename(card.hostPath(cardPath).c_str(), card.hostPath(newPath).c_str()) != 0) {
+    return false;
+  }
+  cardPath = newPath;
+  return true;
+}
+
+void FsFile::rewindDirectory() {
+  if (dir) {
+    rewinddir(dir);
+  }
+}
+
+bool FsFile::close() {
+  bool ok = true;
+  if (file) {
+    ok = fclose(file) == 0;
+    file = nullptr;
+  }
+  if (dir) {
+    closedir(dir);
+    dir = nullptr;
+  }
+  return ok;
+}
+
+FsFile FsFile::openNextFile() {
+  if (!dir) {
+    return {};
+  }
+  while (const dirent* entry = readdir(dir)) {
+    if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+      continue;
+    }
+    return openPath(childPath(cardPath, entry->d_name), O_RDONLY);
+  }
+  return {};
+}
+
+// ---- SDCardManager ----
+
+SDCardManager& SDCardManager::getInstance() {
+  static SDCardManager instance;
+  return instance;
+}
+
+std::string SDCardManager::hostPath(const std::string& cardPath) const {
+  if (cardPath.empty() || cardPath.front() != '/') {
+    return root + "/" + cardPath;
+  }
+  return root + cardPath;
+}
+
+bool SDCardManager::begin() {
+  std::error_code ec;
+  initialized = fs::is_directory(root, ec);
+  if (!initialized) {
+    LOG_ERR("SD", "Card directory %s does not exist", root.c_str());
+  }
+  return initialized;
+}
+
+std::vector<String> SDCardManager::listFiles(const char* path, const int maxFiles) {
+  std::vector<String> names;
+  std::error_code ec;
+  for (const auto& entry : fs::directory_iterator(hostPath(path), ec)) {
+    names.emplace_back(entry.path().filename().string());
+  }
+  // Directory order on the host is arbitrary; sort so sessions list files the same way on every machine
+  std::sort(names.begin(), names.end());
+  if (maxFiles >= 0 && names.size() > static_cast<size_t>(maxFiles)) {
+    names.resize(maxFiles);
+  }
+  return names;
+}
+
+String SDCardManager::readFile(const char* path) {
+  FsFile file;
+  if (!openFileForRead("SD", path, file)) {
+    return String();
+  }
+  std::string content(file.size(), '\0');
+  const int n = file.read(content.data(), content.size());
+  content.resize(n > 0 ? n : 0);
+  return String(content);
+}
+
+bool SDCardManager::readFileToStream(const char* path, Print& out, const size_t chunkSize) {
+  FsFile file;
+  if (!openFileForRead("SD", path, file)) {
+    return false;
+  }
+  std::vector<uint8_t> chunk(chunkSize > 0 ? chunkSize : 256);
+  int n;
+  while ((n = file.read(chunk.data(), chunk.size())) > 0) {
+    out.write(chunk.data(), n);
+  }
+  return n == 0;
+}
+
+size_t SDCardManager::readFileToBuffer(const char* path, char* buffer, const size_t bufferSize,
+                                       const size_t maxBytes) {
+  if (!buffer || bufferSize == 0) {
+    return 0;
+  }
+  buffer[0] = '\0';
+  FsFile file;
+  if (!openFileForRead("SD", path, file)) {
+    return 0;
+  }
+  size_t toRead = bufferSize - 1;
+  if (maxBytes > 0 && maxBytes < toRead) {
+    toRead = maxBytes;
+  }
+  const int n = file.read(buffer, toRead);
+  const size_t count = n > 0 ? n : 0;
+  buffer[count] = '\0';
+  return count;
+}
+
+bool SDCardManager::writeFile(const char* path, const String& content) {
+  FsFile file;
+  if (!openFileForWrite("SD", path, file)) {
+    return false;
+  }
+  return file.write(content.c_str(), content.length()) == content.length() && file.close();
+}
+
+bool SDCardManager::ensureDirectoryExists(const char* path) { return mkdir(path, true); }
+
+FsFile SDCardManager::open(const char* path, const oflag_t oflag) { return FsFile::openPath(path, oflag); }
+
+bool SDCardManager::mkdir(const char* path, const bool pFlag) {
+  std::error_code ec;
+  const std::string host = hostPath(path);
+  if (pFlag) {
+    fs::create_directories(host, ec);
+  } else {
+    fs::create_directory(host, ec);
+  }
+  return fs::is_directory(host, ec);
+}
+
+bool SDCardManager::exists(const char* path) {
+  std::error_code ec;
+  return fs::exists(hostPath(path), ec);
+}
+
+bool SDCardManager::remove(const char* path) { return ::unlink(hostPath(path).c_str()) == 0; }
+
+bool SDCardManager::rename(const char* oldPath, const char* newPath) {
+  return ::rename(hostPath(oldPath).c_str(), hostPath(newPath).c_str()) == 0;
+}
+
+bool SDCardManager::rmdir(const char* path) { return ::rmdir(hostPath(path).c_str()) == 0; }
+
+bool SDCardManager::removeDir(const char* path) {
+  std::error_code ec;
+  fs::remove_all(hostPath(path), ec);
+  return !ec;
+}
+
+bool SDCardManager::openFileForRead(const char* moduleName, const char* path, FsFile& file) {
+  std::error_code ec;
+  if (!fs::is_regular_file(hostPath(path), ec)) {
+    LOG_ERR(moduleName, "File does not exist: %s", path);
+    return false;
+  }
+  file = FsFile::openPath(path, O_RDONLY);
+  if (!file) {
+    LOG_ERR(moduleName, "Failed to open file for reading: %s", path);
+    return false;
+  }
+  return true;
+}
+
+bool SDCardManager::openFileForWrite(const char* moduleName, const char* path, FsFile& file) {
+  file = FsFile::openPath(path, O_RDWR | O_CREAT | O_TRUNC);
+  if (!file || file.isDirectory()) {
+    LOG_ERR(moduleName, "Failed to open file for writing: %s", path);
+    file.close();
+    return false;
+  }
+  return true;
+}
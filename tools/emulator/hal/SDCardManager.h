@@ -0,0 +1,93 @@
+#pragma once
+
+#include <Stream.h>
+#include <WString.h>
+#include <common/FsApiConstants.h>
+#include <dirent.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// The SD card, emulated by a host directory (see Emulator::setStorageRoot). FsFile and SDCardManager keep the SdFat
+// and SDK interfaces lib/hal/HalStorage.cpp calls, so the HAL's locking wrapper runs unchanged on top of them.
+class FsFile : public Stream {
+ public:
+  FsFile() = default;
+  ~FsFile() override;
+  FsFile(FsFile&& other) noexcept;
+  FsFile& operator=(FsFile&& other) noexcept;
+  FsFile(const FsFile&) = delete;
+  FsFile& operator=(const FsFile&) = delete;
+
+  void flush() override;
+  size_t getName(char* name, size_t len);
+  size_t size() const;
+  size_t fileSize() const { return size(); }
+  bool getModifyDateTime(uint16_t* pdate, uint16_t* ptime);
+  bool seekSet(size_t offset);
+  bool seekCur(int64_t offset);
+  int available() const;
+  int available() override { return static_cast<const FsFile&>(*this).available(); }
+  size_t position() const;
+  int read(void* buf, size_t count);
+  int read() override;
+  int peek() override;
+  size_t write(const void* buf, size_t count);
+  size_t write(uint8_t b) override;
+  bool rename(const char* newPath);
+  bool isDirectory() const { return dir != nullptr; }
+  void rewindDirectory();
+  bool close();
+  FsFile openNextFile();
+  bool isOpen() const { return file != nullptr || dir != nullptr; }
+  operator bool() const { return isOpen(); }
+
+ private:
+  friend class SDCardManager;
+
+  std::string cardPath;
+  FILE* file = nullptr;
+  DIR* dir = nullptr;
+  bool writable = false;
+  bool lastWasWrite = false;
+
+  static FsFile openPath(const std::string& cardPath, oflag_t oflag);
+  // C streams need a seek between a read and a write on the same handle
+  void switchDirection(bool toWrite);
+};
+
+class SDCardManager {
+ public:
+  static SDCardManager& getInstance();
+
+  bool begin();
+  bool ready() const { return initialized; }
+
+  std::vector<String> listFiles(const char* path = "/", int maxFiles = 200);
+  String readFile(const char* path);
+  bool readFileToStream(const char* path, Print& out, size_t chunkSize = 256);
+  size_t readFileToBuffer(const char* path, char* buffer, size_t bufferSize, size_t maxBytes = 0);
+  bool writeFile(const char* path, const String& content);
+  bool ensureDirectoryExists(const char* path);
+
+  FsFile open(const char* path, oflag_t oflag = O_RDONLY);
+  bool mkdir(const char* path, bool pFlag = true);
+  bool exists(const char* path);
+  bool remove(const char* path);
+  bool rename(const char* oldPath, const char* newPath);
+  bool rmdir(const char* path);
+  bool removeDir(const char* path);
+
+  bool openFileForRead(const char* moduleName, const char* path, FsFile& file);
+  bool openFileForWrite(const char* moduleName, const char* path, FsFile& file);
+
+  // Host location of a card path
+  std::string hostPath(const std::string& cardPath) const;
+  void setRoot(const std::string& hostDir) { root = hostDir; }
+
+ private:
+  std::string root = ".";
+  bool initialized = false;
+};
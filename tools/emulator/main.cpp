@@ -0,0 +1,140 @@
+// Headless firmware session on the host. The whole firmware - src/main.cpp's setup() and loop(), ActivityManager and
+// every reader activity - runs unmodified on top of the emulated panel, card and buttons in tools/emulator/hal, with
+// the radio off. The driver only plays the part of the user: it opens a book the way a remote open does, presses the
+// scripted buttons and stops once the firmware has settled.
+//
+//   emulator [--sd DIR] [--frames DIR] [--script "right*20 left"] [--rapid] [--timeout MS] /Books/book.epub
+//
+// The book path is a card path below --sd and may be anything the firmware opens (EPUB, XTC, TXT, Markdown). Each
+// scripted press waits until the firmware has drawn the previous one, like a reader turning pages; with --rapid the
+// presses start as soon as the reader is up and follow each other on consecutive loop iterations, while chapters are
+// still being laid out. Power held past the sleep threshold (e.g. power@1000) puts the device to sleep and ends the
+// session. A summary is printed to stdout when the session ends.
+
+#include <Arduino.h>
+#include <Logging.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "CrossPointState.h"
+#include "Emulator.h"
+#include "activities/ActivityManager.h"
+
+namespace {
+
+// The firmware counts as settled once its tasks have been parked this long with the main loop running
+constexpr unsigned long SETTLE_MS = 300;
+constexpr unsigned long DEFAULT_TIMEOUT_MS = 120000;
+
+struct Options {
+  std::string sdRoot = ".";
+  std::string frameDir;
+  std::string script;
+  std::string book;
+  bool rapid = false;
+  unsigned long timeoutMs = DEFAULT_TIMEOUT_MS;
+};
+
+Options options;
+unsigned long sessionStart = 0;
+bool readerOpen = false;
+
+// Also runs when the firmware ends the session itself by going to sleep
+void printSummary() {
+  const auto stats = Emulator::getDisplayStats();
+  printf("book: %s\n", options.book.c_str());
+  printf("reader open: %s\n", readerOpen ? "yes" : "no");
+  printf("refreshes: full %u, half %u, fast %u, gray %u\n", stats.fullRefreshes, stats.halfRefreshes,
+         stats.fastRefreshes, stats.grayRefreshes);
+  printf("session: %lums\n", millis() - sessionStart);
+  fflush(stdout);
+}
+
+// Runs loop() until `done(settled)` holds, where settled means the firmware's tasks have been idle for SETTLE_MS.
+// Returns false on timeout.
+template <typename Done>
+bool runUntil(Done done) {
+  unsigned long settleStart = millis();
+  while (true) {
+    loop();
+    readerOpen = activityManager.isReaderActivity();
+    const unsigned long now = millis();
+    if (!Emulator::tasksIdle() || !APP_STATE.pendingOpenPath.empty()) {
+      settleStart = now;
+    }
+    const bool settled = now - settleStart >= SETTLE_MS;
+    if (done(settled)) {
+      return true;
+    }
+    if (settled && !options.rapid) {
+      Emulator::allowNextPress();
+      settleStart = now;
+    }
+    if (now - sessionStart >= options.timeoutMs) {
+      LOG_ERR("EMU", "Firmware did not settle within %lums", options.timeoutMs);
+      return false;
+    }
+  }
+}
+
+void usage(const char* argv0) {
+  fprintf(stderr, "usage: %s [--sd DIR] [--frames DIR] [--script PRESSES] [--rapid] [--timeout MS] BOOK\n", argv0);
+}
+
+bool parseArgs(const int argc, char** argv) {
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    const bool hasValue = i + 1 < argc;
+    if (arg == "--sd" && hasValue) {
+      options.sdRoot = argv[++i];
+    } else if (arg == "--frames" && hasValue) {
+      options.frameDir = argv[++i];
+    } else if (arg == "--script" && hasValue) {
+      options.script = argv[++i];
+    } else if (arg == "--rapid") {
+      options.rapid = true;
+    } else if (arg == "--timeout" && hasValue) {
+      options.timeoutMs = strtoul(argv[++i], nullptr, 10);
+    } else if (arg.rfind("--", 0) == 0 || !options.book.empty()) {
+      return false;
+    } else {
+      options.book = arg;
+    }
+  }
+  return !options.book.empty();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (!parseArgs(argc, argv)) {
+    usage(argv[0]);
+    return 2;
+  }
+  if (!Emulator::loadButtonScript(options.script)) {
+    fprintf(stderr, "invalid button script: %s\n", options.script.c_str());
+    return 2;
+  }
+  Emulator::setStorageRoot(options.sdRoot);
+  Emulator::setFrameDumpDir(options.frameDir);
+  sessionStart = millis();
+  atexit(printSummary);
+
+  // setup() and the first loops read the buttons too, so the script is held until the book is on screen. In rapid
+  // mode it starts as soon as the reader is up, while the layout task is still working through the chapters.
+  Emulator::setButtonScriptPaced(true);
+  setup();
+  APP_STATE.pendingOpenPath = options.book;
+  if (!runUntil([](const bool settled) { return settled || (options.rapid && readerOpen); })) {
+    return 1;
+  }
+  if (!readerOpen) {
+    LOG_ERR("EMU", "The firmware did not open %s", options.book.c_str());
+    return 1;
+  }
+
+  Emulator::setButtonScriptPaced(!options.rapid);
+  return runUntil([](const bool settled) { return settled && Emulator::buttonScriptFinished(); }) ? 0 : 1;
+}
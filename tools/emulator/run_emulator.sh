@@ -0,0 +1,9 @@
+#!/usr/bin/env bash
+# Builds the host emulator and runs one reader session. Arguments are passed to the emulator, e.g.
+#   tools/emulator/run_emulator.sh --sd ~/sdcard --frames build/frames --script "right*10 left" /Books/book.epub
+set -euo pipefail
+
+ROOT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")/../.." && pwd)"
+
+"$ROOT_DIR/tools/emulator/build_emulator.sh"
+"$ROOT_DIR/build/emulator/emulator" "$@"
@@ -0,0 +1,58 @@
+#include <Arduino.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+
+HWCDC Serial;
+EspClass ESP;
+
+namespace {
+const auto processStart = std::chrono::steady_clock::now();
+uint32_t cpuFrequencyMhz = 160;
+}  // namespace
+
+unsigned long millis() {
+  const auto elapsed = std::chrono::steady_clock::now() - processStart;
+  return static_cast<unsigned long>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+}
+
+unsigned long micros() {
+  const auto elapsed = std::chrono::steady_clock::now() - processStart;
+  return static_cast<unsigned long>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+}
+
+void delay(const unsigned long ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+
+long random(const long howBig) { return howBig <= 0 ? 0 : static_cast<long>(esp_random() % howBig); }
+
+long random(const long howSmall, const long howBig) {
+  return howSmall >= howBig ? howSmall : howSmall + random(howBig - howSmall);
+}
+
+uint32_t esp_random() {
+  static std::mt19937 rng(std::random_device{}());
+  return rng();
+}
+
+uint32_t getCpuFrequencyMhz() { return cpuFrequencyMhz; }
+
+bool setCpuFrequencyMhz(const uint32_t mhz) {
+  cpuFrequencyMhz = mhz;
+  return true;
+}
+
+void EspClass::restart() { esp_restart(); }
+
+void esp_restart() {
+  fflush(stderr);
+  std::exit(0);
+}
+
+size_t HWCDC::write(const uint8_t b) { return fputc(b, stderr) == EOF ? 0 : 1; }
+
+size_t HWCDC::write(const uint8_t* buffer, const size_t size) { return fwrite(buffer, 1, size, stderr); }
+
+void HWCDC::flush() { fflush(stderr); }
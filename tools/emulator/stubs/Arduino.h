@@ -0,0 +1,28 @@
+#pragma once
+
+// Arduino core surface used by the HAL and the libraries, implemented on top of the C++ standard library.
+
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+
+#include "Esp.h"
+#include "HardwareSerial.h"
+#include "Print.h"
+#include "WString.h"
+#include "esp32-hal.h"
+
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+
+template <typename T>
+inline uint8_t pgm_read_byte(const T* ptr) {
+  return static_cast<uint8_t>(*ptr);
+}
+
+using byte = uint8_t;
+
+// The sketch entry points, from src/main.cpp
+void setup();
+void loop();
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstdint>
+
+class BatteryMonitor {
+ public:
+  explicit BatteryMonitor(int /*adcPin*/) {}
+  uint16_t readPercentage() const { return 100; }
+};
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+#include "IPAddress.h"
+#include "WString.h"
+
+enum class DNSReplyCode : uint8_t { NoError = 0, FormError, ServerFailure, NonExistentDomain };
+
+// Captive-portal DNS that never binds: the emulator has no radio.
+class DNSServer {
+ public:
+  void setErrorReplyCode(DNSReplyCode /*code*/) {}
+  void setTTL(uint32_t /*ttl*/) {}
+  bool start(uint16_t /*port*/, const String& /*domainName*/, const IPAddress& /*resolvedIP*/) { return false; }
+  void stop() {}
+  void processNextRequest() {}
+};
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+
+// mDNS responder that never announces: the emulator has no radio.
+class MDNSResponder {
+ public:
+  bool begin(const char* /*hostname*/) { return false; }
+  void end() {}
+  bool addService(const char* /*service*/, const char* /*proto*/, uint16_t /*port*/) { return false; }
+};
+
+extern MDNSResponder MDNS;
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+// Heap figures are reported from a fixed budget matching the X4's free heap after boot; the emulator does not track
+// allocations.
+class EspClass {
+ public:
+  uint32_t getFreeHeap() const { return 200 * 1024; }
+  uint32_t getHeapSize() const { return 320 * 1024; }
+  uint32_t getMaxAllocHeap() const { return 110 * 1024; }
+  uint32_t getMinFreeHeap() const { return 150 * 1024; }
+  [[noreturn]] void restart();
+};
+
+extern EspClass ESP;
+
+inline uint32_t esp_get_free_heap_size() { return ESP.getFreeHeap(); }
@@ -0,0 +1,257 @@
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Emulator.h"
+
+struct HostTask {
+  std::string name;
+  std::mutex mutex;
+  std::condition_variable notified;
+  uint32_t notifyValue = 0;
+  bool spawned = false;  // false for the main thread, which is not a FreeRTOS task
+  bool parked = false;   // blocked in ulTaskNotifyTake(portMAX_DELAY)
+};
+
+struct HostSemaphore {
+  std::mutex mutex;
+  std::condition_variable released;
+  UBaseType_t count = 0;
+  UBaseType_t maxCount = 1;
+  bool isMutex = false;
+  TaskHandle_t holder = nullptr;
+  UBaseType_t depth = 0;  // recursive takes by holder
+};
+
+namespace {
+// Thrown by vTaskDelete(nullptr) to unwind the calling task back to its thread entry
+struct TaskExit {};
+
+thread_local HostTask* currentTask = nullptr;
+std::recursive_mutex criticalSection;
+
+// Spawned tasks that have not returned yet, for Emulator::tasksIdle(). Never destroyed, as task threads are detached
+// and may still be leaving when exit() runs the static destructors.
+std::mutex& liveTasksMutex = *new std::mutex;
+std::vector<HostTask*>& liveTasks = *new std::vector<HostTask*>;
+
+// Task records are never freed: a handle may still be notified after its task ended, and the firmware only creates a
+// handful of tasks per session.
+HostTask* current() {
+  if (currentTask == nullptr) {
+    currentTask = new HostTask{"main"};
+  }
+  return currentTask;
+}
+
+// Waits on `cv` until `ready()` or the FreeRTOS timeout expires; portMAX_DELAY waits forever.
+template <typename Predicate>
+bool waitTicks(std::condition_variable& cv, std::unique_lock<std::mutex>& lock, const TickType_t ticks,
+               Predicate ready) {
+  if (ticks == portMAX_DELAY) {
+    cv.wait(lock, ready);
+    return true;
+  }
+  return cv.wait_for(lock, std::chrono::milliseconds(ticks), ready);
+}
+
+SemaphoreHandle_t createSemaphore(const UBaseType_t maxCount, const UBaseType_t initialCount, const bool isMutex) {
+  auto* sem = new HostSemaphore;
+  sem->maxCount = maxCount;
+  sem->count = initialCount;
+  sem->isMutex = isMutex;
+  return sem;
+}
+
+BaseType_t take(const SemaphoreHandle_t sem, const TickType_t ticks, const bool recursive) {
+  if (sem == nullptr) {
+    return pdFAIL;
+  }
+  std::unique_lock<std::mutex> lock(sem->mutex);
+  HostTask* self = current();
+  if (recursive && sem->holder == self) {
+    sem->depth++;
+    return pdTRUE;
+  }
+  if (!waitTicks(sem->released, lock, ticks, [sem] { return sem->count > 0; })) {
+    return pdFALSE;
+  }
+  sem->count--;
+  if (sem->isMutex) {
+    sem->holder = self;
+    sem->depth = 1;
+  }
+  return pdTRUE;
+}
+
+BaseType_t give(const SemaphoreHandle_t sem, const bool recursive) {
+  if (sem == nullptr) {
+    return pdFAIL;
+  }
+  std::lock_guard<std::mutex> lock(sem->mutex);
+  if (sem->isMutex) {
+    if (sem->holder != current()) {
+      return pdFAIL;
+    }
+    if (recursive && --sem->depth > 0) {
+      return pdTRUE;
+    }
+    sem->holder = nullptr;
+    sem->depth = 0;
+  }
+  if (sem->count >= sem->maxCount) {
+    return pdFAIL;
+  }
+  sem->count++;
+  sem->released.notify_one();
+  return pdTRUE;
+}
+}  // namespace
+
+void vPortEnterCritical() { criticalSection.lock(); }
+
+void vPortExitCritical() { criticalSection.unlock(); }
+
+BaseType_t xTaskCreate(const TaskFunction_t task, const char* name, uint32_t /*stackDepth*/, void* params,
+                       UBaseType_t /*priority*/, TaskHandle_t* createdTask) {
+  auto* handle = new HostTask{name ? name : ""};
+  handle->spawned = true;
+  {
+    std::lock_guard<std::mutex> lock(liveTasksMutex);
+    liveTasks.push_back(handle);
+  }
+  std::thread([handle, task, params] {
+    currentTask = handle;
+    try {
+      task(params);
+    } catch (const TaskExit&) {
+    }
+    std::lock_guard<std::mutex> lock(liveTasksMutex);
+    liveTasks.erase(std::remove(liveTasks.begin(), liveTasks.end(), handle), liveTasks.end());
+  }).detach();
+  if (createdTask != nullptr) {
+    *createdTask = handle;
+  }
+  return pdPASS;
+}
+
+BaseType_t xTaskCreatePinnedToCore(const TaskFunction_t task, const char* name, const uint32_t stackDepth,
+                                   void* params, const UBaseType_t priority, TaskHandle_t* createdTask,
+                                   BaseType_t /*coreId*/) {
+  return xTaskCreate(task, name, stackDepth, params, priority, createdTask);
+}
+
+void vTaskDelete(const TaskHandle_t task) {
+  if ((task == nullptr || task == currentTask) && currentTask != nullptr && currentTask->spawned) {
+    throw TaskExit{};
+  }
+}
+
+void vTaskDelay(const TickType_t ticks) { std::this_thread::sleep_for(std::chrono::milliseconds(ticks)); }
+
+TickType_t xTaskGetTickCount() { return static_cast<TickType_t>(millis()); }
+
+TaskHandle_t xTaskGetCurrentTaskHandle() { return current(); }
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t /*task*/) { return 4096; }
+
+BaseType_t xTaskNotify(const TaskHandle_t task, const uint32_t value, const eNotifyAction action) {
+  if (task == nullptr) {
+    return pdFAIL;
+  }
+  std::lock_guard<std::mutex> lock(task->mutex);
+  switch (action) {
+    case eSetBits:
+      task->notifyValue |= value;
+      break;
+    case eIncrement:
+      task->notifyValue++;
+      break;
+    case eSetValueWithOverwrite:
+      task->notifyValue = value;
+      break;
+    case eSetValueWithoutOverwrite:
+      if (task->notifyValue != 0) {
+        return pdFAIL;
+      }
+      task->notifyValue = value;
+      break;
+    case eNoAction:
+      break;
+  }
+  task->notified.notify_all();
+  return pdPASS;
+}
+
+BaseType_t xTaskNotifyGive(const TaskHandle_t task) { return xTaskNotify(task, 0, eIncrement); }
+
+uint32_t ulTaskNotifyTake(const BaseType_t clearCountOnExit, const TickType_t ticksToWait) {
+  HostTask* self = current();
+  std::unique_lock<std::mutex> lock(self->mutex);
+  self->parked = ticksToWait == portMAX_DELAY;
+  const bool woken = waitTicks(self->notified, lock, ticksToWait, [self] { return self->notifyValue > 0; });
+  self->parked = false;
+  if (!woken) {
+    return 0;
+  }
+  const uint32_t value = self->notifyValue;
+  self->notifyValue = clearCountOnExit ? 0 : value - 1;
+  return value;
+}
+
+bool Emulator::tasksIdle() {
+  std::lock_guard<std::mutex> lock(liveTasksMutex);
+  return std::all_of(liveTasks.begin(), liveTasks.end(), [](HostTask* task) {
+    std::lock_guard<std::mutex> taskLock(task->mutex);
+    return task->parked && task->notifyValue == 0;
+  });
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex() { return createSemaphore(1, 1, true); }
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex() { return createSemaphore(1, 1, true); }
+
+SemaphoreHandle_t xSemaphoreCreateBinary() { return createSemaphore(1, 0, false); }
+
+SemaphoreHandle_t xSemaphoreCreateCounting(const UBaseType_t maxCount, const UBaseType_t initialCount) {
+  return createSemaphore(maxCount, initialCount, false);
+}
+
+void vSemaphoreDelete(const SemaphoreHandle_t sem) { delete sem; }
+
+BaseType_t xSemaphoreTake(const SemaphoreHandle_t sem, const TickType_t ticksToWait) {
+  return take(sem, ticksToWait, false);
+}
+
+BaseType_t xSemaphoreGive(const SemaphoreHandle_t sem) { return give(sem, false); }
+
+BaseType_t xSemaphoreTakeRecursive(const SemaphoreHandle_t sem, const TickType_t ticksToWait) {
+  return take(sem, ticksToWait, true);
+}
+
+BaseType_t xSemaphoreGiveRecursive(const SemaphoreHandle_t sem) { return give(sem, true); }
+
+TaskHandle_t xSemaphoreGetMutexHolder(const SemaphoreHandle_t sem) {
+  if (sem == nullptr) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(sem->mutex);
+  return sem->holder;
+}
+
+BaseType_t xQueuePeek(const QueueHandle_t queue, void* /*buffer*/, TickType_t /*ticksToWait*/) {
+  if (queue == nullptr) {
+    return pdFALSE;
+  }
+  std::lock_guard<std::mutex> lock(queue->mutex);
+  return queue->count > 0 ? pdTRUE : pdFALSE;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+
+#include "WString.h"
+#include "WiFiClient.h"
+
+// HTTP client whose requests never leave the host: the emulator has no radio, so every request fails to connect.
+
+constexpr int HTTPC_ERROR_CONNECTION_REFUSED = -1;
+constexpr int HTTP_CODE_OK = 200;
+
+typedef enum {
+  HTTPC_DISABLE_FOLLOW_REDIRECTS,
+  HTTPC_STRICT_FOLLOW_REDIRECTS,
+  HTTPC_FORCE_FOLLOW_REDIRECTS
+} followRedirects_t;
+
+class HTTPClient {
+ public:
+  bool begin(WiFiClient& /*client*/, const String& /*url*/) { return true; }
+  bool begin(const String& /*url*/) { return true; }
+  void end() {}
+  void setFollowRedirects(followRedirects_t /*follow*/) {}
+  void setTimeout(uint16_t /*timeoutMs*/) {}
+  void setAuthorization(const char* /*user*/, const char* /*password*/) {}
+  void addHeader(const String& /*name*/, const String& /*value*/) {}
+
+  int GET() { return HTTPC_ERROR_CONNECTION_REFUSED; }
+  int POST(const String& /*payload*/) { return HTTPC_ERROR_CONNECTION_REFUSED; }
+  int PUT(const String& /*payload*/) { return HTTPC_ERROR_CONNECTION_REFUSED; }
+  int getSize() const { return -1; }
+  String getString() const { return String(); }
+  template <typename Out>
+  int writeToStream(Out* /*stream*/) {
+    return HTTPC_ERROR_CONNECTION_REFUSED;
+  }
+  static String errorToString(int /*error*/) { return String("connection refused"); }
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+// Like the core's HardwareSerial.h this brings in the timing and ESP calls, which many files rely on through
+// Logging.h.
+#include "Esp.h"
+#include "Stream.h"
+#include "esp32-hal.h"
+
+// USB CDC console; log output goes to stderr so stdout stays free for session reports. Nothing is ever received, so
+// the USB serial protocol stays idle.
+class HWCDC : public Stream {
+ public:
+  operator bool() const { return true; }
+
+  void begin(unsigned long /*baud*/) {}
+
+  size_t write(uint8_t b) override;
+  size_t write(const uint8_t* buffer, size_t size) override;
+  void flush() override;
+  using Print::write;
+
+  int available() override { return 0; }
+  int read() override { return -1; }
+  size_t read(uint8_t* /*buffer*/, size_t /*size*/) { return 0; }
+  int peek() override { return -1; }
+};
+
+using HardwareSerial = HWCDC;
+
+extern HWCDC Serial;
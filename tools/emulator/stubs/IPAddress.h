@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+
+#include "WString.h"
+
+class IPAddress {
+ public:
+  IPAddress() = default;
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : octets{a, b, c, d} {}
+
+  uint8_t operator[](int index) const { return octets[index]; }
+  bool operator==(const IPAddress& rhs) const {
+    return octets[0] == rhs.octets[0] && octets[1] == rhs.octets[1] && octets[2] == rhs.octets[2] &&
+           octets[3] == rhs.octets[3];
+  }
+  bool operator!=(const IPAddress& rhs) const { return !(*this == rhs); }
+
+  String toString() const {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", octets[0], octets[1], octets[2], octets[3]);
+    return String(buf);
+  }
+
+ private:
+  uint8_t octets[4] = {0, 0, 0, 0};
+};
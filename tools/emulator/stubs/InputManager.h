@@ -0,0 +1,7 @@
+#pragma once
+
+// Only the pin constant HalPowerManager.h refers to; buttons come from the scripted HalGPIO in ../hal.
+class InputManager {
+ public:
+  static constexpr int POWER_BUTTON_PIN = 3;
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "WString.h"
+
+// The core's MD5Builder over a plain RFC 1321 implementation, so KOReader document ids match the device's.
+class MD5Builder {
+ public:
+  void begin();
+  void add(const uint8_t* data, size_t length);
+  void add(const char* data) { add(reinterpret_cast<const uint8_t*>(data), strlen(data)); }
+  void add(const String& data) { add(data.c_str()); }
+  void calculate();
+  void getBytes(uint8_t* output) const;
+  String toString() const;
+
+ private:
+  uint32_t state[4] = {};
+  uint64_t bitCount = 0;
+  uint8_t buffer[64] = {};
+  uint8_t digest[16] = {};
+
+  void transform(const uint8_t* block);
+};
@@ -0,0 +1,94 @@
+#include <ESPmDNS.h>
+#include <SPI.h>
+#include <WiFi.h>
+#include <base64.h>
+#include <esp_err.h>
+#include <mbedtls/base64.h>
+
+#include <string>
+
+WiFiClass WiFi;
+MDNSResponder MDNS;
+SPIClass SPI;
+
+// Referenced by the OTA client configuration; never called because no HTTP client is ever created.
+extern "C" esp_err_t esp_crt_bundle_attach(void* /*conf*/) { return ESP_ERR_NOT_SUPPORTED; }
+
+namespace {
+constexpr char BASE64_ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+int base64Value(const unsigned char c) {
+  if (c >= 'A' && c <= 'Z') return c - 'A';
+  if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+  if (c >= '0' && c <= '9') return c - '0' + 52;
+  if (c == '+') return 62;
+  if (c == '/') return 63;
+  return -1;
+}
+}  // namespace
+
+int mbedtls_base64_encode(unsigned char* dst, const size_t dlen, size_t* olen, const unsigned char* src,
+                          const size_t slen) {
+  const size_t needed = 4 * ((slen + 2) / 3) + 1;
+  if (dst == nullptr || dlen < needed) {
+    *olen = needed;
+    return MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL;
+  }
+  size_t out = 0;
+  for (size_t i = 0; i < slen; i += 3) {
+    const uint32_t chunk = (src[i] << 16) | (i + 1 < slen ? src[i + 1] << 8 : 0) | (i + 2 < slen ? src[i + 2] : 0);
+    dst[out++] = BASE64_ALPHABET[(chunk >> 18) & 0x3F];
+    dst[out++] = BASE64_ALPHABET[(chunk >> 12) & 0x3F];
+    dst[out++] = i + 1 < slen ? BASE64_ALPHABET[(chunk >> 6) & 0x3F] : '=';
+    dst[out++] = i + 2 < slen ? BASE64_ALPHABET[chunk & 0x3F] : '=';
+  }
+  dst[out] = '\0';
+  *olen = out;
+  return 0;
+}
+
+int mbedtls_base64_decode(unsigned char* dst, const size_t dlen, size_t* olen, const unsigned char* src,
+                          const size_t slen) {
+  size_t symbols = 0;
+  size_t padding = 0;
+  for (size_t i = 0; i < slen; i++) {
+    if (src[i] == '\r' || src[i] == '\n' || src[i] == ' ') continue;
+    if (src[i] == '=') {
+      padding++;
+      continue;
+    }
+    if (padding > 0 || base64Value(src[i]) < 0) return MBEDTLS_ERR_BASE64_INVALID_CHARACTER;
+    symbols++;
+  }
+  if (padding > 2 || (symbols + padding) % 4 == 1) return MBEDTLS_ERR_BASE64_INVALID_CHARACTER;
+  const size_t needed = symbols * 6 / 8;
+  if (dst == nullptr || dlen < needed) {
+    *olen = needed;
+    return MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL;
+  }
+  uint32_t accumulator = 0;
+  int bits = 0;
+  size_t out = 0;
+  for (size_t i = 0; i < slen; i++) {
+    const int value = base64Value(src[i]);
+    if (value < 0) continue;
+    accumulator = (accumulator << 6) | static_cast<uint32_t>(value);
+    bits += 6;
+    if (bits >= 8) {
+      bits -= 8;
+      dst[out++] = static_cast<unsigned char>((accumulator >> bits) & 0xFF);
+    }
+  }
+  *olen = out;
+  return 0;
+}
+
+String base64::encode(const uint8_t* data, const size_t length) {
+  size_t needed = 0;
+  mbedtls_base64_encode(nullptr, 0, &needed, data, length);
+  std::string encoded(needed, '\0');
+  size_t written = 0;
+  mbedtls_base64_encode(reinterpret_cast<unsigned char*>(&encoded[0]), needed, &written, data, length);
+  encoded.resize(written);
+  return String(encoded);
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include "WString.h"
+
+class Print {
+ public:
+  virtual ~Print() = default;
+
+  virtual size_t write(uint8_t) = 0;
+  virtual size_t write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) {
+      if (write(*buffer++))
+        n++;
+      else
+        break;
+    }
+    return n;
+  }
+  size_t write(const char* buffer, size_t size) { return write(reinterpret_cast<const uint8_t*>(buffer), size); }
+  virtual void flush() {}
+
+  size_t print(const char* text) { return write(reinterpret_cast<const uint8_t*>(text), strlen(text)); }
+  size_t print(const String& text) { return print(text.c_str()); }
+  size_t print(char c) { return write(static_cast<uint8_t>(c)); }
+  size_t print(long n) { return print(String(n)); }
+  size_t print(unsigned long n) { return print(String(n)); }
+  size_t print(int n) { return print(String(n)); }
+  size_t print(unsigned int n) { return print(String(n)); }
+  size_t print(double d, int decimals = 2) { return print(String(d, decimals)); }
+  size_t println() { return print("\n"); }
+  template <typename T>
+  size_t println(const T& value) {
+    return print(value) + println();
+  }
+  size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+    char buf[256];
+    va_list args;
+    va_start(args, format);
+    const int len = vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    if (len <= 0) {
+      return 0;
+    }
+    const size_t n = static_cast<size_t>(len) < sizeof(buf) ? static_cast<size_t>(len) : sizeof(buf) - 1;
+    return write(reinterpret_cast<const uint8_t*>(buf), n);
+  }
+};
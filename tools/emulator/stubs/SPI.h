@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+
+// The panel and the SD card are emulated above the bus, so SPI setup is accepted and ignored.
+class SPIClass {
+ public:
+  void begin(int8_t /*sck*/ = -1, int8_t /*miso*/ = -1, int8_t /*mosi*/ = -1, int8_t /*ss*/ = -1) {}
+  void end() {}
+};
+
+extern SPIClass SPI;
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Print.h"
+
+// Arduino Stream: a Print that can also be read from. Only the calls the firmware makes are covered.
+class Stream : public Print {
+ public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+
+  void setTimeout(unsigned long timeoutMs) { timeout = timeoutMs; }
+  size_t readBytes(uint8_t* buffer, size_t length) {
+    size_t n = 0;
+    while (n < length) {
+      const int c = read();
+      if (c < 0) break;
+      buffer[n++] = static_cast<uint8_t>(c);
+    }
+    return n;
+  }
+  size_t readBytes(char* buffer, size_t length) { return readBytes(reinterpret_cast<uint8_t*>(buffer), length); }
+  String readStringUntil(char terminator) {
+    String out;
+    int c;
+    while ((c = read()) >= 0 && c != terminator) out += static_cast<char>(c);
+    return out;
+  }
+
+ protected:
+  unsigned long timeout = 1000;
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Stream.h"
+#include "WString.h"
+
+// A String that can be written to and read back like a Stream.
+class StreamString : public Stream, public String {
+ public:
+  size_t write(uint8_t b) override {
+    *this += static_cast<char>(b);
+    return 1;
+  }
+  size_t write(const uint8_t* buffer, size_t size) override {
+    concat(reinterpret_cast<const char*>(buffer), size);
+    return size;
+  }
+  using Print::write;
+
+  int available() override { return static_cast<int>(length()); }
+  int read() override {
+    if (length() == 0) return -1;
+    const char c = charAt(0);
+    remove(0, 1);
+    return static_cast<unsigned char>(c);
+  }
+  int peek() override { return length() == 0 ? -1 : static_cast<unsigned char>(charAt(0)); }
+};
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+// Flash strings are ordinary strings on the host.
+#define F(string_literal) (string_literal)
+
+// Numbers other than char, which String(char) and operator+(char) take as a character
+template <typename N>
+using EnableIfNumber = typename std::enable_if<std::is_arithmetic<N>::value && !std::is_same<N, char>::value>::type;
+
+// Arduino String over std::string, covering the calls the HAL, the libraries and the firmware make.
+class String {
+ public:
+  String() = default;
+  String(const char* s) : s(s ? s : "") {}
+  String(const char* s, size_t len) : s(s ? std::string(s, len) : std::string()) {}
+  explicit String(const std::string& s) : s(s) {}
+  explicit String(char c) : s(1, c) {}
+  explicit String(int n) : s(std::to_string(n)) {}
+  explicit String(unsigned int n) : s(std::to_string(n)) {}
+  explicit String(long n) : s(std::to_string(n)) {}
+  explicit String(unsigned long n) : s(std::to_string(n)) {}
+  explicit String(long long n) : s(std::to_string(n)) {}
+  explicit String(unsigned long long n) : s(std::to_string(n)) {}
+  explicit String(float f, unsigned int decimals = 2) : String(static_cast<double>(f), decimals) {}
+  explicit String(double d, unsigned int decimals = 2) {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", static_cast<int>(decimals), d);
+    s = buf;
+  }
+
+  const char* c_str() const { return s.c_str(); }
+  size_t length() const { return s.size(); }
+  bool isEmpty() const { return s.empty(); }
+  void clear() { s.clear(); }
+  char operator[](size_t i) const { return i < s.size() ? s[i] : '\0'; }
+  char& operator[](size_t i) { return s[i]; }
+  char charAt(size_t i) const { return (*this)[i]; }
+  void setCharAt(size_t i, char c) {
+    if (i < s.size()) s[i] = c;
+  }
+  const char* begin() const { return s.c_str(); }
+  const char* end() const { return s.c_str() + s.size(); }
+
+  bool operator==(const String& rhs) const { return s == rhs.s; }
+  bool operator==(const char* rhs) const { return s == (rhs ? rhs : ""); }
+  bool operator!=(const String& rhs) const { return s != rhs.s; }
+  bool operator!=(const char* rhs) const { return !(*this == rhs); }
+  bool operator<(const String& rhs) const { return s < rhs.s; }
+  bool equals(const String& rhs) const { return s == rhs.s; }
+  bool equalsIgnoreCase(const String& rhs) const {
+    return s.size() == rhs.s.size() && std::equal(s.begin(), s.end(), rhs.s.begin(), [](char a, char b) {
+             return tolower(static_cast<unsigned char>(a)) == tolower(static_cast<unsigned char>(b));
+           });
+  }
+  int compareTo(const String& rhs) const { return s.compare(rhs.s); }
+
+  String operator+(const String& rhs) const { return String(s + rhs.s); }
+  String operator+(const char* rhs) const { return String(s + (rhs ? rhs : "")); }
+  String operator+(char c) const { return String(s + c); }
+  template <typename N, typename = EnableIfNumber<N>>
+  String operator+(N n) const {
+    return *this + String(n);
+  }
+  friend String operator+(const char* lhs, const String& rhs) { return String(std::string(lhs ? lhs : "") + rhs.s); }
+  String& operator+=(const String& rhs) {
+    s += rhs.s;
+    return *this;
+  }
+  String& operator+=(const char* rhs) {
+    if (rhs) s += rhs;
+    return *this;
+  }
+  String& operator+=(char c) {
+    s += c;
+    return *this;
+  }
+  template <typename N, typename = EnableIfNumber<N>>
+  String& operator+=(N n) {
+    return *this += String(n);
+  }
+  template <typename T>
+  bool concat(const T& value) {
+    *this += value;
+    return true;
+  }
+  bool concat(const char* str, size_t len) {
+    if (str) s.append(str, len);
+    return true;
+  }
+
+  bool startsWith(const String& prefix) const { return s.rfind(prefix.s, 0) == 0; }
+  bool endsWith(const String& suffix) const {
+    return s.size() >= suffix.s.size() && s.compare(s.size() - suffix.s.size(), suffix.s.size(), suffix.s) == 0;
+  }
+  int indexOf(char c, size_t from = 0) const { return toIndex(s.find(c, from)); }
+  int indexOf(const String& str, size_t from = 0) const { return toIndex(s.find(str.s, from)); }
+  int lastIndexOf(char c) const { return toIndex(s.rfind(c)); }
+  int lastIndexOf(const String& str) const { return toIndex(s.rfind(str.s)); }
+  String substring(size_t from) const { return from >= s.size() ? String() : String(s.substr(from)); }
+  String substring(size_t from, size_t to) const {
+    return from >= s.size() || to <= from ? String() : String(s.substr(from, to - from));
+  }
+
+  void toLowerCase() {
+    for (auto& c : s) c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+  }
+  void toUpperCase() {
+    for (auto& c : s) c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+  }
+  void trim() {
+    const auto notSpace = [](char c) { return !isspace(static_cast<unsigned char>(c)); };
+    s.erase(s.begin(), std::find_if(s.begin(), s.end(), notSpace));
+    s.erase(std::find_if(s.rbegin(), s.rend(), notSpace).base(), s.end());
+  }
+  void replace(const String& from, const String& to) {
+    if (from.s.empty()) return;
+    for (size_t pos = 0; (pos = s.find(from.s, pos)) != std::string::npos; pos += to.s.size()) {
+      s.replace(pos, from.s.size(), to.s);
+    }
+  }
+  void replace(char from, char to) { std::replace(s.begin(), s.end(), from, to); }
+  void remove(size_t index) {
+    if (index < s.size()) s.erase(index);
+  }
+  void remove(size_t index, size_t count) {
+    if (index < s.size()) s.erase(index, count);
+  }
+  long toInt() const { return strtol(s.c_str(), nullptr, 10); }
+  float toFloat() const { return strtof(s.c_str(), nullptr); }
+  void toCharArray(char* buf, size_t size) const {
+    if (size == 0) return;
+    const size_t n = std::min(size - 1, s.size());
+    memcpy(buf, s.data(), n);
+    buf[n] = '\0';
+  }
+  void getBytes(unsigned char* buf, size_t size) const { toCharArray(reinterpret_cast<char*>(buf), size); }
+  bool reserve(size_t size) {
+    s.reserve(size);
+    return true;
+  }
+
+ private:
+  std::string s;
+
+  static int toIndex(size_t pos) { return pos == std::string::npos ? -1 : static_cast<int>(pos); }
+};
@@ -0,0 +1,113 @@
+#pragma once
+
+// The ESP32 WebServer API without a socket behind it. Routes are accepted and dropped, handlers passed to
+// addHandler() are owned and deleted like the core does, and no request ever arrives, so handleClient() is a no-op.
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "WString.h"
+#include "WiFi.h"
+
+enum HTTPMethod {
+  HTTP_ANY,
+  HTTP_GET,
+  HTTP_HEAD,
+  HTTP_POST,
+  HTTP_PUT,
+  HTTP_PATCH,
+  HTTP_DELETE,
+  HTTP_OPTIONS,
+  HTTP_PROPFIND,
+  HTTP_MKCOL,
+  HTTP_MOVE,
+  HTTP_COPY,
+  HTTP_LOCK,
+  HTTP_UNLOCK,
+};
+
+enum HTTPUploadStatus { UPLOAD_FILE_START, UPLOAD_FILE_WRITE, UPLOAD_FILE_END, UPLOAD_FILE_ABORTED };
+enum HTTPRawStatus { RAW_START, RAW_WRITE, RAW_END, RAW_ABORTED };
+
+constexpr size_t HTTP_UPLOAD_BUFLEN = 1436;
+constexpr size_t HTTP_RAW_BUFLEN = 1436;
+constexpr size_t CONTENT_LENGTH_UNKNOWN = static_cast<size_t>(-1);
+
+struct HTTPUpload {
+  HTTPUploadStatus status = UPLOAD_FILE_START;
+  String filename;
+  String name;
+  String type;
+  size_t totalSize = 0;
+  size_t currentSize = 0;
+  uint8_t buf[HTTP_UPLOAD_BUFLEN] = {};
+};
+
+struct HTTPRaw {
+  HTTPRawStatus status = RAW_START;
+  size_t totalSize = 0;
+  size_t currentSize = 0;
+  uint8_t buf[HTTP_RAW_BUFLEN] = {};
+};
+
+class WebServer;
+
+class RequestHandler {
+ public:
+  virtual ~RequestHandler() = default;
+  virtual bool canHandle(WebServer& /*server*/, HTTPMethod /*method*/, const String& /*uri*/) { return false; }
+  virtual bool canUpload(WebServer& /*server*/, const String& /*uri*/) { return false; }
+  virtual bool canRaw(WebServer& /*server*/, const String& /*uri*/) { return false; }
+  virtual bool handle(WebServer& /*server*/, HTTPMethod /*method*/, const String& /*uri*/) { return false; }
+  virtual void upload(WebServer& /*server*/, const String& /*uri*/, HTTPUpload& /*upload*/) {}
+  virtual void raw(WebServer& /*server*/, const String& /*uri*/, HTTPRaw& /*raw*/) {}
+};
+
+class WebServer {
+ public:
+  explicit WebServer(int port = 80) : port(port) {}
+
+  void begin() {}
+  void begin(uint16_t /*port*/) {}
+  void stop() {}
+  void close() {}
+  void handleClient() {}
+  int getPort() const { return port; }
+
+  template <typename... Handlers>
+  void on(const String& /*uri*/, Handlers&&... /*handlers*/) {}
+  template <typename Handler>
+  void onNotFound(Handler&& /*handler*/) {}
+  void addHandler(RequestHandler* handler) { handlers.emplace_back(handler); }
+  void collectHeaders(const char* /*headerKeys*/[], size_t /*count*/) {}
+
+  template <typename... Args>
+  void send(int /*code*/, Args&&... /*args*/) {}
+  template <typename... Args>
+  void send_P(int /*code*/, Args&&... /*args*/) {}
+  template <typename... Args>
+  void sendContent(Args&&... /*args*/) {}
+  template <typename... Args>
+  void sendHeader(Args&&... /*args*/) {}
+  void setContentLength(size_t /*length*/) {}
+
+  bool hasArg(const String& /*name*/) const { return false; }
+  String arg(const String& /*name*/) const { return String(); }
+  String arg(int /*index*/) const { return String(); }
+  int args() const { return 0; }
+  String header(const String& /*name*/) const { return String(); }
+  bool hasHeader(const String& /*name*/) const { return false; }
+  String uri() const { return String(); }
+  HTTPMethod method() const { return HTTP_GET; }
+  WiFiClient client() { return WiFiClient(); }
+  HTTPUpload& upload() { return currentUpload; }
+  HTTPRaw& raw() { return currentRaw; }
+
+ private:
+  int port;
+  std::vector<std::unique_ptr<RequestHandler>> handlers;
+  HTTPUpload currentUpload;
+  HTTPRaw currentRaw;
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "WString.h"
+
+typedef enum {
+  WStype_ERROR,
+  WStype_DISCONNECTED,
+  WStype_CONNECTED,
+  WStype_TEXT,
+  WStype_BIN,
+  WStype_PING,
+  WStype_PONG,
+} WStype_t;
+
+// WebSocket server that never listens: the emulator has no radio, so no client ever connects.
+class WebSocketsServer {
+ public:
+  using WebSocketServerEvent = std::function<void(uint8_t num, WStype_t type, uint8_t* payload, size_t length)>;
+
+  explicit WebSocketsServer(uint16_t /*port*/) {}
+
+  void begin() {}
+  void close() {}
+  void loop() {}
+  void onEvent(WebSocketServerEvent event) { onEventHandler = std::move(event); }
+
+  bool sendTXT(uint8_t /*num*/, const char* /*payload*/, size_t /*length*/ = 0) { return false; }
+  bool sendTXT(uint8_t num, const String& payload) { return sendTXT(num, payload.c_str()); }
+  bool broadcastTXT(const char* /*payload*/, size_t /*length*/ = 0) { return false; }
+  bool broadcastTXT(const String& payload) { return broadcastTXT(payload.c_str()); }
+
+ private:
+  WebSocketServerEvent onEventHandler;
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+// The ESP32 WiFi API with the radio switched off. Mode changes are remembered so code that checks the mode sees what
+// it asked for, but a station never associates, an access point never gets clients and scans find nothing.
+
+#include <cstdint>
+
+#include "IPAddress.h"
+#include "WString.h"
+#include "WiFiClient.h"
+#include "WiFiUdp.h"
+#include "esp_wifi.h"
+
+typedef enum {
+  WL_IDLE_STATUS = 0,
+  WL_NO_SSID_AVAIL = 1,
+  WL_SCAN_COMPLETED = 2,
+  WL_CONNECTED = 3,
+  WL_CONNECT_FAILED = 4,
+  WL_CONNECTION_LOST = 5,
+  WL_DISCONNECTED = 6,
+} wl_status_t;
+
+constexpr int16_t WIFI_SCAN_RUNNING = -1;
+constexpr int16_t WIFI_SCAN_FAILED = -2;
+
+class WiFiClass {
+ public:
+  bool mode(wifi_mode_t m) {
+    currentMode = m;
+    return true;
+  }
+  wifi_mode_t getMode() const { return currentMode; }
+  void persistent(bool /*persistent*/) {}
+  bool setHostname(const char* /*hostname*/) { return true; }
+  const char* getHostname() const { return "crosspoint"; }
+  bool setSleep(bool /*enabled*/) { return true; }
+
+  wl_status_t begin(const char* /*ssid*/, const char* /*password*/ = nullptr) {
+    if (currentMode == WIFI_MODE_NULL) currentMode = WIFI_MODE_STA;
+    return WL_NO_SSID_AVAIL;
+  }
+  bool disconnect(bool /*wifiOff*/ = false, bool /*eraseAp*/ = false) { return true; }
+  wl_status_t status() const { return WL_DISCONNECTED; }
+  IPAddress localIP() const { return IPAddress(); }
+  String SSID() const { return String(); }
+  int8_t RSSI() const { return 0; }
+  void macAddress(uint8_t* mac) const {
+    static const uint8_t emulatedMac[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01};
+    for (int i = 0; i < 6; i++) mac[i] = emulatedMac[i];
+  }
+  String macAddress() const { return String("02:00:00:00:00:01"); }
+
+  int16_t scanNetworks(bool /*async*/ = false) { return 0; }
+  int16_t scanComplete() const { return 0; }
+  void scanDelete() {}
+  String SSID(uint8_t /*index*/) const { return String(); }
+  int32_t RSSI(uint8_t /*index*/) const { return 0; }
+  wifi_auth_mode_t encryptionType(uint8_t /*index*/) const { return WIFI_AUTH_OPEN; }
+
+  bool softAP(const char* /*ssid*/, const char* /*password*/ = nullptr, int /*channel*/ = 1, bool /*hidden*/ = false,
+              int /*maxConnections*/ = 4) {
+    return false;
+  }
+  bool softAPConfig(IPAddress /*local*/, IPAddress /*gateway*/, IPAddress /*subnet*/) { return false; }
+  bool softAPdisconnect(bool /*wifiOff*/ = false) { return true; }
+  IPAddress softAPIP() const { return IPAddress(); }
+  String softAPSSID() const { return String(); }
+  uint8_t softAPgetStationNum() const { return 0; }
+
+ private:
+  wifi_mode_t currentMode = WIFI_MODE_NULL;
+};
+
+extern WiFiClass WiFi;
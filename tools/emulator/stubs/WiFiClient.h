@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Stream.h"
+
+// A TCP client that never connects: the emulator has no radio.
+class WiFiClient : public Stream {
+ public:
+  virtual ~WiFiClient() = default;
+
+  virtual int connect(const char* /*host*/, uint16_t /*port*/) { return 0; }
+  virtual void stop() {}
+  virtual uint8_t connected() { return 0; }
+  operator bool() { return connected() != 0; }
+  void setTimeout(uint32_t /*seconds*/) {}
+
+  size_t write(uint8_t) override { return 0; }
+  size_t write(const uint8_t* /*buffer*/, size_t /*size*/) override { return 0; }
+  template <typename Source>
+  size_t write(Source& /*source*/) {
+    return 0;
+  }
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int read(uint8_t* /*buffer*/, size_t /*size*/) { return -1; }
+  int peek() override { return -1; }
+};
+
+using NetworkClient = WiFiClient;
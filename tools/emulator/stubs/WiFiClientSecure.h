@@ -0,0 +1,13 @@
+#pragma once
+
+#include "WiFiClient.h"
+
+class WiFiClientSecure : public WiFiClient {
+ public:
+  void setInsecure() {}
+  void setCACert(const char* /*rootCA*/) {}
+  void setCACertBundle(const uint8_t* /*bundle*/) {}
+  void setHandshakeTimeout(unsigned long /*seconds*/) {}
+};
+
+using NetworkClientSecure = WiFiClientSecure;
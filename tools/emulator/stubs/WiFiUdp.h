@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "IPAddress.h"
+
+// UDP socket that never binds: the emulator has no radio, so discovery stays silent.
+class WiFiUDP {
+ public:
+  uint8_t begin(uint16_t /*port*/) { return 0; }
+  void stop() {}
+  int parsePacket() { return 0; }
+  int read(uint8_t* /*buffer*/, size_t /*size*/) { return 0; }
+  int read(char* buffer, size_t size) { return read(reinterpret_cast<uint8_t*>(buffer), size); }
+  int beginPacket(IPAddress /*ip*/, uint16_t /*port*/) { return 0; }
+  int beginPacket(const char* /*host*/, uint16_t /*port*/) { return 0; }
+  size_t write(const uint8_t* /*buffer*/, size_t /*size*/) { return 0; }
+  int endPacket() { return 0; }
+  IPAddress remoteIP() const { return IPAddress(); }
+  uint16_t remotePort() const { return 0; }
+};
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// No I2C bus on the host: every transaction fails, as with nothing attached, so X3 probes report an X4.
+class TwoWire {
+ public:
+  bool begin(int /*sda*/, int /*scl*/, uint32_t /*frequency*/) { return true; }
+  void end() {}
+  void setTimeOut(uint16_t /*timeoutMs*/) {}
+  void beginTransmission(uint8_t /*address*/) {}
+  size_t write(uint8_t /*data*/) { return 0; }
+  uint8_t endTransmission(bool /*sendStop*/ = true) { return 2; }
+  uint8_t requestFrom(uint8_t /*address*/, uint8_t /*quantity*/, uint8_t /*sendStop*/ = 1) { return 0; }
+  int available() { return 0; }
+  int read() { return -1; }
+};
+
+inline TwoWire Wire;
@@ -0,0 +1,13 @@
+#pragma once
+
+// SdFat's open flags; on the host they are the POSIX ones, so the emulated card hands them straight to open(2).
+#include <fcntl.h>
+
+using oflag_t = int;
+
+#ifndef O_READ
+#define O_READ O_RDONLY
+#endif
+#ifndef O_WRITE
+#define O_WRITE O_WRONLY
+#endif
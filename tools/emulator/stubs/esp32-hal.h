@@ -0,0 +1,36 @@
+#pragma once
+
+// Timing, GPIO and clock calls of the ESP32 Arduino core. millis()/micros() count from process start on the steady
+// clock, so timings logged by the firmware code read the same way they do on the device.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+#include "esp_system.h"
+
+constexpr uint8_t HIGH = 1;
+constexpr uint8_t LOW = 0;
+constexpr uint8_t INPUT = 0;
+constexpr uint8_t OUTPUT = 1;
+constexpr uint8_t INPUT_PULLUP = 2;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+inline void yield() {}
+
+inline void pinMode(int /*pin*/, int /*mode*/) {}
+inline void digitalWrite(int /*pin*/, int /*value*/) {}
+inline int digitalRead(int /*pin*/) { return LOW; }
+
+// Arduino's random() takes bounds; the host PRNG is seeded once per run like the device's hardware RNG
+long random(long howBig);
+long random(long howSmall, long howBig);
+inline void randomSeed(unsigned long /*seed*/) {}
+uint32_t esp_random();
+
+// Clock control is accepted and remembered so HalPowerManager's bookkeeping behaves as on the device
+uint32_t getCpuFrequencyMhz();
+bool setCpuFrequencyMhz(uint32_t mhz);
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+
+typedef int esp_err_t;
+
+constexpr esp_err_t ESP_OK = 0;
+constexpr esp_err_t ESP_FAIL = -1;
+constexpr esp_err_t ESP_ERR_NO_MEM = 0x101;
+constexpr esp_err_t ESP_ERR_NOT_FOUND = 0x105;
+constexpr esp_err_t ESP_ERR_NOT_SUPPORTED = 0x106;
+constexpr esp_err_t ESP_ERR_HTTPS_OTA_IN_PROGRESS = 0x9001;
+
+inline const char* esp_err_to_name(esp_err_t code) {
+  switch (code) {
+    case ESP_OK:
+      return "ESP_OK";
+    case ESP_ERR_NO_MEM:
+      return "ESP_ERR_NO_MEM";
+    case ESP_ERR_NOT_FOUND:
+      return "ESP_ERR_NOT_FOUND";
+    case ESP_ERR_NOT_SUPPORTED:
+      return "ESP_ERR_NOT_SUPPORTED";
+    default:
+      return "ESP_FAIL";
+  }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+
+#include "esp_err.h"
+
+// ESP-IDF HTTP client whose handles never get created: the emulator has no radio, so init fails and callers take
+// their error path. Field order matches the IDF struct for the designated initializers the firmware uses.
+
+typedef struct esp_http_client* esp_http_client_handle_t;
+
+typedef enum {
+  HTTP_EVENT_ERROR,
+  HTTP_EVENT_ON_CONNECTED,
+  HTTP_EVENT_HEADERS_SENT,
+  HTTP_EVENT_ON_HEADER,
+  HTTP_EVENT_ON_DATA,
+  HTTP_EVENT_ON_FINISH,
+  HTTP_EVENT_DISCONNECTED,
+} esp_http_client_event_id_t;
+
+typedef struct {
+  esp_http_client_event_id_t event_id;
+  esp_http_client_handle_t client;
+  void* data;
+  int data_len;
+  void* user_data;
+} esp_http_client_event_t;
+
+typedef esp_err_t (*http_event_handle_cb)(esp_http_client_event_t* event);
+
+typedef struct {
+  const char* url;
+  int timeout_ms;
+  http_event_handle_cb event_handler;
+  int buffer_size;
+  int buffer_size_tx;
+  void* user_data;
+  esp_err_t (*crt_bundle_attach)(void* conf);
+  bool keep_alive_enable;
+} esp_http_client_config_t;
+
+inline esp_http_client_handle_t esp_http_client_init(const esp_http_client_config_t* /*config*/) { return nullptr; }
+inline esp_err_t esp_http_client_set_header(esp_http_client_handle_t /*client*/, const char* /*key*/,
+                                            const char* /*value*/) {
+  return ESP_ERR_NOT_SUPPORTED;
+}
+inline esp_err_t esp_http_client_perform(esp_http_client_handle_t /*client*/) { return ESP_ERR_NOT_SUPPORTED; }
+inline int esp_http_client_get_status_code(esp_http_client_handle_t /*client*/) { return 0; }
+inline esp_err_t esp_http_client_cleanup(esp_http_client_handle_t /*client*/) { return ESP_OK; }
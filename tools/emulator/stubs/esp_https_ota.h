@@ -0,0 +1,25 @@
+#pragma once
+
+#include "esp_err.h"
+#include "esp_http_client.h"
+
+// HTTPS OTA that never starts: there is no radio and no update partition in the emulator.
+
+typedef void* esp_https_ota_handle_t;
+typedef esp_err_t (*http_client_init_cb_t)(esp_http_client_handle_t);
+
+typedef struct {
+  const esp_http_client_config_t* http_config;
+  http_client_init_cb_t http_client_init_cb;
+} esp_https_ota_config_t;
+
+inline esp_err_t esp_https_ota_begin(const esp_https_ota_config_t* /*config*/, esp_https_ota_handle_t* handle) {
+  *handle = nullptr;
+  return ESP_ERR_NOT_SUPPORTED;
+}
+inline esp_err_t esp_https_ota_perform(esp_https_ota_handle_t /*handle*/) { return ESP_ERR_NOT_SUPPORTED; }
+inline bool esp_https_ota_is_complete_data_received(esp_https_ota_handle_t /*handle*/) { return false; }
+inline esp_err_t esp_https_ota_finish(esp_https_ota_handle_t /*handle*/) { return ESP_ERR_NOT_SUPPORTED; }
+inline esp_err_t esp_https_ota_abort(esp_https_ota_handle_t /*handle*/) { return ESP_OK; }
+inline int esp_https_ota_get_image_size(esp_https_ota_handle_t /*handle*/) { return -1; }
+inline int esp_https_ota_get_image_len_read(esp_https_ota_handle_t /*handle*/) { return 0; }
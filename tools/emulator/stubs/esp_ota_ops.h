@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "esp_err.h"
+
+// The emulator has no flash partitions, so there is never an update slot and every OTA path reports failure.
+
+typedef uint32_t esp_ota_handle_t;
+
+typedef struct {
+  uint32_t address;
+  uint32_t size;
+  char label[17];
+} esp_partition_t;
+
+constexpr size_t OTA_SIZE_UNKNOWN = 0xffffffff;
+constexpr size_t OTA_WITH_SEQUENTIAL_WRITES = 0xfffffffe;
+
+inline const esp_partition_t* esp_ota_get_next_update_partition(const esp_partition_t* /*start*/) { return nullptr; }
+inline const esp_partition_t* esp_ota_get_running_partition() { return nullptr; }
+inline esp_err_t esp_ota_begin(const esp_partition_t* /*partition*/, size_t /*imageSize*/,
+                               esp_ota_handle_t* /*outHandle*/) {
+  return ESP_ERR_NOT_SUPPORTED;
+}
+inline esp_err_t esp_ota_write(esp_ota_handle_t /*handle*/, const void* /*data*/, size_t /*size*/) {
+  return ESP_ERR_NOT_SUPPORTED;
+}
+inline esp_err_t esp_ota_end(esp_ota_handle_t /*handle*/) { return ESP_ERR_NOT_SUPPORTED; }
+inline esp_err_t esp_ota_abort(esp_ota_handle_t /*handle*/) { return ESP_OK; }
+inline esp_err_t esp_ota_set_boot_partition(const esp_partition_t* /*partition*/) { return ESP_ERR_NOT_SUPPORTED; }
+inline esp_err_t esp_partition_read(const esp_partition_t* /*partition*/, size_t /*offset*/, void* /*dst*/,
+                                    size_t /*size*/) {
+  return ESP_ERR_NOT_SUPPORTED;
+}
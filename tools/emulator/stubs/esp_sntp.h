@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+// SNTP client that never syncs: the emulator has no radio, and the host clock is already correct.
+
+typedef enum { ESP_SNTP_OPMODE_POLL, ESP_SNTP_OPMODE_LISTENONLY } esp_sntp_operatingmode_t;
+typedef enum { SNTP_SYNC_STATUS_RESET, SNTP_SYNC_STATUS_COMPLETED, SNTP_SYNC_STATUS_IN_PROGRESS } sntp_sync_status_t;
+
+constexpr esp_sntp_operatingmode_t SNTP_OPMODE_POLL = ESP_SNTP_OPMODE_POLL;
+
+inline bool esp_sntp_enabled() { return false; }
+inline void esp_sntp_stop() {}
+inline void esp_sntp_init() {}
+inline void esp_sntp_setoperatingmode(esp_sntp_operatingmode_t /*mode*/) {}
+inline void esp_sntp_setservername(uint8_t /*index*/, const char* /*server*/) {}
+inline sntp_sync_status_t sntp_get_sync_status() { return SNTP_SYNC_STATUS_RESET; }
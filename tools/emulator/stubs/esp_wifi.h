@@ -0,0 +1,27 @@
+#pragma once
+
+// Driver-level WiFi types; the calls are accepted and do nothing because the emulator has no radio.
+
+typedef enum {
+  WIFI_MODE_NULL = 0,
+  WIFI_MODE_STA,
+  WIFI_MODE_AP,
+  WIFI_MODE_APSTA,
+} wifi_mode_t;
+
+constexpr wifi_mode_t WIFI_OFF = WIFI_MODE_NULL;
+constexpr wifi_mode_t WIFI_STA = WIFI_MODE_STA;
+constexpr wifi_mode_t WIFI_AP = WIFI_MODE_AP;
+constexpr wifi_mode_t WIFI_AP_STA = WIFI_MODE_APSTA;
+
+typedef enum {
+  WIFI_AUTH_OPEN = 0,
+  WIFI_AUTH_WEP,
+  WIFI_AUTH_WPA_PSK,
+  WIFI_AUTH_WPA2_PSK,
+  WIFI_AUTH_WPA_WPA2_PSK,
+} wifi_auth_mode_t;
+
+typedef enum { WIFI_PS_NONE, WIFI_PS_MIN_MODEM, WIFI_PS_MAX_MODEM } wifi_ps_type_t;
+
+inline int esp_wifi_set_ps(wifi_ps_type_t /*type*/) { return 0; }
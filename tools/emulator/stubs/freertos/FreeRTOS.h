@@ -0,0 +1,29 @@
+#pragma once
+
+// FreeRTOS on host threads. A task is a std::thread, a tick is one millisecond, and critical sections take one
+// process-wide lock. See FreeRTOS.cpp.
+
+#include <cstdint>
+
+using BaseType_t = int;
+using UBaseType_t = unsigned int;
+using TickType_t = uint32_t;
+
+constexpr BaseType_t pdFALSE = 0;
+constexpr BaseType_t pdTRUE = 1;
+constexpr BaseType_t pdFAIL = pdFALSE;
+constexpr BaseType_t pdPASS = pdTRUE;
+constexpr TickType_t portMAX_DELAY = 0xFFFFFFFFu;
+
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) (static_cast<TickType_t>(ms))
+#define tskIDLE_PRIORITY 0
+#define configMAX_PRIORITIES 25
+
+using portMUX_TYPE = int;
+#define portMUX_INITIALIZER_UNLOCKED 0
+
+void vPortEnterCritical();
+void vPortExitCritical();
+#define taskENTER_CRITICAL(mux) vPortEnterCritical()
+#define taskEXIT_CRITICAL(mux) vPortExitCritical()
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+struct HostSemaphore;
+using SemaphoreHandle_t = HostSemaphore*;
+using QueueHandle_t = HostSemaphore*;
+
+// Storage for the *Static constructors; the host allocates the semaphore itself and ignores the buffer.
+struct StaticSemaphore_t {
+  void* reserved = nullptr;
+};
+
+SemaphoreHandle_t xSemaphoreCreateMutex();
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex();
+SemaphoreHandle_t xSemaphoreCreateBinary();
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t maxCount, UBaseType_t initialCount);
+inline SemaphoreHandle_t xSemaphoreCreateMutexStatic(StaticSemaphore_t* /*buffer*/) { return xSemaphoreCreateMutex(); }
+inline SemaphoreHandle_t xSemaphoreCreateRecursiveMutexStatic(StaticSemaphore_t* /*buffer*/) {
+  return xSemaphoreCreateRecursiveMutex();
+}
+void vSemaphoreDelete(SemaphoreHandle_t sem);
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticksToWait);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem);
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t sem, TickType_t ticksToWait);
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t sem);
+TaskHandle_t xSemaphoreGetMutexHolder(SemaphoreHandle_t sem);
+
+// Only used on semaphores: pdTRUE while one can be taken without blocking
+BaseType_t xQueuePeek(QueueHandle_t queue, void* buffer, TickType_t ticksToWait);
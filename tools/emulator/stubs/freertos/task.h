@@ -0,0 +1,27 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+struct HostTask;
+using TaskHandle_t = HostTask*;
+using TaskFunction_t = void (*)(void*);
+
+enum eNotifyAction { eNoAction = 0, eSetBits, eIncrement, eSetValueWithOverwrite, eSetValueWithoutOverwrite };
+
+// Stack depth and priority are accepted for source compatibility; host threads use the platform defaults.
+BaseType_t xTaskCreate(TaskFunction_t task, const char* name, uint32_t stackDepth, void* params, UBaseType_t priority,
+                       TaskHandle_t* createdTask);
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t task, const char* name, uint32_t stackDepth, void* params,
+                                   UBaseType_t priority, TaskHandle_t* createdTask, BaseType_t coreId);
+
+// vTaskDelete(nullptr) ends the calling task. Another task cannot be stopped from outside on the host; it is detached
+// and left blocked, which matches how the firmware only deletes tasks that are parked or about to exit.
+void vTaskDelete(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+TickType_t xTaskGetTickCount();
+TaskHandle_t xTaskGetCurrentTaskHandle();
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task);
+
+BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value, eNotifyAction action);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait);
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstddef>
+
+constexpr int MBEDTLS_ERR_BASE64_BUFFER_TOO_SMALL = -0x002A;
+constexpr int MBEDTLS_ERR_BASE64_INVALID_CHARACTER = -0x002C;
+
+// Same contract as mbedtls: with a too-small (or null) destination, *olen receives the required size.
+int mbedtls_base64_encode(unsigned char* dst, size_t dlen, size_t* olen, const unsigned char* src, size_t slen);
+int mbedtls_base64_decode(unsigned char* dst, size_t dlen, size_t* olen, const unsigned char* src, size_t slen);
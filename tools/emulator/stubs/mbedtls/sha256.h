@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Only OTA image verification hashes, and the emulator has no partitions to verify, so the context is a placeholder
+// and starting a hash fails.
+typedef struct {
+  int unused;
+} mbedtls_sha256_context;
+
+inline void mbedtls_sha256_init(mbedtls_sha256_context* /*ctx*/) {}
+inline void mbedtls_sha256_free(mbedtls_sha256_context* /*ctx*/) {}
+inline int mbedtls_sha256_starts_ret(mbedtls_sha256_context* /*ctx*/, int /*is224*/) { return -1; }
+inline int mbedtls_sha256_update_ret(mbedtls_sha256_context* /*ctx*/, const unsigned char* /*input*/,
+                                     size_t /*ilen*/) {
+  return -1;
+}
+inline int mbedtls_sha256_finish_ret(mbedtls_sha256_context* /*ctx*/, unsigned char* /*output*/) { return -1; }
@@ -5,7 +5,7 @@ cpf_convert.py — CrossPoint Font (CPF) binary converter.
 Rasterizes a TTF/OTF font file at a given pixel size using FreeType and writes
 a .cpf binary file suitable for loading by SdFont on the CrossPoint Reader.
 
-CPF binary format (22-byte header, then payload):
+CPF binary format (26-byte header, then payload):
   Magic     4 bytes  "CPF\\x01"
   advanceY  1 byte   uint8    line height in pixels
   ascender  4 bytes  int32 LE
@@ -243,7 +243,7 @@ def convert(font_path: str, size: int, output_path: str, use_2bit: bool) -> None
     assert struct.calcsize(INTERVAL_FMT) == 12, "EpdUnicodeInterval struct size mismatch"
 
     with open(output_path, "wb") as f:
-        # Header (22 bytes)
+        # Header (26 bytes)
         f.write(b"CPF\x01")
         f.write(struct.pack("<B", advance_y))
         f.write(struct.pack("<i", ascender))